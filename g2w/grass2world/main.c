@@ -13,6 +13,7 @@
 #include "world.h"
 #include "macaque.h"
 #include "fun.h" 
+#include "zonal.h"
 
 
 
@@ -57,6 +58,7 @@
   int  f,lev,lev2,ext;
   int  nh_flag,i;
   int world_flag, template_flag;
+  int zonal_flag;
   int 	label_cos, label_sin;
   float	mult,add,value;
   float value_sin, value_cos;
@@ -67,6 +69,7 @@
   char tmpname[MAXFILENAME];
   char tmpname2[MAXFILENAME];
   char template_fname[MAXFILENAME];
+  char grid_dir[MAXFILENAME];
   char world_fname[MAXFILENAME];
   char header_fname[MAXFILENAME];
   char **VARNAME;
@@ -84,6 +87,7 @@
 	nh_flag = 0;
 	template_flag = 0;
 	world_flag = 0;
+	zonal_flag = 0;
 	i = 0;
 	while (i < argc)
         {
@@ -103,6 +107,20 @@
 				strncpy(world_fname, argv[i+1], MAXFILENAME);
 				world_flag = 1;
 			}
+
+			/* compute all tables in memory instead of running rat */
+			if (!strcmp(argv[i],"-s"))
+			{
+				if (zonal_flag == 0)
+					zonal_flag = 1;
+			}
+
+			/* as -s, reading ascii grids <dir>/<map>.asc instead of GRASS maps */
+			if (!strcmp(argv[i],"-a"))
+			{
+				strncpy(grid_dir, argv[i+1], MAXFILENAME);
+				zonal_flag = 2;
+			}
 		i++;
 	}
  
@@ -261,10 +279,21 @@
      rat, one for each level. We then open the files
      and let a recursive routine go through them constructing
      the tree as it goes...
+
+     With -s (or -a) the same tables, and those of all the
+     parameters below, are computed in memory in one pass
+     over the maps instead.
   */
 
+  if (zonal_flag > 0)
+    zonal_tables(tlevel, (zonal_flag == 2) ? grid_dir : NULL);
+
   for(lev=0;lev<NUMLEVELS;lev++) {
 
+    /* table already computed by zonal_tables */
+    if (zonal_flag > 0)
+      break;
+
 	/* form rat command to find output the number of sub-levels for each level */
 	/*	ie. the number of patches in each zone 												*/
 
@@ -369,6 +398,10 @@
 
   for(lev=0;lev<NUMLEVELS;lev++) {
 
+    /* tables already computed by zonal_tables */
+    if (zonal_flag > 0)
+      break;
+
    for (ext=0; ext < tlevel[lev].extent; ext++) {
 
     thetvarlist = tlevel[lev].thetvarlist;
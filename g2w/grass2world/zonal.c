@@ -0,0 +1,662 @@
+/*
+  zonal.c
+
+  In-memory replacement for the rat (r.average.tables) pipeline used
+  by grass2world.
+
+  For every level of the template, rat is run once to count the sub
+  units of each unit, and once more for each parameter (and extent) to
+  average, count or take the mode of a map within each unit, each run
+  reading the maps again through r.stats and temp files. Here every map
+  is read once, a band of rows at a time, and all of those tables are
+  accumulated together: each level keeps a hash table of its units
+  (keyed by the categories of all levels down to it) holding the cell
+  count and the sums of the averaged maps, plus a hash table of
+  (unit, statistic, category) cell counts for counts and modes.
+
+  When compiled with OpenMP the maps of a band are parsed in parallel,
+  and the rows of a band are split over threads which each keep their
+  own tables; these are merged at the end. All sums are of integer
+  categories, so the result does not depend on the number of threads.
+
+  The tables are those rat would produce with -z (and -k for
+  parameters): units with a zero (or no data) category at any level are
+  left out, no data in parameter maps counts as category 0, floating
+  point maps are rounded to integer categories (r.stats -i), and the
+  values go through the same text precision rat writes them with.
+
+  Maps are read with r.out.ascii from the current GRASS location or,
+  if a grid directory is given, from the ascii grids <dir>/<map>.asc
+  (ESRI or GRASS ascii format), so GRASS is not needed at all.
+*/
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "world.h"
+#include "macaque.h"
+#include "fun.h"
+#include "zonal.h"
+
+static void *zalloc(size_t size)
+{
+	void *ptr;
+
+	if ((ptr = malloc(size > 0 ? size : 1)) == NULL) {
+		fprintf(stderr, "ERROR: Could not allocate zonal statistics tables \n");
+		exit(EXIT_FAILURE);
+	}
+	return(ptr);
+}
+
+static void *zrealloc(void *ptr, size_t size)
+{
+	if ((ptr = realloc(ptr, size > 0 ? size : 1)) == NULL) {
+		fprintf(stderr, "ERROR: Could not allocate zonal statistics tables \n");
+		exit(EXIT_FAILURE);
+	}
+	return(ptr);
+}
+
+/* Hash tables ------------------------------------------------------------- */
+
+static void zhash_init(struct zhashstruct *h, int klen)
+{
+	h->klen = klen;
+	h->n = 0;
+	h->cap = 0;
+	h->keys = NULL;
+	h->nslots = 0;
+	h->slots = NULL;
+}
+
+static void zhash_free(struct zhashstruct *h)
+{
+	free(h->keys);
+	free(h->slots);
+	zhash_init(h, h->klen);
+}
+
+static unsigned int zhash_key(const int *key, int klen)
+{
+	unsigned int h = 2166136261u;
+	int i;
+
+	for (i = 0; i < klen; i++) {
+		h ^= (unsigned int)key[i];
+		h *= 16777619u;
+		h ^= h >> 15;
+	}
+	return(h);
+}
+
+static void zhash_rehash(struct zhashstruct *h, int nslots)
+{
+	int e, s;
+
+	free(h->slots);
+	h->nslots = nslots;
+	h->slots = (int *)zalloc(nslots * sizeof(int));
+	memset(h->slots, 0, nslots * sizeof(int));
+	for (e = 0; e < h->n; e++) {
+		s = zhash_key(&(h->keys[e * h->klen]), h->klen) & (nslots - 1);
+		while (h->slots[s] != 0)
+			s = (s + 1) & (nslots - 1);
+		h->slots[s] = e + 1;
+	}
+}
+
+/* Return the index of key, adding it if it is new. Sets *inserted. */
+static int zhash_find(struct zhashstruct *h, const int *key, int *inserted)
+{
+	int s, e;
+
+	if (ZONALHASHLOAD * (h->n + 1) > h->nslots)
+		zhash_rehash(h, (h->nslots == 0) ? 1024 : 2 * h->nslots);
+
+	s = zhash_key(key, h->klen) & (h->nslots - 1);
+	while ((e = h->slots[s]) != 0) {
+		if (memcmp(&(h->keys[(e - 1) * h->klen]), key, h->klen * sizeof(int)) == 0) {
+			*inserted = 0;
+			return(e - 1);
+		}
+		s = (s + 1) & (h->nslots - 1);
+	}
+
+	if (h->n == h->cap) {
+		h->cap = (h->cap == 0) ? 1024 : 2 * h->cap;
+		h->keys = (int *)zrealloc(h->keys, (size_t)h->cap * h->klen * sizeof(int));
+	}
+	memcpy(&(h->keys[h->n * h->klen]), key, h->klen * sizeof(int));
+	h->slots[s] = h->n + 1;
+	*inserted = 1;
+	return(h->n++);
+}
+
+/* Unit tables ------------------------------------------------------------- */
+
+static void zunit_init(struct zunitstruct *z, int lev, int nsums)
+{
+	zhash_init(&(z->index), lev + 1);
+	zhash_init(&(z->values), 3);
+	z->count = NULL;
+	z->sums = NULL;
+	z->nsums = nsums;
+	z->vcount = NULL;
+}
+
+static void zunit_free(struct zunitstruct *z)
+{
+	zhash_free(&(z->index));
+	zhash_free(&(z->values));
+	free(z->count);
+	free(z->sums);
+	free(z->vcount);
+}
+
+static int zunit_find(struct zunitstruct *z, const int *key)
+{
+	int u, inserted, cap;
+
+	cap = z->index.cap;
+	u = zhash_find(&(z->index), key, &inserted);
+	if (z->index.cap != cap || z->count == NULL) {
+		z->count = (long *)zrealloc(z->count, z->index.cap * sizeof(long));
+		z->sums = (double *)zrealloc(z->sums, (size_t)z->index.cap * z->nsums * sizeof(double));
+	}
+	if (inserted) {
+		z->count[u] = 0;
+		memset(&(z->sums[(size_t)u * z->nsums]), 0, z->nsums * sizeof(double));
+	}
+	return(u);
+}
+
+static void zunit_value(struct zunitstruct *z, int u, int s, int cat, long n)
+{
+	int key[3];
+	int v, inserted, cap;
+
+	key[0] = u;
+	key[1] = s;
+	key[2] = cat;
+	cap = z->values.cap;
+	v = zhash_find(&(z->values), key, &inserted);
+	if (z->values.cap != cap || z->vcount == NULL)
+		z->vcount = (long *)zrealloc(z->vcount, z->values.cap * sizeof(long));
+	if (inserted)
+		z->vcount[v] = 0;
+	z->vcount[v] += n;
+}
+
+/* Map input --------------------------------------------------------------- */
+
+/* Read one value, with "*" (GRASS no data) and the grid no data value as 0 */
+static int zmap_value(struct zmapstruct *m, double *value)
+{
+	char token[64];
+
+	if (m->haspending) {
+		m->haspending = 0;
+		*value = m->pending;
+		return(1);
+	}
+	if (fscanf(m->fp, "%63s", token) != 1)
+		return(0);
+	if (token[0] == '*')
+		*value = 0.0;
+	else {
+		*value = atof(token);
+		if (m->hasnodata && (*value == m->nodata))
+			*value = 0.0;
+	}
+	return(1);
+}
+
+static void zmap_open(struct zmapstruct *m, char *grid_dir)
+{
+	char command[MAXCOMMAND];
+	char token[64], value[64];
+	char *end;
+	double north = 0.0, south = 0.0, east = 0.0, west = 0.0, cellsize = 0.0;
+
+	if (grid_dir != NULL) {
+		snprintf(command, MAXCOMMAND, "%s/%s.asc", grid_dir, m->name);
+		m->fp = fopen(command, "r");
+		m->ispipe = 0;
+	}
+	else {
+		snprintf(command, MAXCOMMAND, "r.out.ascii input=%s output=- 2>/dev/null", m->name);
+		m->fp = popen(command, "r");
+		m->ispipe = 1;
+	}
+	if (m->fp == NULL) {
+		fprintf(stderr, "ERROR: Could not read map %s \n", m->name);
+		exit(EXIT_FAILURE);
+	}
+
+	/* GRASS (north: ... cols:) or ESRI (ncols ... NODATA_value) header */
+	m->rows = m->cols = 0;
+	m->hasnodata = 0;
+	m->haspending = 0;
+	while (fscanf(m->fp, "%63s", token) == 1) {
+		strtod(token, &end);
+		if ((token[0] == '*') || (*end == '\0')) {
+			m->pending = (token[0] == '*') ? 0.0 : atof(token);
+			m->haspending = 1;
+			break;
+		}
+		if (fscanf(m->fp, "%63s", value) != 1)
+			break;
+		for (end = token; *end != '\0'; end++)
+			*end = tolower((unsigned char)*end);
+		if (!strcmp(token, "north:"))	north = atof(value);
+		else if (!strcmp(token, "south:"))	south = atof(value);
+		else if (!strcmp(token, "east:"))	east = atof(value);
+		else if (!strcmp(token, "west:"))	west = atof(value);
+		else if (!strcmp(token, "rows:") || !strcmp(token, "nrows"))	m->rows = atoi(value);
+		else if (!strcmp(token, "cols:") || !strcmp(token, "ncols"))	m->cols = atoi(value);
+		else if (!strcmp(token, "cellsize"))	cellsize = atof(value);
+		else if (!strcmp(token, "nodata_value") || !strcmp(token, "null:")) {
+			m->nodata = atof(value);
+			m->hasnodata = 1;
+		}
+	}
+	if (m->haspending && m->hasnodata && (m->pending == m->nodata))
+		m->pending = 0.0;
+
+	if ((m->rows <= 0) || (m->cols <= 0)) {
+		fprintf(stderr, "ERROR: Could not read the header of map %s \n", m->name);
+		exit(EXIT_FAILURE);
+	}
+	if (cellsize > 0.0)
+		m->cellarea = cellsize * cellsize;
+	else
+		m->cellarea = ((north - south) / m->rows) * ((east - west) / m->cols);
+
+	m->band = (double *)zalloc((size_t)ZONALBANDROWS * m->cols * sizeof(double));
+}
+
+static void zmap_close(struct zmapstruct *m)
+{
+	if (m->ispipe)
+		pclose(m->fp);
+	else
+		fclose(m->fp);
+	free(m->band);
+}
+
+static int zmap_index(struct zmapstruct **maps, int *nmaps, char *name)
+{
+	int m;
+
+	for (m = 0; m < *nmaps; m++)
+		if (!strcmp((*maps)[m].name, name))
+			return(m);
+	*maps = (struct zmapstruct *)zrealloc(*maps, (*nmaps + 1) * sizeof(struct zmapstruct));
+	memset(&((*maps)[*nmaps]), 0, sizeof(struct zmapstruct));
+	strncpy((*maps)[*nmaps].name, name, MAXFILENAME - 1);
+	return((*nmaps)++);
+}
+
+/* rat -k: maps named ..1d.., ..1c.. or ..1k.. are scaled integers */
+static double zonal_kfactor(char *name)
+{
+	return(strstr(name, "1d") ? 10.0 :
+		strstr(name, "1c") ? 100.0 :
+		strstr(name, "1k") ? 1000.0 : 1.0);
+}
+
+/* r.stats -i reads floating point maps as integer categories */
+static int zonal_cat(double value)
+{
+	return((int)floor(value + 0.5));
+}
+
+/* Values pass through rat as "%.10lf" and are then written as "%lf" */
+static float zonal_text(double value)
+{
+	char buf[100];
+
+	sprintf(buf, "%.10lf", value);
+	value = atof(buf);
+	sprintf(buf, "%lf", value);
+	return((float)atof(buf));
+}
+
+/* Sort units of a level by their categories, as r.stats does */
+static struct zhashstruct *zsort_index;
+
+static int zonal_compare(const void *a, const void *b)
+{
+	const int *ka = &(zsort_index->keys[*(const int *)a * zsort_index->klen]);
+	const int *kb = &(zsort_index->keys[*(const int *)b * zsort_index->klen]);
+	int i;
+
+	for (i = 0; i < zsort_index->klen; i++) {
+		if (ka[i] != kb[i])
+			return((ka[i] < kb[i]) ? -1 : 1);
+	}
+	return(0);
+}
+
+static void zonal_table_add(struct tableliststruct **head, struct tableliststruct **tail,
+	int label, float value)
+{
+	struct tableliststruct *entry;
+
+	entry = (struct tableliststruct *)zalloc(sizeof(struct tableliststruct));
+	entry->label = label;
+	entry->value = value;
+	entry->next = NULL;
+	if (*tail == NULL)
+		*head = entry;
+	else
+		(*tail)->next = entry;
+	*tail = entry;
+}
+
+void zonal_tables(tlevel, grid_dir)
+	struct	tlevelstruct	*tlevel;
+	char	*grid_dir;
+{
+	struct zmapstruct *maps = NULL;
+	struct zstatstruct *stats[NUMLEVELS];
+	struct zunitstruct *units;	/* [thread][level] */
+	struct zunitstruct *total;
+	struct tvarliststruct *thetvarlist;
+	struct tableliststruct *tail;
+	int nstats[NUMLEVELS], nsums[NUMLEVELS];
+	int levmap[NUMLEVELS];
+	int nmaps = 0;
+	int nthreads = 1;
+	int lev, ext, s, m, t, r, nrows, band, u, g, ncols, rows;
+	int *order, *remap, *distinct, *modecat;
+	long *modecount;
+	double value;
+	float angle;
+
+	/* Plan the statistics of each level: first the sub unit count (the
+	   rat "X" table of the next level map), then one per parameter and
+	   extent, in template order */
+	for (lev = 0; lev < NUMLEVELS; lev++)
+		levmap[lev] = zmap_index(&maps, &nmaps, tlevel[lev].map);
+
+	for (lev = 0; lev < NUMLEVELS; lev++) {
+		nstats[lev] = 1;
+		for (thetvarlist = tlevel[lev].thetvarlist; thetvarlist != NULL; thetvarlist = thetvarlist->next)
+			nstats[lev] += tlevel[lev].extent;
+		stats[lev] = (struct zstatstruct *)zalloc(nstats[lev] * sizeof(struct zstatstruct));
+
+		nsums[lev] = 0;
+		stats[lev][0].kind = (lev < BOTTOMLEVEL) ? ZCOUNT : ZZERO;
+		stats[lev][0].map = (lev < BOTTOMLEVEL) ? levmap[lev + 1] : -1;
+		stats[lev][0].kfactor = 1.0;
+		stats[lev][0].table = &(tlevel[lev].table);
+
+		s = 1;
+		for (thetvarlist = tlevel[lev].thetvarlist; thetvarlist != NULL; thetvarlist = thetvarlist->next) {
+			for (ext = 0; ext < tlevel[lev].extent; ext++, s++) {
+				stats[lev][s].map = -1;
+				stats[lev][s].kfactor = 1.0;
+				stats[lev][s].table = &(thetvarlist->table[ext]);
+				thetvarlist->table[ext] = NULL;
+				switch (thetvarlist->funcnum) {
+				case 0:
+				case 1:
+				case 4:
+				case 5:
+					stats[lev][s].kind = ZSUM;
+					stats[lev][s].map = zmap_index(&maps, &nmaps, thetvarlist->map[ext]);
+					stats[lev][s].kfactor = zonal_kfactor(thetvarlist->map[ext]);
+					stats[lev][s].slot = nsums[lev]++;
+					break;
+				case 2:
+					stats[lev][s].kind = ZAREA;
+					break;
+				case 3:
+					stats[lev][s].kind = ZCOUNT;
+					stats[lev][s].map = zmap_index(&maps, &nmaps, thetvarlist->map[ext]);
+					break;
+				case 8:
+					stats[lev][s].kind = ZSPAVG;
+					stats[lev][s].map = zmap_index(&maps, &nmaps, thetvarlist->map[ext]);
+					stats[lev][s].map2 = zmap_index(&maps, &nmaps, thetvarlist->map2[ext]);
+					stats[lev][s].slot = nsums[lev];
+					nsums[lev] += 2;
+					break;
+				case 9:
+					stats[lev][s].kind = ZMODE;
+					stats[lev][s].map = zmap_index(&maps, &nmaps, thetvarlist->map[ext]);
+					break;
+				default:	/* value, dvalue: nothing to compute */
+					stats[lev][s].kind = ZZERO;
+					stats[lev][s].table = NULL;
+				}
+			}
+		}
+	}
+
+	for (m = 0; m < nmaps; m++) {
+		zmap_open(&(maps[m]), grid_dir);
+		if ((maps[m].rows != maps[0].rows) || (maps[m].cols != maps[0].cols)) {
+			fprintf(stderr, "ERROR: map %s is %d x %d, map %s is %d x %d \n",
+				maps[m].name, maps[m].rows, maps[m].cols,
+				maps[0].name, maps[0].rows, maps[0].cols);
+			exit(EXIT_FAILURE);
+		}
+	}
+	rows = maps[0].rows;
+	ncols = maps[0].cols;
+	printf("\n Computing zonal statistics of %d maps (%d x %d)", nmaps, rows, ncols);
+
+#ifdef _OPENMP
+	nthreads = omp_get_max_threads();
+#endif
+	units = (struct zunitstruct *)zalloc((size_t)nthreads * NUMLEVELS * sizeof(struct zunitstruct));
+	for (t = 0; t < nthreads; t++)
+		for (lev = 0; lev < NUMLEVELS; lev++)
+			zunit_init(&(units[t * NUMLEVELS + lev]), lev, nsums[lev]);
+
+	/* Stream the maps a band of rows at a time */
+	for (band = 0; band < rows; band += ZONALBANDROWS) {
+		nrows = (rows - band < ZONALBANDROWS) ? rows - band : ZONALBANDROWS;
+
+		#pragma omp parallel for schedule(dynamic, 1)
+		for (m = 0; m < nmaps; m++) {
+			int i;
+			for (i = 0; i < nrows * ncols; i++) {
+				if (zmap_value(&(maps[m]), &(maps[m].band[i])) == 0) {
+					fprintf(stderr, "ERROR: map %s is shorter than %d x %d \n",
+						maps[m].name, rows, ncols);
+					exit(EXIT_FAILURE);
+				}
+			}
+		}
+
+		#pragma omp parallel for schedule(static) private(r)
+		for (r = 0; r < nrows; r++) {
+			struct zunitstruct *mine;
+			struct zstatstruct *st;
+			int cats[NUMLEVELS];
+			int c, l, depth, i, k, unit, tid;
+			double *sums;
+			double a, b;
+
+			tid = 0;
+#ifdef _OPENMP
+			tid = omp_get_thread_num();
+#endif
+			mine = &(units[tid * NUMLEVELS]);
+
+			for (c = 0; c < ncols; c++) {
+				i = r * ncols + c;
+
+				/* rat -z: a unit with a zero category at any level is left out */
+				for (depth = 0; depth < NUMLEVELS; depth++) {
+					cats[depth] = zonal_cat(maps[levmap[depth]].band[i]);
+					if (cats[depth] == 0)
+						break;
+				}
+
+				for (l = 0; l < depth; l++) {
+					unit = zunit_find(&(mine[l]), cats);
+					mine[l].count[unit]++;
+					sums = &(mine[l].sums[(size_t)unit * nsums[l]]);
+					for (k = 0; k < nstats[l]; k++) {
+						st = &(stats[l][k]);
+						switch (st->kind) {
+						case ZSUM:
+							sums[st->slot] += zonal_cat(maps[st->map].band[i]);
+							break;
+						case ZSPAVG:
+							/* r.mapcalc cos = 100*cos(map)*sin(map2), sin = 100*sin(map)*sin(map2), in degrees */
+							a = maps[st->map].band[i] * DtoR;
+							b = maps[st->map2].band[i] * DtoR;
+							sums[st->slot] += zonal_cat(100.0 * sin(a) * sin(b));
+							sums[st->slot + 1] += zonal_cat(100.0 * cos(a) * sin(b));
+							break;
+						case ZCOUNT:
+						case ZMODE:
+							zunit_value(&(mine[l]), unit, k, zonal_cat(maps[st->map].band[i]), 1);
+							break;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	for (m = 0; m < nmaps; m++)
+		zmap_close(&(maps[m]));
+
+	/* Merge the thread tables, in thread order, and write out each level */
+	for (lev = 0; lev < NUMLEVELS; lev++) {
+		total = &(units[lev]);
+		for (t = 1; t < nthreads; t++) {
+			struct zunitstruct *mine = &(units[t * NUMLEVELS + lev]);
+			int key[3];
+
+			remap = (int *)zalloc(mine->index.n * sizeof(int));
+			for (u = 0; u < mine->index.n; u++) {
+				g = zunit_find(total, &(mine->index.keys[u * mine->index.klen]));
+				remap[u] = g;
+				total->count[g] += mine->count[u];
+				for (s = 0; s < nsums[lev]; s++)
+					total->sums[(size_t)g * nsums[lev] + s] += mine->sums[(size_t)u * nsums[lev] + s];
+			}
+			for (u = 0; u < mine->values.n; u++) {
+				memcpy(key, &(mine->values.keys[u * 3]), sizeof(key));
+				zunit_value(total, remap[key[0]], key[1], key[2], mine->vcount[u]);
+			}
+			free(remap);
+			zunit_free(mine);
+		}
+
+		/* counts and modes of every (unit, statistic) */
+		distinct = (int *)zalloc((size_t)total->index.n * nstats[lev] * sizeof(int));
+		modecat = (int *)zalloc((size_t)total->index.n * nstats[lev] * sizeof(int));
+		modecount = (long *)zalloc((size_t)total->index.n * nstats[lev] * sizeof(long));
+		memset(distinct, 0, (size_t)total->index.n * nstats[lev] * sizeof(int));
+		memset(modecount, 0, (size_t)total->index.n * nstats[lev] * sizeof(long));
+		for (u = 0; u < total->values.n; u++) {
+			int *key = &(total->values.keys[u * 3]);
+			size_t i = (size_t)key[0] * nstats[lev] + key[1];
+
+			distinct[i]++;
+			/* ties go to the lowest category, as rat scans categories in order */
+			if ((total->vcount[u] > modecount[i]) ||
+				((total->vcount[u] == modecount[i]) && (key[2] < modecat[i]))) {
+				modecount[i] = total->vcount[u];
+				modecat[i] = key[2];
+			}
+		}
+
+		order = (int *)zalloc(total->index.n * sizeof(int));
+		for (u = 0; u < total->index.n; u++)
+			order[u] = u;
+		zsort_index = &(total->index);
+		qsort(order, total->index.n, sizeof(int), zonal_compare);
+
+		for (s = 0; s < nstats[lev]; s++) {
+			struct zstatstruct *st = &(stats[lev][s]);
+
+			if (st->table == NULL)
+				continue;
+			*(st->table) = NULL;
+			tail = NULL;
+			for (g = 0; g < total->index.n; g++) {
+				size_t i;
+				double *sums;
+				int label;
+
+				u = order[g];
+				i = (size_t)u * nstats[lev] + s;
+				sums = &(total->sums[(size_t)u * nsums[lev]]);
+				label = total->index.keys[u * total->index.klen + lev];
+
+				switch (st->kind) {
+				case ZSUM:
+					value = zonal_text((sums[st->slot] / st->kfactor) / total->count[u]);
+					break;
+				case ZAREA:
+					value = zonal_text(total->count[u] * maps[0].cellarea);
+					break;
+				case ZCOUNT:
+					value = distinct[i];
+					break;
+				case ZMODE:
+					value = zonal_text(modecat[i]);
+					break;
+				case ZSPAVG: {
+					float value_sin = zonal_text(sums[st->slot] / total->count[u]);
+					float value_cos = zonal_text(sums[st->slot + 1] / total->count[u]);
+					float aspect;
+
+					/* same conversion to an aspect as the rat based spavg */
+					angle = (float)atan(value_sin / value_cos) * RtoD;
+					if (value_cos < 0.0)
+						aspect = angle + 180;
+					else if (value_sin < 0.0)
+						aspect = angle + 360;
+					else
+						aspect = angle;
+					aspect = 360 - aspect;
+					if (aspect <= 270)
+						aspect += 90;
+					else
+						aspect -= 270;
+					value = aspect;
+					break;
+					}
+				default:
+					value = 0.0;
+				}
+				zonal_table_add(st->table, &tail, label, (float)value);
+			}
+			/* sentinel, as left at the end of a table read from a rat file */
+			zonal_table_add(st->table, &tail, 0, 0.0);
+		}
+
+		tlevel[lev].table_ptr = tlevel[lev].table;
+		for (thetvarlist = tlevel[lev].thetvarlist; thetvarlist != NULL; thetvarlist = thetvarlist->next)
+			for (ext = 0; ext < tlevel[lev].extent; ext++)
+				thetvarlist->table_ptr[ext] = thetvarlist->table[ext];
+
+		printf("\n %d %s units", total->index.n, LEVELNAME[lev]);
+		free(order);
+		free(distinct);
+		free(modecat);
+		free(modecount);
+		zunit_free(total);
+		free(stats[lev]);
+	}
+
+	free(units);
+	free(maps);
+}
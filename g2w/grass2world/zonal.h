@@ -0,0 +1,71 @@
+/*
+  In-memory zonal statistics for grass2world.
+
+  Replaces the rat (r.average.tables) temp-file pipeline: every map named
+  in the template is streamed once, and the tables that rat would have
+  written for each level and each parameter are accumulated in hash-keyed
+  tables, in parallel over bands of rows when built with OpenMP.
+*/
+
+#ifndef ZONAL_H
+#define ZONAL_H
+
+#define ZONALBANDROWS 64
+#define ZONALHASHLOAD 2	/* slots per entry */
+
+/* Kinds of statistic kept for a spatial unit */
+#define ZSUM	0	/* average (aver, daver, eqn, deqn) */
+#define ZAREA	1	/* area of the unit */
+#define ZCOUNT	2	/* number of distinct categories (count, sub units) */
+#define ZMODE	3	/* category with the largest area (mode) */
+#define ZSPAVG	4	/* spherical average (spavg), two sums */
+#define ZZERO	5	/* constant zero (bottom level sub units) */
+
+/* Hash table of fixed length integer keys. Values are the insertion index. */
+struct zhashstruct {
+	int klen;
+	int n;
+	int cap;
+	int *keys;
+	int nslots;
+	int *slots;	/* entry index + 1, 0 if empty */
+};
+
+/* A statistic requested by the template at one level */
+struct zstatstruct {
+	int kind;
+	int map;		/* index into the map list */
+	int map2;		/* second map of spavg */
+	int slot;		/* first sum slot of ZSUM and ZSPAVG */
+	double kfactor;	/* divisor of averages of maps named "1d", "1c" or "1k" */
+	struct tableliststruct **table;	/* where the finished table goes */
+};
+
+/* Units found at one level, with their cell counts and sums */
+struct zunitstruct {
+	struct zhashstruct index;	/* key is the categories of levels 0..lev */
+	long *count;
+	double *sums;
+	int nsums;
+	struct zhashstruct values;	/* key is (unit, stat, category) */
+	long *vcount;
+};
+
+/* A map read as text from r.out.ascii or an ascii grid file */
+struct zmapstruct {
+	char name[MAXFILENAME];
+	FILE *fp;
+	int ispipe;
+	int rows;
+	int cols;
+	double cellarea;
+	int hasnodata;
+	double nodata;
+	int haspending;	/* first data value, read while looking for the header */
+	double pending;
+	double *band;
+};
+
+void zonal_tables(struct tlevelstruct *tlevel, char *grid_dir);
+
+#endif
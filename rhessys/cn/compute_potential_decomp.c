@@ -103,9 +103,13 @@ int compute_potential_decomp(double tsoil, double maxpsi,
 	but set parameters to reduce sensitivity to water stress
 	(Parton et al, 1996 Global Biogeochemical cycles, 10:3, 401-412 ) */
 
+	/* frozen soil has no decomposition whatever the moisture, so	*/
+	/* the moisture scalar is not evaluated				*/
 	a=0.68; b=2.5; c=0.0012; d=2.84;
-	w_scalar = 0.0;
-	if (std > ZERO) {
+	if (t_scalar == 0.0)
+		w_scalar = 0.0;
+	else if (std > ZERO) {
+		w_scalar = 0.0;
 		for (i=0; i<NUM_NORMAL; i++) {
 			thetai = theta + NORMAL[i]*std;
 			thetai = min(1.0, thetai);
@@ -135,6 +139,18 @@ int compute_potential_decomp(double tsoil, double maxpsi,
 	/* assign output variables */
 	cs_litr->t_scalar = t_scalar;
 	cs_litr->w_scalar = w_scalar;
+	/* classify the day: with a zero rate scalar, or no pool with	*/
+	/* both C and N, every potential flux below is zero and	*/
+	/* update_decomp can leave the pools alone			*/
+	cdf->decomp_active = (rate_scalar != 0.0) && (
+		((cs_litr->litr1c > ZERO) && (ns_litr->litr1n > ZERO)) ||
+		((cs_litr->litr2c > ZERO) && (ns_litr->litr2n > ZERO)) ||
+		((cs_litr->litr3c > ZERO) && (ns_litr->litr3n > ZERO)) ||
+		((cs_litr->litr4c > ZERO) && (ns_litr->litr4n > ZERO)) ||
+		((cs_soil->soil1c > ZERO) && (ns_soil->soil1n > ZERO)) ||
+		((cs_soil->soil2c > ZERO) && (ns_soil->soil2n > ZERO)) ||
+		((cs_soil->soil3c > ZERO) && (ns_soil->soil3n > ZERO)) ||
+		((cs_soil->soil4c > ZERO) && (ns_soil->soil4n > ZERO)));
 	/* calculate compartment C:N ratios */
 	if ((cs_litr->litr1c > ZERO) && (ns_litr->litr1n > ZERO ))	cn_l1 = cs_litr->litr1c/ns_litr->litr1n;
 		else cn_l1 = LIVELAB_CN;
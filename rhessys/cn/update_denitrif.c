@@ -86,21 +86,6 @@ int update_denitrif(
 			a=4.82; b=14.0; c=16.0; d=1.39;
 		}
 
-		water_scalar = 0.0;
-		if (std > 0) {
-			for (i =1; i< NUM_NORMAL; i++) {
-				thetai = theta + std*NORMAL[i];
-				thetai = min(1.0, thetai);
-				thetai = max(0.0, thetai);
-				if (thetai > ZERO)
-				water_scalari = min(1.0,a / pow(b,  (c / pow(b, (d*thetai) )) ));
-				water_scalar += 1.0/NUM_NORMAL * water_scalari;
-				}
-			}
-		else
-				water_scalar = min(1.0,a / pow(b,  (c / pow(b, (d*theta) )) ));
-
-
 		nitrate_ratio = (ns_soil->nitrate)
 			/ (cs_soil->totalc + ns_soil->totaln) * 1e6;
 		/*--------------------------------------------------------------*/
@@ -119,9 +104,28 @@ int update_denitrif(
 		else
 			fCO2 = 0.0;
 		/*--------------------------------------------------------------*/
-		/*	estimate denitrification				*/
+		/*	estimate denitrification; without respiration (or	*/
+		/*	nitrate) there is none whatever the water scalar, so	*/
+		/*	the water scalar is only evaluated when it matters	*/
 		/*--------------------------------------------------------------*/
-		denitrify = min(fCO2, fnitrate) * water_scalar;
+		if (min(fCO2, fnitrate) > 0.0) {
+			water_scalar = 0.0;
+			if (std > 0) {
+				for (i =1; i< NUM_NORMAL; i++) {
+					thetai = theta + std*NORMAL[i];
+					thetai = min(1.0, thetai);
+					thetai = max(0.0, thetai);
+					if (thetai > ZERO)
+					water_scalari = min(1.0,a / pow(b,  (c / pow(b, (d*thetai) )) ));
+					water_scalar += 1.0/NUM_NORMAL * water_scalari;
+					}
+				}
+			else
+					water_scalar = min(1.0,a / pow(b,  (c / pow(b, (d*theta) )) ));
+			denitrify = min(fCO2, fnitrate) * water_scalar;
+		}
+		else
+			denitrify = 0.0;
 	} /* end mineralized N available */
 	else
 		denitrify = 0.0;
@@ -120,8 +120,17 @@ int update_nitrif(
 			a=0.6; b=1.27; c=0.0012; d=2.84;
 		}
 
-		water_scalar = 0.0;
-		if (std > ZERO) {
+		/*--------------------------------------------------------------*/
+		/*	the temperature scalar is zero in cold soil (below about */
+		/*	-11 C), when the moisture scalar need not be evaluated	*/
+		/*--------------------------------------------------------------*/
+		T_scalar = -0.06 + 0.13 * exp(0.07 * soilT);
+		if (T_scalar < ZERO) T_scalar = 0.0;
+
+		if (T_scalar == 0.0)
+			water_scalar = 0.0;
+		else if (std > ZERO) {
+			water_scalar = 0.0;
 			for (i=0; i<NUM_NORMAL; i++) {
 				thetai = theta + NORMAL[i]*std;
 				thetai = min(1.0, thetai);
@@ -138,9 +147,6 @@ int update_nitrif(
 			else
 				water_scalar = 0.000001;
 			}
-	
-		T_scalar = -0.06 + 0.13 * exp(0.07 * soilT);
-		if (T_scalar < ZERO) T_scalar = 0.0;
                 /*--------------------------------------------------------------*/
                 /* effect of pH on nitrification                                */
                 /*--------------------------------------------------------------*/
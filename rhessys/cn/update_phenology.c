@@ -394,42 +394,45 @@ void update_phenology(struct zone_object  *zone,
 	/*		last seasons stored photosynthesis		*/
 	/*	note all cdf and ndf variables are zero'd at the 	*/
 	/*	start of the day, so only values set above are used	*/
+	/*	- transfers are only set during leaf expansion, so	*/
+	/*	the rest of the year there is nothing to move		*/
 	/*--------------------------------------------------------------*/
-	 
-	/* Leaf carbon transfer growth */
-	cs->leafc            += cdf->leafc_transfer_to_leafc;
-     	cs->leafc_age1            += cdf->leafc_transfer_to_leafc;
-	cs->leafc_transfer   -= cdf->leafc_transfer_to_leafc;
-	/* Leaf nitrogen transfer growth */
-	ns->leafn           += ndf->leafn_transfer_to_leafn;
-	ns->leafn_transfer  -= ndf->leafn_transfer_to_leafn;
-	if (grow_flag > 0) {
-		cs->frootc           += cdf->frootc_transfer_to_frootc;
-		cs->frootc_transfer  -= cdf->frootc_transfer_to_frootc;
-		ns->frootn          += ndf->frootn_transfer_to_frootn;
-		ns->frootn_transfer -= ndf->frootn_transfer_to_frootn;
-		if (epc.veg_type == TREE){
-			/* Stem and coarse root transfer growth */
-			cs->live_stemc             += cdf->livestemc_transfer_to_livestemc;
-			cs->livestemc_transfer    -= cdf->livestemc_transfer_to_livestemc;
-			cs->dead_stemc             += cdf->deadstemc_transfer_to_deadstemc;
-			cs->deadstemc_transfer    -= cdf->deadstemc_transfer_to_deadstemc;
-			cs->live_crootc            += cdf->livecrootc_transfer_to_livecrootc;
-			cs->livecrootc_transfer   -= cdf->livecrootc_transfer_to_livecrootc;
-			cs->dead_crootc            += cdf->deadcrootc_transfer_to_deadcrootc;
-			cs->deadcrootc_transfer   -= cdf->deadcrootc_transfer_to_deadcrootc;
-			/* nitrogen transfer */
-			ns->live_stemn           += ndf->livestemn_transfer_to_livestemn;
-			ns->livestemn_transfer  -= ndf->livestemn_transfer_to_livestemn;
-			ns->dead_stemn           += ndf->deadstemn_transfer_to_deadstemn;
-			ns->deadstemn_transfer  -= ndf->deadstemn_transfer_to_deadstemn;
-			ns->live_crootn          += ndf->livecrootn_transfer_to_livecrootn;
-			ns->livecrootn_transfer -= ndf->livecrootn_transfer_to_livecrootn;
-			ns->dead_crootn          += ndf->deadcrootn_transfer_to_deadcrootn;
-			ns->deadcrootn_transfer -= ndf->deadcrootn_transfer_to_deadcrootn;
+	if (expand_flag == 1) {
+		/* Leaf carbon transfer growth */
+		cs->leafc            += cdf->leafc_transfer_to_leafc;
+	     	cs->leafc_age1            += cdf->leafc_transfer_to_leafc;
+		cs->leafc_transfer   -= cdf->leafc_transfer_to_leafc;
+		/* Leaf nitrogen transfer growth */
+		ns->leafn           += ndf->leafn_transfer_to_leafn;
+		ns->leafn_transfer  -= ndf->leafn_transfer_to_leafn;
+		if (grow_flag > 0) {
+			cs->frootc           += cdf->frootc_transfer_to_frootc;
+			cs->frootc_transfer  -= cdf->frootc_transfer_to_frootc;
+			ns->frootn          += ndf->frootn_transfer_to_frootn;
+			ns->frootn_transfer -= ndf->frootn_transfer_to_frootn;
+			if (epc.veg_type == TREE){
+				/* Stem and coarse root transfer growth */
+				cs->live_stemc             += cdf->livestemc_transfer_to_livestemc;
+				cs->livestemc_transfer    -= cdf->livestemc_transfer_to_livestemc;
+				cs->dead_stemc             += cdf->deadstemc_transfer_to_deadstemc;
+				cs->deadstemc_transfer    -= cdf->deadstemc_transfer_to_deadstemc;
+				cs->live_crootc            += cdf->livecrootc_transfer_to_livecrootc;
+				cs->livecrootc_transfer   -= cdf->livecrootc_transfer_to_livecrootc;
+				cs->dead_crootc            += cdf->deadcrootc_transfer_to_deadcrootc;
+				cs->deadcrootc_transfer   -= cdf->deadcrootc_transfer_to_deadcrootc;
+				/* nitrogen transfer */
+				ns->live_stemn           += ndf->livestemn_transfer_to_livestemn;
+				ns->livestemn_transfer  -= ndf->livestemn_transfer_to_livestemn;
+				ns->dead_stemn           += ndf->deadstemn_transfer_to_deadstemn;
+				ns->deadstemn_transfer  -= ndf->deadstemn_transfer_to_deadstemn;
+				ns->live_crootn          += ndf->livecrootn_transfer_to_livecrootn;
+				ns->livecrootn_transfer -= ndf->livecrootn_transfer_to_livecrootn;
+				ns->dead_crootn          += ndf->deadcrootn_transfer_to_deadcrootn;
+				ns->deadcrootn_transfer -= ndf->deadcrootn_transfer_to_deadcrootn;
 
-		}
-	}	/* end of grow processing */
+			}
+		}	/* end of grow processing */
+	} /* end expansion transfers */
 	/*--------------------------------------------------------------*/
 	/* check for leaf and fine root litfall for this day */
 	/*--------------------------------------------------------------*/
@@ -72,18 +72,23 @@ void	basin_daily_F(
 		struct stream_network_object *,
 		int, struct	date);
 
-	void	update_basin_patch_accumulator(
+	void	update_accumulators(
 		struct command_line_object *command_line,
 		struct basin_object *basin,
 		struct date current_date);
 
-	void	update_hillslope_accumulator(
-		struct command_line_object *command_line,
-		struct basin_object *basin);
+	int	balance_check_due(
+		struct command_line_object *,
+		struct date);
+
+	void	flush_balance_log(
+		struct balance_log_object *,
+		struct date);
 	/*--------------------------------------------------------------*/
 	/*  Local variable definition.                                  */
 	/*--------------------------------------------------------------*/
   int z, p,inx;
+	int	balance_due;
 	double	scale;
 	struct	hillslope_object *hillslope;
 	struct	zone_object *zone;
@@ -98,6 +103,14 @@ void	basin_daily_F(
 	basin[0].snowpack.energy_deficit = 0.0;
 	basin[0].snowpack.T = 0.0;
 	/*--------------------------------------------------------------*/
+	/*	mass balance checks (-balance) are logged by hillslope	*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].balance_flag == 1) {
+		balance_due = balance_check_due(command_line, current_date);
+		for (int h = 0 ; h < basin[0].num_hillslopes; h ++ )
+			basin[0].hillslopes[h][0].balance_log[0].due = balance_due;
+	}
+	/*--------------------------------------------------------------*/
 	/*	Simulate the hillslopes in this basin for the whole day		*/
 	/*--------------------------------------------------------------*/
     #pragma omp parallel for                                                     //schedule(dynamic) num_threads(4)
@@ -111,11 +124,28 @@ void	basin_daily_F(
 			current_date );
     }
 
+	/*--------------------------------------------------------------*/
+	/*	basin snow is the area weighted mean of snow covered	*/
+	/*	patches, summed by each hillslope as it ran		*/
+	/*	and any balance violations are printed in hillslope	*/
+	/*	order							*/
+	/*--------------------------------------------------------------*/
+	for (int h = 0 ; h < basin[0].num_hillslopes; h ++ ){
+		hillslope = basin[0].hillslopes[h];
+		basin[0].area_withsnow += hillslope[0].area_withsnow;
+		basin[0].snowpack.surface_age += hillslope[0].snowpack.surface_age;
+		basin[0].snowpack.T += hillslope[0].snowpack.T;
+		basin[0].snowpack.energy_deficit += hillslope[0].snowpack.energy_deficit;
+		if (hillslope[0].balance_log != NULL)
+			flush_balance_log(hillslope[0].balance_log, current_date);
+	}
         hillslope = basin[0].hillslopes[0];
 	zone = hillslope[0].zones[0];
-	basin[0].snowpack.surface_age /=  basin[0].area_withsnow;
-	basin[0].snowpack.T /=  basin[0].area_withsnow;
-	basin[0].snowpack.energy_deficit /=  basin[0].area_withsnow;
+	if (basin[0].area_withsnow > ZERO) {
+		basin[0].snowpack.surface_age /=  basin[0].area_withsnow;
+		basin[0].snowpack.T /=  basin[0].area_withsnow;
+		basin[0].snowpack.energy_deficit /=  basin[0].area_withsnow;
+	}
 
 
 	/*--------------------------------------------------------------*/
@@ -130,17 +160,14 @@ void	basin_daily_F(
 	}
 
 	/*--------------------------------------------------------------*/
-	/* update basin patch accumulator				*/
+	/* update basin, hillslope and patch accumulators		*/
 	/*--------------------------------------------------------------*/
-	update_basin_patch_accumulator(command_line,
+	update_accumulators(command_line,
 					basin,
 					current_date);
 
-	/*--------------------------------------------------------------*/
-	/* update hillslope accumulator					*/
-	/*--------------------------------------------------------------*/
-    update_hillslope_accumulator(command_line,
-                    basin);
+	/* the output sums of update_daily_aggregates are now stale */
+	basin[0].daily_aggregate_valid = 0;
 
 	return;
 } /*end basin_daily_F*/
@@ -53,6 +53,10 @@ void	basin_hourly(
 		struct tec_entry *,
 		struct date);
 	
+	void	update_hillslope_gw_hourly(
+		struct basin_object *,
+		struct command_line_object *);
+
 	void	*alloc(	size_t, char *, char *);
 
 	/*--------------------------------------------------------------*/
@@ -166,10 +170,15 @@ void	basin_hourly(
 			event,
 			current_date);
 	}
-	
-
 
+	/*--------------------------------------------------------------*/
+	/*	groundwater losses of all hillslopes			*/
+	/*--------------------------------------------------------------*/
+	update_hillslope_gw_hourly(basin, command_line);
 	
+	/* the output sums of update_daily_aggregates are now stale */
+	basin[0].daily_aggregate_valid = 0;
+
 	/*--------------------------------------------------------------*/
 	/*	Destroy the basin hourly parameter arrayu.					*/
 	/*--------------------------------------------------------------*/
@@ -86,13 +86,20 @@ void		hillslope_daily_F(
 		struct hillslope_object *,
 		struct  zone_object ** ,
 		struct	date );
+
+	void	compute_subsurface_temperature_profile(
+		struct soil_thermal_object *);
 	/*--------------------------------------------------------------*/
 	/*  Local variable definition.                                  */
 	/*--------------------------------------------------------------*/
 	int	i,j,zone;
-	double slow_store, fast_store,scale;
+	double slow_store, fast_store;
 	struct patch_object *patch;
 	
+	hillslope[0].area_withsnow = 0.0;
+	hillslope[0].snowpack.surface_age = 0.0;
+	hillslope[0].snowpack.T = 0.0;
+	hillslope[0].snowpack.energy_deficit = 0.0;
 	
 	for ( zone=0 ; zone<hillslope[0].num_zones; zone++ ){
 		zone_daily_F(	day,
@@ -105,6 +112,11 @@ void		hillslope_daily_F(
 			current_date );
 	}
 	/*----------------------------------------------------------------------*/
+	/*  soil temperature profiles of all patches, done together	*/
+	/*----------------------------------------------------------------------*/
+	if ((command_line[0].surface_energy_flag == 1) && (hillslope[0].soil_thermal != NULL))
+		compute_subsurface_temperature_profile(hillslope[0].soil_thermal);
+	/*----------------------------------------------------------------------*/
 	/*  baseflow calculations                                               */
 	/*----------------------------------------------------------------------*/
 	if (command_line[0].routing_flag == 0) {
@@ -139,25 +151,5 @@ void		hillslope_daily_F(
       );
     }
 
-	/*----------------------------------------------------------------------*/
-	/*	accumulate monthly and yearly streamflow variables		*/
-	/*----------------------------------------------------------------------*/
-	scale = hillslope[0].area / basin[0].area;
-	if((command_line[0].output_flags.monthly == 1)&&(command_line[0].b != NULL)){
-		basin[0].acc_month.streamflow += (hillslope[0].base_flow) * scale;
-		basin[0].acc_month.stream_NO3 += (hillslope[0].streamflow_NO3) * scale;
-		basin[0].acc_month.stream_NH4 += (hillslope[0].streamflow_NH4) * scale;
-		basin[0].acc_month.stream_DON += (hillslope[0].streamflow_DON) * scale;
-		basin[0].acc_month.stream_DOC += (hillslope[0].streamflow_DOC) * scale;
-		}
-	if((command_line[0].output_flags.yearly == 1)&&(command_line[0].b != NULL)){
-		basin[0].acc_year.streamflow += (hillslope[0].base_flow) * scale;
-		basin[0].acc_year.stream_NO3 += (hillslope[0].streamflow_NO3) * scale;
-		basin[0].acc_year.stream_NH4 += (hillslope[0].streamflow_NH4) * scale;
-		basin[0].acc_year.stream_DON += (hillslope[0].streamflow_DON) * scale;
-		basin[0].acc_year.stream_DOC += (hillslope[0].streamflow_DOC) * scale;
-		}
-
-
 	return;
 } /*end hillslope_daily_F.c*/
@@ -0,0 +1,532 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*				 		patch_canopy_daily_F					*/
+/*																*/
+/*	NAME														*/
+/*	patch_canopy_daily_F 										*/
+/*				 - first part of the daily cycle of a patch	*/
+/*																*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void patch_canopy_daily_F(								*/
+/*						struct	world_object	*,				*/
+/*						struct	basin_object	*,				*/
+/*						struct	hillslope_object	*,			*/
+/*						struct	zone_object		*,				*/
+/*						struct patch_object	,					*/
+/*						struct command_line_object ,			*/
+/*						struct tec_entry,						*/
+/*						struct date)							*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Sets up the day of a patch (precipitation, irrigation,	*/
+/*	dated inputs and the soil heat flux), runs the canopy	*/
+/*	strata above the snowpack and pond and adds the snow	*/
+/*	throughfall to the snowpack.				*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	zone_daily_F calls this for all patches of a zone, then	*/
+/*	zone_snowpack_daily_F for their snowpacks and then	*/
+/*	patch_daily_F for the rest of the day.  The start of day	*/
+/*	pond and snowpack heights, irrigation and the snow melt	*/
+/*	input are kept in the patch for patch_daily_F.		*/
+/*																*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "rhessys.h"
+
+void		patch_canopy_daily_F(
+						  struct	world_object	*world,
+						  struct	basin_object	*basin,
+						  struct	hillslope_object	*hillslope,
+						  struct	zone_object		*zone,
+						  struct 	patch_object 	*patch,
+						  struct 	command_line_object *command_line,
+						  struct	tec_entry		*event,
+						  struct	date 			current_date)
+{
+	/*------------------------------------------------------*/
+	/*	Local Function Declarations.						*/
+	/*------------------------------------------------------*/
+	void canopy_stratum_daily_F(
+		struct world_object *,
+		struct basin_object *,
+		struct hillslope_object *,
+		struct zone_object *,
+		struct patch_object *,
+		struct layer_object *,
+		struct canopy_strata_object *,
+		struct canopy_strata_object *,
+		struct command_line_object *,
+		struct tec_entry *,
+		struct date);
+
+	double  compute_surface_heat_flux(
+		int,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double);
+
+	int	update_septic(
+		struct	date,
+		struct  patch_object   *);
+
+	void	update_mortality(
+		struct epconst_struct,
+		struct cstate_struct *,
+		struct cdayflux_struct *,
+		struct cdayflux_patch_struct *,
+		struct nstate_struct *,
+		struct ndayflux_struct *,
+		struct ndayflux_patch_struct *,
+		struct litter_c_object *,
+		struct litter_n_object *,
+		int,
+		struct mortality_struct);
+
+	void	compute_fire_effects(
+		struct patch_object *,
+		double);
+
+	void	compute_Lstar(
+		int,
+		struct basin_object *,
+		struct zone_object *,
+		struct patch_object *);
+
+	long julday( struct date);
+	/*--------------------------------------------------------------*/
+	/*  Local variable definition.                                  */
+	/*--------------------------------------------------------------*/
+	int	layer;
+	int stratum, inx;
+	int dum;
+	double  pspread;
+	double  biomass_removal_percent;
+	double tmpwind;
+	struct	canopy_strata_object	*strata;
+	struct  dated_sequence	clim_event;
+	struct  mortality_struct mort;
+	
+	/*--------------------------------------------------------------*/
+	/*	We assume the zone soil temp applies to the patch as well.	*/
+	/* 	unless we are using the surface energy iteration code 	in which */
+	/* 	case we use the temperature from the previous day		*/
+	/*	alos for the Kdowns and PAR (for now Ldown can be kept )	*/
+	/*--------------------------------------------------------------*/
+
+	if (command_line[0].surface_energy_flag == 0) 
+		patch[0].Tsoil = zone[0].metv.tsoil;
+
+
+	patch[0].Kdown_direct = zone[0].Kdown_direct;
+	patch[0].Kdown_diffuse = zone[0].Kdown_diffuse;
+	patch[0].PAR_direct = zone[0].PAR_direct;
+	patch[0].PAR_diffuse = zone[0].PAR_diffuse;
+	patch[0].evaporation_surf = 0.0;
+	patch[0].potential_evaporation = 0.0;
+	patch[0].Ldown = zone[0].Ldown;
+	patch[0].Ldown_night = zone[0].Ldown_night;
+	patch[0].Ldown_day = zone[0].Ldown_day;
+	patch[0].Ldown_final = 0.0;
+	patch[0].Ldown_final_night = 0.0;
+	patch[0].Ldown_final_day = 0.0;
+	
+	patch[0].Kstar_canopy = 0.0;
+	patch[0].Kstar_canopy_final = 0.0;
+	patch[0].LE_canopy = 0.0;
+	patch[0].LE_canopy_final = 0.0;
+	patch[0].Kdown_direct_subcanopy = 0.0;
+	patch[0].Kdown_diffuse_subcanopy = 0.0;
+	patch[0].Ldown_subcanopy = 0.0;
+	
+	patch[0].wind_final = 0.0;
+	patch[0].windsnow_final = 0.0;
+	patch[0].ustar = 0.0;
+	patch[0].ustar_final = 0.0;
+	
+	patch[0].snowpack.overstory_fraction = 0.0;
+	patch[0].overstory_fraction = 0.0;
+	
+	patch[0].ga = 0.0;
+	patch[0].gasnow = 0.0;
+	
+	tmpwind = zone[0].wind;
+	
+	dum = 0;
+	patch[0].Kup_direct = 0.0;
+	patch[0].Kup_diffuse = 0.0;
+	patch[0].Kup_direct_final = 0.0;
+	patch[0].Kup_diffuse_final = 0.0;
+	
+	patch[0].Kdown_direct_bare = 0.0;
+	
+	patch[0].snowpack.sublimation = 0.0;
+	patch[0].snowpack.Rnet = 0.0;
+	patch[0].snowpack.Q_H = 0.0;
+	patch[0].snowpack.Q_LE = 0.0;
+	patch[0].snowpack.Q_rain = 0.0;
+	patch[0].snowpack.Q_melt = 0.0;
+	
+	patch[0].LE_soil = 0.0;
+	
+	
+	patch[0].snowpack.K_reflectance = 0.0;
+	patch[0].snowpack.K_absorptance = 0.0;
+	patch[0].snowpack.PAR_reflectance = 0.0;
+	patch[0].snowpack.PAR_absorptance = 0.0;
+	patch[0].snowpack.Kstar_direct = 0.0;
+	patch[0].snowpack.Kstar_diffuse = 0.0;
+	patch[0].snowpack.APAR_direct = 0.0;
+	patch[0].snowpack.APAR_diffuse = 0.0;
+	
+	
+	patch[0].exfiltration_unsat_zone = 0.0;
+	patch[0].exfiltration_sat_zone = 0.0;
+	
+	patch[0].T_canopy = zone[0].metv.tavg;
+	patch[0].T_canopy_final = 0.0;
+	
+
+	if ( command_line[0].verbose_flag == -5 ){
+	printf("\nPATCH DAILY F:");
+	}
+	
+	/*--------------------------------------------------------------*/
+	/*	Set the patch rain and snow throughfall equivalent to the	*/
+	/*	rain and snow coming down over the zone.					*/
+	/* check to see if there are base station inputs 		*/
+	/*--------------------------------------------------------------*/
+
+	if (patch[0].base_stations != NULL) {
+		inx = patch[0].base_stations[0][0].dated_input[0].irrigation.inx;
+		if (inx > -999) {
+			clim_event = patch[0].base_stations[0][0].dated_input[0].irrigation.seq[inx];
+			while (julday(clim_event.edate) < julday(current_date)) {
+				patch[0].base_stations[0][0].dated_input[0].irrigation.inx += 1;
+				inx = patch[0].base_stations[0][0].dated_input[0].irrigation.inx;
+				clim_event = patch[0].base_stations[0][0].dated_input[0].irrigation.seq[inx];
+				}
+			if ((clim_event.edate.year != 0) && ( julday(clim_event.edate) == julday(current_date)) ) {
+				patch[0].irrigation = clim_event.value;
+				}
+			else patch[0].irrigation = 0.0;
+			} 
+		else patch[0].irrigation = patch[0].landuse_defaults[0][0].irrigation;
+		}
+	else patch[0].irrigation = patch[0].landuse_defaults[0][0].irrigation;
+	/*--------------------------------------------------------------*/
+	/*	process any daily rainfall				*/
+	/*--------------------------------------------------------------*/
+	patch[0].rain_throughfall = zone[0].rain + patch[0].irrigation;
+
+	/* the N_depo is add in patch_hourly.c in hourly */
+	/* it could be washed away hourly or daily, depending on whether the precipitation data is hourly or daily */
+	patch[0].NO3_throughfall = 0;
+
+
+	if (command_line[0].snow_scale_flag == 1) {
+		patch[0].snow_throughfall = zone[0].snow * patch[0].snow_redist_scale;
+		}
+	else	patch[0].snow_throughfall = zone[0].snow;
+
+	patch[0].wind = zone[0].wind;
+	patch[0].windsnow = zone[0].wind;
+
+	patch[0].precip_with_assim += patch[0].rain_throughfall + patch[0].snow_throughfall;
+
+	if ((patch[0].landuse_defaults[0][0].septic_water_load > ZERO) 
+		|| (patch[0].landuse_defaults[0][0].septic_NO3_load > ZERO)) {
+		if (update_septic( current_date, patch) != 0) {
+			printf("\n Error in update_septic ...exiting");
+			exit(EXIT_FAILURE);
+			}
+		}
+
+
+	patch[0].acc_year.pcp += zone[0].rain + zone[0].snow + patch[0].irrigation;
+	patch[0].acc_year.snowin += zone[0].snow;
+	/*--------------------------------------------------------------*/
+	/* if snowmelt is from another model (and input rather than computed */
+	/* get that value and set it up to substitute for rhessys internal snowmelt */
+	/*--------------------------------------------------------------*/
+	patch[0].snow_melt_input=-999.0;
+	if (patch[0].base_stations != NULL) {
+		inx = patch[0].base_stations[0][0].dated_input[0].snow_melt_input.inx;
+		if (inx > -999) {
+			clim_event = patch[0].base_stations[0][0].dated_input[0].snow_melt_input.seq[inx];
+			while (julday(clim_event.edate) < julday(current_date)) {
+				patch[0].base_stations[0][0].dated_input[0].snow_melt_input.inx += 1;
+				inx = patch[0].base_stations[0][0].dated_input[0].snow_melt_input.inx;
+				clim_event = patch[0].base_stations[0][0].dated_input[0].snow_melt_input.seq[inx];
+				}
+			if ((clim_event.edate.year != 0) && ( julday(clim_event.edate) == julday(current_date)) ) {
+				patch[0].snow_melt_input = clim_event.value;
+				}
+			else patch[0].snow_melt_input = 0.0;
+			} 
+		else patch[0].snow_melt_input=-999.0;
+	}
+
+
+	/*--------------------------------------------------------------*/
+	/* remove a percentage of biomass on a particular date, based   */
+	/* on time series input						*/
+	/*--------------------------------------------------------------*/
+	if (patch[0].base_stations != NULL) {
+		inx = patch[0].base_stations[0][0].dated_input[0].biomass_removal_percent.inx;
+		if (inx > -999) {
+			clim_event = patch[0].base_stations[0][0].dated_input[0].biomass_removal_percent.seq[inx];
+			while (julday(clim_event.edate) < julday(current_date)) {
+				patch[0].base_stations[0][0].dated_input[0].biomass_removal_percent.inx += 1;
+				inx = patch[0].base_stations[0][0].dated_input[0].biomass_removal_percent.inx;
+				clim_event = patch[0].base_stations[0][0].dated_input[0].biomass_removal_percent.seq[inx];
+				}
+			if ((clim_event.edate.year != 0) && ( julday(clim_event.edate) == julday(current_date)) ) {
+				biomass_removal_percent = clim_event.value;
+				mort.mort_cpool=biomass_removal_percent;
+				mort.mort_leafc=biomass_removal_percent;
+				mort.mort_deadleafc=biomass_removal_percent;
+				mort.mort_deadstemc=biomass_removal_percent;
+				mort.mort_livestemc=biomass_removal_percent;
+				mort.mort_deadcrootc=biomass_removal_percent;
+				mort.mort_livecrootc=biomass_removal_percent;
+				mort.mort_frootc=biomass_removal_percent;
+					
+				for ( layer=0 ; layer<patch[0].num_layers; layer++ ){
+					/*--------------------------------------------------------------*/
+					/*	Cycle through the canopy strata				*/
+					/*--------------------------------------------------------------*/
+					for ( stratum=0 ; stratum<patch[0].layers[layer].count; stratum++ ){
+					strata = patch[0].canopy_strata[(patch[0].layers[layer].strata[stratum])];
+					printf("\n Removing %f of biomass for stratum %d\n", biomass_removal_percent, strata[0].ID);
+					update_mortality(strata[0].defaults[0][0].epc,
+						&(strata[0].cs),
+						&(strata[0].cdf),
+						&(patch[0].cdf),
+						&(strata[0].ns),
+						&(strata[0].ndf),
+						&(patch[0].ndf),
+						&(patch[0].litter_cs),
+						&(patch[0].litter_ns),
+						2,
+						mort);
+
+					}
+				}
+			}
+		} 
+	}
+
+
+	/*--------------------------------------------------------------*/
+	/* call fire effects on a particular date, based  		*/
+	/* on time series input						*/
+	/*--------------------------------------------------------------*/
+	if (patch[0].base_stations != NULL) {
+		inx = patch[0].base_stations[0][0].dated_input[0].pspread.inx;
+		if (inx > -999) {
+			clim_event = patch[0].base_stations[0][0].dated_input[0].pspread.seq[inx];
+			while (julday(clim_event.edate) < julday(current_date)) {
+				patch[0].base_stations[0][0].dated_input[0].pspread.inx += 1;
+				inx = patch[0].base_stations[0][0].dated_input[0].pspread.inx;
+				clim_event = patch[0].base_stations[0][0].dated_input[0].pspread.seq[inx];
+				}
+			if ((clim_event.edate.year != 0) && ( julday(clim_event.edate) == julday(current_date)) ) {
+				pspread = clim_event.value;
+
+				printf("\n Implementing fire effects with a pspread of %f in patch %d\n", pspread, patch[0].ID);
+				compute_fire_effects(
+					patch,
+					pspread);
+
+			}
+		} 
+	}
+
+
+
+	/*--------------------------------------------------------------*/
+	/*	Compute the stability correction factor for aero cond	*/
+	/*--------------------------------------------------------------*/
+	patch[0].stability_correction = 1.0;
+	
+	
+	/*--------------------------------------------------------------*/
+	/*      Determine patch SOIL heat flux.                         */
+	/*      (This is ignored if there is a 0 height stratum.        */
+	/*--------------------------------------------------------------*/
+
+	patch[0].surface_heat_flux = -1 * compute_surface_heat_flux(
+		command_line[0].verbose_flag,
+		patch[0].snow_stored,
+		patch[0].unsat_storage,
+		patch[0].sat_deficit,
+		zone[0].metv.tavg,
+		zone[0].metv.tnightmax,
+		zone[0].metv.tsoil,
+		patch[0].soil_defaults[0][0].deltaz,
+		patch[0].soil_defaults[0][0].min_heat_capacity,
+		patch[0].soil_defaults[0][0].max_heat_capacity);
+
+
+	
+	/*--------------------------------------------------------------*/
+	/*	Cycle through patch layers with height greater than the	*/
+	/*	snowpack.						*/
+	/*--------------------------------------------------------------*/
+	
+	/*	Calculate initial pond height		*/
+	patch[0].pond_height = max(0.0,-1 * patch[0].sat_deficit_z + patch[0].detention_store);
+
+	/*--------------------------------------------------------------*/
+	/* Layers above snowpack and pond */
+	/*--------------------------------------------------------------*/
+	for ( layer=0 ; layer<patch[0].num_layers; layer++ ){
+		patch[0].snowpack.overstory_height = zone[0].base_stations[0][0].screen_height;
+		if ( (patch[0].layers[layer].height > patch[0].snowpack.height) &&
+			(patch[0].layers[layer].height > patch[0].pond_height) ){
+			if ( command_line[0].verbose_flag == -5 ){
+				printf("\n     ABOVE SNOWPACK AND POND");
+			}
+			patch[0].snowpack.overstory_fraction = max(patch[0].snowpack.overstory_fraction,
+													   (1.0 - patch[0].layers[layer].null_cover));
+			patch[0].snowpack.overstory_height = max(patch[0].snowpack.overstory_height,
+													 patch[0].layers[layer].height);
+			patch[0].overstory_fraction = max(patch[0].overstory_fraction,
+													   (1.0 - patch[0].layers[layer].null_cover));
+			patch[0].Kdown_direct_final = patch[0].layers[layer].null_cover * patch[0].Kdown_direct;
+			patch[0].Kdown_diffuse_final = patch[0].layers[layer].null_cover * patch[0].Kdown_diffuse;
+			patch[0].PAR_direct_final = patch[0].layers[layer].null_cover * patch[0].PAR_direct;
+			patch[0].PAR_diffuse_final = patch[0].layers[layer].null_cover * patch[0].PAR_diffuse;
+			patch[0].Ldown_final = patch[0].layers[layer].null_cover * patch[0].Ldown;
+			patch[0].Ldown_final_night = patch[0].layers[layer].null_cover * patch[0].Ldown_night;
+			patch[0].Ldown_final_day = patch[0].layers[layer].null_cover * patch[0].Ldown_day;
+			patch[0].Kstar_canopy_final = patch[0].Kstar_canopy;
+			patch[0].LE_canopy_final = patch[0].LE_canopy;
+			patch[0].rain_throughfall_final = patch[0].layers[layer].null_cover * patch[0].rain_throughfall;
+			patch[0].snow_throughfall_final = patch[0].layers[layer].null_cover * patch[0].snow_throughfall;
+			patch[0].NO3_throughfall_final = patch[0].layers[layer].null_cover * patch[0].NO3_throughfall;
+			patch[0].T_canopy_final = patch[0].layers[layer].null_cover * patch[0].T_canopy;
+/* 			if (dum == 0) {				
+				patch[0].ga_final = tmpga;
+				patch[0].gasnow_final = tmpgasnow;
+				patch[0].wind_final = patch[0].layers[layer].null_cover * tmpwind;
+				patch[0].windsnow_final = patch[0].layers[layer].null_cover * tmpwindsnow;
+				patch[0].ustar_final = patch[0].layers[layer].null_cover * tmpustar;
+				if ( command_line[0].verbose_flag == -5 ){
+					printf("\n     ***TOP: ga=%lf gasnow=%lf wind=%lf windsnow=%lf",patch[0].ga_final, patch[0].gasnow_final, patch[0].wind_final, patch[0].windsnow_final);
+				}
+			} */
+			//else {				
+			patch[0].ga_final = patch[0].layers[layer].null_cover * patch[0].ga;
+			patch[0].gasnow_final = patch[0].layers[layer].null_cover * patch[0].gasnow;
+			patch[0].wind_final = patch[0].layers[layer].null_cover * patch[0].wind;
+			patch[0].windsnow_final = patch[0].layers[layer].null_cover * patch[0].windsnow;
+			patch[0].ustar_final = patch[0].layers[layer].null_cover * patch[0].ustar;
+			if ( command_line[0].verbose_flag == -5 ){
+				printf("\n     ***NOT TOP: ga=%lf gasnow=%lf wind=%lf windsnow=%lf",patch[0].ga_final, patch[0].gasnow_final, patch[0].wind_final, patch[0].windsnow_final);
+			}
+			//}
+
+			/*--------------------------------------------------------------*/
+			/*		Cycle through the canopy strata in this layer	*/
+			/*--------------------------------------------------------------*/
+			for ( stratum=0 ; stratum<patch[0].layers[layer].count; stratum++ ){
+					canopy_stratum_daily_F(
+						world,
+						basin,
+						hillslope,
+						zone,
+						patch,
+						&(patch[0].layers[layer]),
+						patch[0].canopy_strata[(patch[0].layers[layer].strata[stratum])],
+            					patch[0].shadow_strata[(patch[0].layers[layer].strata[stratum])],
+						command_line,
+						event,
+						current_date );
+				
+				dum += 1;
+			}
+			patch[0].Kdown_direct = patch[0].Kdown_direct_final;
+			patch[0].Kup_direct = patch[0].Kup_direct_final;
+			patch[0].Kdown_diffuse = patch[0].Kdown_diffuse_final;
+			patch[0].Kup_diffuse = patch[0].Kup_diffuse_final;
+			patch[0].PAR_direct = patch[0].PAR_direct_final;
+			patch[0].PAR_diffuse = patch[0].PAR_diffuse_final;
+			patch[0].Ldown = patch[0].Ldown_final;
+			patch[0].Ldown_night = patch[0].Ldown_final_night;
+			patch[0].Ldown_day = patch[0].Ldown_final_day;
+			patch[0].Kstar_canopy = patch[0].Kstar_canopy_final;
+			patch[0].LE_canopy = patch[0].LE_canopy_final;
+			patch[0].rain_throughfall = patch[0].rain_throughfall_final;
+			patch[0].snow_throughfall = patch[0].snow_throughfall_final;
+			patch[0].NO3_throughfall = patch[0].NO3_throughfall_final;
+			patch[0].ga = patch[0].ga_final;
+			patch[0].gasnow = patch[0].gasnow_final;
+			patch[0].wind = patch[0].wind_final;
+			patch[0].windsnow = patch[0].windsnow_final;
+			patch[0].ustar = patch[0].ustar_final;
+			patch[0].T_canopy = patch[0].T_canopy_final;
+		}
+	}
+	
+	/*--------------------------------------------------------------*/
+	/*	Compute patch level long wave radiation processes.			*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].evap_use_longwave_flag) {
+		compute_Lstar(command_line[0].verbose_flag,
+					  basin,
+					  zone,
+					  patch);
+	}
+	
+	
+	/*--------------------------------------------------------------*/
+	/*	We assume the snowpack is conceptually over the		*/
+	/*	current ponded water.					*/
+	/*--------------------------------------------------------------*/
+	/*--------------------------------------------------------------*/
+	/*	Now add the throughfall of snow	to the snowpack	 	 		*/
+	/*		rain is added to the snowpack if it exists				*/
+	/*		and snowpack melt allowed to occur		 				*/
+	/*		this means that in rain on snow - rain is included		*/
+	/*		as snowmelt												*/
+	/*--------------------------------------------------------------*/
+	patch[0].preday_snowpack_height = patch[0].snowpack.height;
+	patch[0].snowpack.water_equivalent_depth += patch[0].snow_throughfall;
+	
+	patch[0].Kdown_direct_subcanopy = patch[0].Kdown_direct;
+	patch[0].Kdown_diffuse_subcanopy = patch[0].Kdown_diffuse;
+	
+	if ( command_line[0].verbose_flag == -5 ){
+	printf("\n     wind=%lf windfin=%lf windsnow=%lf SWE=%lf Kstarcan=%lf Kdowndirpch=%lf Kdowndifpch=%lf detstore=%lf T_canopy=%lf", 
+			patch[0].wind, 
+			patch[0].wind_final, 
+			patch[0].windsnow, 
+			patch[0].snowpack.water_equivalent_depth, 
+			patch[0].Kstar_canopy/86.4, 
+			patch[0].Kdown_direct/86.4, 
+			patch[0].Kdown_diffuse/86.4,
+		   patch[0].detention_store,
+		   patch[0].T_canopy);
+	}
+
+	
+	patch[0].Kdown_direct_bare = patch[0].Kdown_direct;
+	patch[0].Kdown_diffuse_bare = patch[0].Kdown_diffuse;
+
+	return;
+} /*end patch_canopy_daily_F.c*/
@@ -26,6 +26,10 @@
 /*	canopy_stata in the patch. The routine also prints out results*/
 /*	where specified by current tec events files.				*/
 /*																*/
+/*	It is the part of the patch day below the snowpack;	*/
+/*	patch_canopy_daily_F and zone_snowpack_daily_F have	*/
+/*	already run for all patches of the zone.		*/
+/*																*/
 /*																*/
 /*	PROGRAMMER NOTES											*/
 /*																*/
@@ -139,34 +143,6 @@ void		patch_daily_F(
 		struct	date 			current_date); 
 
 	
-	double	snowpack_daily_F (
-		struct date,
-		int,
-		struct zone_object *,
-		struct patch_object *,
-		struct	snowpack_object	*,
-		double,
-		double,
-		double,
-		double,
-		double,
-		double,
-		double,
-		double,
-		double *,
-		double *,
-		double *,
-		double *,
-		double *,
-		double *,
-		double,
-		double,
-		double,
-		double,
-		double,
-		double,
-		int);
-	
 	double	compute_infiltration(
 		int,
 		double,
@@ -180,18 +156,6 @@ void		patch_daily_F(
 		double,
 		double);
 
-	double  compute_surface_heat_flux(
-		int,
-		double,
-		double,
-		double,
-		double,
-		double,
-		double,
-		double,
-		double,
-		double);
-	
 	double	compute_unsat_zone_drainage(
 		int,
 		int,
@@ -257,10 +221,6 @@ void		patch_daily_F(
 		struct cdayflux_patch_struct *,
 		struct ndayflux_patch_struct *);
 	
-	int	update_septic(
-		struct	date,
-		struct  patch_object   *);
-
 	int	update_nitrif(
 		struct  soil_c_object   *,
 		struct  soil_n_object   *,
@@ -363,36 +323,23 @@ void		patch_daily_F(
 								 double *);
 
 
-	void	update_mortality(
-		struct epconst_struct,
-		struct cstate_struct *,
-		struct cdayflux_struct *,
-		struct cdayflux_patch_struct *,
-		struct nstate_struct *,
-		struct ndayflux_struct *,
-		struct ndayflux_patch_struct *,
-		struct litter_c_object *,
-		struct litter_n_object *,
-		int,
-		struct mortality_struct);
-	
-
-	void	compute_fire_effects(
-		struct patch_object *,
-		double);
 
 
 
 	long julday( struct date);
+
+	void	add_balance_entry(
+		struct balance_log_object *,
+		int,
+		int,
+		int,
+		double);
 	/*--------------------------------------------------------------*/
 	/*  Local variable definition.                                  */
 	/*--------------------------------------------------------------*/
 	int	layer;
 	int stratum, ch, inx;
 	int	vegtype;
-	int dum;
-	double  pspread;
-	double  biomass_removal_percent;
 	double	cap_rise, tmp, wilting_point, cap_rise_to_rz_storage, cap_rise_to_unsat;
 	double  rz_deficit, unsat_deficit;
 	double	delta_unsat_zone_storage;
@@ -400,7 +347,6 @@ void		patch_daily_F(
 	double	infiltration_ini;
 	double	infiltration_fin;
 	double	net_inflow, theta;
-	double	preday_snowpack_height;
 	double	sat_zone_patch_demand;
 	double	sat_zone_patch_demand_initial;
 	double	available_sat_water;
@@ -410,656 +356,16 @@ void		patch_daily_F(
 	double  add_field_capacity;
 	double	water_above_field_cap;
 	double	water_below_field_cap;
-	double 	duration, irrigation;
-	double	snow_melt_input;
+	double 	duration;
 	double  fertilizer_NO3, fertilizer_NH4;
 	double	resp, transpiration_reduction_percent;
 	double 	surfaceN_to_soil;
 	double	FERT_TO_SOIL;
-	double	pond_height;
-	double tmpra, tmpga, tmpgasnow, tmpwind, tmpwindcan, tmpwindsnow, tmpustar;
-	double Kup_direct_snow, Kup_diffuse_snow;
-	double Kdown_direct_covered, Kdown_diffuse_covered, Kdown_direct_exposed, Kdown_diffuse_exposed;
-	double Kup_direct_snow_covered, Kup_diffuse_snow_covered, Kup_direct_snow_exposed, Kup_diffuse_snow_exposed;
-	double PAR_direct_covered, PAR_diffuse_covered, PAR_direct_exposed, PAR_diffuse_exposed;
-	double snow_melt_covered, snow_melt_exposed;
 	double 	rz_drainage,unsat_drainage;
 	double prop_detention_store_infiltrated;
 	struct	canopy_strata_object	*strata;
 	struct	litter_object	*litter;
 	struct  dated_sequence	clim_event;
-	struct  mortality_struct mort;
-	
-	/*--------------------------------------------------------------*/
-	/*	We assume the zone soil temp applies to the patch as well.	*/
-	/* 	unless we are using the surface energy iteration code 	in which */
-	/* 	case we use the temperature from the previous day		*/
-	/*	alos for the Kdowns and PAR (for now Ldown can be kept )	*/
-	/*--------------------------------------------------------------*/
-
-	if (command_line[0].surface_energy_flag == 0) 
-		patch[0].Tsoil = zone[0].metv.tsoil;
-
-
-	patch[0].Kdown_direct = zone[0].Kdown_direct;
-	patch[0].Kdown_diffuse = zone[0].Kdown_diffuse;
-	patch[0].PAR_direct = zone[0].PAR_direct;
-	patch[0].PAR_diffuse = zone[0].PAR_diffuse;
-	patch[0].evaporation_surf = 0.0;
-	patch[0].potential_evaporation = 0.0;
-	patch[0].Ldown = zone[0].Ldown;
-	patch[0].Ldown_night = zone[0].Ldown_night;
-	patch[0].Ldown_day = zone[0].Ldown_day;
-	patch[0].Ldown_final = 0.0;
-	patch[0].Ldown_final_night = 0.0;
-	patch[0].Ldown_final_day = 0.0;
-	
-	patch[0].Kstar_canopy = 0.0;
-	patch[0].Kstar_canopy_final = 0.0;
-	patch[0].LE_canopy = 0.0;
-	patch[0].LE_canopy_final = 0.0;
-	patch[0].Kdown_direct_subcanopy = 0.0;
-	patch[0].Kdown_diffuse_subcanopy = 0.0;
-	patch[0].Ldown_subcanopy = 0.0;
-	
-	patch[0].wind_final = 0.0;
-	patch[0].windsnow_final = 0.0;
-	patch[0].ustar = 0.0;
-	patch[0].ustar_final = 0.0;
-	
-	patch[0].snowpack.overstory_fraction = 0.0;
-	patch[0].overstory_fraction = 0.0;
-	
-	patch[0].ga = 0.0;
-	patch[0].gasnow = 0.0;
-	
-	tmpwind = zone[0].wind;
-	
-	dum = 0;
-	patch[0].Kup_direct = 0.0;
-	patch[0].Kup_diffuse = 0.0;
-	patch[0].Kup_direct_final = 0.0;
-	patch[0].Kup_diffuse_final = 0.0;
-	Kup_direct_snow = 0.0;
-	Kup_diffuse_snow = 0.0;
-	
-	patch[0].Kdown_direct_bare = 0.0;
-	
-	patch[0].snowpack.sublimation = 0.0;
-	patch[0].snowpack.Rnet = 0.0;
-	patch[0].snowpack.Q_H = 0.0;
-	patch[0].snowpack.Q_LE = 0.0;
-	patch[0].snowpack.Q_rain = 0.0;
-	patch[0].snowpack.Q_melt = 0.0;
-	
-	patch[0].LE_soil = 0.0;
-	
-	
-	patch[0].snowpack.K_reflectance = 0.0;
-	patch[0].snowpack.K_absorptance = 0.0;
-	patch[0].snowpack.PAR_reflectance = 0.0;
-	patch[0].snowpack.PAR_absorptance = 0.0;
-	patch[0].snowpack.Kstar_direct = 0.0;
-	patch[0].snowpack.Kstar_diffuse = 0.0;
-	patch[0].snowpack.APAR_direct = 0.0;
-	patch[0].snowpack.APAR_diffuse = 0.0;
-	
-	Kdown_direct_covered = 0.0;
-	Kdown_diffuse_covered = 0.0;
-	Kdown_direct_exposed = 0.0;
-	Kdown_diffuse_exposed = 0.0;
-	Kup_direct_snow_covered = 0.0;
-	Kup_diffuse_snow_covered = 0.0;
-	Kup_direct_snow_exposed = 0.0;
-	Kup_diffuse_snow_exposed = 0.0;	
-	PAR_direct_covered = 0.0;
-	PAR_diffuse_covered = 0.0;
-	PAR_direct_exposed = 0.0;
-	PAR_diffuse_exposed = 0.0;
-	snow_melt_covered = 0.0;
-	snow_melt_exposed = 0.0;
-	
-	patch[0].exfiltration_unsat_zone = 0.0;
-	patch[0].exfiltration_sat_zone = 0.0;
-	
-	patch[0].T_canopy = zone[0].metv.tavg;
-	patch[0].T_canopy_final = 0.0;
-	
-
-	if ( command_line[0].verbose_flag == -5 ){
-	printf("\nPATCH DAILY F:");
-	}
-	
-	/*--------------------------------------------------------------*/
-	/*	Set the patch rain and snow throughfall equivalent to the	*/
-	/*	rain and snow coming down over the zone.					*/
-	/* check to see if there are base station inputs 		*/
-	/*--------------------------------------------------------------*/
-
-	if (patch[0].base_stations != NULL) {
-		inx = patch[0].base_stations[0][0].dated_input[0].irrigation.inx;
-		if (inx > -999) {
-			clim_event = patch[0].base_stations[0][0].dated_input[0].irrigation.seq[inx];
-			while (julday(clim_event.edate) < julday(current_date)) {
-				patch[0].base_stations[0][0].dated_input[0].irrigation.inx += 1;
-				inx = patch[0].base_stations[0][0].dated_input[0].irrigation.inx;
-				clim_event = patch[0].base_stations[0][0].dated_input[0].irrigation.seq[inx];
-				}
-			if ((clim_event.edate.year != 0) && ( julday(clim_event.edate) == julday(current_date)) ) {
-				irrigation = clim_event.value;
-				}
-			else irrigation = 0.0;
-			} 
-		else irrigation = patch[0].landuse_defaults[0][0].irrigation;
-		}
-	else irrigation = patch[0].landuse_defaults[0][0].irrigation;
-	/*--------------------------------------------------------------*/
-	/*	process any daily rainfall				*/
-	/*--------------------------------------------------------------*/
-	patch[0].rain_throughfall = zone[0].rain + irrigation;
-
-	/* the N_depo is add in patch_hourly.c in hourly */
-	/* it could be washed away hourly or daily, depending on whether the precipitation data is hourly or daily */
-	patch[0].NO3_throughfall = 0;
-
-
-	if (command_line[0].snow_scale_flag == 1) {
-		patch[0].snow_throughfall = zone[0].snow * patch[0].snow_redist_scale;
-		}
-	else	patch[0].snow_throughfall = zone[0].snow;
-
-	patch[0].wind = zone[0].wind;
-	patch[0].windsnow = zone[0].wind;
-
-	patch[0].precip_with_assim += patch[0].rain_throughfall + patch[0].snow_throughfall;
-
-	if ((patch[0].landuse_defaults[0][0].septic_water_load > ZERO) 
-		|| (patch[0].landuse_defaults[0][0].septic_NO3_load > ZERO)) {
-		if (update_septic( current_date, patch) != 0) {
-			printf("\n Error in update_septic ...exiting");
-			exit(EXIT_FAILURE);
-			}
-		}
-
-
-	patch[0].acc_year.pcp += zone[0].rain + zone[0].snow + irrigation;
-	patch[0].acc_year.snowin += zone[0].snow;
-	/*--------------------------------------------------------------*/
-	/* if snowmelt is from another model (and input rather than computed */
-	/* get that value and set it up to substitute for rhessys internal snowmelt */
-	/*--------------------------------------------------------------*/
-	snow_melt_input=-999.0;
-	if (patch[0].base_stations != NULL) {
-		inx = patch[0].base_stations[0][0].dated_input[0].snow_melt_input.inx;
-		if (inx > -999) {
-			clim_event = patch[0].base_stations[0][0].dated_input[0].snow_melt_input.seq[inx];
-			while (julday(clim_event.edate) < julday(current_date)) {
-				patch[0].base_stations[0][0].dated_input[0].snow_melt_input.inx += 1;
-				inx = patch[0].base_stations[0][0].dated_input[0].snow_melt_input.inx;
-				clim_event = patch[0].base_stations[0][0].dated_input[0].snow_melt_input.seq[inx];
-				}
-			if ((clim_event.edate.year != 0) && ( julday(clim_event.edate) == julday(current_date)) ) {
-				snow_melt_input = clim_event.value;
-				}
-			else snow_melt_input = 0.0;
-			} 
-		else snow_melt_input=-999.0;
-	}
-
-
-	/*--------------------------------------------------------------*/
-	/* remove a percentage of biomass on a particular date, based   */
-	/* on time series input						*/
-	/*--------------------------------------------------------------*/
-	if (patch[0].base_stations != NULL) {
-		inx = patch[0].base_stations[0][0].dated_input[0].biomass_removal_percent.inx;
-		if (inx > -999) {
-			clim_event = patch[0].base_stations[0][0].dated_input[0].biomass_removal_percent.seq[inx];
-			while (julday(clim_event.edate) < julday(current_date)) {
-				patch[0].base_stations[0][0].dated_input[0].biomass_removal_percent.inx += 1;
-				inx = patch[0].base_stations[0][0].dated_input[0].biomass_removal_percent.inx;
-				clim_event = patch[0].base_stations[0][0].dated_input[0].biomass_removal_percent.seq[inx];
-				}
-			if ((clim_event.edate.year != 0) && ( julday(clim_event.edate) == julday(current_date)) ) {
-				biomass_removal_percent = clim_event.value;
-				mort.mort_cpool=biomass_removal_percent;
-				mort.mort_leafc=biomass_removal_percent;
-				mort.mort_deadleafc=biomass_removal_percent;
-				mort.mort_deadstemc=biomass_removal_percent;
-				mort.mort_livestemc=biomass_removal_percent;
-				mort.mort_deadcrootc=biomass_removal_percent;
-				mort.mort_livecrootc=biomass_removal_percent;
-				mort.mort_frootc=biomass_removal_percent;
-					
-				for ( layer=0 ; layer<patch[0].num_layers; layer++ ){
-					/*--------------------------------------------------------------*/
-					/*	Cycle through the canopy strata				*/
-					/*--------------------------------------------------------------*/
-					for ( stratum=0 ; stratum<patch[0].layers[layer].count; stratum++ ){
-					strata = patch[0].canopy_strata[(patch[0].layers[layer].strata[stratum])];
-					printf("\n Removing %f of biomass for stratum %d\n", biomass_removal_percent, strata[0].ID);
-					update_mortality(strata[0].defaults[0][0].epc,
-						&(strata[0].cs),
-						&(strata[0].cdf),
-						&(patch[0].cdf),
-						&(strata[0].ns),
-						&(strata[0].ndf),
-						&(patch[0].ndf),
-						&(patch[0].litter_cs),
-						&(patch[0].litter_ns),
-						2,
-						mort);
-
-					}
-				}
-			}
-		} 
-	}
-
-
-	/*--------------------------------------------------------------*/
-	/* call fire effects on a particular date, based  		*/
-	/* on time series input						*/
-	/*--------------------------------------------------------------*/
-	if (patch[0].base_stations != NULL) {
-		inx = patch[0].base_stations[0][0].dated_input[0].pspread.inx;
-		if (inx > -999) {
-			clim_event = patch[0].base_stations[0][0].dated_input[0].pspread.seq[inx];
-			while (julday(clim_event.edate) < julday(current_date)) {
-				patch[0].base_stations[0][0].dated_input[0].pspread.inx += 1;
-				inx = patch[0].base_stations[0][0].dated_input[0].pspread.inx;
-				clim_event = patch[0].base_stations[0][0].dated_input[0].pspread.seq[inx];
-				}
-			if ((clim_event.edate.year != 0) && ( julday(clim_event.edate) == julday(current_date)) ) {
-				pspread = clim_event.value;
-
-				printf("\n Implementing fire effects with a pspread of %f in patch %d\n", pspread, patch[0].ID);
-				compute_fire_effects(
-					patch,
-					pspread);
-
-			}
-		} 
-	}
-
-
-
-	/*--------------------------------------------------------------*/
-	/*	Compute the stability correction factor for aero cond	*/
-	/*--------------------------------------------------------------*/
-	patch[0].stability_correction = 1.0;
-	
-	
-	/*--------------------------------------------------------------*/
-	/*      Determine patch SOIL heat flux.                         */
-	/*      (This is ignored if there is a 0 height stratum.        */
-	/*--------------------------------------------------------------*/
-
-	patch[0].surface_heat_flux = -1 * compute_surface_heat_flux(
-		command_line[0].verbose_flag,
-		patch[0].snow_stored,
-		patch[0].unsat_storage,
-		patch[0].sat_deficit,
-		zone[0].metv.tavg,
-		zone[0].metv.tnightmax,
-		zone[0].metv.tsoil,
-		patch[0].soil_defaults[0][0].deltaz,
-		patch[0].soil_defaults[0][0].min_heat_capacity,
-		patch[0].soil_defaults[0][0].max_heat_capacity);
-
-
-	
-	/*--------------------------------------------------------------*/
-	/*	Cycle through patch layers with height greater than the	*/
-	/*	snowpack.						*/
-	/*--------------------------------------------------------------*/
-	
-	/*	Calculate initial pond height		*/
-	pond_height = max(0.0,-1 * patch[0].sat_deficit_z + patch[0].detention_store);
-
-	/*--------------------------------------------------------------*/
-	/* Layers above snowpack and pond */
-	/*--------------------------------------------------------------*/
-	for ( layer=0 ; layer<patch[0].num_layers; layer++ ){
-		patch[0].snowpack.overstory_height = zone[0].base_stations[0][0].screen_height;
-		if ( (patch[0].layers[layer].height > patch[0].snowpack.height) &&
-			(patch[0].layers[layer].height > pond_height) ){
-			if ( command_line[0].verbose_flag == -5 ){
-				printf("\n     ABOVE SNOWPACK AND POND");
-			}
-			patch[0].snowpack.overstory_fraction = max(patch[0].snowpack.overstory_fraction,
-													   (1.0 - patch[0].layers[layer].null_cover));
-			patch[0].snowpack.overstory_height = max(patch[0].snowpack.overstory_height,
-													 patch[0].layers[layer].height);
-			patch[0].overstory_fraction = max(patch[0].overstory_fraction,
-													   (1.0 - patch[0].layers[layer].null_cover));
-			patch[0].Kdown_direct_final = patch[0].layers[layer].null_cover * patch[0].Kdown_direct;
-			patch[0].Kdown_diffuse_final = patch[0].layers[layer].null_cover * patch[0].Kdown_diffuse;
-			patch[0].PAR_direct_final = patch[0].layers[layer].null_cover * patch[0].PAR_direct;
-			patch[0].PAR_diffuse_final = patch[0].layers[layer].null_cover * patch[0].PAR_diffuse;
-			patch[0].Ldown_final = patch[0].layers[layer].null_cover * patch[0].Ldown;
-			patch[0].Ldown_final_night = patch[0].layers[layer].null_cover * patch[0].Ldown_night;
-			patch[0].Ldown_final_day = patch[0].layers[layer].null_cover * patch[0].Ldown_day;
-			patch[0].Kstar_canopy_final = patch[0].Kstar_canopy;
-			patch[0].LE_canopy_final = patch[0].LE_canopy;
-			patch[0].rain_throughfall_final = patch[0].layers[layer].null_cover * patch[0].rain_throughfall;
-			patch[0].snow_throughfall_final = patch[0].layers[layer].null_cover * patch[0].snow_throughfall;
-			patch[0].NO3_throughfall_final = patch[0].layers[layer].null_cover * patch[0].NO3_throughfall;
-			patch[0].T_canopy_final = patch[0].layers[layer].null_cover * patch[0].T_canopy;
-/* 			if (dum == 0) {				
-				patch[0].ga_final = tmpga;
-				patch[0].gasnow_final = tmpgasnow;
-				patch[0].wind_final = patch[0].layers[layer].null_cover * tmpwind;
-				patch[0].windsnow_final = patch[0].layers[layer].null_cover * tmpwindsnow;
-				patch[0].ustar_final = patch[0].layers[layer].null_cover * tmpustar;
-				if ( command_line[0].verbose_flag == -5 ){
-					printf("\n     ***TOP: ga=%lf gasnow=%lf wind=%lf windsnow=%lf",patch[0].ga_final, patch[0].gasnow_final, patch[0].wind_final, patch[0].windsnow_final);
-				}
-			} */
-			//else {				
-			patch[0].ga_final = patch[0].layers[layer].null_cover * patch[0].ga;
-			patch[0].gasnow_final = patch[0].layers[layer].null_cover * patch[0].gasnow;
-			patch[0].wind_final = patch[0].layers[layer].null_cover * patch[0].wind;
-			patch[0].windsnow_final = patch[0].layers[layer].null_cover * patch[0].windsnow;
-			patch[0].ustar_final = patch[0].layers[layer].null_cover * patch[0].ustar;
-			if ( command_line[0].verbose_flag == -5 ){
-				printf("\n     ***NOT TOP: ga=%lf gasnow=%lf wind=%lf windsnow=%lf",patch[0].ga_final, patch[0].gasnow_final, patch[0].wind_final, patch[0].windsnow_final);
-			}
-			//}
-
-			/*--------------------------------------------------------------*/
-			/*		Cycle through the canopy strata in this layer	*/
-			/*--------------------------------------------------------------*/
-			for ( stratum=0 ; stratum<patch[0].layers[layer].count; stratum++ ){
-					canopy_stratum_daily_F(
-						world,
-						basin,
-						hillslope,
-						zone,
-						patch,
-						&(patch[0].layers[layer]),
-						patch[0].canopy_strata[(patch[0].layers[layer].strata[stratum])],
-            					patch[0].shadow_strata[(patch[0].layers[layer].strata[stratum])],
-						command_line,
-						event,
-						current_date );
-				
-				dum += 1;
-			}
-			patch[0].Kdown_direct = patch[0].Kdown_direct_final;
-			patch[0].Kup_direct = patch[0].Kup_direct_final;
-			patch[0].Kdown_diffuse = patch[0].Kdown_diffuse_final;
-			patch[0].Kup_diffuse = patch[0].Kup_diffuse_final;
-			patch[0].PAR_direct = patch[0].PAR_direct_final;
-			patch[0].PAR_diffuse = patch[0].PAR_diffuse_final;
-			patch[0].Ldown = patch[0].Ldown_final;
-			patch[0].Ldown_night = patch[0].Ldown_final_night;
-			patch[0].Ldown_day = patch[0].Ldown_final_day;
-			patch[0].Kstar_canopy = patch[0].Kstar_canopy_final;
-			patch[0].LE_canopy = patch[0].LE_canopy_final;
-			patch[0].rain_throughfall = patch[0].rain_throughfall_final;
-			patch[0].snow_throughfall = patch[0].snow_throughfall_final;
-			patch[0].NO3_throughfall = patch[0].NO3_throughfall_final;
-			patch[0].ga = patch[0].ga_final;
-			patch[0].gasnow = patch[0].gasnow_final;
-			patch[0].wind = patch[0].wind_final;
-			patch[0].windsnow = patch[0].windsnow_final;
-			patch[0].ustar = patch[0].ustar_final;
-			patch[0].T_canopy = patch[0].T_canopy_final;
-		}
-	}
-	
-	/*--------------------------------------------------------------*/
-	/*	Compute patch level long wave radiation processes.			*/
-	/*--------------------------------------------------------------*/
-	if (command_line[0].evap_use_longwave_flag) {
-		compute_Lstar(command_line[0].verbose_flag,
-					  basin,
-					  zone,
-					  patch);
-	}
-	
-	
-	/*--------------------------------------------------------------*/
-	/*	We assume the snowpack is conceptually over the		*/
-	/*	current ponded water.					*/
-	/*--------------------------------------------------------------*/
-	/*--------------------------------------------------------------*/
-	/*	Now add the throughfall of snow	to the snowpack	 	 		*/
-	/*		rain is added to the snowpack if it exists				*/
-	/*		and snowpack melt allowed to occur		 				*/
-	/*		this means that in rain on snow - rain is included		*/
-	/*		as snowmelt												*/
-	/*--------------------------------------------------------------*/
-	preday_snowpack_height = patch[0].snowpack.height;
-	patch[0].snowpack.water_equivalent_depth += patch[0].snow_throughfall;
-	
-	patch[0].Kdown_direct_subcanopy = patch[0].Kdown_direct;
-	patch[0].Kdown_diffuse_subcanopy = patch[0].Kdown_diffuse;
-	
-	if ( command_line[0].verbose_flag == -5 ){
-	printf("\n     wind=%lf windfin=%lf windsnow=%lf SWE=%lf Kstarcan=%lf Kdowndirpch=%lf Kdowndifpch=%lf detstore=%lf T_canopy=%lf", 
-			patch[0].wind, 
-			patch[0].wind_final, 
-			patch[0].windsnow, 
-			patch[0].snowpack.water_equivalent_depth, 
-			patch[0].Kstar_canopy/86.4, 
-			patch[0].Kdown_direct/86.4, 
-			patch[0].Kdown_diffuse/86.4,
-		   patch[0].detention_store,
-		   patch[0].T_canopy);
-	}
-
-	
-	patch[0].Kdown_direct_bare = patch[0].Kdown_direct;
-	patch[0].Kdown_diffuse_bare = patch[0].Kdown_diffuse;
-	
-
-	if ( patch[0].snowpack.water_equivalent_depth > ZERO ) {
-		
-		/*--------------------------------------------------------------*/
-		/*	Calculate snowmelt 											*/
-		/*--------------------------------------------------------------*/
-		/*	Check to see if snowpack is above pond. If so, proceed 	*/
-		/*	with snowpack daily F.  Otherwise, melt all snow and add 	*/
-		/*	to rain throughfall.										*/
-		/*--------------------------------------------------------------*/
-		if ( patch[0].snowpack.water_equivalent_depth > pond_height ) {
-			
-			/* COVER FRACTION */
-			if ((patch[0].snowpack.overstory_fraction < 1) && (patch[0].snowpack.overstory_fraction > 0)) {
-				if ( command_line[0].verbose_flag == -5 ){
-					printf("\nSNOWPACK WITH COVER FRACTION %lf", 
-						   patch[0].snowpack.overstory_fraction);
-				}				
-				/* Separate Kdown under canopy from patch-average Kdown below canopy layers */
-				/* Using zone Kdown for exposed portion */
-				Kdown_direct_covered = ( patch[0].Kdown_direct - zone[0].Kdown_direct 
-											* (1 - patch[0].snowpack.overstory_fraction) )
-											/ patch[0].snowpack.overstory_fraction;
-				Kdown_diffuse_covered = ( patch[0].Kdown_diffuse - zone[0].Kdown_diffuse 
-											* (1 - patch[0].snowpack.overstory_fraction) )
-											/ patch[0].snowpack.overstory_fraction;
-				Kdown_direct_exposed = zone[0].Kdown_direct;
-				Kdown_diffuse_exposed = zone[0].Kdown_diffuse;
-				PAR_direct_covered = ( patch[0].PAR_direct - zone[0].PAR_direct 
-											* (1 - patch[0].snowpack.overstory_fraction) )
-											/ patch[0].snowpack.overstory_fraction;
-				PAR_diffuse_covered = ( patch[0].PAR_diffuse - zone[0].PAR_diffuse 
-											* (1 - patch[0].snowpack.overstory_fraction) )
-											/ patch[0].snowpack.overstory_fraction;
-				PAR_direct_exposed = zone[0].PAR_direct;
-				PAR_diffuse_exposed = zone[0].PAR_diffuse;
-				
-				/* Lundberg 1994 reduce conductance for snow vs. rain by factor of 10 */
-				snow_melt_covered = snowpack_daily_F(
-						current_date,
-						command_line[0].verbose_flag,
-						zone,
-						patch,
-						&patch[0].snowpack,
-						basin[0].theta_noon,
-						zone[0].metv.tavg,
-						zone[0].e_dewpoint,
-						patch[0].gasnow/10.0,
-						zone[0].metv.pa,
-						zone[0].cloud_fraction,
-						patch[0].rain_throughfall,
-						patch[0].snow_throughfall,
-						&Kdown_direct_covered,
-						&Kup_direct_snow_covered,
-						&Kdown_diffuse_covered,
-						&Kup_diffuse_snow_covered,
-						&PAR_direct_covered,
-						&PAR_diffuse_covered,
-						patch[0].soil_defaults[0][0].maximum_snow_energy_deficit,
-						patch[0].soil_defaults[0][0].snow_water_capacity,
-						patch[0].soil_defaults[0][0].snow_light_ext_coef,
-						patch[0].soil_defaults[0][0].snow_melt_Tcoef,
-						1.0,
-						patch[0].snowpack.overstory_fraction,
-						0);
-				snow_melt_exposed = snowpack_daily_F(
-						current_date,
-						command_line[0].verbose_flag,
-						zone,
-						patch,
-						&patch[0].snowpack,
-						basin[0].theta_noon,
-						zone[0].metv.tavg,
-						zone[0].e_dewpoint,
-						patch[0].gasnow/10.0,
-						zone[0].metv.pa,
-						zone[0].cloud_fraction,
-						patch[0].rain_throughfall,
-						patch[0].snow_throughfall,
-						&Kdown_direct_exposed,
-						&Kup_direct_snow_exposed,
-						&Kdown_diffuse_exposed,
-						&Kup_diffuse_snow_exposed,
-						&PAR_direct_exposed,
-						&PAR_diffuse_exposed,
-						patch[0].soil_defaults[0][0].maximum_snow_energy_deficit,
-						patch[0].soil_defaults[0][0].snow_water_capacity,
-						patch[0].soil_defaults[0][0].snow_light_ext_coef,
-						patch[0].soil_defaults[0][0].snow_melt_Tcoef,
-						0.0,
-						(1-patch[0].snowpack.overstory_fraction),
-						1);
-				
-				patch[0].snow_melt = (snow_melt_covered * patch[0].snowpack.overstory_fraction)
-						+ (snow_melt_exposed * (1-patch[0].snowpack.overstory_fraction));
-				patch[0].Kdown_direct = (Kdown_direct_covered * patch[0].snowpack.overstory_fraction)
-						+ (Kdown_direct_exposed * (1-patch[0].snowpack.overstory_fraction));
-				patch[0].Kdown_diffuse = (Kdown_diffuse_covered * patch[0].snowpack.overstory_fraction)
-						+ (Kdown_diffuse_exposed * (1-patch[0].snowpack.overstory_fraction));
-				patch[0].PAR_direct = (PAR_direct_covered * patch[0].snowpack.overstory_fraction)
-						+ (PAR_direct_exposed * (1-patch[0].snowpack.overstory_fraction));
-				patch[0].PAR_diffuse = (PAR_diffuse_covered * patch[0].snowpack.overstory_fraction)
-						+ (PAR_diffuse_exposed * (1-patch[0].snowpack.overstory_fraction));
-				
-			}
-			/* NO COVER FRACTION */
-			else {
-				if ( command_line[0].verbose_flag == -5 ){
-					printf("\nSNOWPACK WITHOUT COVER FRACTION %lf", 
-						   patch[0].snowpack.overstory_fraction);
-				}								
-				patch[0].snow_melt = snowpack_daily_F(
-					current_date,
-					command_line[0].verbose_flag,
-					zone,
-					patch,
-					&patch[0].snowpack,
-					basin[0].theta_noon,
-					zone[0].metv.tavg,
-					zone[0].e_dewpoint,
-					patch[0].gasnow/10.0,
-					zone[0].metv.pa,
-					zone[0].cloud_fraction,
-					patch[0].rain_throughfall,
-					patch[0].snow_throughfall,
-					&patch[0].Kdown_direct,
-					&Kup_direct_snow,
-					&patch[0].Kdown_diffuse,
-					&Kup_diffuse_snow,
-					&patch[0].PAR_direct,
-					&patch[0].PAR_diffuse,
-					patch[0].soil_defaults[0][0].maximum_snow_energy_deficit,
-					patch[0].soil_defaults[0][0].snow_water_capacity,
-					patch[0].soil_defaults[0][0].snow_light_ext_coef,
-					patch[0].soil_defaults[0][0].snow_melt_Tcoef,
-					patch[0].snowpack.overstory_fraction,
-					1.0,
-					1);
-					if (patch[0].snowpack.overstory_fraction == 0) {
-						Kup_direct_snow_exposed = Kup_direct_snow;
-						Kup_diffuse_snow_exposed = Kup_diffuse_snow;
-						}
-				}
-				
-			/* FOR ALL COVER FRACTIONS */
-			patch[0].Kup_direct += Kup_direct_snow_exposed * (1 - patch[0].snowpack.overstory_fraction);
-			patch[0].Kup_diffuse += Kup_diffuse_snow_exposed * (1 - patch[0].snowpack.overstory_fraction);
-		
-			patch[0].snowpack.water_equivalent_depth -= patch[0].snow_melt;
-			patch[0].snowpack.sublimation = min(patch[0].snowpack.sublimation, patch[0].snowpack.water_equivalent_depth);
-			patch[0].snowpack.height = patch[0].snowpack.water_equivalent_depth / 0.1; /* snow density ~ 0.1 */
-
-			if (snow_melt_input == -999.0) 
-				patch[0].rain_throughfall += patch[0].snow_melt;
-			else {
-				patch[0].rain_throughfall += snow_melt_input;
-				patch[0].snow_melt = snow_melt_input;
-			}
-			patch[0].snow_throughfall = 0.0;
-			patch[0].snowpack.water_equivalent_depth -= patch[0].snowpack.sublimation;
-			/* Force turbulent fluxes to 0 under snowpack */
-			patch[0].ga = 0.0;
-			patch[0].wind = 0.0;
-		}
-		
-		else {
-			patch[0].rain_throughfall += patch[0].snowpack.water_equivalent_depth;
-			patch[0].snow_throughfall = 0.0;
-			patch[0].snowpack.water_equivalent_depth = 0.0;
-			patch[0].snowpack.height = 0.0;
-		}
-	}
-	else{
-		/*--------------------------------------------------------------*/
-		/*	Just to create symmetrical output for snow and no snow	*/
-		/*	days we do some fake calls which snowpack_daily_F does	*/
-		/*--------------------------------------------------------------*/
-		temp = 1;
-		temp = compute_radiative_fluxes(0,&temp,&temp,1,1,1);
-		temp = compute_radiative_fluxes(0,&temp,&temp,1,1,1);
-		temp = compute_radiative_fluxes(0,&temp,&temp,1,1,1);
-		temp = compute_radiative_fluxes(0,&temp,&temp,1,1,1);
-		patch[0].snow_melt = 0.0;
-		patch[0].snowpack.energy_deficit = 0.001;
-		patch[0].snowpack.Kstar_direct = 0.0;
-		patch[0].snowpack.Kstar_diffuse = 0.0;
-		patch[0].snowpack.APAR_direct = 0.0;
-		patch[0].snowpack.APAR_diffuse = 0.0;
-		patch[0].snowpack.water_equivalent_depth = 0.0;
-	}
-	
-	if (patch[0].snowpack.water_equivalent_depth < 0.0001) {
-		patch[0].rain_throughfall += patch[0].snowpack.water_equivalent_depth;
-		patch[0].snowpack.water_equivalent_depth = 0.0;
-		patch[0].snowpack.energy_deficit = 0.001;
-		patch[0].snowpack.surface_age = 0.0;
-		patch[0].snowpack.T = 0.0;
-		patch[0].snowpack.height = 0.0;
-		}
-	
-	if ( command_line[0].verbose_flag == -5 ){
-		printf("\n     AFTER SNOWPACK: Kup_direct=%lf Kup_diffuse=%lf", 
-			   patch[0].Kup_direct/86.4, 
-			   patch[0].Kup_diffuse/86.4);
-	}
-	
 	
 	/*--------------------------------------------------------------*/
 	/*	Cycle through patch layers with height less than the	*/
@@ -1084,8 +390,8 @@ void		patch_daily_F(
 	/* Layers below snowpack and above pond */
 	/*--------------------------------------------------------------*/
 	for ( layer=0 ; layer<patch[0].num_layers; layer++ ){
-		if ( (preday_snowpack_height > 0.0) && (patch[0].layers[layer].height <= preday_snowpack_height) &&
-			(patch[0].layers[layer].height > pond_height) ){
+		if ( (patch[0].preday_snowpack_height > 0.0) && (patch[0].layers[layer].height <= patch[0].preday_snowpack_height) &&
+			(patch[0].layers[layer].height > patch[0].pond_height) ){
 			if ( command_line[0].verbose_flag == -5 ){
 				printf("\n     BELOW SNOWPACK AND ABOVE POND");
 			}
@@ -1132,7 +438,7 @@ void		patch_daily_F(
 	/*	Layers below the pond.					*/
 	/*--------------------------------------------------------------*/
 	for ( layer=0 ; layer<patch[0].num_layers; layer++ ){
-		if (patch[0].layers[layer].height <= pond_height){
+		if (patch[0].layers[layer].height <= patch[0].pond_height){
 			if ( command_line[0].verbose_flag == -5 ){
 				printf("\n     BELOW POND (INCLUDING SURFACE)");
 			}
@@ -2140,11 +1446,12 @@ void		patch_daily_F(
 
 
 	/* track variables for snow assimilation  */
+	/* summed by hillslope, then over the basin in basin_daily_F */
 	if (patch[0].snowpack.water_equivalent_depth > ZERO) {
-		basin[0].snowpack.energy_deficit += patch[0].snowpack.energy_deficit * patch[0].area;
-		basin[0].snowpack.surface_age += patch[0].snowpack.surface_age * patch[0].area;
-		basin[0].snowpack.T += patch[0].snowpack.T * patch[0].area;
-		basin[0].area_withsnow += patch[0].area;
+		hillslope[0].snowpack.energy_deficit += patch[0].snowpack.energy_deficit * patch[0].area;
+		hillslope[0].snowpack.surface_age += patch[0].snowpack.surface_age * patch[0].area;
+		hillslope[0].snowpack.T += patch[0].snowpack.T * patch[0].area;
+		hillslope[0].area_withsnow += patch[0].area;
 		}
 
 	/* track variables for fire spread */
@@ -2189,61 +1496,47 @@ void		patch_daily_F(
 		+ patch[0].cdf.soil2c_hr + patch[0].cdf.soil3c_hr
 		+ patch[0].cdf.soil4c_hr);
 
-	if (command_line[0].snow_scale_flag == 1)
-	  patch[0].water_balance = zone[0].rain + zone[0].snow*patch[0].snow_redist_scale 
-		+ patch[0].preday_detention_store +
-		+ irrigation 
-		+ patch[0].landuse_defaults[0][0].septic_water_load 
-		+ zone[0].rain_hourly_total - ( patch[0].gw_drainage
-		+ patch[0].transpiration_sat_zone + patch[0].transpiration_unsat_zone
-		+ patch[0].evaporation + patch[0].evaporation_surf 
-		+ patch[0].exfiltration_unsat_zone + patch[0].exfiltration_sat_zone)
-		- (patch[0].rz_storage - patch[0].preday_rz_storage)		
-		- (patch[0].unsat_storage - patch[0].preday_unsat_storage)
-		- (patch[0].preday_sat_deficit - patch[0].sat_deficit)
-		- patch[0].delta_snowpack - patch[0].delta_rain_stored
-		- patch[0].delta_snow_stored - patch[0].detention_store;
-	else	
-	  patch[0].water_balance = zone[0].rain + zone[0].snow 
-		+ patch[0].preday_detention_store +
-		+ irrigation 
-		+ patch[0].landuse_defaults[0][0].septic_water_load 
-		+ zone[0].rain_hourly_total - ( patch[0].gw_drainage
-		+ patch[0].transpiration_sat_zone + patch[0].transpiration_unsat_zone
-		+ patch[0].evaporation + patch[0].evaporation_surf 
-		+ patch[0].exfiltration_unsat_zone + patch[0].exfiltration_sat_zone)
-		- (patch[0].rz_storage - patch[0].preday_rz_storage)			
-		- (patch[0].unsat_storage - patch[0].preday_unsat_storage)
-		- (patch[0].preday_sat_deficit - patch[0].sat_deficit)
-		- patch[0].delta_snowpack - patch[0].delta_rain_stored
-		- patch[0].delta_snow_stored - patch[0].detention_store;
-
-	/*
-	if ((patch[0].water_balance > 0.00000001)||
-		(patch[0].water_balance < -0.00000001)){
-		printf("\n Water Balance is %12.8f on %ld %ld %ld for patch %d of type %d",
-			patch[0].water_balance,
-			current_date.day,
-			current_date.month,
-			current_date.year,
-			patch[0].ID,
-			patch[0].drainage_type);
-		printf("\nRain %lf %lf, dt %lf, rh %lf, T %lf %lf, E %lf ES %lf, Ex %lf %lf, RZ %lf %lf, US %lf %lf, SD %lf %lf, S %lf, RS %lf (%lf %lf), SS %lf, DT %lf",
-		 zone[0].rain , zone[0].snow , patch[0].preday_detention_store ,
-		 zone[0].rain_hourly_total ,  
-		 patch[0].transpiration_sat_zone , patch[0].transpiration_unsat_zone
-		, patch[0].evaporation , patch[0].evaporation_surf
-		, patch[0].exfiltration_unsat_zone , patch[0].exfiltration_sat_zone
-		, patch[0].rz_storage , patch[0].preday_rz_storage
-		, patch[0].unsat_storage , patch[0].preday_unsat_storage
-		, patch[0].preday_sat_deficit , patch[0].sat_deficit
-		, patch[0].delta_snowpack , patch[0].delta_rain_stored
-		, patch[0].preday_rain_stored, patch[0].rain_stored
-		, patch[0].delta_snow_stored , patch[0].detention_store);	
-	
+	/*--------------------------------------------------------------*/
+	/*	water balance, only on -balance check days and for the	*/
+	/*	sampled patches; violations go to the hillslope log	*/
+	/*--------------------------------------------------------------*/
+	patch[0].water_balance = 0.0;
+	if ((hillslope[0].balance_log != NULL) && (hillslope[0].balance_log[0].due == 1)
+		&& ((patch[0].ID % command_line[0].balance_sample) == 0)) {
+		if (command_line[0].snow_scale_flag == 1)
+		  patch[0].water_balance = zone[0].rain + zone[0].snow*patch[0].snow_redist_scale 
+			+ patch[0].preday_detention_store +
+			+ patch[0].irrigation 
+			+ patch[0].landuse_defaults[0][0].septic_water_load 
+			+ zone[0].rain_hourly_total - ( patch[0].gw_drainage
+			+ patch[0].transpiration_sat_zone + patch[0].transpiration_unsat_zone
+			+ patch[0].evaporation + patch[0].evaporation_surf 
+			+ patch[0].exfiltration_unsat_zone + patch[0].exfiltration_sat_zone)
+			- (patch[0].rz_storage - patch[0].preday_rz_storage)		
+			- (patch[0].unsat_storage - patch[0].preday_unsat_storage)
+			- (patch[0].preday_sat_deficit - patch[0].sat_deficit)
+			- patch[0].delta_snowpack - patch[0].delta_rain_stored
+			- patch[0].delta_snow_stored - patch[0].detention_store;
+		else	
+		  patch[0].water_balance = zone[0].rain + zone[0].snow 
+			+ patch[0].preday_detention_store +
+			+ patch[0].irrigation 
+			+ patch[0].landuse_defaults[0][0].septic_water_load 
+			+ zone[0].rain_hourly_total - ( patch[0].gw_drainage
+			+ patch[0].transpiration_sat_zone + patch[0].transpiration_unsat_zone
+			+ patch[0].evaporation + patch[0].evaporation_surf 
+			+ patch[0].exfiltration_unsat_zone + patch[0].exfiltration_sat_zone)
+			- (patch[0].rz_storage - patch[0].preday_rz_storage)			
+			- (patch[0].unsat_storage - patch[0].preday_unsat_storage)
+			- (patch[0].preday_sat_deficit - patch[0].sat_deficit)
+			- patch[0].delta_snowpack - patch[0].delta_rain_stored
+			- patch[0].delta_snow_stored - patch[0].detention_store;
+
+		if ((patch[0].water_balance > 0.00000001)||
+			(patch[0].water_balance < -0.00000001))
+			add_balance_entry(hillslope[0].balance_log, BALANCE_PATCH_WATER,
+				patch[0].ID, patch[0].drainage_type, patch[0].water_balance);
 	}
-	 
-	*/
 	
 	/* Calculate LE for surface evap */
 	/* soil&litter&detstore evap x latent heat vaporization x water density */
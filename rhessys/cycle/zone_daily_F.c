@@ -151,6 +151,23 @@ void		zone_daily_F(
 		struct command_line_object *,
 		struct tec_entry *,
 		struct date);
+
+	void    patch_canopy_daily_F(
+		struct	world_object	*,
+		struct	basin_object	*,
+		struct	hillslope_object	*,
+		struct 	zone_object 	*,
+		struct patch_object *,
+		struct command_line_object *,
+		struct tec_entry *,
+		struct date);
+
+	void    zone_snowpack_daily_F(
+		struct	basin_object	*,
+		struct	hillslope_object	*,
+		struct 	zone_object 	*,
+		struct command_line_object *,
+		struct date);
 	long julday(struct date);
 	
 	/*--------------------------------------------------------------*/
@@ -626,7 +643,30 @@ void		zone_daily_F(
 	
 	/*--------------------------------------------------------------*/
 	/*	Cycle through the patches for day end computations		    	*/
+	/*	in three passes: the canopy above the snowpack of every	*/
+	/*	patch, the snowpack energy balance of the zone as one	*/
+	/*	batch, and the rest of each patch day			*/
 	/*--------------------------------------------------------------*/
+	for ( patch=0 ; patch<zone[0].num_patches; patch++ ){
+		patch_canopy_daily_F(
+			world,
+			basin,
+			hillslope,
+			zone,
+			zone[0].patches[patch],
+			command_line,
+			event,
+			current_date );
+	}
+
+	if (zone[0].num_patches > 0)
+		zone_snowpack_daily_F(
+			basin,
+			hillslope,
+			zone,
+			command_line,
+			current_date );
+
 	for ( patch=0 ; patch<zone[0].num_patches; patch++ ){
 		patch_daily_F(
 			world,
@@ -0,0 +1,273 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*				 		zone_snowpack_daily_F					*/
+/*																*/
+/*	NAME														*/
+/*	zone_snowpack_daily_F 										*/
+/*				 - snowpack cycling of the patches of a zone	*/
+/*																*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void zone_snowpack_daily_F(								*/
+/*						struct	basin_object	*,				*/
+/*						struct	hillslope_object	*,			*/
+/*						struct	zone_object		*,				*/
+/*						struct command_line_object *,			*/
+/*						struct date)							*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Runs between patch_canopy_daily_F and patch_daily_F for	*/
+/*	all patches of a zone.  Patches with a snowpack above the	*/
+/*	pond get one lane in the hillslope snowpack batch, or a	*/
+/*	covered and an exposed lane when the overstory covers	*/
+/*	part of the patch; snowpack_daily_F then evaluates the	*/
+/*	energy balance of all lanes together.  Snow below the	*/
+/*	pond is melted into the throughfall and snow free patches	*/
+/*	only have their snowpack fluxes reset.			*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	The patches are taken in zone order, and the lanes of a	*/
+/*	patch are next to each other, covered first, so sums	*/
+/*	over the lanes are taken in the order of the former	*/
+/*	per patch calls.					*/
+/*																*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+
+static	void	add_lane(
+						 struct snowpack_batch_object *batch,
+						 struct patch_object *patch,
+						 double	Kdown_direct,
+						 double	Kdown_diffuse,
+						 double	PAR_direct,
+						 double	PAR_diffuse,
+						 double	overstory_fraction,
+						 double	area_fraction,
+						 int	update_flag)
+{
+	int	c;
+
+	c = batch[0].num_lanes++;
+	batch[0].patch[c] = patch;
+	batch[0].update_flag[c] = update_flag;
+	batch[0].albedo_flag[c] = patch[0].soil_defaults[0][0].snow_albedo_flag;
+	/* Lundberg 1994 reduce conductance for snow vs. rain by factor of 10 */
+	batch[0].gasnow[c] = patch[0].gasnow/10.0;
+	batch[0].rain[c] = patch[0].rain_throughfall;
+	batch[0].snow[c] = patch[0].snow_throughfall;
+	batch[0].Kdown_direct[c] = Kdown_direct;
+	batch[0].Kup_direct[c] = 0.0;
+	batch[0].Kdown_diffuse[c] = Kdown_diffuse;
+	batch[0].Kup_diffuse[c] = 0.0;
+	batch[0].PAR_direct[c] = PAR_direct;
+	batch[0].PAR_diffuse[c] = PAR_diffuse;
+	batch[0].Lstar[c] = patch[0].Lstar_snow;
+	batch[0].overstory_fraction[c] = overstory_fraction;
+	batch[0].area_fraction[c] = area_fraction;
+	batch[0].bats_b[c] = patch[0].soil_defaults[0][0].bats_b;
+	batch[0].bats_r3[c] = patch[0].soil_defaults[0][0].bats_r3;
+	batch[0].maximum_energy_deficit[c] = patch[0].soil_defaults[0][0].maximum_snow_energy_deficit;
+	batch[0].light_ext_coef[c] = patch[0].soil_defaults[0][0].snow_light_ext_coef;
+	batch[0].melt_Tcoef[c] = patch[0].soil_defaults[0][0].snow_melt_Tcoef;
+	batch[0].water_equivalent_depth[c] = patch[0].snowpack.water_equivalent_depth;
+	batch[0].surface_age[c] = patch[0].snowpack.surface_age;
+	batch[0].energy_deficit[c] = patch[0].snowpack.energy_deficit;
+	return;
+}
+
+void		zone_snowpack_daily_F(
+						  struct	basin_object	*basin,
+						  struct	hillslope_object	*hillslope,
+						  struct	zone_object		*zone,
+						  struct 	command_line_object *command_line,
+						  struct	date 			current_date)
+{
+	/*------------------------------------------------------*/
+	/*	Local Function Declarations.						*/
+	/*------------------------------------------------------*/
+	void	snowpack_daily_F (
+		struct date,
+		int,
+		struct zone_object *,
+		struct snowpack_batch_object *,
+		double);
+	/*--------------------------------------------------------------*/
+	/*  Local variable definition.                                  */
+	/*--------------------------------------------------------------*/
+	int	p, c;
+	double	of;
+	double Kup_direct_snow_exposed, Kup_diffuse_snow_exposed;
+	struct	patch_object	*patch;
+	struct	snowpack_batch_object	*batch;
+
+	batch = hillslope[0].snowpack_batch;
+	batch[0].num_lanes = 0;
+
+	/*--------------------------------------------------------------*/
+	/*	Calculate snowmelt 											*/
+	/*--------------------------------------------------------------*/
+	/*	Check to see if snowpack is above pond. If so, proceed 	*/
+	/*	with snowpack daily F.  Otherwise, melt all snow and add 	*/
+	/*	to rain throughfall.										*/
+	/*--------------------------------------------------------------*/
+	for ( p=0 ; p<zone[0].num_patches; p++ ){
+		patch = zone[0].patches[p];
+		if ( (patch[0].snowpack.water_equivalent_depth > ZERO)
+			&& (patch[0].snowpack.water_equivalent_depth > patch[0].pond_height) ) {
+			patch[0].stability_correction = 1.0;
+			of = patch[0].snowpack.overstory_fraction;
+			/* COVER FRACTION */
+			if ((of < 1) && (of > 0)) {
+				if ( command_line[0].verbose_flag == -5 ){
+					printf("\nSNOWPACK WITH COVER FRACTION %lf", of);
+				}
+				/* Separate Kdown under canopy from patch-average Kdown below canopy layers */
+				/* Using zone Kdown for exposed portion */
+				add_lane(batch, patch,
+					( patch[0].Kdown_direct - zone[0].Kdown_direct * (1 - of) ) / of,
+					( patch[0].Kdown_diffuse - zone[0].Kdown_diffuse * (1 - of) ) / of,
+					( patch[0].PAR_direct - zone[0].PAR_direct * (1 - of) ) / of,
+					( patch[0].PAR_diffuse - zone[0].PAR_diffuse * (1 - of) ) / of,
+					1.0,
+					of,
+					0);
+				add_lane(batch, patch,
+					zone[0].Kdown_direct,
+					zone[0].Kdown_diffuse,
+					zone[0].PAR_direct,
+					zone[0].PAR_diffuse,
+					0.0,
+					(1-of),
+					1);
+			}
+			/* NO COVER FRACTION */
+			else {
+				if ( command_line[0].verbose_flag == -5 ){
+					printf("\nSNOWPACK WITHOUT COVER FRACTION %lf", of);
+				}
+				add_lane(batch, patch,
+					patch[0].Kdown_direct,
+					patch[0].Kdown_diffuse,
+					patch[0].PAR_direct,
+					patch[0].PAR_diffuse,
+					of,
+					1.0,
+					1);
+			}
+		}
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	energy balance of all snowpacks of the zone		*/
+	/*--------------------------------------------------------------*/
+	if (batch[0].num_lanes > 0)
+		snowpack_daily_F(
+			current_date,
+			command_line[0].verbose_flag,
+			zone,
+			batch,
+			basin[0].theta_noon);
+
+	c = 0;
+	for ( p=0 ; p<zone[0].num_patches; p++ ){
+		patch = zone[0].patches[p];
+		if ( patch[0].snowpack.water_equivalent_depth > ZERO ) {
+			if ( (c < batch[0].num_lanes) && (batch[0].patch[c] == patch) ) {
+				of = patch[0].snowpack.overstory_fraction;
+				Kup_direct_snow_exposed = 0.0;
+				Kup_diffuse_snow_exposed = 0.0;
+				/* COVER FRACTION */
+				if ((of < 1) && (of > 0)) {
+					patch[0].snow_melt = (batch[0].melt[c] * of)
+							+ (batch[0].melt[c+1] * (1-of));
+					patch[0].Kdown_direct = (batch[0].Kdown_direct[c] * of)
+							+ (batch[0].Kdown_direct[c+1] * (1-of));
+					patch[0].Kdown_diffuse = (batch[0].Kdown_diffuse[c] * of)
+							+ (batch[0].Kdown_diffuse[c+1] * (1-of));
+					patch[0].PAR_direct = (batch[0].PAR_direct[c] * of)
+							+ (batch[0].PAR_direct[c+1] * (1-of));
+					patch[0].PAR_diffuse = (batch[0].PAR_diffuse[c] * of)
+							+ (batch[0].PAR_diffuse[c+1] * (1-of));
+					Kup_direct_snow_exposed = batch[0].Kup_direct[c+1];
+					Kup_diffuse_snow_exposed = batch[0].Kup_diffuse[c+1];
+					c += 2;
+				}
+				/* NO COVER FRACTION */
+				else {
+					patch[0].snow_melt = batch[0].melt[c];
+					patch[0].Kdown_direct = batch[0].Kdown_direct[c];
+					patch[0].Kdown_diffuse = batch[0].Kdown_diffuse[c];
+					patch[0].PAR_direct = batch[0].PAR_direct[c];
+					patch[0].PAR_diffuse = batch[0].PAR_diffuse[c];
+					if (of == 0) {
+						Kup_direct_snow_exposed = batch[0].Kup_direct[c];
+						Kup_diffuse_snow_exposed = batch[0].Kup_diffuse[c];
+					}
+					c += 1;
+				}
+
+				/* FOR ALL COVER FRACTIONS */
+				patch[0].Kup_direct += Kup_direct_snow_exposed * (1 - of);
+				patch[0].Kup_diffuse += Kup_diffuse_snow_exposed * (1 - of);
+
+				patch[0].snowpack.water_equivalent_depth -= patch[0].snow_melt;
+				patch[0].snowpack.sublimation = min(patch[0].snowpack.sublimation, patch[0].snowpack.water_equivalent_depth);
+				patch[0].snowpack.height = patch[0].snowpack.water_equivalent_depth / 0.1; /* snow density ~ 0.1 */
+
+				if (patch[0].snow_melt_input == -999.0)
+					patch[0].rain_throughfall += patch[0].snow_melt;
+				else {
+					patch[0].rain_throughfall += patch[0].snow_melt_input;
+					patch[0].snow_melt = patch[0].snow_melt_input;
+				}
+				patch[0].snow_throughfall = 0.0;
+				patch[0].snowpack.water_equivalent_depth -= patch[0].snowpack.sublimation;
+				/* Force turbulent fluxes to 0 under snowpack */
+				patch[0].ga = 0.0;
+				patch[0].wind = 0.0;
+			}
+			else {
+				patch[0].rain_throughfall += patch[0].snowpack.water_equivalent_depth;
+				patch[0].snow_throughfall = 0.0;
+				patch[0].snowpack.water_equivalent_depth = 0.0;
+				patch[0].snowpack.height = 0.0;
+			}
+		}
+		else{
+			/*--------------------------------------------------------------*/
+			/*	snow free: no snowfall reached the patch and there is	*/
+			/*	no pack, so none of the snowpack energy balance is	*/
+			/*	needed; just reset the snowpack fluxes			*/
+			/*--------------------------------------------------------------*/
+			patch[0].snow_melt = 0.0;
+			patch[0].snowpack.energy_deficit = 0.001;
+			patch[0].snowpack.Kstar_direct = 0.0;
+			patch[0].snowpack.Kstar_diffuse = 0.0;
+			patch[0].snowpack.APAR_direct = 0.0;
+			patch[0].snowpack.APAR_diffuse = 0.0;
+			patch[0].snowpack.water_equivalent_depth = 0.0;
+		}
+
+		if (patch[0].snowpack.water_equivalent_depth < 0.0001) {
+			patch[0].rain_throughfall += patch[0].snowpack.water_equivalent_depth;
+			patch[0].snowpack.water_equivalent_depth = 0.0;
+			patch[0].snowpack.energy_deficit = 0.001;
+			patch[0].snowpack.surface_age = 0.0;
+			patch[0].snowpack.T = 0.0;
+			patch[0].snowpack.height = 0.0;
+			}
+
+		if ( command_line[0].verbose_flag == -5 ){
+			printf("\n     AFTER SNOWPACK: Kup_direct=%lf Kup_diffuse=%lf",
+				   patch[0].Kup_direct/86.4,
+				   patch[0].Kup_diffuse/86.4);
+		}
+	}
+	return;
+} /*end zone_snowpack_daily_F.c*/
@@ -33,6 +33,21 @@
 #include <stdio.h>
 #include "rhessys.h"
 
+/*--------------------------------------------------------------*/
+/*	clear the stream flow of a patch before it drains; a	*/
+/*	road may already have added to the stream patch it	*/
+/*	drains to, so this is done in route list order		*/
+/*--------------------------------------------------------------*/
+static void reset_hourly_stream_flow(struct patch_object *patch)
+{
+	patch[0].hourly_subsur2stream_flow = 0;
+	patch[0].hourly_sur2stream_flow = 0;
+	patch[0].hourly_stream_flow = 0;
+	patch[0].hourly[0].streamflow_NO3 = 0;
+	patch[0].hourly[0].streamflow_NO3_from_sub = 0;
+	patch[0].hourly[0].streamflow_NO3_from_surface = 0;
+}
+
 void compute_subsurface_routing(struct command_line_object *command_line,
 		struct hillslope_object *hillslope, int n_timesteps, struct date current_date) {
 	/*--------------------------------------------------------------*/
@@ -46,6 +61,10 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 			struct command_line_object *, double, int);
 
 	void update_drainage_land(struct patch_object *,
+			struct neighbour_table_object *, int,
+			struct command_line_object *, double, int);
+
+	void gather_drainage_land(struct neighbour_table_object *,
 			struct command_line_object *, double, int);
 
 	double compute_infiltration(int, double, double, double, double, double,
@@ -53,6 +72,8 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 
 	double compute_z_final(int, double, double, double, double, double);
 
+	void add_balance_entry(struct balance_log_object *, int, int, int, double);
+
 	double compute_N_leached(int, double, double, double, double, double,
 			double, double, double, double, double, double, double,double *);
 
@@ -65,9 +86,10 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.				*/
 	/*--------------------------------------------------------------*/
-	int i, d;
+	int i, d, s;
+	struct neighbour_table_object *table;
 	int j, k;
-	int grow_flag, verbose_flag;
+	int grow_flag, verbose_flag, balance_due;
 	double time_int, tmp;
 	double theta, m, Ksat, Nout;
 	double NO3_out, NH4_out, DON_out, DOC_out;
@@ -96,8 +118,10 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 	/*--------------------------------------------------------------*/
 	grow_flag = command_line[0].grow_flag;
 	verbose_flag = command_line[0].verbose_flag;
+	balance_due = (hillslope[0].balance_log != NULL) && (hillslope[0].balance_log[0].due == 1);
 
 	time_int = 1.0 / n_timesteps;
+	table = hillslope[0].neighbour_table;
 	hillslope_outflow = 0.0;
 	hillslope_area = 0.0;
 	hillslope_unsat_storage = 0.0;
@@ -130,18 +154,27 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 	// Note: this assumes that the set of patches in the surface routing table is identical to
 	//       the set of patches in the subsurface flow table
  
-  #pragma omp parallel for reduction(+ : preday_hillslope_rz_storage,preday_hillslope_unsat_storage,preday_hillslope_sat_deficit,preday_hillslope_return_flow,preday_hillslope_detention_store,hillslope_area)
+	/*--------------------------------------------------------------*/
+	/*	starting stores for the hillslope water balance, only	*/
+	/*	on -balance check days					*/
+	/*--------------------------------------------------------------*/
+	if (balance_due) {
+		for (i = 0; i < hillslope->route_list->num_patches; i++) {
+			patch = hillslope->route_list->list[i];
+			preday_hillslope_rz_storage += patch[0].rz_storage * patch[0].area;
+			preday_hillslope_unsat_storage += patch[0].unsat_storage * patch[0].area;
+			preday_hillslope_sat_deficit += patch[0].sat_deficit * patch[0].area;
+			preday_hillslope_detention_store += patch[0].detention_store * patch[0].area;
+		}
+	}
+
+  #pragma omp parallel for private(patch) reduction(+ : hillslope_area)
   for (i = 0; i < hillslope->route_list->num_patches; i++) {
 		patch = hillslope->route_list->list[i];
 		patch[0].streamflow = 0.0;
 		patch[0].return_flow = 0.0;
 		patch[0].base_flow = 0.0;
 		patch[0].infiltration_excess = 0.0;
-		preday_hillslope_rz_storage += patch[0].rz_storage * patch[0].area;
-		preday_hillslope_unsat_storage += patch[0].unsat_storage * patch[0].area;
-		preday_hillslope_sat_deficit += patch[0].sat_deficit * patch[0].area;
-		preday_hillslope_return_flow += patch[0].return_flow * patch[0].area;
-		preday_hillslope_detention_store += patch[0].detention_store * patch[0].area;
 		hillslope_area += patch[0].area;
 		patch[0].Qin_total = 0.0;
 		patch[0].Qout_total = 0.0;
@@ -225,37 +258,52 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 				-1.0 * patch[0].sat_deficit);
 		patch[0].preday_sat_deficit = patch[0].sat_deficit;
 
-    #pragma omp parallel for
-		for (i = 0; i < hillslope->route_list->num_patches; i++) {
-			patch = hillslope->route_list->list[i];
-		      	patch[0].hourly_subsur2stream_flow = 0;
-			patch[0].hourly_sur2stream_flow = 0;
-			patch[0].hourly_stream_flow = 0;
-			patch[0].hourly[0].streamflow_NO3 = 0;
-			patch[0].hourly[0].streamflow_NO3_from_sub = 0;
-			patch[0].hourly[0].streamflow_NO3_from_surface = 0;			
-			/*--------------------------------------------------------------*/
-			/*	for roads, saturated throughflow beneath road cut	*/
-			/*	is routed to downslope patches; saturated throughflow	*/
-			/*	above the cut and overland flow is routed to the stream	*/
-			/*								*/
-			/*	for streams, no routing - all exported from hillslope	*/
-			/*								*/
-			/*	regular land patches - route to downslope neighbours    */
-			/*--------------------------------------------------------------*/
-			if ((patch[0].drainage_type == ROAD)
+		/*--------------------------------------------------------------*/
+		/*	for roads, saturated throughflow beneath road cut	*/
+		/*	is routed to downslope patches; saturated throughflow	*/
+		/*	above the cut and overland flow is routed to the stream	*/
+		/*								*/
+		/*	for streams, no routing - all exported from hillslope	*/
+		/*								*/
+		/*	regular land patches - route to downslope neighbours    */
+		/*								*/
+		/*	the route list is walked in order one segment of a	*/
+		/*	single drainage type at a time.  Patches add to their	*/
+		/*	neighbours as they drain, so this is serial, except	*/
+		/*	that with -pull a land patch only keeps its outflow	*/
+		/*	and the patches of a land segment run in parallel;	*/
+		/*	roads and streams still push and stay serial		*/
+		/*--------------------------------------------------------------*/
+		for (s = 0; s < table[0].num_segments; s++) {
+			if ((table[0].segment_type[s] == ROAD)
 					&& (command_line[0].road_flag == 1)) {
-				update_drainage_road(patch, command_line, time_int,
-						verbose_flag);
-			} else if (patch[0].drainage_type == STREAM) {
-				update_drainage_stream(patch, command_line, time_int,
-						verbose_flag);
+				for (i = table[0].segment_start[s]; i < table[0].segment_start[s+1]; i++) {
+					patch = hillslope->route_list->list[i];
+					reset_hourly_stream_flow(patch);
+					update_drainage_road(patch, command_line, time_int,
+							verbose_flag);
+				}
+			} else if (table[0].segment_type[s] == STREAM) {
+				for (i = table[0].segment_start[s]; i < table[0].segment_start[s+1]; i++) {
+					patch = hillslope->route_list->list[i];
+					reset_hourly_stream_flow(patch);
+					update_drainage_stream(patch, command_line, time_int,
+							verbose_flag);
+				}
 			} else {
-				update_drainage_land(patch, command_line, time_int,
-						verbose_flag);
+				#pragma omp parallel for private(patch) schedule(dynamic) if (command_line[0].pull_flag == 1)
+				for (i = table[0].segment_start[s]; i < table[0].segment_start[s+1]; i++) {
+					patch = hillslope->route_list->list[i];
+					reset_hourly_stream_flow(patch);
+					update_drainage_land(patch, table, i,
+							command_line, time_int,
+							verbose_flag);
+				}
 			}
-
-		} /* end i */
+		} /* end s */
+		if (command_line[0].pull_flag == 1)
+			gather_drainage_land(table, command_line,
+					time_int, verbose_flag);
 
 		/*--------------------------------------------------------------*/
 		/*	update soil moisture and nitrogen stores		*/
@@ -968,18 +1016,6 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 						+ patch[0].base_flow;
 				}
 
-				/*--------------------------------------------------------------*/
-				/* final stream flow calculations				*/
-				/*--------------------------------------------------------------*/
-
-				hillslope[0].hillslope_return_flow += (patch[0].return_flow) * patch[0].area;
-				hillslope[0].hillslope_outflow += (patch[0].streamflow) * patch[0].area;
-				hillslope[0].hillslope_unsat_storage += patch[0].unsat_storage * patch[0].area;
-				hillslope[0].hillslope_sat_deficit += patch[0].sat_deficit * patch[0].area;
-				hillslope[0].hillslope_rz_storage += patch[0].rz_storage * patch[0].area;
-				hillslope[0].hillslope_detention_store += patch[0].detention_store
-						* patch[0].area;
-				
 				/*---------------------------------------------------------------------*/
 				/*update accumulator variables                                            */
 				/*-----------------------------------------------------------------------*/
@@ -1003,19 +1039,38 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 
 	} /* end k  */
 
-	hillslope[0].hillslope_outflow /= hillslope_area;
-	hillslope[0].preday_hillslope_rz_storage /= hillslope_area;
-	hillslope[0].preday_hillslope_unsat_storage /= hillslope_area;
-	hillslope[0].preday_hillslope_detention_store /= hillslope_area;
-	hillslope[0].preday_hillslope_sat_deficit /= hillslope_area;
-	hillslope[0].hillslope_rz_storage /= hillslope_area;
-	hillslope[0].hillslope_unsat_storage /= hillslope_area;
-	hillslope[0].hillslope_detention_store /= hillslope_area;
-	hillslope[0].hillslope_sat_deficit /= hillslope_area;
-	water_balance = hillslope[0].preday_hillslope_rz_storage + hillslope[0].preday_hillslope_unsat_storage
-			+ hillslope[0].preday_hillslope_detention_store - hillslope[0].preday_hillslope_sat_deficit
-			- (hillslope[0].hillslope_rz_storage + hillslope[0].hillslope_unsat_storage + hillslope[0].hillslope_detention_store
-					- hillslope[0].hillslope_sat_deficit) - hillslope[0].hillslope_outflow;
+	/*--------------------------------------------------------------*/
+	/*	hillslope water balance on -balance check days, from	*/
+	/*	the final stores of all patches once routing is done	*/
+	/*--------------------------------------------------------------*/
+	if (balance_due) {
+		for (i = 0; i < hillslope->route_list->num_patches; i++) {
+			patch = hillslope->route_list->list[i];
+			hillslope[0].hillslope_return_flow += (patch[0].return_flow) * patch[0].area;
+			hillslope[0].hillslope_outflow += (patch[0].streamflow) * patch[0].area;
+			hillslope[0].hillslope_unsat_storage += patch[0].unsat_storage * patch[0].area;
+			hillslope[0].hillslope_sat_deficit += patch[0].sat_deficit * patch[0].area;
+			hillslope[0].hillslope_rz_storage += patch[0].rz_storage * patch[0].area;
+			hillslope[0].hillslope_detention_store += patch[0].detention_store
+					* patch[0].area;
+		}
+		hillslope[0].hillslope_outflow /= hillslope_area;
+		hillslope[0].preday_hillslope_rz_storage /= hillslope_area;
+		hillslope[0].preday_hillslope_unsat_storage /= hillslope_area;
+		hillslope[0].preday_hillslope_detention_store /= hillslope_area;
+		hillslope[0].preday_hillslope_sat_deficit /= hillslope_area;
+		hillslope[0].hillslope_rz_storage /= hillslope_area;
+		hillslope[0].hillslope_unsat_storage /= hillslope_area;
+		hillslope[0].hillslope_detention_store /= hillslope_area;
+		hillslope[0].hillslope_sat_deficit /= hillslope_area;
+		water_balance = hillslope[0].preday_hillslope_rz_storage + hillslope[0].preday_hillslope_unsat_storage
+				+ hillslope[0].preday_hillslope_detention_store - hillslope[0].preday_hillslope_sat_deficit
+				- (hillslope[0].hillslope_rz_storage + hillslope[0].hillslope_unsat_storage + hillslope[0].hillslope_detention_store
+						- hillslope[0].hillslope_sat_deficit) - hillslope[0].hillslope_outflow;
+		if ((water_balance > 0.0000001) || (water_balance < -0.0000001))
+			add_balance_entry(hillslope[0].balance_log, BALANCE_ROUTING_WATER,
+				hillslope[0].ID, 0, water_balance);
+	}
 
 
 	if((command_line[0].output_flags.yearly == 1)
@@ -49,6 +49,10 @@ void compute_subsurface_routing_hourly(
 			struct command_line_object *, double, int);
 
 	void update_drainage_land(struct patch_object *,
+			struct neighbour_table_object *, int,
+			struct command_line_object *, double, int);
+
+	void gather_drainage_land(struct neighbour_table_object *,
 			struct command_line_object *, double, int);
 
 	double compute_infiltration(int, double, double, double, double, double,
@@ -68,7 +72,8 @@ void compute_subsurface_routing_hourly(
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.				*/
 	/*--------------------------------------------------------------*/
-	int i, d;
+	int i, d, s;
+	struct neighbour_table_object *table;
 	int j, k;
 	int grow_flag, verbose_flag;
 	double time_int, tmp;
@@ -94,7 +99,6 @@ void compute_subsurface_routing_hourly(
 	double streamflow, Qout, Qin_total, Qstr_total;
 	struct patch_object *patch;
 	struct patch_object *neigh;
-	struct litter_object *litter;
 	d=0;
 	/*--------------------------------------------------------------*/
 	/*	initializations						*/
@@ -104,6 +108,7 @@ void compute_subsurface_routing_hourly(
 		verbose_flag = command_line[0].verbose_flag;
 
 		time_int = 1.0 / n_timesteps;
+		table = hillslope[0].neighbour_table;
 
 	if (current_date.hour==1)
 	{
@@ -227,33 +232,49 @@ void compute_subsurface_routing_hourly(
 			patch[0].hourly[0].streamflow_NO3_from_surface = 0;
 		}
 
-		for (i = 0; i < hillslope->route_list->num_patches; i++) {
-			patch = hillslope->route_list->list[i];
-			litter=&(patch[0].litter);
-			/*--------------------------------------------------------------*/
-			/*	for roads, saturated throughflow beneath road cut	*/
-			/*	is routed to downslope patches; saturated throughflow	*/
-			/*	above the cut and overland flow is routed to the stream	*/
-			/*								*/
-			/*	for streams, no routing - all exported from hillslope	*/
-			/*								*/
-			/*	regular land patches - route to downslope neighbours    */
-			/*--------------------------------------------------------------*/
-			if ((patch[0].drainage_type == ROAD)
+		/*--------------------------------------------------------------*/
+		/*	for roads, saturated throughflow beneath road cut	*/
+		/*	is routed to downslope patches; saturated throughflow	*/
+		/*	above the cut and overland flow is routed to the stream	*/
+		/*								*/
+		/*	for streams, no routing - all exported from hillslope	*/
+		/*								*/
+		/*	regular land patches - route to downslope neighbours    */
+		/*								*/
+		/*	the route list is walked in order one segment of a	*/
+		/*	single drainage type at a time.  Patches add to their	*/
+		/*	neighbours as they drain, so this is serial, except	*/
+		/*	that with -pull a land patch only keeps its outflow	*/
+		/*	and the patches of a land segment run in parallel;	*/
+		/*	roads and streams still push and stay serial		*/
+		/*--------------------------------------------------------------*/
+		for (s = 0; s < table[0].num_segments; s++) {
+			if ((table[0].segment_type[s] == ROAD)
 					&& (command_line[0].road_flag == 1)) {
-				update_drainage_road(patch, command_line, time_int,
-						verbose_flag);
-			} else if (patch[0].drainage_type == STREAM) {
-				update_drainage_stream(patch, command_line, time_int,
-						verbose_flag);
+				for (i = table[0].segment_start[s]; i < table[0].segment_start[s+1]; i++) {
+					patch = hillslope->route_list->list[i];
+					update_drainage_road(patch, command_line, time_int,
+							verbose_flag);
+				}
+			} else if (table[0].segment_type[s] == STREAM) {
+				for (i = table[0].segment_start[s]; i < table[0].segment_start[s+1]; i++) {
+					patch = hillslope->route_list->list[i];
+					update_drainage_stream(patch, command_line, time_int,
+							verbose_flag);
+				}
 			} else {
-				update_drainage_land(patch, command_line, time_int,
-						verbose_flag);
+				#pragma omp parallel for private(patch) schedule(dynamic) if (command_line[0].pull_flag == 1)
+				for (i = table[0].segment_start[s]; i < table[0].segment_start[s+1]; i++) {
+					patch = hillslope->route_list->list[i];
+					update_drainage_land(patch, table, i,
+							command_line, time_int,
+							verbose_flag);
+				}
 			}
-
-
-
-		} /* end i */
+		} /* end s */
+		if (command_line[0].pull_flag == 1)
+			gather_drainage_land(table, command_line,
+					time_int, verbose_flag);
 
 		/*--------------------------------------------------------------*/
 		/*	update soil moisture and nitrogen stores		*/
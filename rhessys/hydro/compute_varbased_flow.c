@@ -35,12 +35,78 @@
 /*								*/
 /*	PROGRAMMER NOTES					*/
 /*								*/
+/*	with -stdevtable the 9 point normal integration is	*/
+/*	tabulated once per patch at each soil interval of s1	*/
+/*	and interpolated linearly; the table is rebuilt if	*/
+/*	std or the transmissivity profile of the patch changes	*/
+/*	deficits above the surface use the top of the profile	*/
+/*								*/
 /*--------------------------------------------------------------*/
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 #include "rhessys.h"
 #include "phys_constants.h"
 
+static const double normal[9] = {0, 0.253, 0.524, 0.842, 1.283,
+				-0.253, -0.524, -0.842, -1.283};
+static const double perc[9] = {0.2, 0.1, 0.1, 0.1, 0.1,
+				0.1, 0.1, 0.1, 0.1};
+
+/*--------------------------------------------------------------*/
+/*	normal integration of transmissivity around s1		*/
+/*--------------------------------------------------------------*/
+static double	integrate_varbased_flow(
+				int num_soil_intervals,
+				double std,
+				double s1,
+				double interval_size,
+				double *transmissivity)
+{
+	double	flow;
+	int i;
+	int didx;
+
+	flow = 0.0;
+	for (i=0; i <9; i++) {
+		didx = (int) lround((s1 + normal[i]*std)/interval_size);
+		if (didx > num_soil_intervals) didx = num_soil_intervals;
+		if (didx < 0) didx = 0;
+		flow += transmissivity[didx] * perc[i];
+	}
+	return(flow);
+}
+
+/*--------------------------------------------------------------*/
+/*	tabulate the integration from s1 = 0 to the depth	*/
+/*	below which all points fall past the last interval	*/
+/*--------------------------------------------------------------*/
+static void	build_varflow_table(
+				struct varflow_table_object *table,
+				int num_soil_intervals,
+				double std,
+				double interval_size,
+				double *transmissivity)
+{
+	void	*alloc(size_t, char *, char *);
+	int i;
+
+	free(table[0].flow);
+	table[0].num_entries = (int) ceil(num_soil_intervals + 0.5
+		+ normal[4]*std/interval_size) + 1;
+	table[0].flow = (double *) alloc(table[0].num_entries * sizeof(double),
+		"flow", "compute_varbased_flow");
+	for (i=0; i < table[0].num_entries; i++)
+		table[0].flow[i] = integrate_varbased_flow(num_soil_intervals,
+			std, i*interval_size, interval_size, transmissivity);
+
+	table[0].std = std;
+	table[0].interval_size = interval_size;
+	table[0].transmissivity = transmissivity;
+	table[0].num_soil_intervals = num_soil_intervals;
+	return;
+}
+
 double	compute_varbased_flow(
 				int num_soil_intervals,
 				double std,
@@ -60,10 +126,11 @@ double	compute_varbased_flow(
 	/*	Local variable definition.				*/
 	/*--------------------------------------------------------------*/
 
-	double	flow, accum,thre_flow,abovthre_flow;
-	double	normal[9], perc[9];
-	int i;
+	double	flow, thre_flow,abovthre_flow;
+	double	q, w;
+	int k;
 	int didx,didthr;
+	struct varflow_table_object *table;
 	
 
 	// soil deficit threshold, not the soil moisture threshold, fs_threshold is defined as the soil moiture threshold as
@@ -76,50 +143,44 @@ double	compute_varbased_flow(
 	double fs_percolation;
 
 
-	/*--------------------------------------------------------------*/
-	/* calculate or initialize value    				*/
-	/*--------------------------------------------------------------*/
-	p = patch[0].soil_defaults[0][0].porosity_decay;
-	n_0 = patch[0].soil_defaults[0][0].porosity_0;
-	soil_depth = patch[0].soil_defaults[0][0].soil_depth;
-	threshold = n_0 * p * (1 - exp(-soil_depth/p))*(1 - patch[0].soil_defaults[0][0].fs_threshold);
-	fs_spill = patch[0].soil_defaults[0][0].fs_spill;
-	fs_percolation = patch[0].soil_defaults[0][0].fs_percolation;
-
-
-	normal[0] = 0;
-	normal[1] = 0.253;
-	normal[2] = 0.524;
-	normal[3] = 0.842;
-	normal[4] = 1.283;
-	normal[5] = -0.253;
-	normal[6] = -0.524;
-	normal[7] = -0.842;
-	normal[8] = -1.283;
-
-	perc[0] = 0.2;
-	for (i=1; i<9; i++)
-		perc[i] = 0.1;
-
-	
 	flow = 0.0;
 	if (s1 < 0.0) s1 = 0.0;	
 
 	if (std > ZERO) {
-	for (i=0; i <9; i++) {
-		didx = (int) lround((s1 + normal[i]*std)/interval_size);
-		if (didx > num_soil_intervals) didx = num_soil_intervals;
-
-		accum = transmissivity[didx] * 1;
-		/* fill and spill */
-		if ((patch[0].sat_deficit <= threshold) && ((s1 + normal[i]*std) <= threshold)){
-		    accum=transmissivity[didx] * 1;
+	table = patch[0].varflow_table;
+	if (table == NULL) {
+		flow = integrate_varbased_flow(num_soil_intervals, std, s1,
+			interval_size, transmissivity);
+	}
+	else {
+		if ((table[0].transmissivity != transmissivity)
+			|| (table[0].std != std)
+			|| (table[0].interval_size != interval_size)
+			|| (table[0].num_soil_intervals != num_soil_intervals))
+			build_varflow_table(table, num_soil_intervals, std,
+				interval_size, transmissivity);
+
+		q = s1 / interval_size;
+		if (q >= table[0].num_entries - 1)
+			flow = table[0].flow[table[0].num_entries - 1];
+		else {
+			k = (int) q;
+			w = q - k;
+			flow = (1.0 - w) * table[0].flow[k] + w * table[0].flow[k+1];
 		}
-
-		flow += accum * perc[i];
 	}
 	}
 	else  {
+		/*--------------------------------------------------------------*/
+		/* calculate or initialize value    				*/
+		/*--------------------------------------------------------------*/
+		p = patch[0].soil_defaults[0][0].porosity_decay;
+		n_0 = patch[0].soil_defaults[0][0].porosity_0;
+		soil_depth = patch[0].soil_defaults[0][0].soil_depth;
+		threshold = n_0 * p * (1 - exp(-soil_depth/p))*(1 - patch[0].soil_defaults[0][0].fs_threshold);
+		fs_spill = patch[0].soil_defaults[0][0].fs_spill;
+		fs_percolation = patch[0].soil_defaults[0][0].fs_percolation;
+
 		didx = (int) lround(s1/interval_size);
 		didthr = (int) lround(threshold/interval_size);
 		if (didx > num_soil_intervals) didx = num_soil_intervals;
@@ -103,9 +103,37 @@
 /*	hillslope						*/
 /*	to deal with single patch scenarios			*/
 /*								*/
+/*	patches are swept from the flat hillslope route_list	*/
+/*	built by construct_topmodel_patchlist, in parallel; 	*/
+/*	each patch writes its terms of the hillslope sums to	*/
+/*	its row of topmodel_sums and the rows are then added	*/
+/*	in list order, so results do not depend on the number	*/
+/*	of threads. The preday sums are taken in the first	*/
+/*	sweep of the first time step.				*/
+/*								*/
 /*--------------------------------------------------------------*/
 #include "rhessys.h"
 
+/* columns of hillslope[0].topmodel_sums */
+#define	TM_PREDAY_SAT_DEFICIT	0
+#define	TM_PREDAY_UNSAT_STORAGE	1
+#define	TM_PREDAY_RZ_STORAGE	2
+#define	TM_PREDAY_DETENTION	3
+#define	TM_PREDAY_LITTER	4
+#define	TM_DETENTION		5
+#define	TM_LITTER		6
+#define	TM_SAT_DEFICIT		7
+#define	TM_NITRATE		8
+#define	TM_AREA			9
+#define	TM_LNA			10
+/* columns reused by the redistribution sweep */
+#define	TM_NEW_RETURN_FLOW	0
+#define	TM_NEW_SAT_DEFICIT	1
+#define	TM_NEW_UNSAT_STORAGE	2
+#define	TM_NEW_RZ_STORAGE	3
+#define	TM_NEW_DETENTION	4
+#define	TM_NEW_LITTER		5
+
 double	top_model(
 				  int	verbose_flag,
 				  int	grow_flag,
@@ -129,6 +157,13 @@ double	top_model(
 		double,
 		double,
 		double);
+
+	void	add_balance_entry(
+		struct balance_log_object *,
+		int,
+		int,
+		int,
+		double);
 	
 	double compute_varbased_returnflow(
 		double,
@@ -186,7 +221,7 @@ double	top_model(
 	/*--------------------------------------------------------------*/
 	/*  Local variable definition.                                  */
 	/*--------------------------------------------------------------*/
-	int i,j,k;
+	int k, n, num_patches;
 	double	base_flow, total_baseflow;
 	double  mean_sat_deficit, mean_sat_deficit_z, up_flow, down_flow;			/* Taehee Hwang */
 	double  new_mean_sat_deficit, new_mean_rz_storage, new_mean_unsat_storage;		/* Taehee Hwang */
@@ -204,6 +239,7 @@ double	top_model(
 	double	return_flow;
 	double  mean_N_leached, mean_nitrate;
 	double	preday_sat_deficit_z, add_field_capacity;
+	double	*sums, *row;
 	struct	patch_object *patch;
 	
 
@@ -217,25 +253,12 @@ double	top_model(
 	preday_total_detention_store = 0.0;
 	preday_total_litter_store = 0.0;
 	/*--------------------------------------------------------------*/
-	/* compute initial conditions					*/
+	/* initial conditions are summed in the first sweep		*/
 	/*--------------------------------------------------------------*/
-
-	for (	i=0 ; i<hillslope[0].num_zones; i++ ){
-		for ( j=0; j< zones[i][0].num_patches; j++ ){
-			patch =  zones[i][0].patches[j];
-			preday_mean_sat_deficit += zones[i][0].patches[j][0].sat_deficit
-				* zones[i][0].patches[j][0].area;
-			preday_mean_unsat_storage += zones[i][0].patches[j][0].unsat_storage
-				* zones[i][0].patches[j][0].area;
-			preday_mean_rz_storage += zones[i][0].patches[j][0].rz_storage
-				* zones[i][0].patches[j][0].area;			/* Taehee Hwang */
-			preday_total_detention_store += zones[i][0].patches[j][0].detention_store
-				* zones[i][0].patches[j][0].area;
-			preday_total_litter_store += patch[0].litter.rain_stored
-				* zones[i][0].patches[j][0].area;
-				
-		}
-	}
+	num_patches = 0;
+	if (hillslope[0].route_list != NULL)
+		num_patches = hillslope[0].route_list->num_patches;
+	sums = hillslope[0].topmodel_sums;
 
 	for ( k=0; k< num_timesteps; ++k) { 
 
@@ -252,16 +275,24 @@ double	top_model(
 	/*--------------------------------------------------------------*/
 	/*  Compute Mean Hillslope Saturation Deficit                   */
 	/*--------------------------------------------------------------*/
-	for (	i=0 ; i<hillslope[0].num_zones; i++ ){
-		for ( j=0; j< zones[i][0].num_patches; j++ ){
+	#pragma omp parallel for private(patch, row, return_flow)
+	for (n = 0; n < num_patches; n++) {
+			patch = hillslope[0].route_list->list[n];
+			row = &(sums[n * TOPMODEL_NUM_SUMS]);
+			if (k == 0) {
+				row[TM_PREDAY_SAT_DEFICIT] = patch[0].sat_deficit * patch[0].area;
+				row[TM_PREDAY_UNSAT_STORAGE] = patch[0].unsat_storage * patch[0].area;
+				row[TM_PREDAY_RZ_STORAGE] = patch[0].rz_storage * patch[0].area;	/* Taehee Hwang */
+				row[TM_PREDAY_DETENTION] = patch[0].detention_store * patch[0].area;
+				row[TM_PREDAY_LITTER] = patch[0].litter.rain_stored * patch[0].area;
+			}
 	/*--------------------------------------------------------------*/
 	/*	get rid of any intial return flow from infiltration excess	*/
 	/*--------------------------------------------------------------*/
 			
-			patch =  zones[i][0].patches[j];
 			return_flow = 0.0;
-			total_detention_store += patch[0].detention_store * patch[0].area;
-			total_litter_store += patch[0].litter.rain_stored * patch[0].area;
+			row[TM_DETENTION] = patch[0].detention_store * patch[0].area;
+			row[TM_LITTER] = patch[0].litter.rain_stored * patch[0].area;
 			
 			if ((patch[0].sat_deficit - patch[0].rz_storage - patch[0].unsat_storage) < -1.0*ZERO)  {
 				return_flow = compute_varbased_returnflow(
@@ -305,16 +336,30 @@ double	top_model(
 	/*--------------------------------------------------------------*/
 	/*	compute mean soil moisture				*/
 	/*--------------------------------------------------------------*/
-			mean_sat_deficit += zones[i][0].patches[j][0].sat_deficit
-				* zones[i][0].patches[j][0].area;
-			if (grow_flag > 0) {
-				mean_nitrate += zones[i][0].patches[j][0].soil_ns.nitrate
-					* zones[i][0].patches[j][0].area;
-			}
-			area += zones[i][0].patches[j][0].area;
-			mean_hillslope_lna += zones[i][0].patches[j][0].lna
-				* zones[i][0].patches[j][0].area;
+			row[TM_SAT_DEFICIT] = patch[0].sat_deficit * patch[0].area;
+			row[TM_NITRATE] = 0.0;
+			if (grow_flag > 0)
+				row[TM_NITRATE] = patch[0].soil_ns.nitrate * patch[0].area;
+			row[TM_AREA] = patch[0].area;
+			row[TM_LNA] = patch[0].lna * patch[0].area;
+	}
+
+	for (n = 0; n < num_patches; n++) {
+		row = &(sums[n * TOPMODEL_NUM_SUMS]);
+		if (k == 0) {
+			preday_mean_sat_deficit += row[TM_PREDAY_SAT_DEFICIT];
+			preday_mean_unsat_storage += row[TM_PREDAY_UNSAT_STORAGE];
+			preday_mean_rz_storage += row[TM_PREDAY_RZ_STORAGE];
+			preday_total_detention_store += row[TM_PREDAY_DETENTION];
+			preday_total_litter_store += row[TM_PREDAY_LITTER];
 		}
+		total_detention_store += row[TM_DETENTION];
+		total_litter_store += row[TM_LITTER];
+		mean_sat_deficit += row[TM_SAT_DEFICIT];
+		if (grow_flag > 0)
+			mean_nitrate += row[TM_NITRATE];
+		area += row[TM_AREA];
+		mean_hillslope_lna += row[TM_LNA];
 	}
 	mean_sat_deficit = mean_sat_deficit / area;
 	mean_hillslope_lna = mean_hillslope_lna / area;
@@ -393,9 +438,10 @@ double	top_model(
 	new_mean_unsat_storage = 0.0;
 	new_mean_rz_storage = 0.0;			/* Taehee Hwang */
 	total_new_return_flow = 0.0;
-	for (	i=0 ; i<hillslope[0].num_zones; i++ ){
-		for ( j=0; j < zones[i][0].num_patches; j++ ){
-			patch =  zones[i][0].patches[j];
+	#pragma omp parallel for private(patch, row, return_flow, preday_sat_deficit_z, rz_drainage, unsat_drainage, add_field_capacity)
+	for (n = 0; n < num_patches; n++) {
+			patch = hillslope[0].route_list->list[n];
+			row = &(sums[n * TOPMODEL_NUM_SUMS]);
 
 			preday_sat_deficit_z = compute_z_final(
 				verbose_flag,
@@ -633,12 +679,12 @@ double	top_model(
 				patch[0].rootzone.S = min((patch[0].rz_storage + patch[0].rootzone.potential_sat - patch[0].sat_deficit)
 					/ (patch[0].rootzone.potential_sat), 1.0);
 			
-			total_new_return_flow += patch[0].return_flow * patch[0].area;
-			new_mean_sat_deficit += patch[0].sat_deficit * patch[0].area;
-			new_mean_unsat_storage += patch[0].unsat_storage * patch[0].area;
-			new_mean_rz_storage += patch[0].rz_storage * patch[0].area;		/* Taehee Hwang */
-			new_total_detention_store += patch[0].detention_store * patch[0].area;
-			new_total_litter_store += patch[0].litter.rain_stored * patch[0].area;
+			row[TM_NEW_RETURN_FLOW] = patch[0].return_flow * patch[0].area;
+			row[TM_NEW_SAT_DEFICIT] = patch[0].sat_deficit * patch[0].area;
+			row[TM_NEW_UNSAT_STORAGE] = patch[0].unsat_storage * patch[0].area;
+			row[TM_NEW_RZ_STORAGE] = patch[0].rz_storage * patch[0].area;		/* Taehee Hwang */
+			row[TM_NEW_DETENTION] = patch[0].detention_store * patch[0].area;
+			row[TM_NEW_LITTER] = patch[0].litter.rain_stored * patch[0].area;
 
 			patch[0].streamflow = patch[0].return_flow;	
 			
@@ -649,45 +695,48 @@ double	top_model(
 				patch[0].soil_defaults[0][0].soil_depth,
 				0.0,
 				-1.0 * patch[0].sat_deficit);
-		} /* end patches */
-	} /* end zones */
+	} /* end patches */
+
+	for (n = 0; n < num_patches; n++) {
+		row = &(sums[n * TOPMODEL_NUM_SUMS]);
+		total_new_return_flow += row[TM_NEW_RETURN_FLOW];
+		new_mean_sat_deficit += row[TM_NEW_SAT_DEFICIT];
+		new_mean_unsat_storage += row[TM_NEW_UNSAT_STORAGE];
+		new_mean_rz_storage += row[TM_NEW_RZ_STORAGE];
+		new_total_detention_store += row[TM_NEW_DETENTION];
+		new_total_litter_store += row[TM_NEW_LITTER];
+	}
 
 	} /* end time step iterations */
 
-	/* for now water balance cannot be computed for multiple  */
-	if (total_detention_store < ZERO)
-		water_balance = ( -new_mean_sat_deficit + preday_mean_sat_deficit + 
-			new_mean_unsat_storage + new_mean_rz_storage + new_total_litter_store -
-			preday_total_litter_store - preday_mean_unsat_storage - preday_mean_rz_storage + 
-			total_new_return_flow - preday_total_detention_store + new_total_detention_store) / hillslope[0].area
-		 + total_baseflow; 
-	 
-	else
-		water_balance = 0.0;
-
-	if ((water_balance > 0.0000001) || (water_balance < -0.0000001))  
-		printf("\n Hill Water Balance is %12.8f on %d %d %d for Hill %d base %lf return %lf sd %lf %lf un %lf %lf rz %lf %lf litter %lf %lf det %lf %lf\n",
-		water_balance,
-		current_date.day,
-		current_date.month,
-		current_date.year,
-		hillslope[0].ID,
-		total_baseflow,
-		total_new_return_flow /hillslope[0].area,
-		preday_mean_sat_deficit /hillslope[0].area , new_mean_sat_deficit /hillslope[0].area,
-		preday_mean_unsat_storage /hillslope[0].area , new_mean_unsat_storage /hillslope[0].area,
-		preday_mean_rz_storage /hillslope[0].area , new_mean_rz_storage /hillslope[0].area,
-		preday_total_litter_store /hillslope[0].area , new_total_litter_store /hillslope[0].area,
-		preday_total_detention_store /hillslope[0].area , new_total_detention_store / hillslope[0].area
-		);
+	/*--------------------------------------------------------------*/
+	/*	hillslope water balance on -balance check days		*/
+	/* 	for now water balance cannot be computed for multiple	*/
+	/*--------------------------------------------------------------*/
+	if ((hillslope[0].balance_log != NULL) && (hillslope[0].balance_log[0].due == 1)) {
+		if (total_detention_store < ZERO)
+			water_balance = ( -new_mean_sat_deficit + preday_mean_sat_deficit + 
+				new_mean_unsat_storage + new_mean_rz_storage + new_total_litter_store -
+				preday_total_litter_store - preday_mean_unsat_storage - preday_mean_rz_storage + 
+				total_new_return_flow - preday_total_detention_store + new_total_detention_store) / hillslope[0].area
+			 + total_baseflow; 
+		else
+			water_balance = 0.0;
+
+		if ((water_balance > 0.0000001) || (water_balance < -0.0000001))  
+			add_balance_entry(hillslope[0].balance_log, BALANCE_TOPMODEL_WATER,
+				hillslope[0].ID, 0, water_balance);
+	}
 
 	/*--------------------------------------------------------------*/
 	/* now that redistribution is complete update output variables	*/
+	/*	basin accumulators are shared by hillslopes run in	*/
+	/*	parallel, patch accumulators are updated in parallel	*/
 	/*--------------------------------------------------------------*/
-	for (	i=0 ; i<hillslope[0].num_zones; i++ ){
-		for ( j=0; j < zones[i][0].num_patches; j++ ){
-
-		patch =  zones[i][0].patches[j];
+	#pragma omp critical (top_model_basin_acc)
+	{
+	for (n = 0; n < num_patches; n++) {
+		patch = hillslope[0].route_list->list[n];
 		if((command_line[0].output_flags.monthly == 1)&&(command_line[0].b != NULL)){
 			scale = patch[0].area / basin[0].area;
 			basin[0].acc_month.streamflow += (patch[0].return_flow) * scale;
@@ -718,8 +767,17 @@ double	top_model(
 			basin[0].acc_year.streamflow += (patch[0].streamflow)*scale;
 			basin[0].acc_year.lai += patch[0].lai * scale;
 			}
+	}
 
-	
+	basin[0].acc_month.stream_NO3 += (hillslope[0].streamflow_NO3 * hillslope[0].area / basin[0].area);
+	basin[0].acc_year.stream_NO3 += (hillslope[0].streamflow_NO3 * hillslope[0].area / basin[0].area);
+	basin[0].acc_month.streamflow += (total_baseflow * hillslope[0].area / basin[0].area);
+	basin[0].acc_year.streamflow += (total_baseflow * hillslope[0].area / basin[0].area);
+	}
+
+	#pragma omp parallel for private(patch)
+	for (n = 0; n < num_patches; n++) {
+		patch = hillslope[0].route_list->list[n];
 		if((command_line[0].output_flags.monthly == 1)&&(command_line[0].p != NULL)){
 			patch[0].acc_month.sm_deficit += (patch[0].sat_deficit - patch[0].unsat_storage);
 
@@ -763,14 +821,8 @@ double	top_model(
 			patch[0].acc_year.lai = max(patch[0].acc_year.lai, patch[0].lai);
 			
 		}
-	   }
 	}
 
-	basin[0].acc_month.stream_NO3 += (hillslope[0].streamflow_NO3 * hillslope[0].area / basin[0].area);
-	basin[0].acc_year.stream_NO3 += (hillslope[0].streamflow_NO3 * hillslope[0].area / basin[0].area);
-	basin[0].acc_month.streamflow += (total_baseflow * hillslope[0].area / basin[0].area);
-	basin[0].acc_year.streamflow += (total_baseflow * hillslope[0].area / basin[0].area);
-
 	return(total_baseflow);
 } /*end top_model.c*/
 
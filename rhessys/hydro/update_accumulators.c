@@ -0,0 +1,536 @@
+/*--------------------------------------------------------------------------------------*/
+/* 											*/
+/*			update_accumulators						*/
+/*											*/
+/*	NAME										*/
+/*	update_accumulators.c - update the monthly and yearly accumulators of a	*/
+/*					basin, its hillslopes and patches at the end of	*/
+/*					each day					*/
+/*	SYNOPSIS									*/
+/*	void update_accumulators( 							*/
+/*					struct command_line_object *command_line,	*/
+/*					struct basin_object *basin			*/
+/*					struct date current_date)			*/
+/*											*/
+/*	OPTIONS										*/
+/*											*/
+/*	DESCRIPTION									*/
+/*	Replaces update_basin_patch_accumulator and update_hillslope_accumulator.	*/
+/*											*/
+/*	Running sums are listed once in accumulator_registry: the daily patch	*/
+/*	(or hillslope) quantity, the level it is summed to (basin, hillslope or	*/
+/*	patch acc_month / acc_year), and whether it is weighted by area.  Each	*/
+/*	day the entries of the levels and periods that have output enabled are	*/
+/*	picked out, and a single pass over the patches of each hillslope	*/
+/*	computes every needed quantity once and adds it to all of its targets.	*/
+/*	With no basin, hillslope or patch output the patches are not visited.	*/
+/*											*/
+/*	Hillslopes are done in parallel; basin sums are kept per hillslope and	*/
+/*	added to the basin in hillslope order afterwards.  Patch accumulators	*/
+/*	that are not running sums (maxima, thresholds, water year days) are	*/
+/*	updated in update_patch_accumulator_extras.				*/
+/*											*/
+/*	PROGRAMMER NOTES								*/
+/*											*/
+/*	top_model (-t) still adds its own basin sums.				*/
+/*											*/
+/*--------------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include "rhessys.h"
+
+/*--------------------------------------------------------------*/
+/*	daily quantities; patch quantities come first, then	*/
+/*	the hillslope quantities summed to the basin		*/
+/*--------------------------------------------------------------*/
+enum accumulator_source {
+	ACC_ONE,
+	ACC_STREAMFLOW,
+	ACC_ET,
+	ACC_TRANS,
+	ACC_DENITRIF,
+	ACC_NITRIF,
+	ACC_MINERALIZED,
+	ACC_UPTAKE,
+	ACC_DON_ROUTED,
+	ACC_DOC_ROUTED,
+	ACC_DON_LOSS,
+	ACC_DOC_LOSS,
+	ACC_STREAM_NO3,
+	ACC_STREAM_NH4,
+	ACC_STREAM_DON,
+	ACC_STREAM_DOC,
+	ACC_PSN,
+	ACC_LAI,
+	ACC_LEACH,
+	ACC_PET,
+	ACC_SNOWPACK,
+	ACC_THETA,
+	ACC_SM_DEFICIT,
+	ACC_BURN,
+	ACC_QIN,
+	ACC_QOUT,
+	ACC_THROUGHFALL,
+	ACC_RECHARGE,
+	ACC_NUM_PATCH_SOURCES,
+	ACC_HILL_BASE_FLOW = ACC_NUM_PATCH_SOURCES,
+	ACC_HILL_STREAM_NO3,
+	ACC_HILL_STREAM_NH4,
+	ACC_HILL_STREAM_DON,
+	ACC_HILL_STREAM_DOC,
+	ACC_NUM_SOURCES
+};
+
+/* targets: level * 2 + period */
+#define	ACC_BASIN	0
+#define	ACC_HILLSLOPE	1
+#define	ACC_PATCH	2
+#define	ACC_MONTH	0
+#define	ACC_YEAR	1
+#define	ACC_NUM_TARGETS	6
+
+struct accumulator_entry
+{
+	int	source;
+	int	level;
+	int	period;
+	int	per_area;	/* 1: weighted by area / area of the level */
+	size_t	offset;		/* field of struct accumulate_patch_object */
+};
+
+#define	ACC_FIELD(f)	offsetof(struct accumulate_patch_object, f)
+
+static const struct accumulator_entry accumulator_registry[] = {
+	/* basin monthly */
+	{ACC_STREAMFLOW,	ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(streamflow)},
+	{ACC_ET,		ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(et)},
+	{ACC_DENITRIF,		ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(denitrif)},
+	{ACC_NITRIF,		ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(nitrif)},
+	{ACC_MINERALIZED,	ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(mineralized)},
+	{ACC_UPTAKE,		ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(uptake)},
+	{ACC_DON_ROUTED,	ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(DON_loss)},
+	{ACC_DOC_ROUTED,	ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(DOC_loss)},
+	{ACC_ONE,		ACC_BASIN,	ACC_MONTH,	0,	ACC_FIELD(length)},
+	{ACC_STREAM_NO3,	ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(stream_NO3)},
+	{ACC_STREAM_NH4,	ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(stream_NH4)},
+	{ACC_STREAM_DON,	ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(stream_DON)},
+	{ACC_STREAM_DOC,	ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(stream_DOC)},
+	{ACC_PSN,		ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(psn)},
+	{ACC_LAI,		ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(lai)},
+	{ACC_LEACH,		ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(leach)},
+	{ACC_HILL_BASE_FLOW,	ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(streamflow)},
+	{ACC_HILL_STREAM_NO3,	ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(stream_NO3)},
+	{ACC_HILL_STREAM_NH4,	ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(stream_NH4)},
+	{ACC_HILL_STREAM_DON,	ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(stream_DON)},
+	{ACC_HILL_STREAM_DOC,	ACC_BASIN,	ACC_MONTH,	1,	ACC_FIELD(stream_DOC)},
+	/* basin yearly */
+	{ACC_ONE,		ACC_BASIN,	ACC_YEAR,	0,	ACC_FIELD(length)},
+	{ACC_LEACH,		ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(leach)},
+	{ACC_STREAM_NH4,	ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(stream_NH4)},
+	{ACC_STREAM_NO3,	ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(stream_NO3)},
+	{ACC_DENITRIF,		ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(denitrif)},
+	{ACC_NITRIF,		ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(nitrif)},
+	{ACC_MINERALIZED,	ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(mineralized)},
+	{ACC_UPTAKE,		ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(uptake)},
+	{ACC_DON_ROUTED,	ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(DON_loss)},
+	{ACC_DOC_ROUTED,	ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(DOC_loss)},
+	{ACC_STREAM_DON,	ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(stream_DON)},
+	{ACC_STREAM_DOC,	ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(stream_DOC)},
+	{ACC_PSN,		ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(psn)},
+	{ACC_PET,		ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(PET)},
+	{ACC_ET,		ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(et)},
+	{ACC_STREAMFLOW,	ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(streamflow)},
+	{ACC_LAI,		ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(lai)},
+	{ACC_HILL_BASE_FLOW,	ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(streamflow)},
+	{ACC_HILL_STREAM_NO3,	ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(stream_NO3)},
+	{ACC_HILL_STREAM_NH4,	ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(stream_NH4)},
+	{ACC_HILL_STREAM_DON,	ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(stream_DON)},
+	{ACC_HILL_STREAM_DOC,	ACC_BASIN,	ACC_YEAR,	1,	ACC_FIELD(stream_DOC)},
+	/* hillslope monthly */
+	{ACC_SNOWPACK,		ACC_HILLSLOPE,	ACC_MONTH,	1,	ACC_FIELD(snowpack)},
+	{ACC_STREAMFLOW,	ACC_HILLSLOPE,	ACC_MONTH,	1,	ACC_FIELD(streamflow)},
+	{ACC_ET,		ACC_HILLSLOPE,	ACC_MONTH,	1,	ACC_FIELD(et)},
+	{ACC_DENITRIF,		ACC_HILLSLOPE,	ACC_MONTH,	1,	ACC_FIELD(denitrif)},
+	{ACC_NITRIF,		ACC_HILLSLOPE,	ACC_MONTH,	1,	ACC_FIELD(nitrif)},
+	{ACC_MINERALIZED,	ACC_HILLSLOPE,	ACC_MONTH,	1,	ACC_FIELD(mineralized)},
+	{ACC_UPTAKE,		ACC_HILLSLOPE,	ACC_MONTH,	1,	ACC_FIELD(uptake)},
+	{ACC_DOC_LOSS,		ACC_HILLSLOPE,	ACC_MONTH,	1,	ACC_FIELD(DOC_loss)},
+	{ACC_DON_LOSS,		ACC_HILLSLOPE,	ACC_MONTH,	1,	ACC_FIELD(DON_loss)},
+	{ACC_STREAM_NO3,	ACC_HILLSLOPE,	ACC_MONTH,	1,	ACC_FIELD(stream_NO3)},
+	{ACC_STREAM_NH4,	ACC_HILLSLOPE,	ACC_MONTH,	1,	ACC_FIELD(stream_NH4)},
+	{ACC_PSN,		ACC_HILLSLOPE,	ACC_MONTH,	1,	ACC_FIELD(psn)},
+	{ACC_LAI,		ACC_HILLSLOPE,	ACC_MONTH,	1,	ACC_FIELD(lai)},
+	/* hillslope yearly */
+	{ACC_ONE,		ACC_HILLSLOPE,	ACC_YEAR,	0,	ACC_FIELD(length)},
+	{ACC_STREAM_NO3,	ACC_HILLSLOPE,	ACC_YEAR,	1,	ACC_FIELD(stream_NO3)},
+	{ACC_STREAM_NH4,	ACC_HILLSLOPE,	ACC_YEAR,	1,	ACC_FIELD(stream_NH4)},
+	{ACC_DENITRIF,		ACC_HILLSLOPE,	ACC_YEAR,	1,	ACC_FIELD(denitrif)},
+	{ACC_NITRIF,		ACC_HILLSLOPE,	ACC_YEAR,	1,	ACC_FIELD(nitrif)},
+	{ACC_MINERALIZED,	ACC_HILLSLOPE,	ACC_YEAR,	1,	ACC_FIELD(mineralized)},
+	{ACC_UPTAKE,		ACC_HILLSLOPE,	ACC_YEAR,	1,	ACC_FIELD(uptake)},
+	{ACC_DOC_LOSS,		ACC_HILLSLOPE,	ACC_YEAR,	1,	ACC_FIELD(DOC_loss)},
+	{ACC_DON_LOSS,		ACC_HILLSLOPE,	ACC_YEAR,	1,	ACC_FIELD(DON_loss)},
+	{ACC_PSN,		ACC_HILLSLOPE,	ACC_YEAR,	1,	ACC_FIELD(psn)},
+	{ACC_ET,		ACC_HILLSLOPE,	ACC_YEAR,	1,	ACC_FIELD(et)},
+	{ACC_STREAMFLOW,	ACC_HILLSLOPE,	ACC_YEAR,	1,	ACC_FIELD(streamflow)},
+	{ACC_LAI,		ACC_HILLSLOPE,	ACC_YEAR,	1,	ACC_FIELD(lai)},
+	/* patch monthly */
+	{ACC_THETA,		ACC_PATCH,	ACC_MONTH,	0,	ACC_FIELD(theta)},
+	{ACC_SM_DEFICIT,	ACC_PATCH,	ACC_MONTH,	0,	ACC_FIELD(sm_deficit)},
+	{ACC_ET,		ACC_PATCH,	ACC_MONTH,	0,	ACC_FIELD(et)},
+	{ACC_DENITRIF,		ACC_PATCH,	ACC_MONTH,	0,	ACC_FIELD(denitrif)},
+	{ACC_NITRIF,		ACC_PATCH,	ACC_MONTH,	0,	ACC_FIELD(nitrif)},
+	{ACC_MINERALIZED,	ACC_PATCH,	ACC_MONTH,	0,	ACC_FIELD(mineralized)},
+	{ACC_UPTAKE,		ACC_PATCH,	ACC_MONTH,	0,	ACC_FIELD(uptake)},
+	{ACC_DON_ROUTED,	ACC_PATCH,	ACC_MONTH,	0,	ACC_FIELD(DON_loss)},
+	{ACC_DOC_ROUTED,	ACC_PATCH,	ACC_MONTH,	0,	ACC_FIELD(DOC_loss)},
+	{ACC_PSN,		ACC_PATCH,	ACC_MONTH,	0,	ACC_FIELD(psn)},
+	{ACC_LEACH,		ACC_PATCH,	ACC_MONTH,	0,	ACC_FIELD(leach)},
+	{ACC_BURN,		ACC_PATCH,	ACC_MONTH,	0,	ACC_FIELD(burn)},
+	{ACC_ONE,		ACC_PATCH,	ACC_MONTH,	0,	ACC_FIELD(length)},
+	/* patch yearly */
+	{ACC_ONE,		ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(length)},
+	{ACC_THETA,		ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(theta)},
+	{ACC_DENITRIF,		ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(denitrif)},
+	{ACC_NITRIF,		ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(nitrif)},
+	{ACC_MINERALIZED,	ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(mineralized)},
+	{ACC_UPTAKE,		ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(uptake)},
+	{ACC_LEACH,		ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(leach)},
+	{ACC_DON_ROUTED,	ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(DON_loss)},
+	{ACC_DOC_ROUTED,	ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(DOC_loss)},
+	{ACC_STREAMFLOW,	ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(streamflow)},
+	{ACC_QOUT,		ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(Qout_total)},
+	{ACC_QIN,		ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(Qin_total)},
+	{ACC_PSN,		ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(psn)},
+	{ACC_PET,		ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(PET)},
+	{ACC_BURN,		ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(burn)},
+	{ACC_THROUGHFALL,	ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(potential_recharge)},
+	{ACC_RECHARGE,		ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(recharge)},
+	{ACC_ET,		ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(et)},
+	{ACC_TRANS,		ACC_PATCH,	ACC_YEAR,	0,	ACC_FIELD(trans)}
+};
+
+#define	ACC_NUM_ENTRIES	(sizeof(accumulator_registry) / sizeof(struct accumulator_entry))
+
+#define	ACC_TARGET(acc, offset)	(*(double *)((char *)(acc) + (offset)))
+
+/*--------------------------------------------------------------*/
+/*	daily value of a patch quantity				*/
+/*--------------------------------------------------------------*/
+static double patch_source(struct patch_object *patch, int source)
+{
+	switch (source) {
+	case ACC_ONE:		return(1.0);
+	case ACC_STREAMFLOW:	return(patch[0].streamflow);
+	case ACC_ET:		return(patch[0].evaporation
+					+ patch[0].evaporation_surf
+					+ patch[0].exfiltration_unsat_zone
+					+ patch[0].exfiltration_sat_zone
+					+ patch[0].transpiration_unsat_zone
+					+ patch[0].transpiration_sat_zone);
+	case ACC_TRANS:		return(patch[0].transpiration_unsat_zone
+					+ patch[0].transpiration_sat_zone);
+	case ACC_DENITRIF:	return(patch[0].ndf.denitrif);
+	case ACC_NITRIF:	return(patch[0].ndf.sminn_to_nitrate);
+	case ACC_MINERALIZED:	return(patch[0].ndf.net_mineralized);
+	case ACC_UPTAKE:	return(patch[0].ndf.sminn_to_npool);
+	case ACC_DON_ROUTED:	return(patch[0].soil_ns.DON_Qout_total
+					- patch[0].soil_ns.DON_Qin_total);
+	case ACC_DOC_ROUTED:	return(patch[0].soil_cs.DOC_Qout_total
+					- patch[0].soil_cs.DOC_Qin_total);
+	case ACC_DON_LOSS:	return(patch[0].ndf.total_DON_loss);
+	case ACC_DOC_LOSS:	return(patch[0].cdf.total_DOC_loss);
+	case ACC_STREAM_NO3:	return(patch[0].streamflow_NO3);
+	case ACC_STREAM_NH4:	return(patch[0].streamflow_NH4);
+	case ACC_STREAM_DON:	return(patch[0].streamflow_DON);
+	case ACC_STREAM_DOC:	return(patch[0].streamflow_DOC);
+	case ACC_PSN:		return(patch[0].net_plant_psn);
+	case ACC_LAI:		return(patch[0].lai);
+	case ACC_LEACH:		return(patch[0].soil_ns.leach + patch[0].surface_ns_leach);
+	case ACC_PET:		return(patch[0].PE + patch[0].PET);
+	case ACC_SNOWPACK:	return(patch[0].snowpack.water_equivalent_depth);
+	case ACC_THETA:		return(patch[0].rootzone.S);
+	case ACC_SM_DEFICIT:	return(max(0.0, patch[0].sat_deficit
+					- patch[0].rz_storage - patch[0].unsat_storage));
+	case ACC_BURN:		return(patch[0].burn);
+	case ACC_QIN:		return(patch[0].Qin_total);
+	case ACC_QOUT:		return(patch[0].Qout_total);
+	case ACC_THROUGHFALL:	return(patch[0].rain_throughfall);
+	case ACC_RECHARGE:	return(patch[0].recharge);
+	}
+	return(0.0);
+}
+
+/*--------------------------------------------------------------*/
+/*	daily value of a hillslope quantity			*/
+/*--------------------------------------------------------------*/
+static double hillslope_source(struct hillslope_object *hillslope, int source)
+{
+	switch (source) {
+	case ACC_HILL_BASE_FLOW:	return(hillslope[0].base_flow);
+	case ACC_HILL_STREAM_NO3:	return(hillslope[0].streamflow_NO3);
+	case ACC_HILL_STREAM_NH4:	return(hillslope[0].streamflow_NH4);
+	case ACC_HILL_STREAM_DON:	return(hillslope[0].streamflow_DON);
+	case ACC_HILL_STREAM_DOC:	return(hillslope[0].streamflow_DOC);
+	}
+	return(0.0);
+}
+
+/*--------------------------------------------------------------*/
+/*	patch accumulators that are not running sums; run after	*/
+/*	the registry so that acc_year.length includes today	*/
+/*--------------------------------------------------------------*/
+static void update_patch_accumulator_extras(
+			struct command_line_object 	*command_line,
+			struct patch_object 		*patch,
+			struct date		 	current_date)
+{
+	double tmp;
+
+	if (command_line[0].output_flags.monthly == 1) {
+		patch[0].acc_month.snowpack =
+				max(patch[0].snowpack.water_equivalent_depth, patch[0].acc_month.snowpack);
+		patch[0].acc_month.lai =
+				max(patch[0].acc_month.lai, patch[0].lai);
+	}
+	if (command_line[0].output_flags.yearly == 1) {
+		if ((patch[0].sat_deficit - patch[0].unsat_storage)
+				> command_line[0].thresholds[SATDEF])
+			patch[0].acc_year.num_threshold += 1;
+		patch[0].acc_year.potential_recharge_wyd +=
+				patch[0].rain_throughfall
+						* round(patch[0].acc_year.length);
+		patch[0].acc_year.recharge_wyd += patch[0].recharge
+				* round(patch[0].acc_year.length);
+
+		if ((patch[0].snowpack.water_equivalent_depth == 0)
+				&& (patch[0].acc_year.snowpack > 0)) {
+			if (patch[0].acc_year.meltday
+					< patch[0].acc_year.peaksweday)
+				patch[0].acc_year.meltday = round(
+						patch[0].acc_year.length);
+		}
+
+		if (patch[0].snowpack.water_equivalent_depth
+				> patch[0].acc_year.snowpack) {
+			patch[0].acc_year.peaksweday = round(
+					patch[0].acc_year.length);
+		}
+
+		patch[0].acc_year.snowpack =
+				max(patch[0].snowpack.water_equivalent_depth,
+						patch[0].acc_year.snowpack);
+
+		/* transpiration water stress computations */
+		tmp = (patch[0].transpiration_unsat_zone
+				+ patch[0].transpiration_sat_zone);
+		patch[0].acc_year.day7trans = (tmp / 14
+				+ 13 / 14 * patch[0].acc_year.day7trans);
+		patch[0].acc_year.day7pet = (patch[0].PET + patch[0].PE)
+				/ 14 + 13 / 14 * patch[0].acc_year.day7pet;
+		if (patch[0].acc_year.day7pet > patch[0].acc_year.maxpet) {
+			patch[0].acc_year.maxpet = patch[0].acc_year.day7pet;
+			patch[0].acc_year.rec_pet_wyd = 0;
+			patch[0].acc_year.max_pet_wyd = patch[0].acc_year.wyd;
+		}
+
+		if ((patch[0].acc_year.day7trans
+				> patch[0].acc_year.maxtrans)) {
+			patch[0].acc_year.maxtrans =
+					patch[0].acc_year.day7trans;
+			patch[0].acc_year.rec_wyd = 0;
+		}
+
+		if ((patch[0].acc_year.rec_wyd == 0)
+				&& (patch[0].acc_year.day7trans
+						< patch[0].acc_year.maxtrans * 0.5)) {
+			patch[0].acc_year.rec_wyd = patch[0].acc_year.wyd;
+		}
+
+		if ((patch[0].acc_year.rec_pet_wyd == 0)
+				&& (patch[0].acc_year.day7pet
+						< patch[0].acc_year.maxpet * 0.5)) {
+			patch[0].acc_year.rec_pet_wyd = patch[0].acc_year.wyd;
+		}
+
+		tmp = (patch[0].transpiration_unsat_zone
+				+ patch[0].exfiltration_unsat_zone
+				+ patch[0].exfiltration_sat_zone
+				+ patch[0].evaporation_surf
+				+ patch[0].transpiration_sat_zone
+				+ patch[0].evaporation);
+
+		if (patch[0].lai > patch[0].acc_year.lai) {
+			patch[0].acc_year.peaklaiday = round(
+					patch[0].acc_year.length);
+		}
+
+		if ((patch[0].PET + patch[0].PE - tmp)
+				> patch[0].acc_year.sm_deficit)
+			patch[0].acc_year.sm_deficit = (patch[0].PET
+					+ patch[0].PE - tmp);
+		patch[0].acc_year.lai =
+				max(patch[0].acc_year.lai, patch[0].lai);
+
+		tmp = patch[0].sat_deficit - patch[0].unsat_storage
+				- patch[0].rz_storage;
+		if (tmp <= 0)
+			patch[0].acc_year.ndays_sat += 1;
+
+		if (patch[0].rootzone.S > 0.7)
+			patch[0].acc_year.ndays_sat70 += 1;
+
+		tmp =
+				max(0.0, (patch[0].rootzone.field_capacity/patch[0].rootzone.potential_sat -
+								patch[0].wilting_point*patch[0].soil_defaults[0][0].porosity_0))
+						/ 2.0
+						+ patch[0].wilting_point
+								* patch[0].soil_defaults[0][0].porosity_0;
+
+		if ((patch[0].rootzone.S < tmp) && (current_date.month < 10)
+				&& (patch[0].acc_year.midsm_wyd == 0)
+				&& (patch[0].snowpack.water_equivalent_depth <= 0.0))
+			patch[0].acc_year.midsm_wyd = patch[0].acc_year.wyd;
+
+		patch[0].acc_year.wyd = patch[0].acc_year.wyd + 1;
+	}
+	return;
+}
+
+void update_accumulators(
+			struct command_line_object 	*command_line,
+			struct basin_object 		*basin,
+			struct date		 	current_date)
+{
+	/*----------------------------------------------------------------------*/
+	/* Local variables definition                                           */
+	/*-----------------------------------------------------------------------*/
+	struct accumulator_entry active[ACC_NUM_ENTRIES];
+	struct accumulator_entry basin_active[ACC_NUM_ENTRIES];
+	struct accumulate_patch_object *basin_partial;
+	int enabled[ACC_NUM_TARGETS];
+	int num_active, num_patch_active, num_basin_active, i, j, h, patch_flag, walk_flag;
+	size_t e;
+
+	/*----------------------------------------------------------------------*/
+	/* entries whose level and period have output, patch quantities first	*/
+	/*----------------------------------------------------------------------*/
+	for (i = 0; i < 2; i++) {
+		enabled[ACC_BASIN * 2 + i] = (command_line[0].b != NULL);
+		enabled[ACC_HILLSLOPE * 2 + i] = (command_line[0].h != NULL);
+		enabled[ACC_PATCH * 2 + i] = (command_line[0].p != NULL);
+	}
+	for (i = 0; i < 3; i++) {
+		enabled[i * 2 + ACC_MONTH] = enabled[i * 2 + ACC_MONTH]
+			&& (command_line[0].output_flags.monthly == 1);
+		enabled[i * 2 + ACC_YEAR] = enabled[i * 2 + ACC_YEAR]
+			&& (command_line[0].output_flags.yearly == 1);
+	}
+	num_active = 0;
+	for (e = 0; e < ACC_NUM_ENTRIES; e++)
+		if (enabled[accumulator_registry[e].level * 2 + accumulator_registry[e].period]
+			&& (accumulator_registry[e].source < ACC_NUM_PATCH_SOURCES))
+			active[num_active++] = accumulator_registry[e];
+	num_patch_active = num_active;
+	for (e = 0; e < ACC_NUM_ENTRIES; e++)
+		if (enabled[accumulator_registry[e].level * 2 + accumulator_registry[e].period]
+			&& (accumulator_registry[e].source >= ACC_NUM_PATCH_SOURCES))
+			active[num_active++] = accumulator_registry[e];
+
+	/* acc_year_trans is read by the daily basin output */
+	patch_flag = enabled[ACC_PATCH * 2 + ACC_MONTH] || enabled[ACC_PATCH * 2 + ACC_YEAR];
+	walk_flag = (num_active > 0) || (command_line[0].b != NULL);
+	if (!walk_flag)
+		return;
+
+	basin_partial = (struct accumulate_patch_object *) calloc(
+		2 * max(basin[0].num_hillslopes, 1), sizeof(struct accumulate_patch_object));
+	if (basin_partial == NULL) {
+		fprintf(stderr, "FATAL ERROR: out of memory in update_accumulators\n");
+		exit(EXIT_FAILURE);
+	}
+
+	/*----------------------------------------------------------------------*/
+	/* one pass over the patches of each hillslope				*/
+	/*----------------------------------------------------------------------*/
+	#pragma omp parallel for private(e)
+	for (h = 0; h < basin[0].num_hillslopes; h++) {
+		struct hillslope_object *hillslope = basin[0].hillslopes[h];
+		struct accumulate_patch_object *acc[ACC_NUM_TARGETS];
+		double scale[3], src[ACC_NUM_SOURCES];
+		int need[ACC_NUM_SOURCES];
+		int s, z, p, n;
+
+		for (s = 0; s < ACC_NUM_SOURCES; s++)
+			need[s] = 0;
+		for (n = 0; n < num_active; n++)
+			need[active[n].source] = 1;
+
+		acc[ACC_BASIN * 2 + ACC_MONTH] = &(basin_partial[2 * h]);
+		acc[ACC_BASIN * 2 + ACC_YEAR] = &(basin_partial[2 * h + 1]);
+		acc[ACC_HILLSLOPE * 2 + ACC_MONTH] = &(hillslope[0].acc_month);
+		acc[ACC_HILLSLOPE * 2 + ACC_YEAR] = &(hillslope[0].acc_year);
+		hillslope[0].acc_month.length += 1;
+
+		for (z = 0; z < hillslope[0].num_zones; z++) {
+			for (p = 0; p < hillslope[0].zones[z][0].num_patches; p++) {
+				struct patch_object *patch = hillslope[0].zones[z][0].patches[p];
+
+				patch[0].acc_year_trans += (patch[0].transpiration_unsat_zone
+						+ patch[0].transpiration_sat_zone);
+
+				for (s = 0; s < ACC_NUM_PATCH_SOURCES; s++)
+					if (need[s])
+						src[s] = patch_source(patch, s);
+				scale[ACC_BASIN] = patch[0].area / basin[0].area;
+				scale[ACC_HILLSLOPE] = patch[0].area / hillslope[0].area;
+				scale[ACC_PATCH] = 1.0;
+				acc[ACC_PATCH * 2 + ACC_MONTH] = &(patch[0].acc_month);
+				acc[ACC_PATCH * 2 + ACC_YEAR] = &(patch[0].acc_year);
+
+				for (n = 0; n < num_patch_active; n++)
+					ACC_TARGET(acc[active[n].level * 2 + active[n].period], active[n].offset)
+						+= active[n].per_area ? src[active[n].source] * scale[active[n].level]
+						: src[active[n].source];
+
+				if (patch_flag)
+					update_patch_accumulator_extras(command_line, patch, current_date);
+			} /* end of p */
+		} /* end of z */
+
+		/* hillslope quantities summed to the basin */
+		scale[ACC_BASIN] = hillslope[0].area / basin[0].area;
+		for (n = num_patch_active; n < num_active; n++)
+			ACC_TARGET(acc[active[n].level * 2 + active[n].period], active[n].offset)
+				+= hillslope_source(hillslope, active[n].source) * scale[ACC_BASIN];
+	} /* end of h */
+
+	/*----------------------------------------------------------------------*/
+	/* basin sums in hillslope order; patch and hillslope sources can	*/
+	/* share a basin field (e.g. streamflow), so each field is added once	*/
+	/*----------------------------------------------------------------------*/
+	num_basin_active = 0;
+	for (i = 0; i < num_active; i++) {
+		if (active[i].level != ACC_BASIN)
+			continue;
+		for (j = 0; j < num_basin_active; j++)
+			if ((basin_active[j].period == active[i].period)
+				&& (basin_active[j].offset == active[i].offset))
+				break;
+		if (j == num_basin_active)
+			basin_active[num_basin_active++] = active[i];
+	}
+	for (h = 0; h < basin[0].num_hillslopes; h++) {
+		for (i = 0; i < num_basin_active; i++) {
+			if (basin_active[i].period == ACC_MONTH)
+				ACC_TARGET(&(basin[0].acc_month), basin_active[i].offset)
+					+= ACC_TARGET(&(basin_partial[2 * h]), basin_active[i].offset);
+			else
+				ACC_TARGET(&(basin[0].acc_year), basin_active[i].offset)
+					+= ACC_TARGET(&(basin_partial[2 * h + 1]), basin_active[i].offset);
+		}
+	}
+	free(basin_partial);
+	return;
+} /* end of update_accumulators.c */
@@ -10,16 +10,24 @@
 /*	SYNOPSIS									*/
 /*	void update_drainage_land( 							*/
 /*					struct patch_object *patch			*/
+/*					struct neighbour_table_object *table		*/
+/*							int,				*/
 /*				 			double,			 	*/
 /*				 			double,			 	*/
 /*				 			double,			 	*/
 /*							int,				*/
 /*							int)				*/
-/*											*/
-/* 											*/
+/*	void gather_drainage_land(							*/
+/*					struct neighbour_table_object *table		*/
+/*					struct command_line_object *command_line	*/
+/*							double,				*/
+/*							int)				*/
 /*											*/
 /*	OPTIONS										*/
-/*											*/
+/*	-pull										*/
+/*		update_drainage_land only keeps the outflow of the patch		*/
+/*		in the table; gather_drainage_land then moves it to the			*/
+/*		neighbours								*/
 /*											*/
 /*	DESCRIPTION									*/
 /*											*/
@@ -28,14 +36,189 @@
 /*											*/
 /*	PROGRAMMER NOTES								*/
 /*											*/
+/*	patch is entry route_index of the hillslope route list; its			*/
+/*	neighbours are read from the hillslope neighbour table, built			*/
+/*	by construct_neighbour_table from the innundation lists				*/
 /*											*/
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
 
+/*--------------------------------------------------------------*/
+/*	move gamma of the outflow of a patch into neigh; used by	*/
+/*	the push loops of update_drainage_land and by			*/
+/*	gather_drainage_land, so both add the same terms		*/
+/*--------------------------------------------------------------*/
+static double add_subsurface_inflow(
+					struct patch_object *neigh,
+					double gamma,
+					double *outflow,
+					struct command_line_object *command_line)
+{
+	double Qin, Nin;
+
+	/*--------------------------------------------------------------*/
+	/* first transfer subsurface water and nitrogen */
+	/*--------------------------------------------------------------*/
+	Qin =	(gamma * outflow[OUTFLOW_WATER]) / neigh[0].area;
+	if (command_line[0].grow_flag > 0) {
+		Nin = (gamma * outflow[OUTFLOW_DON]) 
+			/ neigh[0].area;
+		neigh[0].soil_ns.DON_Qin += Nin;
+		Nin = (gamma * outflow[OUTFLOW_DOC]) 
+			/ neigh[0].area;
+		neigh[0].soil_cs.DOC_Qin += Nin;
+		Nin = (gamma * outflow[OUTFLOW_NO3]) 
+			/ neigh[0].area;
+		neigh[0].soil_ns.NO3_Qin += Nin;
+		Nin = (gamma * outflow[OUTFLOW_NH4]) 
+			/ neigh[0].area;
+		neigh[0].soil_ns.NH4_Qin += Nin;
+		}
+	neigh[0].Qin += Qin;
+	return(Qin);
+} /*end add_subsurface_inflow*/
+
+static void add_surface_inflow(
+					struct patch_object *neigh,
+					double gamma,
+					double *outflow,
+					struct command_line_object *command_line,
+					double time_int,
+					int verbose_flag)
+{
+	double compute_infiltration( int,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double);
+
+	double Qin, Nin;
+	double infiltration; /* m */
+
+	/*--------------------------------------------------------------*/
+	/* now transfer surface water and nitrogen */
+	/*	- first nitrogen					*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].grow_flag > 0) {
+		Nin = (gamma * outflow[OUTFLOW_SURFACE_NO3]) / neigh[0].area;
+		neigh[0].surface_NO3 += Nin;
+		if (neigh[0].drainage_type == STREAM)
+			neigh[0].streamNO3_from_surface += Nin;
+		Nin = (gamma * outflow[OUTFLOW_SURFACE_NH4]) / neigh[0].area;
+		neigh[0].surface_NH4 += Nin;
+		Nin = (gamma * outflow[OUTFLOW_SURFACE_DON]) / neigh[0].area;
+		neigh[0].surface_DON += Nin;
+		Nin = (gamma * outflow[OUTFLOW_SURFACE_DOC]) / neigh[0].area;
+		neigh[0].surface_DOC += Nin;
+		}
+	
+	/*--------------------------------------------------------------*/
+	/*	- now surface water 					*/
+	/*	surface stores should be updated to facilitate transfer */
+	/* added net surface water transfer to detention store		*/
+	/*--------------------------------------------------------------*/
+
+	Qin = (gamma * outflow[OUTFLOW_SURFACE_WATER]) / neigh[0].area;
+	neigh[0].detention_store += Qin;// need fix this
+	neigh[0].surface_Qin += Qin;
+	
+	/*--------------------------------------------------------------*/
+	/* try to infiltrate this water					*/ 
+	/* use time_int as duration */
+	/*--------------------------------------------------------------*/
+	if (neigh[0].detention_store > ZERO) {
+		if (neigh[0].rootzone.depth > ZERO) {
+		infiltration = compute_infiltration(
+			verbose_flag,
+			neigh[0].sat_deficit_z,
+			neigh[0].rootzone.S,
+			neigh[0].Ksat_vertical,
+			neigh[0].soil_defaults[0][0].Ksat_0_v,
+			neigh[0].soil_defaults[0][0].mz_v,
+			neigh[0].soil_defaults[0][0].porosity_0,
+			neigh[0].soil_defaults[0][0].porosity_decay,
+			(neigh[0].detention_store),	
+			time_int,
+			neigh[0].soil_defaults[0][0].psi_air_entry);
+		}
+		else {
+		infiltration = compute_infiltration(
+			verbose_flag,
+			neigh[0].sat_deficit_z,
+			neigh[0].S,
+			neigh[0].Ksat_vertical,
+			neigh[0].soil_defaults[0][0].Ksat_0_v,
+			neigh[0].soil_defaults[0][0].mz_v,
+			neigh[0].soil_defaults[0][0].porosity_0,
+			neigh[0].soil_defaults[0][0].porosity_decay,
+			(neigh[0].detention_store),	
+			time_int,
+			neigh[0].soil_defaults[0][0].psi_air_entry);
+		}
+	}
+	else infiltration = 0.0;
+	/*--------------------------------------------------------------*/
+	/* added an surface N flux to surface N pool	and		*/
+	/* allow infiltration of surface N				*/
+	/*--------------------------------------------------------------*/
+	if ((command_line[0].grow_flag > 0 ) && (infiltration > ZERO)) {
+		neigh[0].soil_cs.DOC_Qin += ((infiltration / neigh[0].detention_store) * neigh[0].surface_DOC);
+		neigh[0].surface_DOC -= ((infiltration / neigh[0].detention_store) * neigh[0].surface_DOC);
+		neigh[0].soil_ns.DON_Qin += ((infiltration / neigh[0].detention_store) * neigh[0].surface_DON);
+		neigh[0].surface_DON -= ((infiltration / neigh[0].detention_store) * neigh[0].surface_DON);
+		neigh[0].soil_ns.NO3_Qin += ((infiltration / neigh[0].detention_store) * neigh[0].surface_NO3);
+		neigh[0].surface_NO3 -= ((infiltration / neigh[0].detention_store) * neigh[0].surface_NO3);
+		neigh[0].soil_ns.NH4_Qin += ((infiltration / neigh[0].detention_store) * neigh[0].surface_NH4);
+		neigh[0].surface_NH4 -= ((infiltration / neigh[0].detention_store) * neigh[0].surface_NH4);
+	}
+
+	if (infiltration > neigh[0].sat_deficit - neigh[0].unsat_storage - neigh[0].rz_storage) {
+		neigh[0].sat_deficit -= (infiltration + neigh[0].unsat_storage + neigh[0].rz_storage);
+		neigh[0].unsat_storage = 0.0; 
+		neigh[0].rz_storage = 0.0; 
+		neigh[0].field_capacity = 0.0; 
+		neigh[0].rootzone.field_capacity = 0.0; 
+	}
+
+	else if ((neigh[0].sat_deficit > neigh[0].rootzone.potential_sat) &&
+		(infiltration > neigh[0].rootzone.potential_sat - neigh[0].rz_storage)) {
+	/*------------------------------------------------------------------------------*/
+	/*		Just add the infiltration to the rz_storage and unsat_storage	*/
+	/*------------------------------------------------------------------------------*/
+		neigh[0].unsat_storage += infiltration - (neigh[0].rootzone.potential_sat - neigh[0].rz_storage);
+		neigh[0].rz_storage = neigh[0].rootzone.potential_sat;
+	}								
+	/* Only rootzone layer saturated - perched water table case */
+	else if ((neigh[0].sat_deficit > neigh[0].rootzone.potential_sat) &&
+		(infiltration <= neigh[0].rootzone.potential_sat - neigh[0].rz_storage)) {
+		/*--------------------------------------------------------------*/
+		/*		Just add the infiltration to the rz_storage	*/
+		/*--------------------------------------------------------------*/
+		neigh[0].rz_storage += infiltration;
+	}
+	else if ((neigh[0].sat_deficit <= neigh[0].rootzone.potential_sat) &&
+		(infiltration <= neigh[0].sat_deficit - neigh[0].rz_storage - neigh[0].unsat_storage)) {
+		neigh[0].rz_storage += neigh[0].unsat_storage;		
+		/* transfer left water in unsat storage to rootzone layer */
+		neigh[0].unsat_storage = 0;
+		neigh[0].rz_storage += infiltration;
+		neigh[0].field_capacity = 0;
+	}
+
+	neigh[0].detention_store -= infiltration;
+} /*end add_surface_inflow*/
 
 void  update_drainage_land(
 					struct patch_object *patch,
+					 struct neighbour_table_object *table,
+					 int route_index,
 					 struct command_line_object *command_line,
 					 double time_int,
 					 int verbose_flag)
@@ -87,23 +270,11 @@ void  update_drainage_land(
 		struct patch_object *,
 		double);
 
-
-	double compute_infiltration( int,
-		double,
-		double,
-		double,
-		double,
-		double,
-		double,
-		double,
-		double,
-		double,
-		double);
-	
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.				*/
 	/*--------------------------------------------------------------*/
 	int j, d, idx;
+	int r, hi, mid;
 	double tmp;
 	double m, Ksat, std_scale;
 	double NH4_leached_to_patch, NH4_leached_to_stream;
@@ -121,12 +292,12 @@ void  update_drainage_land(
 	double return_flow,route_to_patch ;  /* m3 */
 	double available_sat_water; /* m3 */
 	double Qin, Qout;  /* m */
-	double innundation_depth, infiltration; /* m */
+	double innundation_depth; /* m */
 	double total_gamma;
-	double Nin, Nout; /* kg/m2 */ 
+	double Nout; /* kg/m2 */ 
+	double *outflow;
 	double t1,t2,t3;
 
-	struct patch_object *neigh;
 	route_to_patch = 0.0;
 	route_to_surface = 0.0;
 	return_flow=0.0;
@@ -151,6 +322,7 @@ void  update_drainage_land(
 	m = patch[0].m ;
 	Ksat = patch[0].soil_defaults[0][0].Ksat_0 ;
 	d=0;
+	r = table[0].first_row[route_index];
 
 	/*--------------------------------------------------------------*/
 	/*	recalculate gamma based on current saturation deficits  */
@@ -408,31 +580,6 @@ void  update_drainage_land(
 	/* regular downslope routing */
 	/*--------------------------------------------------------------*/
 	if (command_line[0].noredist_flag == 0) {
-	d=0;
-	for (j = 0; j < patch[0].innundation_list[d].num_neighbours; j++) {
-		neigh = patch[0].innundation_list[d].neighbours[j].patch;  
-		/*--------------------------------------------------------------*/
-		/* first transfer subsurface water and nitrogen */
-		/*--------------------------------------------------------------*/
-		Qin =	(patch[0].innundation_list[d].neighbours[j].gamma * route_to_patch) / neigh[0].area;
-		if (Qin < 0) printf("\n warning negative routing from patch %d with gamma %lf", patch[0].ID, total_gamma);
-		if (command_line[0].grow_flag > 0) {
-			Nin = (patch[0].innundation_list[d].neighbours[j].gamma * DON_leached_to_patch) 
-				/ neigh[0].area;
-			neigh[0].soil_ns.DON_Qin += Nin;
-			Nin = (patch[0].innundation_list[d].neighbours[j].gamma * DOC_leached_to_patch) 
-				/ neigh[0].area;
-			neigh[0].soil_cs.DOC_Qin += Nin;
-			Nin = (patch[0].innundation_list[d].neighbours[j].gamma * NO3_leached_to_patch) 
-				/ neigh[0].area;
-			neigh[0].soil_ns.NO3_Qin += Nin;
-			Nin = (patch[0].innundation_list[d].neighbours[j].gamma * NH4_leached_to_patch) 
-				/ neigh[0].area;
-			neigh[0].soil_ns.NH4_Qin += Nin;
-			}
-		neigh[0].Qin += Qin;
-	}
-
 	/*--------------------------------------------------------------*/
 	/* surface downslope routing */
 	/*--------------------------------------------------------------*/
@@ -442,128 +589,57 @@ void  update_drainage_land(
     if (patch[0].num_innundation_depths > 0) {
 		  innundation_depth = patch[0].detention_store + route_to_surface/patch[0].area; 
 		  d=0;
-		  while ((innundation_depth > patch[0].innundation_list[d].critical_depth) 
-			  && (d < patch[0].num_innundation_depths-1)) {
-			  d++;}
+		  if (table[0].sorted_depths[route_index] == 1) {
+			  hi = patch[0].num_innundation_depths-1;
+			  while (d < hi) {
+				  mid = (d + hi) / 2;
+				  if (innundation_depth > table[0].critical_depth[r+mid])
+					  d = mid+1;
+				  else
+					  hi = mid;
+				  }
+			  }
+		  else {
+			  while ((innundation_depth > table[0].critical_depth[r+d]) 
+				  && (d < patch[0].num_innundation_depths-1)) {
+				  d++;}
+			  }
 		}
 	else d=0;
-	for (j = 0; j < patch[0].surface_innundation_list[d].num_neighbours; j++) {
-
-		neigh = patch[0].surface_innundation_list[d].neighbours[j].patch;
-
-		/*--------------------------------------------------------------*/
-		/* now transfer surface water and nitrogen */
-		/*	- first nitrogen					*/
-		/*--------------------------------------------------------------*/
-		if (command_line[0].grow_flag > 0) {
-			Nin = (patch[0].surface_innundation_list[d].neighbours[j].gamma * NO3_leached_to_surface) / neigh[0].area;
-			neigh[0].surface_NO3 += Nin;
-			if (neigh[0].drainage_type == STREAM)
-				neigh[0].streamNO3_from_surface += Nin;
-			Nin = (patch[0].surface_innundation_list[d].neighbours[j].gamma * NH4_leached_to_surface) / neigh[0].area;
-			neigh[0].surface_NH4 += Nin;
-			Nin = (patch[0].surface_innundation_list[d].neighbours[j].gamma * DON_leached_to_surface) / neigh[0].area;
-			neigh[0].surface_DON += Nin;
-			Nin = (patch[0].surface_innundation_list[d].neighbours[j].gamma * DOC_leached_to_surface) / neigh[0].area;
-			neigh[0].surface_DOC += Nin;
-			}
-		
-		/*--------------------------------------------------------------*/
-		/*	- now surface water 					*/
-		/*	surface stores should be updated to facilitate transfer */
-		/* added net surface water transfer to detention store		*/
-		/*--------------------------------------------------------------*/
-
-		Qin = (patch[0].surface_innundation_list[d].neighbours[j].gamma * route_to_surface) / neigh[0].area;
-		neigh[0].detention_store += Qin;// need fix this
-		neigh[0].surface_Qin += Qin;
-		
-		/*--------------------------------------------------------------*/
-		/* try to infiltrate this water					*/ 
-		/* use time_int as duration */
-		/*--------------------------------------------------------------*/
-		if (neigh[0].detention_store > ZERO) {
-			if (neigh[0].rootzone.depth > ZERO) {
-			infiltration = compute_infiltration(
-				verbose_flag,
-				neigh[0].sat_deficit_z,
-				neigh[0].rootzone.S,
-				neigh[0].Ksat_vertical,
-				neigh[0].soil_defaults[0][0].Ksat_0_v,
-				neigh[0].soil_defaults[0][0].mz_v,
-				neigh[0].soil_defaults[0][0].porosity_0,
-				neigh[0].soil_defaults[0][0].porosity_decay,
-				(neigh[0].detention_store),	
-				time_int,
-				neigh[0].soil_defaults[0][0].psi_air_entry);
-			}
-			else {
-			infiltration = compute_infiltration(
-				verbose_flag,
-				neigh[0].sat_deficit_z,
-				neigh[0].S,
-				neigh[0].Ksat_vertical,
-				neigh[0].soil_defaults[0][0].Ksat_0_v,
-				neigh[0].soil_defaults[0][0].mz_v,
-				neigh[0].soil_defaults[0][0].porosity_0,
-				neigh[0].soil_defaults[0][0].porosity_decay,
-				(neigh[0].detention_store),	
-				time_int,
-				neigh[0].soil_defaults[0][0].psi_air_entry);
-			}
-		}
-		else infiltration = 0.0;
-		/*--------------------------------------------------------------*/
-		/* added an surface N flux to surface N pool	and		*/
-		/* allow infiltration of surface N				*/
-		/*--------------------------------------------------------------*/
-		if ((command_line[0].grow_flag > 0 ) && (infiltration > ZERO)) {
-			neigh[0].soil_cs.DOC_Qin += ((infiltration / neigh[0].detention_store) * neigh[0].surface_DOC);
-			neigh[0].surface_DOC -= ((infiltration / neigh[0].detention_store) * neigh[0].surface_DOC);
-			neigh[0].soil_ns.DON_Qin += ((infiltration / neigh[0].detention_store) * neigh[0].surface_DON);
-			neigh[0].surface_DON -= ((infiltration / neigh[0].detention_store) * neigh[0].surface_DON);
-			neigh[0].soil_ns.NO3_Qin += ((infiltration / neigh[0].detention_store) * neigh[0].surface_NO3);
-			neigh[0].surface_NO3 -= ((infiltration / neigh[0].detention_store) * neigh[0].surface_NO3);
-			neigh[0].soil_ns.NH4_Qin += ((infiltration / neigh[0].detention_store) * neigh[0].surface_NH4);
-			neigh[0].surface_NH4 -= ((infiltration / neigh[0].detention_store) * neigh[0].surface_NH4);
-		}
-
-		if (infiltration > neigh[0].sat_deficit - neigh[0].unsat_storage - neigh[0].rz_storage) {
-			neigh[0].sat_deficit -= (infiltration + neigh[0].unsat_storage + neigh[0].rz_storage);
-			neigh[0].unsat_storage = 0.0; 
-			neigh[0].rz_storage = 0.0; 
-			neigh[0].field_capacity = 0.0; 
-			neigh[0].rootzone.field_capacity = 0.0; 
-		}
-
-		else if ((neigh[0].sat_deficit > neigh[0].rootzone.potential_sat) &&
-			(infiltration > neigh[0].rootzone.potential_sat - neigh[0].rz_storage)) {
-		/*------------------------------------------------------------------------------*/
-		/*		Just add the infiltration to the rz_storage and unsat_storage	*/
-		/*------------------------------------------------------------------------------*/
-			neigh[0].unsat_storage += infiltration - (neigh[0].rootzone.potential_sat - neigh[0].rz_storage);
-			neigh[0].rz_storage = neigh[0].rootzone.potential_sat;
-		}								
-		/* Only rootzone layer saturated - perched water table case */
-		else if ((neigh[0].sat_deficit > neigh[0].rootzone.potential_sat) &&
-			(infiltration <= neigh[0].rootzone.potential_sat - neigh[0].rz_storage)) {
-			/*--------------------------------------------------------------*/
-			/*		Just add the infiltration to the rz_storage	*/
-			/*--------------------------------------------------------------*/
-			neigh[0].rz_storage += infiltration;
-		}
-		else if ((neigh[0].sat_deficit <= neigh[0].rootzone.potential_sat) &&
-			(infiltration <= neigh[0].sat_deficit - neigh[0].rz_storage - neigh[0].unsat_storage)) {
-			neigh[0].rz_storage += neigh[0].unsat_storage;		
-			/* transfer left water in unsat storage to rootzone layer */
-			neigh[0].unsat_storage = 0;
-			neigh[0].rz_storage += infiltration;
-			neigh[0].field_capacity = 0;
-		}
-
-		neigh[0].detention_store -= infiltration;
+	/*--------------------------------------------------------------*/
+	/*	keep the outflow in the neighbour table; with -pull the	*/
+	/*	receiving patches take it in gather_drainage_land	*/
+	/*--------------------------------------------------------------*/
+	outflow = &(table[0].outflow[route_index * NEIGHBOUR_NUM_FLUXES]);
+	outflow[OUTFLOW_WATER] = route_to_patch;
+	outflow[OUTFLOW_DON] = DON_leached_to_patch;
+	outflow[OUTFLOW_DOC] = DOC_leached_to_patch;
+	outflow[OUTFLOW_NO3] = NO3_leached_to_patch;
+	outflow[OUTFLOW_NH4] = NH4_leached_to_patch;
+	outflow[OUTFLOW_SURFACE_WATER] = route_to_surface;
+	outflow[OUTFLOW_SURFACE_DON] = DON_leached_to_surface;
+	outflow[OUTFLOW_SURFACE_DOC] = DOC_leached_to_surface;
+	outflow[OUTFLOW_SURFACE_NO3] = NO3_leached_to_surface;
+	outflow[OUTFLOW_SURFACE_NH4] = NH4_leached_to_surface;
+	table[0].surface_row[route_index] = r + d;
+	if (command_line[0].pull_flag == 1)
+		return;
 
+	/*--------------------------------------------------------------*/
+	/* first transfer subsurface water and nitrogen */
+	/*--------------------------------------------------------------*/
+	for (j = table[0].start[r]; j < table[0].start[r+1]; j++) {
+		Qin = add_subsurface_inflow(table[0].target_patch[table[0].target[j]],
+			table[0].gamma[j], outflow, command_line);
+		if (Qin < 0) printf("\n warning negative routing from patch %d with gamma %lf", patch[0].ID, total_gamma);
 	}
+	/*--------------------------------------------------------------*/
+	/* then surface water and nitrogen */
+	/*--------------------------------------------------------------*/
+	for (j = table[0].surface_start[r+d]; j < table[0].surface_start[r+d+1]; j++)
+		add_surface_inflow(table[0].target_patch[table[0].surface_target[j]],
+			table[0].surface_gamma[j], outflow, command_line,
+			time_int, verbose_flag);
 
 	} /* end if redistribution flag */
 
@@ -571,3 +647,54 @@ void  update_drainage_land(
 
 } /*end update_drainage_land.c*/
 
+/*--------------------------------------------------------------*/
+/*	-pull routing: once update_drainage_land has run for	*/
+/*	every patch of the hillslope, each receiving patch adds	*/
+/*	the outflows of its sources.  A patch is only changed by	*/
+/*	its own pass, so the patches can run in parallel; each	*/
+/*	takes its inflows in route list order of the sources,	*/
+/*	subsurface before surface, as the push loops do.	*/
+/*--------------------------------------------------------------*/
+void  gather_drainage_land(
+					 struct neighbour_table_object *table,
+					 struct command_line_object *command_line,
+					 double time_int,
+					 int verbose_flag)
+{
+	int t, k, ks, i, j;
+	struct patch_object *patch;
+
+	if ((table == NULL) || (command_line[0].noredist_flag == 1))
+		return;
+
+	#pragma omp parallel for private(k, ks, i, j, patch) schedule(dynamic)
+	for (t = 0; t < table[0].num_targets; t++) {
+		patch = table[0].target_patch[t];
+		k = table[0].inflow_start[t];
+		ks = table[0].surface_inflow_start[t];
+		while ((k < table[0].inflow_start[t+1])
+			|| (ks < table[0].surface_inflow_start[t+1])) {
+			if ((ks == table[0].surface_inflow_start[t+1])
+				|| ((k < table[0].inflow_start[t+1])
+				&& (table[0].inflow_source[k] <= table[0].surface_inflow_source[ks]))) {
+				i = table[0].inflow_source[k];
+				j = table[0].inflow_entry[k];
+				k++;
+				if (table[0].surface_row[i] < 0)
+					continue;
+				add_subsurface_inflow(patch, table[0].gamma[j],
+					&(table[0].outflow[i * NEIGHBOUR_NUM_FLUXES]), command_line);
+			}
+			else {
+				i = table[0].surface_inflow_source[ks];
+				j = table[0].surface_inflow_entry[ks];
+				if (table[0].surface_row[i] == table[0].surface_inflow_row[ks])
+					add_surface_inflow(patch, table[0].surface_gamma[j],
+						&(table[0].outflow[i * NEIGHBOUR_NUM_FLUXES]), command_line,
+						time_int, verbose_flag);
+				ks++;
+			}
+		}
+	}
+	return;
+} /*end gather_drainage_land*/
@@ -0,0 +1,170 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		update_hillslope_gw_hourly			*/
+/*								*/
+/*	NAME							*/
+/*	update_hillslope_gw_hourly - hourly losses of the	*/
+/*			hillslope groundwater stores of a basin	*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	void	update_hillslope_gw_hourly(			*/
+/*			struct basin_object *basin,		*/
+/*			struct command_line_object *command_line)	*/
+/*								*/
+/*	OPTIONS							*/
+/*	-gw							*/
+/*	-gwtoriparian						*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	Called by basin_hourly once every hillslope has done	*/
+/*	its hour.  The hillslopes are done in parallel, and	*/
+/*	the loss of each store is:				*/
+/*								*/
+/*	Qout = storage * slope / 1.571 * gw_loss_coeff / 24	*/
+/*								*/
+/*	or, with a fast threshold, the same on the store below	*/
+/*	the threshold plus gw_loss_fast_coeff on the rest.	*/
+/*	Each hillslope then removes its loss and the nitrogen	*/
+/*	and carbon that go with it, and sends them to the	*/
+/*	stream or, with -gwtoriparian, spreads them over the	*/
+/*	patches of its riparian_list.				*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*	This was the end of hillslope_hourly; hillslopes do	*/
+/*	not share groundwater so doing it after the hillslope	*/
+/*	loop gives the same result.  hillslope.gw stays the	*/
+/*	store that patches drain into and that is written to	*/
+/*	the state and output files.				*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include "rhessys.h"
+
+void	update_hillslope_gw_hourly(struct basin_object *basin,
+				   struct command_line_object *command_line)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int	h, i;
+	double	slow_store, fast_store;
+	double	hourly_gw_Qout;
+	double	gw_Qout_ratio;
+	double	Qout;
+	struct	hillslope_object	*hillslope;
+	struct	patch_object	*patch;
+
+	/*--------------------------------------------------------------*/
+	/*	move the loss out of each store				*/
+	/*--------------------------------------------------------------*/
+	#pragma omp parallel for private(i, slow_store, fast_store, hourly_gw_Qout, gw_Qout_ratio, Qout, hillslope, patch)
+	for (h = 0; h < basin[0].num_hillslopes; h++) {
+		hillslope = basin[0].hillslopes[h];
+		hillslope[0].hourly_base_flow = 0.0;
+		hillslope[0].gw.hourly_Qout = 0.0;
+		hillslope[0].gw.hourly_NO3out = 0.0;
+		hillslope[0].gw.hourly_NH4out = 0.0;
+		hillslope[0].gw.hourly_DONout = 0.0;
+		hillslope[0].gw.hourly_DOCout = 0.0;
+		hillslope[0].hourly_streamflow_NO3 = 0.0;
+		hillslope[0].hourly_streamflow_NH4 = 0.0;
+		hillslope[0].hourly_streamflow_DOC = 0.0;
+		hillslope[0].hourly_streamflow_DON = 0.0;
+
+		Qout = 0.0;
+		if ((command_line[0].gw_flag > 0) && (hillslope[0].gw.storage > ZERO)) {
+			if (hillslope[0].defaults[0][0].gw_loss_fast_threshold < ZERO) {
+				Qout = hillslope[0].gw.storage * hillslope[0].slope / 1.571 *
+					hillslope[0].defaults[0][0].gw_loss_coeff / 24;
+			}
+			else {
+				slow_store = min(hillslope[0].defaults[0][0].gw_loss_fast_threshold, hillslope[0].gw.storage);
+				Qout = slow_store * hillslope[0].slope / 1.571 * hillslope[0].defaults[0][0].gw_loss_coeff/24;
+				fast_store = max(0.0, hillslope[0].gw.storage - hillslope[0].defaults[0][0].gw_loss_fast_threshold);
+				Qout += fast_store * hillslope[0].slope / 1.571 * hillslope[0].defaults[0][0].gw_loss_fast_coeff/24;
+			}
+		}
+
+		if ((command_line[0].gw_flag > 0) && (hillslope[0].gw.storage > ZERO) && (command_line[0].gwtoriparian_flag==0)) {
+			hillslope[0].gw.hourly_Qout = Qout;
+			hillslope[0].hourly_base_flow += hillslope[0].gw.hourly_Qout;
+
+			hillslope[0].gw.hourly_NH4out = hillslope[0].gw.hourly_Qout * hillslope[0].gw.NH4 / hillslope[0].gw.storage;
+			hillslope[0].gw.hourly_NO3out = hillslope[0].gw.hourly_Qout * hillslope[0].gw.NO3 / hillslope[0].gw.storage;
+			hillslope[0].gw.hourly_DONout = hillslope[0].gw.hourly_Qout * hillslope[0].gw.DON / hillslope[0].gw.storage;
+			hillslope[0].gw.hourly_DOCout = hillslope[0].gw.hourly_Qout * hillslope[0].gw.DOC / hillslope[0].gw.storage;
+			hillslope[0].gw.NO3out += hillslope[0].gw.hourly_NO3out;
+			hillslope[0].gw.NH4out += hillslope[0].gw.hourly_NH4out;
+			hillslope[0].gw.DOCout += hillslope[0].gw.hourly_DOCout;
+			hillslope[0].gw.DONout += hillslope[0].gw.hourly_DONout;
+
+			hillslope[0].gw.storage -= hillslope[0].gw.hourly_Qout;
+
+			hillslope[0].hourly_streamflow_NO3 += hillslope[0].gw.hourly_NO3out;
+			hillslope[0].hourly_streamflow_NH4 += hillslope[0].gw.hourly_NH4out;
+			hillslope[0].hourly_streamflow_DON += hillslope[0].gw.hourly_DONout;
+			hillslope[0].hourly_streamflow_DOC += hillslope[0].gw.hourly_DOCout;
+			hillslope[0].gw.NH4 -= hillslope[0].gw.hourly_NH4out;
+			hillslope[0].gw.NO3 -= hillslope[0].gw.hourly_NO3out;
+			hillslope[0].gw.DON -= hillslope[0].gw.hourly_DONout;
+			hillslope[0].gw.DOC -= hillslope[0].gw.hourly_DOCout;
+
+			hillslope[0].streamflow_NO3 +=hillslope[0].hourly_streamflow_NO3;
+			hillslope[0].streamflow_NH4 +=hillslope[0].hourly_streamflow_NH4;
+			hillslope[0].streamflow_DOC +=hillslope[0].hourly_streamflow_DOC;
+			hillslope[0].streamflow_DON +=hillslope[0].hourly_streamflow_DON;
+		}
+
+		if ((command_line[0].gw_flag > 0) && (hillslope[0].gw.storage > ZERO) && (command_line[0].gwtoriparian_flag == 1)) {
+			hillslope[0].gw.hourly_Qout = Qout;
+
+			hillslope[0].gw.hourly_NH4out = hillslope[0].gw.hourly_Qout * hillslope[0].gw.NH4 / hillslope[0].gw.storage;
+			hillslope[0].gw.hourly_NO3out = hillslope[0].gw.hourly_Qout * hillslope[0].gw.NO3 / hillslope[0].gw.storage;
+			hillslope[0].gw.hourly_DONout = hillslope[0].gw.hourly_Qout * hillslope[0].gw.DON / hillslope[0].gw.storage;
+			hillslope[0].gw.hourly_DOCout = hillslope[0].gw.hourly_Qout * hillslope[0].gw.DOC / hillslope[0].gw.storage;
+
+			gw_Qout_ratio = hillslope[0].gw.hourly_Qout/hillslope[0].gw.storage;
+
+			if (hillslope[0].riparian_area > ZERO){
+				hourly_gw_Qout = hillslope[0].gw.hourly_Qout * hillslope[0].area / hillslope[0].riparian_area;
+			}
+			else {
+				hillslope[0].hourly_streamflow_NO3 += hillslope[0].gw.hourly_NO3out;
+				hillslope[0].hourly_streamflow_NH4 += hillslope[0].gw.hourly_NH4out;
+				hillslope[0].hourly_streamflow_DON += hillslope[0].gw.hourly_DONout;
+				hillslope[0].hourly_streamflow_DOC += hillslope[0].gw.hourly_DOCout;
+
+				hillslope[0].hourly_base_flow += hillslope[0].gw.hourly_Qout;
+				hourly_gw_Qout = 0.0;
+			}
+
+			for (i = 0; i < hillslope[0].riparian_list.num_patches; i++) {
+				patch = hillslope[0].riparian_list.list[i];
+				patch[0].sat_deficit -= hourly_gw_Qout;
+				patch[0].soil_ns.sminn += hourly_gw_Qout * gw_Qout_ratio * hillslope[0].gw.NH4;
+				patch[0].soil_ns.nitrate += hourly_gw_Qout * gw_Qout_ratio * hillslope[0].gw.NO3;
+				patch[0].soil_ns.DON += hourly_gw_Qout * gw_Qout_ratio * hillslope[0].gw.DON;
+				patch[0].soil_cs.DOC += hourly_gw_Qout * gw_Qout_ratio * hillslope[0].gw.DOC;
+			}
+
+			hillslope[0].gw.storage -= hillslope[0].gw.hourly_Qout;
+			hillslope[0].gw.NH4 -= hillslope[0].gw.hourly_NH4out;
+			hillslope[0].gw.NO3 -= hillslope[0].gw.hourly_NO3out;
+			hillslope[0].gw.DON -= hillslope[0].gw.hourly_DONout;
+			hillslope[0].gw.DOC -= hillslope[0].gw.hourly_DOCout;
+			hillslope[0].gw.NO3out += hillslope[0].gw.hourly_NO3out;
+			hillslope[0].gw.NH4out += hillslope[0].gw.hourly_NH4out;
+			hillslope[0].gw.DOCout += hillslope[0].gw.hourly_DOCout;
+			hillslope[0].gw.DONout += hillslope[0].gw.hourly_DONout;
+
+			hillslope[0].streamflow_NO3 +=hillslope[0].hourly_streamflow_NO3;
+			hillslope[0].streamflow_NH4 +=hillslope[0].hourly_streamflow_NH4;
+			hillslope[0].streamflow_DOC +=hillslope[0].hourly_streamflow_DOC;
+			hillslope[0].streamflow_DON +=hillslope[0].hourly_streamflow_DON;
+		}
+		hillslope[0].gw.Qout += hillslope[0].gw.hourly_Qout; // this is the daily gw.Qout, used in hillslop_daily_F
+		hillslope[0].base_flow += hillslope[0].hourly_base_flow; // daily base_flow
+	}
+	return;
+} /*end update_hillslope_gw_hourly*/
@@ -24,6 +24,21 @@ void *alloc(size_t size, char *array_name, char *calling_function);
 
 struct routing_list_object *construct_topmodel_patchlist(struct hillslope_object * const hillslope);
 
+struct neighbour_table_object *construct_neighbour_table(struct hillslope_object *hillslope);
+
+void	destroy_neighbour_table(struct neighbour_table_object *table);
+
+struct soil_thermal_object *construct_soil_thermal(struct hillslope_object * const hillslope);
+
+struct snowpack_batch_object *construct_snowpack_batch(struct hillslope_object * const hillslope);
+
+int	balance_check_due(struct command_line_object *command_line, struct date current_date);
+
+void	add_balance_entry(struct balance_log_object *log, int kind, int ID,
+			  int drainage_type, double balance);
+
+void	flush_balance_log(struct balance_log_object *log, struct date current_date);
+
 double	compute_potential_exfiltration(int 	verbose_flag,
 									   double	S,
 									   double 	sat_deficit_z,
@@ -166,6 +166,18 @@
 #define MAXNAME 60
 #define INTERVAL_SIZE 0.001 
 #define MAX_NUM_INTERVAL 5000 
+#define TOPMODEL_NUM_SUMS 11	/* per patch terms of the top_model reductions */
+#define NEIGHBOUR_NUM_FLUXES 10	/* per patch outflows kept in the neighbour table */
+#define OUTFLOW_WATER 0		/* m3 */
+#define OUTFLOW_DON 1		/* kg */
+#define OUTFLOW_DOC 2
+#define OUTFLOW_NO3 3
+#define OUTFLOW_NH4 4
+#define OUTFLOW_SURFACE_WATER 5	/* m3 */
+#define OUTFLOW_SURFACE_DON 6	/* kg */
+#define OUTFLOW_SURFACE_DOC 7
+#define OUTFLOW_SURFACE_NO3 8
+#define OUTFLOW_SURFACE_NH4 9
 #define STREAM 1
 #define ROAD 2
 #define NON_VEG 20
@@ -215,6 +227,8 @@ int get_netcdf_station_number(char *base_station_filename);
 int get_netcdf_var_timeserias(char *, char *, char *, char *, float, float, float, int, int, int, int, float *);
 int get_netcdf_xy(char *, char *, char *, float, float, float, float *, float *);
 int get_netcdf_var(char *, char *, char *, char *, float, float, float, float *);
+int get_netcdf_var_timeseries_cells(char *, char *, char *, char *, int, float *, float *, float, int, int, int, int, float *);
+int get_netcdf_var_cells(char *, char *, char *, char *, int, float *, float *, float, float *);
 int get_indays(int,int,int,int,int);	//get days since XXXX-01-01
 #endif
 
@@ -348,6 +362,54 @@ struct  output_files_object
         FILE    *hourly;
         };
 
+/*----------------------------------------------------------*/
+/*      One line of text output, built by output_line_*     */
+/*----------------------------------------------------------*/
+#define OUTPUT_LINE_LEN         8192
+#define OUTPUT_FILE_BUFFER      (1024*1024)
+struct  output_line_object
+        {
+        FILE    *outfile;
+        int     length;
+        int     check;                  /* bytes written, < 0 on error */
+        char    text[OUTPUT_LINE_LEN];
+        };
+
+/*----------------------------------------------------------*/
+/*      Output text of one hillslope, formatted in a memory  */
+/*      stream and written to the shared file in order       */
+/*----------------------------------------------------------*/
+struct  output_buffer_object
+        {
+        FILE    *file;                  /* NULL if not used */
+        char    *text;
+        size_t  length;
+        };
+
+struct  hillslope_output_buffer_object
+        {
+        struct  output_buffer_object    hillslope;
+        struct  output_buffer_object    zone;
+        struct  output_buffer_object    patch;
+        struct  output_buffer_object    canopy_stratum;
+        struct  output_buffer_object    fire;
+        };
+
+/*----------------------------------------------------------*/
+/*      Per day statistics of the hourly output of a basin   */
+/*      or zone, kept for -hsum                              */
+/*----------------------------------------------------------*/
+#define HOURLY_SUMMARY_LEN      20
+struct  hourly_summary_object
+        {
+        long    day;                    /* day being summarized */
+        int     num_hours;
+        int     peak_hour[HOURLY_SUMMARY_LEN];
+        double  min[HOURLY_SUMMARY_LEN];
+        double  max[HOURLY_SUMMARY_LEN];
+        double  sum[HOURLY_SUMMARY_LEN];
+        };
+
 /*----------------------------------------------------------*/
 /*      accumlator variables for patch/basin_object         */
 /*----------------------------------------------------------*/
@@ -400,6 +462,131 @@ struct accumulate_patch_object
    double Qout_total;
 };
 
+/*----------------------------------------------------------*/
+/*      daily area weighted sums of a hillslope or basin    */
+/*      shared by the daily output formatters; every        */
+/*      member is a double (summed member by member)        */
+/*----------------------------------------------------------*/
+struct daily_aggregate_object
+{
+   /* zone sums, times zone area */
+   double zone_area;            /* m2 */
+   double pcp;
+   double tmin;
+   double tmax;
+   double tavg;
+   double vpd;
+   double Kdown;
+   double Ldown;
+   double snow;
+   double ndep;
+   /* patch sums, times patch area */
+   double area;                 /* m2 */
+   double rain_throughfall;
+   double rain_throughfall_24hours;
+   double snow_throughfall;
+   double precip_with_assim;
+   double sat_deficit_z;
+   double sat_deficit;
+   double u20;                  /* unsat storage in top 20 cm */
+   double rz_storage;
+   double unsat_storage;
+   double rz_drainage;
+   double unsat_drainage;
+   double cap_rise;
+   double recharge;
+   double evaporation;
+   double evaporation_surf;
+   double exfiltration;
+   double transpiration;
+   double transpiration_sq;
+   double acc_year_trans;
+   double acc_year_trans_sq;
+   double PET;
+   double sublimation;
+   double snowpack;
+   double snow_area;            /* m2 with more than 1 mm swe */
+   double snow_melt;
+   double litter_store;
+   double detention_store;
+   double sat_area;             /* m2 */
+   double return_flow;
+   double base_flow;
+   double streamflow;           /* stream patches only */
+   double streamflow_NO3;
+   double streamflow_NH4;
+   double streamflow_DON;
+   double streamflow_DOC;
+   double streamNO3_from_surface;
+   double streamNO3_from_sub;
+   double Kup;
+   double Lup;
+   double Kstar_canopy;
+   double Kstar_soil;
+   double Kstar_snow;
+   double Lstar_canopy;
+   double Lstar_soil;
+   double Lstar_snow;
+   double LE_canopy;
+   double LE_soil;
+   double LE_snow;
+   double litrc;
+   double litrn;
+   double soilc;
+   double soiln;
+   double soiln_noslow;
+   double sminn;
+   double nitrate;
+   double surfaceN;
+   double totaln;
+   double carbon_balance;
+   double nitrogen_balance;
+   double denitrif;
+   double nitrif;
+   double fertilizer_NO3;
+   double fertilizer_NH4;
+   double DON;
+   double DOC;
+   double nfix;
+   double grazing_Closs;
+   double nuptake;
+   double soilhr;
+   /* canopy strata sums, times cover fraction and patch area */
+   double canopy_store;
+   double canopy_snow;
+   double net_psn;
+   double gpsn;
+   double nppcum;
+   double lai;
+   double canopy_sublimation;
+   double dC13;
+   double mortality_fract;
+   double resp;
+   double resp_leaf;
+   double gs;
+   double ga;
+   double rootdepth;
+   double leafc;
+   double frootc;
+   double woodc;
+   double leafn;
+   double frootn;
+   double woodn;
+   double cpool;
+   double npool;
+   double height;
+   double canopy_Lstar;
+   double canopy_drip;
+   double overstory_height;
+   double overstory_leafc;
+   double overstory_stemc;
+   double overstory_biomassc;
+   double understory_height;
+   double understory_leafc;
+   double understory_stemc;
+   double understory_biomassc;
+};
+
 
 /*----------------------------------------------------------*/
 /*      rooting zone object for patch                       */      
@@ -425,6 +612,51 @@ struct routing_list_object
         struct patch_object **list;
         };
 /*----------------------------------------------------------*/
+/*      Define neighbour table object.                      */
+/*      The innundation lists of the route_list patches of  */
+/*      a hillslope packed into index arrays: patch i owns  */
+/*      depth class rows first_row[i] .. first_row[i+1]-1,  */
+/*      and row r routes to entries start[r] .. start[r+1]-1 */
+/*      of target and gamma (surface_* for surface lists).  */
+/*      target indexes target_patch, which holds the route  */
+/*      list in order followed by any other neighbours.     */
+/*      The inflow_* lists are the same entries grouped by  */
+/*      target, in route list order of the source patch,    */
+/*      for -pull routing.                                  */
+/*      The route list is also cut into segments of         */
+/*      consecutive patches of one drainage type (STREAM,   */
+/*      ROAD or 0 for land): segment s is route list        */
+/*      patches segment_start[s] .. segment_start[s+1]-1.   */
+/*----------------------------------------------------------*/
+struct neighbour_table_object
+        {
+        int     num_patches;
+        int     num_rows;
+        int     num_targets;
+        int     *first_row;             /* num_patches + 1 */
+        int     *sorted_depths;         /* 1 if critical depths ascend */
+        double  *critical_depth;        /* m, num_rows */
+        int     *start;                 /* num_rows + 1 */
+        int     *target;
+        double  *gamma;                 /* m**2 / day */
+        int     *surface_start;         /* num_rows + 1 */
+        int     *surface_target;
+        double  *surface_gamma;         /* m**2 / day */
+        struct  patch_object    **target_patch;
+        int     *inflow_start;          /* num_targets + 1 */
+        int     *inflow_source;         /* route list index */
+        int     *inflow_entry;          /* index into target, gamma */
+        int     *surface_inflow_start;  /* num_targets + 1 */
+        int     *surface_inflow_source;
+        int     *surface_inflow_entry;
+        int     *surface_inflow_row;
+        double  *outflow;               /* num_patches x NEIGHBOUR_NUM_FLUXES */
+        int     *surface_row;           /* row routed this step, -1 if none */
+        int     num_segments;
+        int     *segment_type;          /* num_segments */
+        int     *segment_start;         /* num_segments + 1 */
+        };
+/*----------------------------------------------------------*/
 /*      Define spinup threshold list object.                */
 /*----------------------------------------------------------*/
 struct spinup_thresholds_list_object 
@@ -550,6 +782,9 @@ struct basin_object
         struct  accumulate_patch_object acc_month;
         struct  accumulate_patch_object acc_year;
         struct  snowpack_object snowpack;
+        struct  daily_aggregate_object  daily_aggregate;
+        int     daily_aggregate_valid;  /* 0 once the state has moved on */
+        struct  hourly_summary_object   hourly_summary;
         };
 
 /*----------------------------------------------------------*/
@@ -595,6 +830,7 @@ typedef struct base_station_object
         #ifdef LIU_NETCDF_READER
         double lon;
         double lat;
+        int     referenced;                                                      /* 1 if a basin, hillslope or zone uses it */
         #endif
         double  proj_x;                                                          /* (meters) x coordinate of projection     */
         double  proj_y;                                                          /* (meters) y coordinate of projection     */
@@ -608,6 +844,21 @@ typedef struct base_station_object
         struct  dated_input_object       *dated_input;
         } base_station_object;
 /*----------------------------------------------------------*/
+/*      Define a netcdf grid index: the cells of the base   */
+/*      station header by ID and, when zones are matched by */
+/*      location, by row and column of the netcdf axes.     */
+/*----------------------------------------------------------*/
+typedef struct netcdf_grid_index_object
+{
+        int             num_stations;
+        struct  base_station_object     **by_ID;                /* sorted by ID */
+        int             ny;
+        int             nx;
+        float           *y;                                     /* netcdf_y_varname axis */
+        float           *x;                                     /* netcdf_x_varname axis */
+        struct  base_station_object     **cells;                /* ny * nx, NULL where no station */
+} netcdf_grid_index_object;
+/*----------------------------------------------------------*/
 /*      Define a netcdf base station header object.                                                     */
 /*----------------------------------------------------------*/
 typedef struct base_station_ncheader_object
@@ -637,6 +888,7 @@ typedef struct base_station_ncheader_object
         char    netcdf_tmin_varname[MAXSTR];    /* variable name for tmin in nc file */
         char    netcdf_rain_varname[MAXSTR];    /* variable name for rain in nc file */
         char    netcdf_elev_varname[MAXSTR];    /* variable name for elev in nc file */
+        struct  netcdf_grid_index_object *grid_index;   /* zone to cell lookup, only while zones are built */
 #ifdef LIU_EXTEND_CLIM_VAR
         double  rhum_mult;                    /* multiplier for relative humidity to 0-1 */
         char    netcdf_huss_filename[MAXSTR];   /* filename for specific humidity nc file */
@@ -651,6 +903,12 @@ typedef struct base_station_ncheader_object
         char    netcdf_was_varname[MAXSTR];    /* variable name for wind speed in nc file */
 #endif
 } base_station_ncheader_object;
+struct netcdf_grid_index_object *construct_netcdf_grid_index(struct base_station_object **, int,
+                struct base_station_ncheader_object *);
+struct base_station_object *find_netcdf_grid_station_ID(struct netcdf_grid_index_object *, int);
+int find_netcdf_grid_cell(struct netcdf_grid_index_object *, float, float,
+                float, float *, float *);
+void destroy_netcdf_grid_index(struct netcdf_grid_index_object *);
 /*----------------------------------------------------------*/
 /*      Define dated climate sequence                       */
 /*----------------------------------------------------------*/
@@ -848,6 +1106,7 @@ struct hillslope_object
         double  hourly_streamflow_DON;  /* kgN/m2/day           */
         double  hourly_streamflow_DOC;  /* kgN/m2/day           */
         struct  gw_object               gw;
+        struct  routing_list_object     riparian_list;  /* patches with soil default 42 */
         struct  aggdefs_object          aggdefs;
         struct  base_station_object     **base_stations;
         struct  grow_hillslope_object   *grow;
@@ -857,9 +1116,17 @@ struct hillslope_object
         struct  zone_object             **zones;
         struct  accumulate_patch_object acc_month;
         struct  accumulate_patch_object acc_year;
+        double  area_withsnow;          /*  m2          */
+        struct  snowpack_object snowpack; /* snow covered area sums */
+        struct  daily_aggregate_object  daily_aggregate;
 
         struct  routing_list_object     *route_list;
         struct  routing_list_object     *surface_route_list;
+        struct  neighbour_table_object  *neighbour_table;
+        double  *topmodel_sums;         /* route_list patches x TOPMODEL_NUM_SUMS */
+        struct  soil_thermal_object     *soil_thermal;
+        struct  snowpack_batch_object   *snowpack_batch;
+        struct  balance_log_object      *balance_log;   /* NULL unless -balance */
 
 /*      used in subsurface computation          */
         double hillslope_outflow;
@@ -1055,6 +1322,7 @@ struct zone_object
         struct  zone_hourly_object      *hourly;
         struct  accumulate_zone_object  acc_month;
         struct  accumulate_zone_object  acc_year;
+        struct  hourly_summary_object   hourly_summary;
 
         };
 
@@ -1221,6 +1489,7 @@ struct  cdayflux_patch_struct
     double psoil3c_loss;        /* (kgC/m2/d) release of shielded cellulose */
     double psoil4c_loss;        /* (kgC/m2/d) recalcitrant SOM formation */
     double kl4;                 /* (1/day) rate constant for lignin litter decomp */    
+    int    decomp_active;       /* 0 if no pool can decompose today (frozen, dry or empty pools) */
 
     /* daily turnover fluxes */
     double leafc_to_litr1c;  /* (kgC/m2/d) leaf litfall (labile) */
@@ -1574,6 +1843,21 @@ struct stratum_spinup_object
 
 };
 
+/*----------------------------------------------------------*/
+/*      Define a table of compute_varbased_flow over the     */
+/*      saturation deficit, built for one std and one        */
+/*      transmissivity profile (-stdevtable option)          */
+/*----------------------------------------------------------*/
+struct varflow_table_object
+        {
+        double  std;                    /* m water      */
+        double  interval_size;          /* m water      */
+        double  *transmissivity;        /* profile tabulated, NULL if none */
+        int     num_soil_intervals;
+        int     num_entries;
+        double  *flow;                  /* m2/day at sat_deficit = i*interval_size */
+        };
+
 /*----------------------------------------------------------*/
 /*      Define an patch object                              */      
 /*----------------------------------------------------------*/
@@ -1804,11 +2088,17 @@ struct patch_object
         double  preday_detention_store;                 /* meters water         */
         double  preday_rain_stored;                     /* meters water         */
         double  preday_snowpack;                        /* meters water         */
+/*      set by patch_canopy_daily_F for the rest of the day     */
+        double  preday_snowpack_height;                 /* meters               */
+        double  pond_height;                            /* meters               */
+        double  irrigation;                             /* meters water         */
+        double  snow_melt_input;                        /* meters water, -999.0 if computed */
         double  preday_sat_deficit;                     /* meters water         */
         double  preday_sat_deficit_z;                   /* meters               */
         double  sat_deficit;                            /* meters water         */
         double  sat_deficit_z;                          /* meters               */
         double  *transmissivity_profile;                /* array (m/day) */
+        struct  varflow_table_object *varflow_table;    /* NULL unless -stdevtable */
         struct  snowpack_object snowpack;               /* meters               */
         double  preday_unsat_storage;                   /* meters water         */
         double  preday_rz_storage;                      /* meters water by Taehee Hwang */
@@ -2063,6 +2353,7 @@ struct  command_line_object
         int             gw_flag;
         int             tchange_flag;
         int             stdev_flag;
+        int             stdev_table_flag;
         int             surface_energy_flag;
         int             precip_scale_flag;
         int             snow_scale_flag;
@@ -2071,6 +2362,20 @@ struct  command_line_object
         int             version_flag;
         int		FillSpill_flag;
         int		evap_use_longwave_flag;
+        int             balance_flag;
+        int             balance_interval;       /* days between balance checks */
+        int             balance_sample;         /* check patches with ID % sample == 0 */
+        int             num_workers;            /* basin worker processes for -workers */
+        int             worker_rank;            /* -1 in a single process run */
+        int             checkpoint_flag;
+        int             checkpoint_interval;    /* years between checkpoints */
+        int             restart_flag;
+        int             world_redefined;        /* a redefine or roads_on event ran */
+        int             zstate_flag;            /* gzip compressed state output */
+        int             output_digits;          /* decimals of text output */
+        int             hourly_summary_basin_flag;      /* -hsum */
+        int             hourly_summary_zone_flag;
+        int             pull_flag;              /* -pull lateral routing */
         char    *output_prefix;
         char    routing_filename[FILEPATH_LEN];
         char    surface_routing_filename[FILEPATH_LEN];
@@ -2114,6 +2419,36 @@ struct  command_line_object
         struct  date            end_date;
         };
 
+/*----------------------------------------------------------*/
+/*      Define the header of a -checkpoint file.            */
+/*      It is followed by the basins in world order, each   */
+/*      with its reaches, hillslopes, zones, patches and    */
+/*      strata, and then the climate sequence cursors of    */
+/*      the world base stations.                            */
+/*----------------------------------------------------------*/
+#define CHECKPOINT_MAGIC        "RHSCKPT"
+#define CHECKPOINT_VERSION      2
+
+struct  checkpoint_header_object
+        {
+        char            magic[8];
+        int             version;
+        int             object_size[8];         /* sizeof each object written */
+        int             grow_flag;
+        int             num_basins;
+        int             num_base_stations;
+        struct  date    current_date;
+        long            day;                    /* execute_tec counters */
+        long            month;
+        long            year;
+        long            tec_offset;             /* tec file entry not yet handled */
+        struct  output_flag     output_flags;
+        struct  date    output_yearly_date;
+        int             road_flag;
+        int             world_redefined;        /* -restart is refused if set */
+        long            output_offset[2][8][4]; /* -1 if the file is not open */
+        };
+
 
 /*----------------------------------------------------------*/
 /*      Define a tec file object.                                                               */
@@ -2937,5 +3272,86 @@ struct surface_energy_default {
         double iteration_threshold; /* degrees C */
         };
 
+/*----------------------------------------------------------*/
+/* Define Soil Thermal Object                               */
+/*	surface energy layers of every patch of a hillslope,  */
+/*	layer major ([layer * num_patches + patch]) so that */
+/*	each step of the profile runs across all patches    */
+/*----------------------------------------------------------*/
+struct soil_thermal_object {
+        int num_patches;
+        struct patch_object **patches;
+        double *depth;          /* m - bottom of layer */
+        double *moisture;       /* m water */
+        double *T;              /* degrees C - last profile */
+        };
+
+/*----------------------------------------------------------*/
+/* Define Snowpack Batch Object                             */
+/*	snowpack energy balance of the snow covered patches */
+/*	of one zone, one lane per evaluation (a patch under */
+/*	partial cover has a covered and an exposed lane);   */
+/*	sized for the largest zone of the hillslope         */
+/*----------------------------------------------------------*/
+struct snowpack_batch_object {
+        int num_lanes;
+        int max_lanes;
+        struct patch_object **patch;
+        int *update_flag;               /* 1 if the lane sets the snowpack state */
+        int *albedo_flag;
+        double *gasnow;                 /* m/s */
+        double *rain;                   /* m water */
+        double *snow;                   /* m water */
+        double *Kdown_direct;           /* Kj/(m2*day) - transmitted on return */
+        double *Kup_direct;             /* Kj/(m2*day) */
+        double *Kdown_diffuse;          /* Kj/(m2*day) - transmitted on return */
+        double *Kup_diffuse;            /* Kj/(m2*day) */
+        double *PAR_direct;             /* umol/(m2*day) - transmitted on return */
+        double *PAR_diffuse;            /* umol/(m2*day) - transmitted on return */
+        double *Lstar;                  /* Kj/(m2*day) */
+        double *overstory_fraction;     /* 0-1 */
+        double *area_fraction;          /* 0-1 */
+        double *bats_b;                 /* DIM */
+        double *bats_r3;                /* DIM */
+        double *maximum_energy_deficit; /* degree days */
+        double *light_ext_coef;         /* DIM */
+        double *melt_Tcoef;             /* DIM */
+        double *water_equivalent_depth; /* m water */
+        double *surface_age;            /* days */
+        double *energy_deficit;         /* degree days */
+        double *K_reflectance;          /* 0-1 */
+        double *Kstar_direct;           /* Kj/(m2*day) */
+        double *Kstar_diffuse;          /* Kj/(m2*day) */
+        double *APAR_direct;            /* umol/(m2*day) */
+        double *APAR_diffuse;           /* umol/(m2*day) */
+        double *Rnet;                   /* Kj/(m2*day) */
+        double *sublimation;            /* m water */
+        double *melt;                   /* m water */
+        };
+
+/*----------------------------------------------------------*/
+/* Define Balance Log Object                                */
+/*	mass balance violations found during a day on one   */
+/*	hillslope (-balance option), printed once the day's */
+/*	parallel hillslope loop is over                     */
+/*----------------------------------------------------------*/
+#define	BALANCE_PATCH_WATER	0
+#define	BALANCE_TOPMODEL_WATER	1
+#define	BALANCE_ROUTING_WATER	2
+
+struct balance_entry {
+        int     kind;
+        int     ID;
+        int     drainage_type;
+        double  balance;        /* m water */
+        };
+
+struct balance_log_object {
+        int     due;            /* 1 if today is a check day */
+        int     num_entries;
+        int     max_entries;
+        struct  balance_entry *entries;
+        };
+
 #endif
 
@@ -44,10 +44,32 @@ struct base_station_object
 	/*--------------------------------------------------------------*/
 	int	i;
 	struct	base_station_object *base_station;
+#ifndef FIND_STATION_BASED_ON_ID
+	int	cell;
+	float	cell_x, cell_y;
+#endif
 	/*--------------------------------------------------------------*/
 	/*	Loop through all of the basestations available.			*/
 	/*	and find the record which holds the matching base station	*/
 	/*--------------------------------------------------------------*/
+	/*--------------------------------------------------------------*/
+	/*	While zones are built the world's grid index answers	*/
+	/*	directly.							*/
+	/*--------------------------------------------------------------*/
+	if ((ncheader != NULL) && (ncheader->grid_index != NULL)) {
+        #ifdef FIND_STATION_BASED_ON_ID
+		base_station = find_netcdf_grid_station_ID(ncheader->grid_index, basestation_id);
+        #else
+		cell = find_netcdf_grid_cell(ncheader->grid_index, y, x,
+			ncheader->resolution_meter / 2.0, &cell_y, &cell_x);
+		base_station = (cell == -1) ? NULL : ncheader->grid_index->cells[cell];
+        #endif
+		if (base_station == NULL) {
+			*notfound = 1;
+			return 0;
+		}
+		return(base_station);
+	}
 	i = 0;
 	if (num_base_stations < 1) {
 		*notfound = 1;
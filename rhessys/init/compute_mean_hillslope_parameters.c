@@ -37,6 +37,8 @@ void compute_mean_hillslope_parameters( struct hillslope_object *hillslope)
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.									*/
 	/*--------------------------------------------------------------*/
+	void	construct_riparian_list(
+		struct hillslope_object *);
 	
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
@@ -100,6 +102,11 @@ void compute_mean_hillslope_parameters( struct hillslope_object *hillslope)
 	hillslope[0].aggdefs.NO3_adsorption_rate /= hillslope[0].area;
 	hillslope[0].aggdefs.NH4_adsorption_rate /= hillslope[0].area;
 
+	/*--------------------------------------------------------------*/
+	/*	soil defaults may have changed				*/
+	/*--------------------------------------------------------------*/
+	construct_riparian_list(hillslope);
+
 	return;
 
 	} /* end compute_mean_hillslope_parameters */
@@ -269,6 +269,17 @@ struct basin_object *construct_basin(
     }
   }
 
+  /*--------------------------------------------------------------*/
+  /*      output sums are computed on first use after a step      */
+  /*--------------------------------------------------------------*/
+  basin[0].daily_aggregate_valid = 0;
+
+  /*--------------------------------------------------------------*/
+  /*      no hourly output summarized yet (-hsum)                 */
+  /*--------------------------------------------------------------*/
+  basin[0].hourly_summary.day = -1;
+  basin[0].hourly_summary.num_hours = 0;
+
   /*--------------------------------------------------------------*/
   /*      initialize accumulator variables for this patch         */
   /*--------------------------------------------------------------*/
@@ -413,12 +424,27 @@ struct basin_object *construct_basin(
 
     fclose(routing_file);
 
+    for (int i=0; i<basin[0].num_hillslopes; i++){
+      hillslope = basin[0].hillslopes[i];
+      hillslope->neighbour_table = construct_neighbour_table(hillslope);
+    }
+
   } else { // command_line[0].routing_flag != 1
     // For TOPMODEL mode, make a dummy route list consisting of all patches
     // in the hillslope, in no particular order.
+    // top_model sweeps this flat list, keeping the terms of each patch in
+    // topmodel_sums so that its reductions are summed in list order.
     int h;
-    for (h=0; h < basin[0].num_hillslopes; h++) 
-   		 basin[0].hillslopes[h]->route_list = construct_topmodel_patchlist(basin[0].hillslopes[h]);
+    for (h=0; h < basin[0].num_hillslopes; h++) {
+   		 hillslope = basin[0].hillslopes[h];
+   		 hillslope->route_list = construct_topmodel_patchlist(hillslope);
+   		 hillslope->neighbour_table = NULL;
+   		 hillslope->topmodel_sums = NULL;
+   		 if (hillslope->route_list != NULL)
+   			 hillslope->topmodel_sums = (double *)alloc(
+   				 hillslope->route_list->num_patches * TOPMODEL_NUM_SUMS * sizeof(double),
+   				 "topmodel_sums", "construct_basin");
+    }
   }
 
   /*--------------------------------------------------------------*/
@@ -71,6 +71,7 @@ struct	command_line_object	*construct_command_line(
 	command_line[0].grow_flag = 0;	
 	command_line[0].std_scale = 0;
 	command_line[0].stdev_flag = 0;
+	command_line[0].stdev_table_flag = 0;
 	command_line[0].road_flag = 1;
 	command_line[0].prefix_flag = 0;
 	command_line[0].verbose_flag = 0;
@@ -98,6 +99,20 @@ struct	command_line_object	*construct_command_line(
 	command_line[0].vgsen_flag = 0;
 	command_line[0].FillSpill_flag=0;	
 	command_line[0].evap_use_longwave_flag = 0;
+	command_line[0].balance_flag = 0;
+	command_line[0].balance_interval = 1;
+	command_line[0].balance_sample = 1;
+	command_line[0].num_workers = 1;
+	command_line[0].worker_rank = -1;
+	command_line[0].checkpoint_flag = 0;
+	command_line[0].checkpoint_interval = 1;
+	command_line[0].restart_flag = 0;
+	command_line[0].world_redefined = 0;
+	command_line[0].zstate_flag = 0;
+	command_line[0].output_digits = 6;
+	command_line[0].hourly_summary_basin_flag = 0;
+	command_line[0].hourly_summary_zone_flag = 0;
+	command_line[0].pull_flag = 0;
 	command_line[0].veg_sen1 = 1.0;
 	command_line[0].veg_sen2 = 1.0;
 	command_line[0].veg_sen3 = 1.0;
@@ -371,6 +386,13 @@ struct	command_line_object	*construct_command_line(
 				i++;
 			}/* end if */
 			/*-------------------------------------------------*/
+			/*Check if the stdev lookup table option is next.	*/
+			/*-------------------------------------------------*/
+			else if ( strcmp(main_argv[i],"-stdevtable") == 0 ){
+				command_line[0].stdev_table_flag = 1;
+				i++;
+			}/* end if */
+			/*-------------------------------------------------*/
 			/*Check if the threshold option is next.				*/
 			/*-------------------------------------------------*/
 			else if ( strcmp(main_argv[i],"-th") == 0 ){
@@ -1177,6 +1199,101 @@ struct	command_line_object	*construct_command_line(
 				command_line[0].evap_use_longwave_flag = 1;
 				i++;
 			}
+			/*-------------------------------------------------*/
+			/*	mass balance checks, optionally every nth day	*/
+			/*	and for every nth patch (by ID)			*/
+			/*-------------------------------------------------*/
+			else if (strcmp(main_argv[i], "-balance") == 0) {
+				command_line[0].balance_flag = 1;
+				i++;
+				if ((i < main_argc) && (valid_option(main_argv[i]) == 0)) {
+					command_line[0].balance_interval = max(1, (int)atoi(main_argv[i]));
+					i++;
+					if ((i < main_argc) && (valid_option(main_argv[i]) == 0)) {
+						command_line[0].balance_sample = max(1, (int)atoi(main_argv[i]));
+						i++;
+					}
+				}
+			}
+			/*--------------------------------------------------------------*/
+			/*	split basins over a number of worker processes		*/
+			/*--------------------------------------------------------------*/
+			else if (strcmp(main_argv[i], "-workers") == 0) {
+				i++;
+				if ((i == main_argc) || (valid_option(main_argv[i]) == 1)) {
+					fprintf(stderr,"FATAL ERROR: Number of workers not specified\n");
+					exit(EXIT_FAILURE);
+				}
+				command_line[0].num_workers = max(1, (int)atoi(main_argv[i]));
+				i++;
+			}
+			/*--------------------------------------------------------------*/
+			/*	checkpoint every interval years (default 1)		*/
+			/*--------------------------------------------------------------*/
+			else if (strcmp(main_argv[i], "-checkpoint") == 0) {
+				command_line[0].checkpoint_flag = 1;
+				i++;
+				if ((i < main_argc) && (valid_option(main_argv[i]) == 0)) {
+					command_line[0].checkpoint_interval = max(1, (int)atoi(main_argv[i]));
+					i++;
+				}
+			}
+			/*--------------------------------------------------------------*/
+			/*	resume from the last checkpoint				*/
+			/*--------------------------------------------------------------*/
+			else if (strcmp(main_argv[i], "-restart") == 0) {
+				command_line[0].restart_flag = 1;
+				i++;
+			}
+			/*--------------------------------------------------------------*/
+			/*	gzip compressed state output					*/
+			/*--------------------------------------------------------------*/
+			else if (strcmp(main_argv[i], "-zstate") == 0) {
+#ifndef ZLIB_STATE
+				fprintf(stderr,"FATAL ERROR: -zstate needs rhessys built with make zlib=1\n");
+				exit(EXIT_FAILURE);
+#endif
+				command_line[0].zstate_flag = 1;
+				i++;
+			}
+			/*--------------------------------------------------------------*/
+			/*	decimals written for real valued output (default 6)	*/
+			/*--------------------------------------------------------------*/
+			else if (strcmp(main_argv[i], "-digits") == 0) {
+				i++;
+				if ((i == main_argc) || (valid_option(main_argv[i]) == 1)) {
+					fprintf(stderr,"FATAL ERROR: Number of output digits not specified\n");
+					exit(EXIT_FAILURE);
+				}
+				command_line[0].output_digits = max(0, min(15, (int)atoi(main_argv[i])));
+				i++;
+			}
+			/*--------------------------------------------------------------*/
+			/*	daily statistics in place of hourly basin (b) and/or	*/
+			/*	zone (z) output (default both)				*/
+			/*--------------------------------------------------------------*/
+			else if (strcmp(main_argv[i], "-hsum") == 0) {
+				i++;
+				if ((i < main_argc) && (valid_option(main_argv[i]) == 0)) {
+					if (strchr(main_argv[i], 'b') != NULL)
+						command_line[0].hourly_summary_basin_flag = 1;
+					if (strchr(main_argv[i], 'z') != NULL)
+						command_line[0].hourly_summary_zone_flag = 1;
+					i++;
+				}
+				else {
+					command_line[0].hourly_summary_basin_flag = 1;
+					command_line[0].hourly_summary_zone_flag = 1;
+				}
+			}
+			/*--------------------------------------------------------------*/
+			/*	receiving patches gather lateral inflow after all	*/
+			/*	patches have computed their outflow			*/
+			/*--------------------------------------------------------------*/
+			else if (strcmp(main_argv[i], "-pull") == 0) {
+				command_line[0].pull_flag = 1;
+				i++;
+			}
 			/*--------------------------------------------------------------*/
 			/*	NOTE:  ADD MORE OPTION PARSING HERE.						*/
 			/*--------------------------------------------------------------*/
@@ -1191,6 +1308,17 @@ struct	command_line_object	*construct_command_line(
 			} /*end if*/
 		} /*end if*/
 	} /*end while*/
+	/*--------------------------------------------------------------*/
+	/*	checkpoints hold basin objects only, not the fire grid,	*/
+	/*	spinup targets or the surface energy profiles			*/
+	/*--------------------------------------------------------------*/
+	if (((command_line[0].checkpoint_flag == 1) || (command_line[0].restart_flag == 1))
+		&& ((command_line[0].firespread_flag == 1) || (command_line[0].vegspinup_flag > 0)
+		|| (command_line[0].surface_energy_flag == 1))) {
+		fprintf(stderr,
+			"FATAL ERROR: -checkpoint and -restart cannot be used with fire spread, vegetation spinup or surface energy\n");
+		exit(EXIT_FAILURE);
+	}
 
 	return(command_line);
 } /*end construct_command_line*/
@@ -76,6 +76,15 @@ struct hillslope_object *construct_hillslope(
 	void	*alloc(	size_t,
 		char	*,
 		char	*);
+
+	void	construct_riparian_list(
+		struct hillslope_object *);
+
+	struct soil_thermal_object *construct_soil_thermal(
+		struct hillslope_object *);
+
+	struct snowpack_batch_object *construct_snowpack_batch(
+		struct hillslope_object *);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
@@ -283,6 +292,38 @@ struct hillslope_object *construct_hillslope(
 	hillslope[0].aggdefs.DON_adsorption_rate /= hillslope[0].area;
 	hillslope[0].aggdefs.DOC_adsorption_rate /= hillslope[0].area;
 
+	/*--------------------------------------------------------------*/
+	/*	patches that take groundwater with -gwtoriparian	*/
+	/*--------------------------------------------------------------*/
+	hillslope[0].riparian_list.list = NULL;
+	construct_riparian_list(hillslope);
+
+	/*--------------------------------------------------------------*/
+	/*	thermal nodes of all patches for the surface energy	*/
+	/*	soil temperature solver					*/
+	/*--------------------------------------------------------------*/
+	hillslope[0].soil_thermal = NULL;
+	if (command_line[0].surface_energy_flag == 1)
+		hillslope[0].soil_thermal = construct_soil_thermal(hillslope);
+
+	/*--------------------------------------------------------------*/
+	/*	lanes for the snowpack energy balance of each zone	*/
+	/*--------------------------------------------------------------*/
+	hillslope[0].snowpack_batch = construct_snowpack_batch(hillslope);
+
+	/*--------------------------------------------------------------*/
+	/*	log of mass balance violations (-balance)		*/
+	/*--------------------------------------------------------------*/
+	hillslope[0].balance_log = NULL;
+	if (command_line[0].balance_flag == 1) {
+		hillslope[0].balance_log = (struct balance_log_object *)
+			alloc(sizeof(struct balance_log_object),
+			"balance_log", "construct_hillslope");
+		hillslope[0].balance_log[0].due = 0;
+		hillslope[0].balance_log[0].num_entries = 0;
+		hillslope[0].balance_log[0].max_entries = 0;
+		hillslope[0].balance_log[0].entries = NULL;
+	}
 
 	/*--------------------------------------------------------------*/
 	/*      initialize accumulator variables for this patch         */
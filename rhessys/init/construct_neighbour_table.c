@@ -0,0 +1,334 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		construct_neighbour_table			*/
+/*								*/
+/*	NAME							*/
+/*	construct_neighbour_table - pack the innundation lists	*/
+/*			of a hillslope into index arrays	*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	struct neighbour_table_object *construct_neighbour_table(	*/
+/*			struct hillslope_object *hillslope)	*/
+/*	void	destroy_neighbour_table(			*/
+/*			struct neighbour_table_object *table)	*/
+/*								*/
+/*	OPTIONS							*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	Called once the route_list and surface_route_list of	*/
+/*	the hillslope are read.  Each patch i of the route list	*/
+/*	gets one row per innundation depth, holding the index	*/
+/*	and gamma of the subsurface and surface neighbours of	*/
+/*	that depth in the order of the routing file, so that	*/
+/*	update_drainage_land walks contiguous arrays rather	*/
+/*	than the neighbour structs of each patch.		*/
+/*								*/
+/*	The critical depths of each patch are copied too, and	*/
+/*	marked sorted when they ascend so the depth class can	*/
+/*	be found by bisection.					*/
+/*								*/
+/*	For -pull routing the entries are also listed by target	*/
+/*	patch (inflow_*), in the order update_drainage_land	*/
+/*	would add them, together with room for the outflow of	*/
+/*	each patch.						*/
+/*								*/
+/*	Runs of route list patches with the same drainage type	*/
+/*	are recorded as segments so the routing loops call one	*/
+/*	update_drainage routine per run rather than testing	*/
+/*	the type of every patch.  The runs keep the route list	*/
+/*	order, which push routing depends on.			*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*	The innundation lists are kept, recompute_gamma and	*/
+/*	the stream and road routines still read them.  The	*/
+/*	table must be rebuilt whenever the route lists are.	*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "rhessys.h"
+
+struct	neighbour_key
+	{
+	struct	patch_object	*patch;
+	int	index;
+	};
+
+static	int	compare_neighbour_key(const void *a, const void *b)
+{
+	uintptr_t	pa, pb;
+
+	pa = (uintptr_t) ((const struct neighbour_key *) a)->patch;
+	pb = (uintptr_t) ((const struct neighbour_key *) b)->patch;
+	return((pa > pb) - (pa < pb));
+}
+
+/*--------------------------------------------------------------*/
+/*	route list patches are found by bisection, neighbours	*/
+/*	outside the route list are appended after them		*/
+/*--------------------------------------------------------------*/
+static	int	find_target(struct neighbour_table_object *table,
+			    struct neighbour_key *key,
+			    struct patch_object *patch)
+{
+	struct	neighbour_key	probe, *found;
+	int	k;
+
+	probe.patch = patch;
+	found = (struct neighbour_key *) bsearch(&probe, key,
+		table[0].num_patches, sizeof(struct neighbour_key),
+		compare_neighbour_key);
+	if (found != NULL)
+		return(found[0].index);
+	for (k = table[0].num_patches; k < table[0].num_targets; k++)
+		if (table[0].target_patch[k] == patch)
+			return(k);
+	table[0].target_patch[table[0].num_targets] = patch;
+	return(table[0].num_targets++);
+}
+
+struct neighbour_table_object *construct_neighbour_table(
+			struct hillslope_object *hillslope)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int	i, d, j, r, n, k, ks, t;
+	int	num_entries, num_surface_entries;
+	struct	neighbour_table_object	*table;
+	struct	neighbour_key	*key;
+	struct	patch_object	*patch;
+
+	if (hillslope[0].route_list == NULL)
+		return(NULL);
+	table = (struct neighbour_table_object *) alloc(
+		sizeof(struct neighbour_table_object),
+		"table", "construct_neighbour_table");
+	table[0].num_patches = hillslope[0].route_list[0].num_patches;
+	table[0].first_row = (int *) alloc((table[0].num_patches + 1) * sizeof(int),
+		"first_row", "construct_neighbour_table");
+	table[0].sorted_depths = (int *) alloc((table[0].num_patches + 1) * sizeof(int),
+		"sorted_depths", "construct_neighbour_table");
+
+	/*--------------------------------------------------------------*/
+	/*	count rows and neighbours				*/
+	/*--------------------------------------------------------------*/
+	num_entries = 0;
+	num_surface_entries = 0;
+	table[0].num_rows = 0;
+	for (i = 0; i < table[0].num_patches; i++) {
+		patch = hillslope[0].route_list[0].list[i];
+		n = patch[0].num_innundation_depths;
+		table[0].first_row[i] = table[0].num_rows;
+		table[0].num_rows += max(n, 1);
+		for (d = 0; d < n; d++) {
+			if (patch[0].innundation_list != NULL)
+				num_entries += patch[0].innundation_list[d].num_neighbours;
+			if (patch[0].surface_innundation_list != NULL)
+				num_surface_entries += patch[0].surface_innundation_list[d].num_neighbours;
+		}
+	}
+	table[0].first_row[table[0].num_patches] = table[0].num_rows;
+
+	table[0].critical_depth = (double *) alloc(table[0].num_rows * sizeof(double),
+		"critical_depth", "construct_neighbour_table");
+	table[0].start = (int *) alloc((table[0].num_rows + 1) * sizeof(int),
+		"start", "construct_neighbour_table");
+	table[0].surface_start = (int *) alloc((table[0].num_rows + 1) * sizeof(int),
+		"surface_start", "construct_neighbour_table");
+	table[0].target = (int *) alloc(max(num_entries, 1) * sizeof(int),
+		"target", "construct_neighbour_table");
+	table[0].gamma = (double *) alloc(max(num_entries, 1) * sizeof(double),
+		"gamma", "construct_neighbour_table");
+	table[0].surface_target = (int *) alloc(max(num_surface_entries, 1) * sizeof(int),
+		"surface_target", "construct_neighbour_table");
+	table[0].surface_gamma = (double *) alloc(max(num_surface_entries, 1) * sizeof(double),
+		"surface_gamma", "construct_neighbour_table");
+	table[0].target_patch = (struct patch_object **) alloc(
+		(table[0].num_patches + num_entries + num_surface_entries + 1)
+		* sizeof(struct patch_object *),
+		"target_patch", "construct_neighbour_table");
+
+	/*--------------------------------------------------------------*/
+	/*	route list patches keep their route list index		*/
+	/*--------------------------------------------------------------*/
+	key = (struct neighbour_key *) alloc(
+		(table[0].num_patches + 1) * sizeof(struct neighbour_key),
+		"key", "construct_neighbour_table");
+	for (i = 0; i < table[0].num_patches; i++) {
+		table[0].target_patch[i] = hillslope[0].route_list[0].list[i];
+		key[i].patch = hillslope[0].route_list[0].list[i];
+		key[i].index = i;
+	}
+	qsort(key, table[0].num_patches, sizeof(struct neighbour_key),
+		compare_neighbour_key);
+	table[0].num_targets = table[0].num_patches;
+
+	/*--------------------------------------------------------------*/
+	/*	fill the rows						*/
+	/*--------------------------------------------------------------*/
+	k = 0;
+	ks = 0;
+	for (i = 0; i < table[0].num_patches; i++) {
+		patch = hillslope[0].route_list[0].list[i];
+		n = patch[0].num_innundation_depths;
+		table[0].sorted_depths[i] = 1;
+		for (r = table[0].first_row[i]; r < table[0].first_row[i+1]; r++) {
+			d = r - table[0].first_row[i];
+			table[0].start[r] = k;
+			table[0].surface_start[r] = ks;
+			table[0].critical_depth[r] = NULLVAL;
+			if (d >= n)
+				continue;
+			if (patch[0].innundation_list != NULL) {
+				table[0].critical_depth[r] = patch[0].innundation_list[d].critical_depth;
+				for (j = 0; j < patch[0].innundation_list[d].num_neighbours; j++) {
+					table[0].target[k] = find_target(table, key,
+						patch[0].innundation_list[d].neighbours[j].patch);
+					table[0].gamma[k] = patch[0].innundation_list[d].neighbours[j].gamma;
+					k++;
+				}
+			}
+			if (patch[0].surface_innundation_list != NULL) {
+				for (j = 0; j < patch[0].surface_innundation_list[d].num_neighbours; j++) {
+					table[0].surface_target[ks] = find_target(table, key,
+						patch[0].surface_innundation_list[d].neighbours[j].patch);
+					table[0].surface_gamma[ks] = patch[0].surface_innundation_list[d].neighbours[j].gamma;
+					ks++;
+				}
+			}
+			/*--------------------------------------------------------------*/
+			/*	the last depth is never compared			*/
+			/*--------------------------------------------------------------*/
+			if ((d > 0) && (d < n - 1)
+				&& !(table[0].critical_depth[r] >= table[0].critical_depth[r-1]))
+				table[0].sorted_depths[i] = 0;
+		}
+	}
+	table[0].start[table[0].num_rows] = k;
+	table[0].surface_start[table[0].num_rows] = ks;
+	free(key);
+
+	/*--------------------------------------------------------------*/
+	/*	group the entries by target; entries are in route list	*/
+	/*	order so each target keeps its sources in that order.	*/
+	/*	Only the first depth class routes subsurface water.	*/
+	/*--------------------------------------------------------------*/
+	table[0].inflow_start = (int *) calloc(table[0].num_targets + 1, sizeof(int));
+	table[0].surface_inflow_start = (int *) calloc(table[0].num_targets + 1, sizeof(int));
+	table[0].inflow_source = (int *) alloc(max(num_entries, 1) * sizeof(int),
+		"inflow_source", "construct_neighbour_table");
+	table[0].inflow_entry = (int *) alloc(max(num_entries, 1) * sizeof(int),
+		"inflow_entry", "construct_neighbour_table");
+	table[0].surface_inflow_source = (int *) alloc(max(num_surface_entries, 1) * sizeof(int),
+		"surface_inflow_source", "construct_neighbour_table");
+	table[0].surface_inflow_entry = (int *) alloc(max(num_surface_entries, 1) * sizeof(int),
+		"surface_inflow_entry", "construct_neighbour_table");
+	table[0].surface_inflow_row = (int *) alloc(max(num_surface_entries, 1) * sizeof(int),
+		"surface_inflow_row", "construct_neighbour_table");
+	if ((table[0].inflow_start == NULL) || (table[0].surface_inflow_start == NULL)) {
+		fprintf(stderr,"FATAL ERROR: out of memory in construct_neighbour_table\n");
+		exit(EXIT_FAILURE);
+	}
+	for (i = 0; i < table[0].num_patches; i++) {
+		r = table[0].first_row[i];
+		for (j = table[0].start[r]; j < table[0].start[r+1]; j++)
+			table[0].inflow_start[table[0].target[j] + 1]++;
+		for (j = table[0].surface_start[r]; j < table[0].surface_start[table[0].first_row[i+1]]; j++)
+			table[0].surface_inflow_start[table[0].surface_target[j] + 1]++;
+	}
+	for (t = 0; t < table[0].num_targets; t++) {
+		table[0].inflow_start[t+1] += table[0].inflow_start[t];
+		table[0].surface_inflow_start[t+1] += table[0].surface_inflow_start[t];
+	}
+	for (i = 0; i < table[0].num_patches; i++) {
+		for (r = table[0].first_row[i]; r < table[0].first_row[i+1]; r++) {
+			if (r == table[0].first_row[i]) {
+				for (j = table[0].start[r]; j < table[0].start[r+1]; j++) {
+					t = table[0].target[j];
+					k = table[0].inflow_start[t]++;
+					table[0].inflow_source[k] = i;
+					table[0].inflow_entry[k] = j;
+				}
+			}
+			for (j = table[0].surface_start[r]; j < table[0].surface_start[r+1]; j++) {
+				t = table[0].surface_target[j];
+				ks = table[0].surface_inflow_start[t]++;
+				table[0].surface_inflow_source[ks] = i;
+				table[0].surface_inflow_entry[ks] = j;
+				table[0].surface_inflow_row[ks] = r;
+			}
+		}
+	}
+	for (t = table[0].num_targets; t > 0; t--) {
+		table[0].inflow_start[t] = table[0].inflow_start[t-1];
+		table[0].surface_inflow_start[t] = table[0].surface_inflow_start[t-1];
+	}
+	table[0].inflow_start[0] = 0;
+	table[0].surface_inflow_start[0] = 0;
+
+	table[0].outflow = (double *) alloc(
+		(table[0].num_patches * NEIGHBOUR_NUM_FLUXES + 1) * sizeof(double),
+		"outflow", "construct_neighbour_table");
+	table[0].surface_row = (int *) alloc((table[0].num_patches + 1) * sizeof(int),
+		"surface_row", "construct_neighbour_table");
+	for (i = 0; i < table[0].num_patches; i++)
+		table[0].surface_row[i] = -1;
+
+	/*--------------------------------------------------------------*/
+	/*	segments of one drainage type				*/
+	/*--------------------------------------------------------------*/
+	table[0].segment_type = (int *) alloc((table[0].num_patches + 1) * sizeof(int),
+		"segment_type", "construct_neighbour_table");
+	table[0].segment_start = (int *) alloc((table[0].num_patches + 1) * sizeof(int),
+		"segment_start", "construct_neighbour_table");
+	table[0].num_segments = 0;
+	for (i = 0; i < table[0].num_patches; i++) {
+		t = hillslope[0].route_list[0].list[i][0].drainage_type;
+		if ((t != STREAM) && (t != ROAD))
+			t = 0;
+		if ((table[0].num_segments == 0)
+			|| (table[0].segment_type[table[0].num_segments - 1] != t)) {
+			table[0].segment_type[table[0].num_segments] = t;
+			table[0].segment_start[table[0].num_segments] = i;
+			table[0].num_segments++;
+		}
+	}
+	table[0].segment_start[table[0].num_segments] = table[0].num_patches;
+	return(table);
+} /*end construct_neighbour_table*/
+
+void	destroy_neighbour_table(struct neighbour_table_object *table)
+{
+	if (table == NULL)
+		return;
+	free(table[0].first_row);
+	free(table[0].sorted_depths);
+	free(table[0].critical_depth);
+	free(table[0].start);
+	free(table[0].target);
+	free(table[0].gamma);
+	free(table[0].surface_start);
+	free(table[0].surface_target);
+	free(table[0].surface_gamma);
+	free(table[0].target_patch);
+	free(table[0].inflow_start);
+	free(table[0].inflow_source);
+	free(table[0].inflow_entry);
+	free(table[0].surface_inflow_start);
+	free(table[0].surface_inflow_source);
+	free(table[0].surface_inflow_entry);
+	free(table[0].surface_inflow_row);
+	free(table[0].outflow);
+	free(table[0].surface_row);
+	free(table[0].segment_type);
+	free(table[0].segment_start);
+	free(table);
+} /*end destroy_neighbour_table*/
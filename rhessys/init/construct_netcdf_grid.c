@@ -25,6 +25,178 @@
 #include <math.h>
 #include "rhessys.h"
 
+enum CLIM_VARS {CLM_TMAX, CLM_TMIN, CLM_RAIN, CLM_HUSS, CLM_RMAX,
+                CLM_RMIN, CLM_RSDS, CLM_WAS, clim_vars_counts};
+
+/*--------------------------------------------------------------*/
+/*	clim sequences of a netcdf cell, filled by			*/
+/*	store_netcdf_clim						*/
+/*--------------------------------------------------------------*/
+static void allocate_netcdf_clim(struct base_station_object *base_station,
+                struct date *duration)
+{
+        void	*alloc( 	size_t, char *, char *);
+
+        /* For each daily clim structure allocate clim seqs for all required & optional clims */
+        base_station[0].daily_clim = (struct daily_clim_object *)
+                alloc(1*sizeof(struct daily_clim_object),"daily_clim","construct_netcdf_grid" );
+        //duration.day is a long that was passed into construct_ascii as a date struct
+        base_station[0].daily_clim[0].tmax = (double *) alloc(duration->day * sizeof(double),"tmax", "construct_netcdf_grid");
+        base_station[0].daily_clim[0].tmin = (double *) alloc(duration->day * sizeof(double),"tmin", "construct_netcdf_grid");
+        base_station[0].daily_clim[0].rain = (double *) alloc(duration->day * sizeof(double),"rain", "construct_netcdf_grid");
+#ifdef LIU_EXTEND_CLIM_VAR
+        base_station[0].daily_clim[0].relative_humidity_max = (double *) alloc(duration->day * sizeof(double),"relative_humidity_max", "construct_netcdf_grid");
+        base_station[0].daily_clim[0].relative_humidity_min = (double *) alloc(duration->day * sizeof(double),"relative_humidity_min", "construct_netcdf_grid");
+        base_station[0].daily_clim[0].relative_humidity     = (double *) alloc(duration->day * sizeof(double),"relative_humidity", "construct_netcdf_grid");
+        base_station[0].daily_clim[0].specific_humidity     = (double *) alloc(duration->day * sizeof(double),"specific_humidity", "construct_netcdf_grid");
+        base_station[0].daily_clim[0].surface_shortwave_rad = (double *) alloc(duration->day * sizeof(double),"surface_shortwave_rad", "construct_netcdf_grid");
+        base_station[0].daily_clim[0].wind                  = (double *) alloc(duration->day * sizeof(double),"wind", "construct_netcdf_grid");
+#else
+        base_station[0].daily_clim[0].relative_humidity = NULL;
+        base_station[0].daily_clim[0].wind              = NULL;
+#endif
+        /*--------------------------------------------------------------*/
+        /*	initialize the rest of the clim sequences as null	*/
+        /*--------------------------------------------------------------*/
+        base_station[0].daily_clim[0].atm_trans = NULL;
+        base_station[0].daily_clim[0].CO2 = NULL;
+        base_station[0].daily_clim[0].cloud_fraction = NULL;
+        base_station[0].daily_clim[0].cloud_opacity = NULL;
+        base_station[0].daily_clim[0].dayl = NULL;
+        base_station[0].daily_clim[0].Delta_T = NULL;
+        base_station[0].daily_clim[0].dewpoint = NULL;
+        base_station[0].daily_clim[0].base_station_effective_lai = NULL;
+        base_station[0].daily_clim[0].Kdown_diffuse = NULL;
+        base_station[0].daily_clim[0].Kdown_direct = NULL;
+        base_station[0].daily_clim[0].LAI_scalar = NULL;
+        base_station[0].daily_clim[0].Ldown = NULL;
+        base_station[0].daily_clim[0].PAR_diffuse = NULL;
+        base_station[0].daily_clim[0].PAR_direct = NULL;
+        base_station[0].daily_clim[0].daytime_rain_duration = NULL; 
+        base_station[0].daily_clim[0].snow = NULL;
+        base_station[0].daily_clim[0].tdewpoint = NULL;
+        base_station[0].daily_clim[0].tday = NULL;
+        base_station[0].daily_clim[0].tnight = NULL;
+        base_station[0].daily_clim[0].tnightmax = NULL;
+        base_station[0].daily_clim[0].tavg = NULL;
+        base_station[0].daily_clim[0].tsoil = NULL;
+        base_station[0].daily_clim[0].vpd = NULL;
+        base_station[0].daily_clim[0].ndep_NO3 = NULL;
+        base_station[0].daily_clim[0].ndep_NH4 = NULL;
+
+        /*--------------------------------------------------------------*/
+        /*	Allocate the yearly clim object.								*/
+        /*--------------------------------------------------------------*/
+        base_station[0].yearly_clim = (struct yearly_clim_object *)
+                alloc(1*sizeof(struct yearly_clim_object), "yearly_clim", "construct_netcdf_grid" );
+        /*	Initialize non-critical sequences							*/
+        base_station[0].yearly_clim[0].temp = NULL;		
+        /*--------------------------------------------------------------*/
+        /*	Allocate the monthly clim object.							*/	
+        /*--------------------------------------------------------------*/
+        base_station[0].monthly_clim = (struct monthly_clim_object *)
+                alloc(1*sizeof(struct monthly_clim_object), "monthly_clim", "construct_netcdf_grid" );
+        /*	Initialize non-critical sequences							*/
+        base_station[0].monthly_clim[0].temp = NULL;
+        /*--------------------------------------------------------------*/
+        /*	Allocate the hourly clim object.							*/
+        /*--------------------------------------------------------------*/
+        base_station[0].hourly_clim = (struct hourly_clim_object *)
+                alloc(1*sizeof(struct hourly_clim_object), "hourly_clim", "construct_netcdf_grid" );
+        /*	Initialize non - critical sequences.						*/
+        base_station[0].hourly_clim[0].rain.inx = -999;
+        base_station[0].hourly_clim[0].rain_duration.inx = -999;
+        return;
+}
+
+/*--------------------------------------------------------------*/
+/*	file and variable name of a clim variable; 0 if it is	*/
+/*	not read in this build						*/
+/*--------------------------------------------------------------*/
+static int netcdf_clim_file(struct base_station_ncheader_object *base_station_ncheader,
+                int var, char **filename, char **var_name)
+{
+    switch (var) {
+    case CLM_TMAX:
+        *filename = base_station_ncheader[0].netcdf_tmax_filename;
+        *var_name = base_station_ncheader[0].netcdf_tmax_varname;
+        break;
+    case CLM_TMIN:
+        *filename = base_station_ncheader[0].netcdf_tmin_filename;
+        *var_name = base_station_ncheader[0].netcdf_tmin_varname;
+        break;
+    case CLM_RAIN:
+        *filename = base_station_ncheader[0].netcdf_rain_filename;
+        *var_name = base_station_ncheader[0].netcdf_rain_varname;
+        break;
+#ifdef LIU_EXTEND_CLIM_VAR
+    case CLM_HUSS:
+        *filename = base_station_ncheader[0].netcdf_huss_filename;
+        *var_name = base_station_ncheader[0].netcdf_huss_varname;
+        break;
+    case CLM_RMAX:
+        *filename = base_station_ncheader[0].netcdf_rmax_filename;
+        *var_name = base_station_ncheader[0].netcdf_rmax_varname;
+        break;
+    case CLM_RMIN:
+        *filename = base_station_ncheader[0].netcdf_rmin_filename;
+        *var_name = base_station_ncheader[0].netcdf_rmin_varname;
+        break;
+    case CLM_RSDS:
+        *filename = base_station_ncheader[0].netcdf_rsds_filename;
+        *var_name = base_station_ncheader[0].netcdf_rsds_varname;
+        break;
+    case CLM_WAS:
+        *filename = base_station_ncheader[0].netcdf_was_filename;
+        *var_name = base_station_ncheader[0].netcdf_was_varname;
+        break;
+#endif
+    default:
+        return(0);
+    } //switch
+    return(1);
+}
+
+/*--------------------------------------------------------------*/
+/*	convert and store ndays values of clim variable var	*/
+/*--------------------------------------------------------------*/
+static void store_netcdf_clim(struct base_station_object *base_station,
+                struct base_station_ncheader_object *base_station_ncheader,
+                int var, float *tempdata, int ndays)
+{
+        int	j;
+
+        for (j=0;j<ndays;j++){
+            if (var == CLM_TMAX) {
+                if ((base_station_ncheader[0].temperature_unit == 'K') || (tempdata[j] > 150.0)) // kind of hard coded for temperature > 150
+                    base_station[0].daily_clim[0].tmax[j] =  (double)tempdata[j] - 273.15;
+                else
+                    base_station[0].daily_clim[0].tmax[j] =  (double)tempdata[j];
+            } else if (var == CLM_TMIN) {
+                if ((base_station_ncheader[0].temperature_unit == 'K') || (tempdata[j] > 150.0)) // kind of hard coded for temperature > 150
+                    base_station[0].daily_clim[0].tmin[j] =  (double)tempdata[j] - 273.15;
+                else
+                    base_station[0].daily_clim[0].tmin[j] =  (double)tempdata[j];
+            } else if (var == CLM_RAIN) {
+                base_station[0].daily_clim[0].rain[j] = (double)tempdata[j] * base_station_ncheader[0].precip_mult;
+            }
+#ifdef LIU_EXTEND_CLIM_VAR
+            else if (var == CLM_HUSS) {
+                base_station[0].daily_clim[0].specific_humidity[j] = (double)tempdata[j];
+            } else if (var == CLM_RMAX) {
+                base_station[0].daily_clim[0].relative_humidity_max[j] = (double)tempdata[j] * base_station_ncheader[0].rhum_mult;
+            } else if (var == CLM_RMIN) {
+                base_station[0].daily_clim[0].relative_humidity_min[j] = (double)tempdata[j] * base_station_ncheader[0].rhum_mult;
+            } else if (var == CLM_RSDS) {
+                base_station[0].daily_clim[0].surface_shortwave_rad[j] = (double)tempdata[j];
+            } else if (var == CLM_WAS) {
+                base_station[0].daily_clim[0].wind[j] = (double)tempdata[j];
+            }
+#endif
+        } //j
+        return;
+}
+
 struct base_station_object *construct_netcdf_grid (
 #ifdef LIU_NETCDF_READER
                 struct base_station_object *base_station_in,
@@ -147,81 +319,13 @@ struct base_station_object *construct_netcdf_grid (
         /* Allocate daily clim structures and clim seqs					*/
         /*--------------------------------------------------------------*/	
 
-        /* For each daily clim structure allocate clim seqs for all required & optional clims */
-        base_station[0].daily_clim = (struct daily_clim_object *)
-                alloc(1*sizeof(struct daily_clim_object),"daily_clim","construct_netcdf_grid" );
-        //duration.day is a long that was passed into construct_ascii as a date struct
-        base_station[0].daily_clim[0].tmax = (double *) alloc(duration->day * sizeof(double),"tmax", "construct_netcdf_grid");
-        base_station[0].daily_clim[0].tmin = (double *) alloc(duration->day * sizeof(double),"tmin", "construct_netcdf_grid");
-        base_station[0].daily_clim[0].rain = (double *) alloc(duration->day * sizeof(double),"rain", "construct_netcdf_grid");
-#ifdef LIU_EXTEND_CLIM_VAR
-        base_station[0].daily_clim[0].relative_humidity_max = (double *) alloc(duration->day * sizeof(double),"relative_humidity_max", "construct_netcdf_grid");
-        base_station[0].daily_clim[0].relative_humidity_min = (double *) alloc(duration->day * sizeof(double),"relative_humidity_min", "construct_netcdf_grid");
-        base_station[0].daily_clim[0].relative_humidity     = (double *) alloc(duration->day * sizeof(double),"relative_humidity", "construct_netcdf_grid");
-        base_station[0].daily_clim[0].specific_humidity     = (double *) alloc(duration->day * sizeof(double),"specific_humidity", "construct_netcdf_grid");
-        base_station[0].daily_clim[0].surface_shortwave_rad = (double *) alloc(duration->day * sizeof(double),"surface_shortwave_rad", "construct_netcdf_grid");
-        base_station[0].daily_clim[0].wind                  = (double *) alloc(duration->day * sizeof(double),"wind", "construct_netcdf_grid");
-#else
-        base_station[0].daily_clim[0].relative_humidity = NULL;
-        base_station[0].daily_clim[0].wind              = NULL;
-#endif
-        /*--------------------------------------------------------------*/
-        /*	initialize the rest of the clim sequences as null	*/
-        /*--------------------------------------------------------------*/
-        base_station[0].daily_clim[0].atm_trans = NULL;
-        base_station[0].daily_clim[0].CO2 = NULL;
-        base_station[0].daily_clim[0].cloud_fraction = NULL;
-        base_station[0].daily_clim[0].cloud_opacity = NULL;
-        base_station[0].daily_clim[0].dayl = NULL;
-        base_station[0].daily_clim[0].Delta_T = NULL;
-        base_station[0].daily_clim[0].dewpoint = NULL;
-        base_station[0].daily_clim[0].base_station_effective_lai = NULL;
-        base_station[0].daily_clim[0].Kdown_diffuse = NULL;
-        base_station[0].daily_clim[0].Kdown_direct = NULL;
-        base_station[0].daily_clim[0].LAI_scalar = NULL;
-        base_station[0].daily_clim[0].Ldown = NULL;
-        base_station[0].daily_clim[0].PAR_diffuse = NULL;
-        base_station[0].daily_clim[0].PAR_direct = NULL;
-        base_station[0].daily_clim[0].daytime_rain_duration = NULL; 
-        base_station[0].daily_clim[0].snow = NULL;
-        base_station[0].daily_clim[0].tdewpoint = NULL;
-        base_station[0].daily_clim[0].tday = NULL;
-        base_station[0].daily_clim[0].tnight = NULL;
-        base_station[0].daily_clim[0].tnightmax = NULL;
-        base_station[0].daily_clim[0].tavg = NULL;
-        base_station[0].daily_clim[0].tsoil = NULL;
-        base_station[0].daily_clim[0].vpd = NULL;
-        base_station[0].daily_clim[0].ndep_NO3 = NULL;
-        base_station[0].daily_clim[0].ndep_NH4 = NULL;
-
+        allocate_netcdf_clim(base_station, duration);
         /*Check if any flags are set in the optional clim sequence struct*/
         if ( daily_flags.daytime_rain_duration == 1 ) {
                 base_station[0].daily_clim[0].daytime_rain_duration = (double *) 
                         alloc(duration->day * sizeof(double),"day_rain_dur", "construct_netcdf_grid");
 
         }
-        /*--------------------------------------------------------------*/
-        /*	Allocate the yearly clim object.								*/
-        /*--------------------------------------------------------------*/
-        base_station[0].yearly_clim = (struct yearly_clim_object *)
-                alloc(1*sizeof(struct yearly_clim_object), "yearly_clim", "construct_netcdf_grid" );
-        /*	Initialize non-critical sequences							*/
-        base_station[0].yearly_clim[0].temp = NULL;		
-        /*--------------------------------------------------------------*/
-        /*	Allocate the monthly clim object.							*/	
-        /*--------------------------------------------------------------*/
-        base_station[0].monthly_clim = (struct monthly_clim_object *)
-                alloc(1*sizeof(struct monthly_clim_object), "monthly_clim", "construct_netcdf_grid" );
-        /*	Initialize non-critical sequences							*/
-        base_station[0].monthly_clim[0].temp = NULL;
-        /*--------------------------------------------------------------*/
-        /*	Allocate the hourly clim object.							*/
-        /*--------------------------------------------------------------*/
-        base_station[0].hourly_clim = (struct hourly_clim_object *)
-                alloc(1*sizeof(struct hourly_clim_object), "hourly_clim", "construct_netcdf_grid" );
-        /*	Initialize non - critical sequences.						*/
-        base_station[0].hourly_clim[0].rain.inx = -999;
-        base_station[0].hourly_clim[0].rain_duration.inx = -999;
         /* Calculate start day index */
         instartday = get_indays((int)start_date->year,
                         (int)start_date->month,
@@ -234,49 +338,11 @@ struct base_station_object *construct_netcdf_grid (
         //}
         /* printf("net_y:%f net_x:%f\n",base_station[0].net_y,base_station[0].net_x);
            printf("tmax filename:%s varname:%s sdist:%f instartday:%d dura:%d\n",base_station[0].netcdf_tmax_filename, base_station[0].netcdf_tmax_varname,base_station[0].sdist,instartday,duration.day); */
-        enum CLIM_VARS {CLM_TMAX, CLM_TMIN, CLM_RAIN, CLM_HUSS, CLM_RMAX,
-                        CLM_RMIN, CLM_RSDS, CLM_WAS, clim_vars_counts};
         for (int var = 0; var < clim_vars_counts; var ++) {
             char *filename;
             char *var_name;
-            switch (var) {
-            case CLM_TMAX:
-                filename = base_station_ncheader[0].netcdf_tmax_filename;
-                var_name = base_station_ncheader[0].netcdf_tmax_varname;
-                break;
-            case CLM_TMIN:
-                filename = base_station_ncheader[0].netcdf_tmin_filename;
-                var_name = base_station_ncheader[0].netcdf_tmin_varname;
-                break;
-            case CLM_RAIN:
-                filename = base_station_ncheader[0].netcdf_rain_filename;
-                var_name = base_station_ncheader[0].netcdf_rain_varname;
-                break;
-#ifdef LIU_EXTEND_CLIM_VAR
-            case CLM_HUSS:
-                filename = base_station_ncheader[0].netcdf_huss_filename;
-                var_name = base_station_ncheader[0].netcdf_huss_varname;
-                break;
-            case CLM_RMAX:
-                filename = base_station_ncheader[0].netcdf_rmax_filename;
-                var_name = base_station_ncheader[0].netcdf_rmax_varname;
-                break;
-            case CLM_RMIN:
-                filename = base_station_ncheader[0].netcdf_rmin_filename;
-                var_name = base_station_ncheader[0].netcdf_rmin_varname;
-                break;
-            case CLM_RSDS:
-                filename = base_station_ncheader[0].netcdf_rsds_filename;
-                var_name = base_station_ncheader[0].netcdf_rsds_varname;
-                break;
-            case CLM_WAS:
-                filename = base_station_ncheader[0].netcdf_was_filename;
-                var_name = base_station_ncheader[0].netcdf_was_varname;
-                break;
-#endif
-            default:
-                break;
-            } //switch
+            if (!netcdf_clim_file(base_station_ncheader, var, &filename, &var_name))
+                continue;
             k = get_netcdf_var_timeserias(filename, var_name, lat_name,
                    lon_name, net_y, net_x,
                    (float)base_station_ncheader[0].resolution_dd, instartday,
@@ -286,34 +352,7 @@ struct base_station_object *construct_netcdf_grid (
                 fprintf(stderr,"can't locate station data in netcdf for var %s\n", var_name);
                 exit(0);
             }
-            for (j=0;j<duration->day;j++){
-                if (var == CLM_TMAX) {
-                    if ((base_station_ncheader[0].temperature_unit == 'K') || (tempdata[j] > 150.0)) // kind of hard coded for temperature > 150
-                        base_station[0].daily_clim[0].tmax[j] =  (double)tempdata[j] - 273.15;
-                    else
-                        base_station[0].daily_clim[0].tmax[j] =  (double)tempdata[j];
-                } else if (var == CLM_TMIN) {
-                    if ((base_station_ncheader[0].temperature_unit == 'K') || (tempdata[j] > 150.0)) // kind of hard coded for temperature > 150
-                        base_station[0].daily_clim[0].tmin[j] =  (double)tempdata[j] - 273.15;
-                    else
-                        base_station[0].daily_clim[0].tmin[j] =  (double)tempdata[j];
-                } else if (var == CLM_RAIN) {
-                    base_station[0].daily_clim[0].rain[j] = (double)tempdata[j] * base_station_ncheader[0].precip_mult;
-                }
-#ifdef LIU_EXTEND_CLIM_VAR
-                else if (var == CLM_HUSS) {
-                    base_station[0].daily_clim[0].specific_humidity[j] = (double)tempdata[j];
-                } else if (var == CLM_RMAX) {
-                    base_station[0].daily_clim[0].relative_humidity_max[j] = (double)tempdata[j] * base_station_ncheader[0].rhum_mult;
-                } else if (var == CLM_RMIN) {
-                    base_station[0].daily_clim[0].relative_humidity_min[j] = (double)tempdata[j] * base_station_ncheader[0].rhum_mult;
-                } else if (var == CLM_RSDS) {
-                    base_station[0].daily_clim[0].surface_shortwave_rad[j] = (double)tempdata[j];
-                } else if (var == CLM_WAS) {
-                    base_station[0].daily_clim[0].wind[j] = (double)tempdata[j];
-                }
-#endif
-            } //j
+            store_netcdf_clim(base_station, base_station_ncheader, var, tempdata, (int)duration->day);
         } //var
 #ifdef LIU_EXTEND_CLIM_VAR
         for (j=0;j<duration->day;j++) {
@@ -387,3 +426,94 @@ struct base_station_object *construct_netcdf_grid (
         return(base_station);
 }
 
+
+/*--------------------------------------------------------------*/
+/*	construct_netcdf_grids - loads the clim sequences of the	*/
+/*	num_base_stations cells in base_stations, which construct_world	*/
+/*	has cut down to the cells the zones use.  Each variable is	*/
+/*	read for all cells in one pass over its file.		*/
+/*--------------------------------------------------------------*/
+void construct_netcdf_grids(
+                struct base_station_object **base_stations,
+                int		num_base_stations,
+                struct base_station_ncheader_object *base_station_ncheader,
+                struct		date *start_date,
+                struct		date *duration,
+                struct command_line_object *command_line)
+{
+        void	*alloc( 	size_t, char *, char *);
+
+        int	c, k, ndays, instartday;
+        float	*lat, *lon, *tempdata;
+        char	*filename, *var_name;
+        char	*lat_name = "lat";
+        char	*lon_name = "lon";
+
+        if (num_base_stations < 1)
+                return;
+        ndays = (int)duration->day;
+        lat = (float *) alloc(num_base_stations * sizeof(float),"lat","construct_netcdf_grids");
+        lon = (float *) alloc(num_base_stations * sizeof(float),"lon","construct_netcdf_grids");
+        tempdata = (float *) alloc((size_t)num_base_stations * ndays * sizeof(float),"tempdata","construct_netcdf_grids");
+        for (c = 0; c < num_base_stations; c++) {
+                lat[c] = base_stations[c][0].lat;
+                lon[c] = base_stations[c][0].lon;
+                allocate_netcdf_clim(base_stations[c], duration);
+        }
+
+        instartday = get_indays((int)start_date->year,
+                        (int)start_date->month,
+                        (int)start_date->day,
+                        base_station_ncheader[0].year_start,
+                        base_station_ncheader[0].leap_year);
+
+        for (int var = 0; var < clim_vars_counts; var ++) {
+            if (!netcdf_clim_file(base_station_ncheader, var, &filename, &var_name))
+                continue;
+            k = get_netcdf_var_timeseries_cells(filename, var_name, lat_name,
+                   lon_name, num_base_stations, lat, lon,
+                   (float)base_station_ncheader[0].resolution_dd, instartday,
+                   base_station_ncheader[0].day_offset, ndays,
+                   command_line[0].clim_repeat_flag, tempdata);
+            if (k == -1){
+                fprintf(stderr,"can't locate station data in netcdf for var %s\n", var_name);
+                exit(0);
+            }
+            for (c = 0; c < num_base_stations; c++)
+                store_netcdf_clim(base_stations[c], base_station_ncheader, var,
+                        &tempdata[(size_t)c * ndays], ndays);
+        } //var
+#ifdef LIU_EXTEND_CLIM_VAR
+        for (c = 0; c < num_base_stations; c++) {
+            struct  daily_clim_object *daily_clim = &base_stations[c][0].daily_clim[0];
+            for (int j=0;j<ndays;j++)
+                daily_clim->relative_humidity[j] =
+                    (daily_clim->relative_humidity_max[j]
+                     + daily_clim->relative_humidity_min[j]) / 2.0;
+        }
+#endif
+
+        /* ------------------ ELEV ------------------ */
+        if (base_station_ncheader[0].elevflag == 1) {
+                k = get_netcdf_var_cells(
+                                base_station_ncheader[0].netcdf_elev_filename,
+                                base_station_ncheader[0].netcdf_elev_varname,
+                                lat_name,
+                                lon_name,
+                                num_base_stations, lat, lon,
+                                (float)base_station_ncheader[0].resolution_dd,
+                                tempdata);
+                if (k == -1){
+                        fprintf(stderr,"can't locate station data in netcdf for var elev\n");
+                        exit(0);
+                }
+                for (c = 0; c < num_base_stations; c++)
+                        base_stations[c][0].z = (double)tempdata[c];
+        }
+
+        free(tempdata);
+        free(lat);
+        free(lon);
+        printf("\nLoaded %d netcdf grid cells\n", num_base_stations);
+        return;
+}
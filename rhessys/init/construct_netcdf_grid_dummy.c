@@ -53,3 +53,14 @@ struct base_station_object *construct_netcdf_grid(
   return(base_station);
 }
 
+
+void construct_netcdf_grids(
+                struct base_station_object **base_stations,
+                int     num_base_stations,
+                struct base_station_ncheader_object *base_station_ncheader,
+                struct    date *start_date,
+                struct    date *duration,
+                struct command_line_object *command_line)
+{
+  return;
+}
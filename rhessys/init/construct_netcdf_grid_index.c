@@ -0,0 +1,208 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		construct_netcdf_grid_index			*/
+/*								*/
+/*	NAME							*/
+/*	construct_netcdf_grid_index - in memory lookup of the	*/
+/*		cells of a netcdf base station header		*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	struct netcdf_grid_index_object *construct_netcdf_grid_index(	*/
+/*			struct base_station_object **,		*/
+/*			int,					*/
+/*			struct base_station_ncheader_object *)	*/
+/*	struct base_station_object *find_netcdf_grid_station_ID(	*/
+/*			struct netcdf_grid_index_object *, int)	*/
+/*	int	find_netcdf_grid_cell(				*/
+/*			struct netcdf_grid_index_object *,	*/
+/*			float, float, float, float *, float *)	*/
+/*	void	destroy_netcdf_grid_index(			*/
+/*			struct netcdf_grid_index_object *)	*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	Built once by construct_world after the base station	*/
+/*	header is read, so that construct_zone resolves each	*/
+/*	zone's cell without any file i/o or scan of the whole	*/
+/*	header.  Stations are sorted by ID; when zones are	*/
+/*	matched by location (FIND_STATION_BASED_ON_ID not	*/
+/*	defined) the x and y axes of the tmax file are read	*/
+/*	once and each station is placed in its row and column.	*/
+/*	Lookups only read the index and are safe to call from	*/
+/*	parallel zone construction.  The index points into the	*/
+/*	full station list, so construct_world destroys it	*/
+/*	before dropping the unused cells.			*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "rhessys.h"
+
+static int compare_station_ID(const void *a, const void *b)
+{
+	int	ida, idb;
+
+	ida = (*(struct base_station_object * const *)a)[0].ID;
+	idb = (*(struct base_station_object * const *)b)[0].ID;
+	return((ida > idb) - (ida < idb));
+}
+
+/*--------------------------------------------------------------*/
+/*	nearest entry of a monotonic axis to v, or -1 if it is	*/
+/*	further than md (as locate in read_netcdf.c)		*/
+/*--------------------------------------------------------------*/
+static int nearest_axis_index(float *axis, int n, float v, float md)
+{
+	int	ascnd, jl, ju, jm;
+
+	if (n < 1)
+		return(-1);
+	if (n == 1)
+		return((fabs(axis[0] - v) <= md) ? 0 : -1);
+	ascnd = (axis[n-1] >= axis[0]);
+	jl = 0;
+	ju = n - 1;
+	while ((ju - jl) > 1) {
+		jm = (ju + jl) >> 1;
+		if ((v >= axis[jm]) == ascnd)
+			jl = jm;
+		else
+			ju = jm;
+	}
+	if (fabs(axis[jl] - v) <= fabs(axis[ju] - v))
+		return((fabs(axis[jl] - v) <= md) ? jl : -1);
+	return((fabs(axis[ju] - v) <= md) ? ju : -1);
+}
+
+struct netcdf_grid_index_object *construct_netcdf_grid_index(
+			struct base_station_object **base_stations,
+			int num_base_stations,
+			struct base_station_ncheader_object *base_station_ncheader)
+{
+	void	*alloc(size_t, char *, char *);
+
+	struct	netcdf_grid_index_object *index;
+	int	i;
+#ifndef FIND_STATION_BASED_ON_ID
+	int	get_netcdf_axes(char *, char *, char *, int *, float **, int *, float **);
+	int	iy, ix;
+	struct	base_station_object *station;
+#endif
+
+	index = (struct netcdf_grid_index_object *)
+		alloc(sizeof(struct netcdf_grid_index_object),
+		"grid_index", "construct_netcdf_grid_index");
+	index[0].num_stations = num_base_stations;
+	index[0].by_ID = (struct base_station_object **)
+		alloc(max(num_base_stations, 1) * sizeof(struct base_station_object *),
+		"by_ID", "construct_netcdf_grid_index");
+	for (i = 0; i < num_base_stations; i++)
+		index[0].by_ID[i] = base_stations[i];
+	qsort(index[0].by_ID, num_base_stations, sizeof(struct base_station_object *),
+		compare_station_ID);
+	index[0].ny = 0;
+	index[0].nx = 0;
+	index[0].y = NULL;
+	index[0].x = NULL;
+	index[0].cells = NULL;
+
+#ifndef FIND_STATION_BASED_ON_ID
+	if (get_netcdf_axes(base_station_ncheader[0].netcdf_tmax_filename,
+			base_station_ncheader[0].netcdf_y_varname,
+			base_station_ncheader[0].netcdf_x_varname,
+			&(index[0].ny), &(index[0].y),
+			&(index[0].nx), &(index[0].x)) == -1) {
+		fprintf(stderr, "FATAL ERROR: in construct_netcdf_grid_index cannot read the coordinates of %s\n",
+			base_station_ncheader[0].netcdf_tmax_filename);
+		exit(EXIT_FAILURE);
+	}
+	index[0].cells = (struct base_station_object **)
+		calloc((size_t)index[0].ny * index[0].nx, sizeof(struct base_station_object *));
+	if (index[0].cells == NULL) {
+		fprintf(stderr, "FATAL ERROR: in construct_netcdf_grid_index cannot allocate %d x %d cells\n",
+			index[0].ny, index[0].nx);
+		exit(EXIT_FAILURE);
+	}
+	/* a station sits in the cell its projected or geographic coordinates fall in */
+	for (i = 0; i < num_base_stations; i++) {
+		station = base_stations[i];
+		iy = nearest_axis_index(index[0].y, index[0].ny, station[0].proj_y,
+			base_station_ncheader[0].resolution_meter / 2.0);
+		ix = nearest_axis_index(index[0].x, index[0].nx, station[0].proj_x,
+			base_station_ncheader[0].resolution_meter / 2.0);
+		if ((iy == -1) || (ix == -1)) {
+			iy = nearest_axis_index(index[0].y, index[0].ny, station[0].lat,
+				base_station_ncheader[0].resolution_dd / 2.0);
+			ix = nearest_axis_index(index[0].x, index[0].nx, station[0].lon,
+				base_station_ncheader[0].resolution_dd / 2.0);
+		}
+		if ((iy != -1) && (ix != -1) && (index[0].cells[iy * index[0].nx + ix] == NULL))
+			index[0].cells[iy * index[0].nx + ix] = station;
+	}
+#endif
+	return(index);
+} /*end construct_netcdf_grid_index*/
+
+struct base_station_object *find_netcdf_grid_station_ID(
+			struct netcdf_grid_index_object *index,
+			int ID)
+{
+	int	lo, hi, mid;
+
+	lo = 0;
+	hi = index[0].num_stations - 1;
+	while (lo <= hi) {
+		mid = (lo + hi) >> 1;
+		if (index[0].by_ID[mid][0].ID == ID)
+			return(index[0].by_ID[mid]);
+		if (index[0].by_ID[mid][0].ID < ID)
+			lo = mid + 1;
+		else
+			hi = mid - 1;
+	}
+	return(NULL);
+} /*end find_netcdf_grid_station_ID*/
+
+/*--------------------------------------------------------------*/
+/*	cell (row * nx + column) nearest to (y, x) within sd,	*/
+/*	with its centre in cell_y, cell_x; -1 if none is near	*/
+/*	enough.  index->cells of it is NULL if no station of	*/
+/*	the header lies in it.						*/
+/*--------------------------------------------------------------*/
+int	find_netcdf_grid_cell(
+			struct netcdf_grid_index_object *index,
+			float y,
+			float x,
+			float sd,
+			float *cell_y,
+			float *cell_x)
+{
+	int	iy, ix;
+
+	if (index[0].cells == NULL)
+		return(-1);
+	iy = nearest_axis_index(index[0].y, index[0].ny, y, sd);
+	ix = nearest_axis_index(index[0].x, index[0].nx, x, sd);
+	if ((iy == -1) || (ix == -1))
+		return(-1);
+	*cell_y = index[0].y[iy];
+	*cell_x = index[0].x[ix];
+	return(iy * index[0].nx + ix);
+} /*end find_netcdf_grid_cell*/
+
+void destroy_netcdf_grid_index(struct netcdf_grid_index_object *index)
+{
+	if (index == NULL)
+		return;
+	free(index[0].by_ID);
+	if (index[0].y != NULL)
+		free(index[0].y);
+	if (index[0].x != NULL)
+		free(index[0].x);
+	if (index[0].cells != NULL)
+		free(index[0].cells);
+	free(index);
+	return;
+} /*end destroy_netcdf_grid_index*/
@@ -97,6 +97,7 @@ struct base_station_ncheader_object *construct_netcdf_header (
     #endif
 	base_station_ncheader[0].lastID = 0;
 	base_station_ncheader[0].elevflag = 0;
+	base_station_ncheader[0].grid_index = NULL;
     #ifdef LIU_NETCDF_READER
     for (int i = 0; i < world[0].num_base_stations; i++) {
         struct  base_station_object *basestation = world[0].base_stations[i];
@@ -107,7 +108,8 @@ struct base_station_ncheader_object *construct_netcdf_header (
         basestation[0].proj_y           = -9999;
         basestation[0].lat              = -9999;
         basestation[0].lon              = -9999;
-        //basestation[0].has_constructed  = 0;
+        basestation[0].referenced       = 0;
+        basestation[0].daily_clim       = NULL;
     }
     #endif
 	 
@@ -39,12 +39,13 @@ struct	world_output_file_object *construct_output_files(
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.									*/
 	/*--------------------------------------------------------------*/
-	struct	output_files_object	*construct_output_fileset(char *);
+	struct	output_files_object	*construct_output_fileset(char *, char *);
 	void	*alloc(	size_t, char *, char *);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
 	char	root[256];
+	char	*mode;
 	struct	world_output_file_object	*world_output_file = NULL;
 	/*--------------------------------------------------------------*/
 	/*	Allocate a world output file object if any output is        */
@@ -62,13 +63,20 @@ struct	world_output_file_object *construct_output_files(
 			"WARNING: in construct_output_file no output has been selected.\n");
 		return(world_output_file);
 	}
+	/*--------------------------------------------------------------*/
+	/*	A resumed run writes on after the output it already has.	*/
+	/*--------------------------------------------------------------*/
+	if ( command_line[0].restart_flag == 1 )
+		mode = "r+";
+	else
+		mode = "w";
 /*--------------------------------------------------------------*/
 	/*	Construct the stream_routing output files.							*/
 	/*--------------------------------------------------------------*/
 	if ( command_line[0].stro != NULL ){
 		strcpy(root,prefix);
 		strcat(root, "_streamrouting");
-		world_output_file[0].stream_routing = construct_output_fileset(root);
+		world_output_file[0].stream_routing = construct_output_fileset(root, mode);
 	}
 	/*--------------------------------------------------------------*/
 	/*	Construct the basin output files.							*/
@@ -76,7 +84,7 @@ struct	world_output_file_object *construct_output_files(
 	if ( command_line[0].b != NULL ){
 		strcpy(root,prefix);
 		strcat(root, "_basin");
-		world_output_file[0].basin = construct_output_fileset(root);
+		world_output_file[0].basin = construct_output_fileset(root, mode);
 	}
 	/*--------------------------------------------------------------*/
 	/*	Construct the hillslope output files.						*/
@@ -84,7 +92,7 @@ struct	world_output_file_object *construct_output_files(
 	if ( command_line[0].h != NULL ){
 		strcpy(root,prefix);
 		strcat(root, "_hillslope");
-		world_output_file[0].hillslope = construct_output_fileset(root);
+		world_output_file[0].hillslope = construct_output_fileset(root, mode);
 	}
 	/*--------------------------------------------------------------*/
 	/*	Construct the zone output files.							*/
@@ -92,7 +100,7 @@ struct	world_output_file_object *construct_output_files(
 	if ( command_line[0].z != NULL ){
 		strcpy(root, prefix);
 		strcat(root, "_zone");
-		world_output_file[0].zone = construct_output_fileset(root);
+		world_output_file[0].zone = construct_output_fileset(root, mode);
 	}
 	/*--------------------------------------------------------------*/
 	/*	Construct the patch output files.							*/
@@ -100,7 +108,7 @@ struct	world_output_file_object *construct_output_files(
 	if ( command_line[0].p != NULL ){
 		strcpy(root, prefix);
 		strcat(root, "_patch");
-		world_output_file[0].patch = construct_output_fileset(root);
+		world_output_file[0].patch = construct_output_fileset(root, mode);
 	}
 	/*--------------------------------------------------------------*/
 	/*	Construct the canopy stratum output files.					*/
@@ -109,7 +117,7 @@ struct	world_output_file_object *construct_output_files(
 	if ( (command_line[0].c != NULL) || (command_line[0].p != NULL ) ){
 		strcpy(root, prefix);
 		strcat(root, "_stratum");
-		world_output_file[0].canopy_stratum = construct_output_fileset(root);
+		world_output_file[0].canopy_stratum = construct_output_fileset(root, mode);
   	}
 	/*--------------------------------------------------------------*/
 	/*	Construct the fire output files.							*/
@@ -117,12 +125,12 @@ struct	world_output_file_object *construct_output_files(
 	if ( command_line[0].f != NULL ){
 		strcpy(root,prefix);
 		strcat(root, "_fire");
-		world_output_file[0].fire = construct_output_fileset(root);
+		world_output_file[0].fire = construct_output_fileset(root, mode);
 	}
  if (command_line[0].vegspinup_flag > ZERO)  {
 	  strcpy(root, prefix);
 		strcat(root, "_shadow_stratum");
-		world_output_file[0].shadow_strata = construct_output_fileset(root);
+		world_output_file[0].shadow_strata = construct_output_fileset(root, mode);
   }
 	fprintf(stderr,"FINISHED CONSTRUCT OUTPUT FILES\n");
 	return(world_output_file);
@@ -11,7 +11,8 @@
 /*																*/
 /*	SYNOPSIS													*/
 /*	struct	output_file_object	*construct_output_fileset(		*/
-/*								char	*root)					*/
+/*								char	*root,					*/
+/*								char	*mode)					*/
 /*																*/
 /*	OPTIONS														*/
 /*																*/
@@ -21,6 +22,10 @@
 /*	hourly output for all simulation objects at a single level	*/
 /*	in the spatial hierarchy.									*/
 /*																*/
+/*	mode is passed to fopen: "w" for a new run, "r+" to keep	*/
+/*	the output of a run resumed with -restart.					*/
+/*	Each file gets an OUTPUT_FILE_BUFFER byte stdio buffer.	*/
+/*																*/
 /*																*/
 /*	PROGRAMMER NOTES											*/
 /*																*/
@@ -39,7 +44,8 @@
 
 
 struct	output_files_object	*construct_output_fileset(
-													  char	*root)
+													  char	*root,
+													  char	*mode)
 {
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.									*/
@@ -58,27 +64,31 @@ struct	output_files_object	*construct_output_fileset(
 		"fileset","construct_output_fileset");
 	strcpy(filename, root);
 	strcat(filename,".yearly");
-	if ( (fileset[0].yearly = fopen(filename , "w")) == NULL ){
+	if ( (fileset[0].yearly = fopen(filename , mode)) == NULL ){
 		fprintf(stderr,"FATAL ERROR: in construct_output_fileset.\n");
 		exit(EXIT_FAILURE);
 	} /*end if*/
+	setvbuf(fileset[0].yearly, NULL, _IOFBF, OUTPUT_FILE_BUFFER);
 	strcpy(filename, root);
 	strcat(filename,".monthly");
-	if ( (fileset[0].monthly = fopen(filename , "w"))== NULL ){
+	if ( (fileset[0].monthly = fopen(filename , mode))== NULL ){
 		fprintf(stderr,"FATAL ERROR: in construct_output_fileset.\n");
 		exit(EXIT_FAILURE);
 	} /*end if*/
+	setvbuf(fileset[0].monthly, NULL, _IOFBF, OUTPUT_FILE_BUFFER);
 	strcpy(filename, root);
 	strcat(filename,".daily");
-	if ( (fileset[0].daily = fopen(filename , "w"))	== NULL ){
+	if ( (fileset[0].daily = fopen(filename , mode))	== NULL ){
 		fprintf(stderr,"FATAL ERROR: in construct_output_file.\n");
 		exit(EXIT_FAILURE);
 	} /*end if*/
+	setvbuf(fileset[0].daily, NULL, _IOFBF, OUTPUT_FILE_BUFFER);
 	strcpy(filename, root);
 	strcat(filename,".hourly");
-	if ( (fileset[0].hourly = fopen(filename , "w")) == NULL ) {
+	if ( (fileset[0].hourly = fopen(filename , mode)) == NULL ) {
 		fprintf(stderr,"FATAL ERROR: in construct_output_file.\n");
 		exit(EXIT_FAILURE);
 	} /*end if*/
+	setvbuf(fileset[0].hourly, NULL, _IOFBF, OUTPUT_FILE_BUFFER);
 	return(fileset);
 } /*end construct_output_fileset*/
@@ -144,6 +144,7 @@ struct patch_object *construct_patch(
 		patch[0].std = patch[0].std*command_line[0].std_scale;
 		}
 	else patch[0].std = 0.0;
+	patch[0].varflow_table = NULL;
 	patch[0].rz_storage = getDoubleWorldfile(&paramCnt,&paramPtr,"rz_storage","%lf",0,1);
 	patch[0].unsat_storage = getDoubleWorldfile(&paramCnt,&paramPtr,"unsat_storage","%lf",0,1);
 	patch[0].sat_deficit = getDoubleWorldfile(&paramCnt,&paramPtr,"sat_deficit","%lf",1,1);
@@ -459,6 +460,10 @@ struct patch_object *construct_patch(
 	patch[0].surface_energy_profile[0].psi_air_entry = 0.20;
 	patch[0].surface_energy_profile[0].pore_size_index = 0.2;
 
+	patch[0].surface_energy_profile[1].porosity = patch[0].soil_defaults[0][0].porosity_0;
+	patch[0].surface_energy_profile[2].porosity = patch[0].soil_defaults[0][0].porosity_0;
+	patch[0].surface_energy_profile[3].porosity = patch[0].soil_defaults[0][0].porosity_0;
+
 	patch[0].surface_energy_profile[1].psi_air_entry = patch[0].soil_defaults[0][0].psi_air_entry;
 	patch[0].surface_energy_profile[2].psi_air_entry = patch[0].soil_defaults[0][0].psi_air_entry;
 	patch[0].surface_energy_profile[3].psi_air_entry = patch[0].soil_defaults[0][0].psi_air_entry;
@@ -473,6 +478,11 @@ struct patch_object *construct_patch(
 	patch[0].rootzone.T = -999.0;
 		
 	}
+	/*--------------------------------------------------------------*/
+	/* soil temperature is only set with -surfaceenergy, and then	*/
+	/* first at the end of the day, so start it at 0 C		*/
+	/*--------------------------------------------------------------*/
+	patch[0].Tsoil = 0.0;
 
 
 	/*--------------------------------------------------------------*/
@@ -665,6 +675,11 @@ struct patch_object *construct_patch(
 	/*--------------------------------------------------------------*/
 	patch[0].layers = (struct layer_object *) alloc( patch[0].num_canopy_strata *
 		sizeof( struct layer_object ),"layers","construct_patch");
+	for ( i=0 ; i<patch[0].num_canopy_strata ; i++ ){
+		patch[0].layers[i].strata = (long *) alloc( patch[0].num_canopy_strata *
+			sizeof(long),"layers[i].strata","construct_patch");
+		patch[0].layers[i].count = 0;
+	}
 	patch[0].num_layers = 0;
 	sort_patch_layers(patch);
 
@@ -419,6 +419,11 @@ struct patch_object *construct_patch(
 	/*--------------------------------------------------------------*/
 	patch[0].layers = (struct layer_object *) alloc( patch[0].num_canopy_strata *
 		sizeof( struct layer_object ),"layers","construct_patch");
+	for ( i=0 ; i<patch[0].num_canopy_strata ; i++ ){
+		patch[0].layers[i].strata = (long *) alloc( patch[0].num_canopy_strata *
+			sizeof(long),"layers[i].strata","construct_patch");
+		patch[0].layers[i].count = 0;
+	}
 	patch[0].num_layers = 0;
 	sort_patch_layers(patch);
 	
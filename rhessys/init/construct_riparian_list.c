@@ -0,0 +1,68 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		construct_riparian_list				*/
+/*								*/
+/*	NAME							*/
+/*	construct_riparian_list - list the riparian patches of	*/
+/*			a hillslope				*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	void	construct_riparian_list(			*/
+/*			struct hillslope_object *hillslope)	*/
+/*								*/
+/*	OPTIONS							*/
+/*	-gwtoriparian						*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	Fills hillslope.riparian_list with the patches that	*/
+/*	have soil default 42, in zone and patch order, so the	*/
+/*	hourly groundwater loss goes to them without a search	*/
+/*	of every patch of the hillslope.  Any earlier list is	*/
+/*	freed.							*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*	Called when the hillslope is built and again from	*/
+/*	compute_mean_hillslope_parameters after a redefine	*/
+/*	event, which may change the soil defaults.		*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+
+void	construct_riparian_list(struct hillslope_object *hillslope)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int	i, j, n;
+	struct	patch_object	*patch;
+
+	free(hillslope[0].riparian_list.list);
+	hillslope[0].riparian_list.list = NULL;
+	n = 0;
+	for (i = 0; i < hillslope[0].num_zones; i++)
+		for (j = 0; j < hillslope[0].zones[i][0].num_patches; j++)
+			if (hillslope[0].zones[i][0].patches[j][0].soil_defaults[0][0].ID == 42)
+				n++;
+	hillslope[0].riparian_list.num_patches = n;
+	if (n == 0)
+		return;
+	hillslope[0].riparian_list.list = (struct patch_object **) alloc(
+		n * sizeof(struct patch_object *),
+		"riparian_list", "construct_riparian_list");
+	n = 0;
+	for (i = 0; i < hillslope[0].num_zones; i++) {
+		for (j = 0; j < hillslope[0].zones[i][0].num_patches; j++) {
+			patch = hillslope[0].zones[i][0].patches[j];
+			if (patch[0].soil_defaults[0][0].ID == 42)
+				hillslope[0].riparian_list.list[n++] = patch;
+		}
+	}
+} /*end construct_riparian_list*/
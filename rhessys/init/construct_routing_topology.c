@@ -194,6 +194,22 @@ struct routing_list_object *construct_routing_topology(
 				patch[0].soil_defaults[0][0].interval_size = patch[0].soil_defaults[0][0].soil_water_cap / MAX_NUM_INTERVAL;
 				}
 			patch[0].transmissivity_profile = compute_transmissivity_curve(gamma, patch, command_line);
+
+			/*--------------------------------------------------------------*/
+			/*	varbased flow lookup table, filled in on first use	*/
+			/*	and whenever std or the profile changes			*/
+			/*--------------------------------------------------------------*/
+			if (command_line[0].stdev_table_flag == 1) {
+				if (patch[0].varflow_table == NULL)
+					patch[0].varflow_table = (struct varflow_table_object *)
+						alloc(sizeof(struct varflow_table_object),
+						"varflow_table","construct_routing_topology");
+				else
+					free(patch[0].varflow_table[0].flow);
+				patch[0].varflow_table[0].transmissivity = NULL;
+				patch[0].varflow_table[0].flow = NULL;
+				patch[0].varflow_table[0].num_entries = 0;
+				}
 			}
 
 
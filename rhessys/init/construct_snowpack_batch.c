@@ -0,0 +1,76 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		construct_snowpack_batch			*/
+/*								*/
+/*	NAME							*/
+/*	construct_snowpack_batch - allocates the snowpack	*/
+/*		energy balance lanes of a hillslope		*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	struct snowpack_batch_object *construct_snowpack_batch(	*/
+/*			struct hillslope_object *)		*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	zone_snowpack_daily_F fills one lane per snowpack	*/
+/*	energy balance of a zone, two for a patch under partial	*/
+/*	cover, so the arrays hold twice the patches of the	*/
+/*	largest zone.  Zones of a hillslope are run one after	*/
+/*	the other, so they share the lanes.			*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdlib.h>
+
+#include "rhessys.h"
+#include "functions.h"
+
+struct snowpack_batch_object *construct_snowpack_batch(struct hillslope_object * const hillslope) {
+
+	struct snowpack_batch_object	*batch = NULL;
+	int max_lanes, z;
+
+	max_lanes = 0;
+	for (z = 0; z < hillslope->num_zones; z++)
+		if (2 * hillslope->zones[z]->num_patches > max_lanes)
+			max_lanes = 2 * hillslope->zones[z]->num_patches;
+	if (max_lanes == 0)
+		return(batch);
+
+	batch = (struct snowpack_batch_object *)alloc(sizeof(struct snowpack_batch_object),
+			"snowpack_batch", "construct_snowpack_batch");
+	batch->num_lanes = 0;
+	batch->max_lanes = max_lanes;
+	batch->patch = (struct patch_object **)alloc(max_lanes * sizeof(struct patch_object *),
+			"patch", "construct_snowpack_batch");
+	batch->update_flag = (int *)alloc(max_lanes * sizeof(int), "update_flag", "construct_snowpack_batch");
+	batch->albedo_flag = (int *)alloc(max_lanes * sizeof(int), "albedo_flag", "construct_snowpack_batch");
+	batch->gasnow = (double *)alloc(max_lanes * sizeof(double), "gasnow", "construct_snowpack_batch");
+	batch->rain = (double *)alloc(max_lanes * sizeof(double), "rain", "construct_snowpack_batch");
+	batch->snow = (double *)alloc(max_lanes * sizeof(double), "snow", "construct_snowpack_batch");
+	batch->Kdown_direct = (double *)alloc(max_lanes * sizeof(double), "Kdown_direct", "construct_snowpack_batch");
+	batch->Kup_direct = (double *)alloc(max_lanes * sizeof(double), "Kup_direct", "construct_snowpack_batch");
+	batch->Kdown_diffuse = (double *)alloc(max_lanes * sizeof(double), "Kdown_diffuse", "construct_snowpack_batch");
+	batch->Kup_diffuse = (double *)alloc(max_lanes * sizeof(double), "Kup_diffuse", "construct_snowpack_batch");
+	batch->PAR_direct = (double *)alloc(max_lanes * sizeof(double), "PAR_direct", "construct_snowpack_batch");
+	batch->PAR_diffuse = (double *)alloc(max_lanes * sizeof(double), "PAR_diffuse", "construct_snowpack_batch");
+	batch->Lstar = (double *)alloc(max_lanes * sizeof(double), "Lstar", "construct_snowpack_batch");
+	batch->overstory_fraction = (double *)alloc(max_lanes * sizeof(double), "overstory_fraction", "construct_snowpack_batch");
+	batch->area_fraction = (double *)alloc(max_lanes * sizeof(double), "area_fraction", "construct_snowpack_batch");
+	batch->bats_b = (double *)alloc(max_lanes * sizeof(double), "bats_b", "construct_snowpack_batch");
+	batch->bats_r3 = (double *)alloc(max_lanes * sizeof(double), "bats_r3", "construct_snowpack_batch");
+	batch->maximum_energy_deficit = (double *)alloc(max_lanes * sizeof(double), "maximum_energy_deficit", "construct_snowpack_batch");
+	batch->light_ext_coef = (double *)alloc(max_lanes * sizeof(double), "light_ext_coef", "construct_snowpack_batch");
+	batch->melt_Tcoef = (double *)alloc(max_lanes * sizeof(double), "melt_Tcoef", "construct_snowpack_batch");
+	batch->water_equivalent_depth = (double *)alloc(max_lanes * sizeof(double), "water_equivalent_depth", "construct_snowpack_batch");
+	batch->surface_age = (double *)alloc(max_lanes * sizeof(double), "surface_age", "construct_snowpack_batch");
+	batch->energy_deficit = (double *)alloc(max_lanes * sizeof(double), "energy_deficit", "construct_snowpack_batch");
+	batch->K_reflectance = (double *)alloc(max_lanes * sizeof(double), "K_reflectance", "construct_snowpack_batch");
+	batch->Kstar_direct = (double *)alloc(max_lanes * sizeof(double), "Kstar_direct", "construct_snowpack_batch");
+	batch->Kstar_diffuse = (double *)alloc(max_lanes * sizeof(double), "Kstar_diffuse", "construct_snowpack_batch");
+	batch->APAR_direct = (double *)alloc(max_lanes * sizeof(double), "APAR_direct", "construct_snowpack_batch");
+	batch->APAR_diffuse = (double *)alloc(max_lanes * sizeof(double), "APAR_diffuse", "construct_snowpack_batch");
+	batch->Rnet = (double *)alloc(max_lanes * sizeof(double), "Rnet", "construct_snowpack_batch");
+	batch->sublimation = (double *)alloc(max_lanes * sizeof(double), "sublimation", "construct_snowpack_batch");
+	batch->melt = (double *)alloc(max_lanes * sizeof(double), "melt", "construct_snowpack_batch");
+
+	return(batch);
+}
@@ -0,0 +1,64 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		construct_soil_thermal				*/
+/*								*/
+/*	NAME							*/
+/*	construct_soil_thermal - allocates the surface energy	*/
+/*		layer arrays of all patches of a hillslope	*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	struct soil_thermal_object *construct_soil_thermal(	*/
+/*			struct hillslope_object *)		*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	Every patch has the same 4 surface energy layers	*/
+/*	(litter, rooting, unsat/sat and soil depth), so the	*/
+/*	patches of a hillslope are lanes of layer major arrays	*/
+/*	that are allocated once here.  The profile keeps its	*/
+/*	temperatures from day to day; they start at 0 C.	*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdlib.h>
+
+#include "rhessys.h"
+#include "functions.h"
+
+struct soil_thermal_object *construct_soil_thermal(struct hillslope_object * const hillslope) {
+
+	struct soil_thermal_object	*thermal = NULL;
+	int num_patches, n, l, z, p, cells;
+
+	num_patches = 0;
+	for (z = 0; z < hillslope->num_zones; z++)
+		num_patches += hillslope->zones[z]->num_patches;
+	if (num_patches == 0)
+		return(thermal);
+
+	thermal = (struct soil_thermal_object *)alloc(sizeof(struct soil_thermal_object),
+			"soil_thermal", "construct_soil_thermal");
+	thermal->num_patches = num_patches;
+	thermal->patches = (struct patch_object **)alloc(num_patches * sizeof(struct patch_object *),
+			"patches", "construct_soil_thermal");
+
+	cells = 4 * num_patches;
+	thermal->depth = (double *)alloc(cells * sizeof(double), "depth", "construct_soil_thermal");
+	thermal->moisture = (double *)alloc(cells * sizeof(double), "moisture", "construct_soil_thermal");
+	thermal->T = (double *)alloc(cells * sizeof(double), "T", "construct_soil_thermal");
+
+	n = 0;
+	for (z = 0; z < hillslope->num_zones; z++) {
+		for (p = 0; p < hillslope->zones[z]->num_patches; p++) {
+			thermal->patches[n] = hillslope->zones[z]->patches[p];
+			for (l = 0; l < 4; l++) {
+				thermal->depth[l * num_patches + n] = 0.0;
+				thermal->moisture[l * num_patches + n] = 0.0;
+				thermal->T[l * num_patches + n] = 0.0;
+			}
+			thermal->depth[3 * num_patches + n] =
+				thermal->patches[n]->surface_energy_profile[3].depth;
+			n++;
+		}
+	}
+
+	return(thermal);
+}
@@ -85,7 +85,7 @@ struct surface_energy_default *construct_surface_energy_defaults(
 		/*--------------------------------------------------------------*/
 		default_object_list[i].N_thermal_nodes     = getIntParam(&paramCnt, &paramPtr, "N_thermal_nodes", "%d", 10, 1);
 		default_object_list[i].exp_dist            = getIntParam(&paramCnt, &paramPtr, "exp_dist", "%d", 0, 1);
-		default_object_list[i].damping_depth       = getDoubleParam(&paramCnt, &paramPtr, "damping_depth", "%d", 4, 1);
+		default_object_list[i].damping_depth       = getDoubleParam(&paramCnt, &paramPtr, "damping_depth", "%lf", 4, 1);
 		default_object_list[i].iteration_threshold = getDoubleParam(&paramCnt, &paramPtr, "iteration_threshold", "%lf", 0.01, 1);
 
                 memset(strbuf, '\0', strbufLen);
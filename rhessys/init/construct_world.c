@@ -370,11 +370,13 @@ struct world_object *construct_world(struct command_line_object *command_line){
 	struct fire_object **construct_fire_grid(struct world_object *);
 	struct base_station_object **construct_ascii_grid(char *, struct date, struct date);
 	struct base_station_ncheader_object *construct_netcdf_header(struct world_object *, char *);
-	struct base_station_object *construct_netcdf_grid(struct base_station_object *, struct base_station_ncheader *, int *, float, float, float, struct date *, struct date *, struct command_line_object *);
+	void construct_netcdf_grids(struct base_station_object **, int, struct base_station_ncheader_object *, struct date *, struct date *, struct command_line_object *);
   void *construct_spinup_thresholds(char *, struct world_object *, struct command_line_object *);	
+	void destroy_basin(struct command_line_object *, struct basin_object **);
 	void *alloc(size_t, char *, char *);
 
 	void resemble_hourly_date(struct world_object *);
+	FILE	*open_state_file(char *, char *, int);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
@@ -382,9 +384,12 @@ struct world_object *construct_world(struct command_line_object *command_line){
 	FILE	*header_file;
 	int 	header_file_flag = 0;
 	int		legacy_worldfile = 0;
-	int	i;
+	int	i, j, b, h, z;
+	int	first_basin, last_basin;
 	char	record[MAXSTR];
 	struct world_object *world;
+	struct basin_object *basin;
+	struct hillslope_object *hillslope;
 	/*--------------------------------------------------------------*/
 	/*	Allocate a world array.										*/
 	/*--------------------------------------------------------------*/
@@ -393,7 +398,7 @@ struct world_object *construct_world(struct command_line_object *command_line){
 	/*--------------------------------------------------------------*/
 	/*	Try to open the world file in read mode.					*/
 	/*--------------------------------------------------------------*/
-	if ( (world_file = fopen(command_line[0].world_filename,"r")) == NULL ){
+	if ( (world_file = open_state_file(command_line[0].world_filename, "r", 0)) == NULL ){
 		fprintf(stderr,"FATAL ERROR:  Cannot open world file %s\n",
 			command_line[0].world_filename);
 		exit(EXIT_FAILURE);
@@ -618,7 +623,7 @@ struct world_object *construct_world(struct command_line_object *command_line){
 		/*	Read in the surface energy default files.			*/
 		/*--------------------------------------------------------------*/
 		world[0].surface_energy_default_files= construct_filename_list( header_file,
-			world[0].defaults[0].num_fire_default_files);
+			world[0].defaults[0].num_surface_energy_default_files);
 	}
 	
 	/*--------------------------------------------------------------*/
@@ -792,25 +797,12 @@ struct world_object *construct_world(struct command_line_object *command_line){
 			world[0].base_station_ncheader = construct_netcdf_header(world,
                                                 world[0].base_station_files[0]);
             #ifdef LIU_NETCDF_READER
-            //#pragma omp parallel for
-            for (int i = 0; i < world[0].num_base_stations; i++) {
-                //printf("station %d ID:%d\n",i,world[0].base_stations[i]->ID);
-                //fprintf(stderr,"\ni:%d\tstart_year:%d\tx:%lf\ty:%lf\tduration_days:%d\n",
-                //        i,world[0].start_date.year,world[0].base_stations[i][0].x,world[0].base_stations[i][0].y,world[0].duration.day);
-                world[0].base_stations[i] = construct_netcdf_grid(
-                                                           world[0].base_stations[i],
-                                                           world[0].base_station_ncheader,
-                                                           &world[0].num_base_stations,
-                                                           world[0].base_stations[i][0].proj_x,
-                                                           world[0].base_stations[i][0].proj_y,
-                                                           world[0].base_stations[i][0].z,
-                                                           &world[0].start_date,
-                                                           &world[0].duration,
-							                                             command_line);
-
-                //printf("new station %d ID:%d\n", i, world[0].base_stations[i][0].ID ); 
-            }
+			world[0].base_station_ncheader[0].grid_index = construct_netcdf_grid_index(
+								world[0].base_stations,
+								world[0].num_base_stations,
+								world[0].base_station_ncheader);
             #endif
+            /* cell data is loaded once the basins have claimed their cells */
 			/*printf("\n  file=%s firstID=%d num=%d numfiles=%d lai=%lf screenht=%lf sdist=%lf startyr=%d dayoffset=%d leapyr=%d precipmult=%lf",
 				   world[0].base_station_ncheader[0].netcdf_tmax_filename,
 				   world[0].ID,
@@ -876,15 +868,74 @@ struct world_object *construct_world(struct command_line_object *command_line){
 	
 	/*--------------------------------------------------------------*/
 	/*	Construct the basins. 										*/
-	/*--------------------------------------------------------------*/
+	/*																*/
+	/*	A -workers process keeps only its contiguous share of	*/
+	/*	the basins; the others still have to be read to move	*/
+	/*	through the world file and are freed right away.	*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].worker_rank >= 0) {
+		first_basin = command_line[0].worker_rank * world[0].num_basin_files
+			/ command_line[0].num_workers;
+		last_basin = (command_line[0].worker_rank + 1) * world[0].num_basin_files
+			/ command_line[0].num_workers;
+	}
+	else {
+		first_basin = 0;
+		last_basin = world[0].num_basin_files;
+	}
+	j = 0;
 	for (i=0; i<world[0].num_basin_files; i++ ){
 	  printf("\n creating basin %d\n", i);
-		world[0].basins[i] = construct_basin(
+		basin = construct_basin(
 			command_line, world_file, &(world[0].num_base_stations),
 			world[0].base_stations,	world[0].defaults, 
             world[0].base_station_ncheader,
             world);
+		if ((i >= first_basin) && (i < last_basin))
+			world[0].basins[j++] = basin;
+		else
+			destroy_basin(command_line, &basin);
 	} /*end for*/
+	world[0].num_basin_files = j;
+
+#ifdef LIU_NETCDF_READER
+	/*--------------------------------------------------------------*/
+	/*	Gridded climate: keep only the cells that a basin,	*/
+	/*	hillslope or zone points to, and load just those.	*/
+	/*--------------------------------------------------------------*/
+	if ((command_line[0].dclim_flag == 0) && (command_line[0].gridded_netcdf_flag == 1)) {
+		destroy_netcdf_grid_index(world[0].base_station_ncheader[0].grid_index);
+		world[0].base_station_ncheader[0].grid_index = NULL;
+		for (b = 0; b < world[0].num_basin_files; b++) {
+			basin = world[0].basins[b];
+			for (j = 0; j < basin[0].num_base_stations; j++)
+				basin[0].base_stations[j][0].referenced = 1;
+			for (h = 0; h < basin[0].num_hillslopes; h++) {
+				hillslope = basin[0].hillslopes[h];
+				for (j = 0; j < hillslope[0].num_base_stations; j++)
+					hillslope[0].base_stations[j][0].referenced = 1;
+				for (z = 0; z < hillslope[0].num_zones; z++)
+					for (j = 0; j < hillslope[0].zones[z][0].num_base_stations; j++)
+						hillslope[0].zones[z][0].base_stations[j][0].referenced = 1;
+			}
+		}
+		j = 0;
+		for (i = 0; i < world[0].num_base_stations; i++) {
+			if (world[0].base_stations[i][0].referenced == 1)
+				world[0].base_stations[j++] = world[0].base_stations[i];
+			else
+				free(world[0].base_stations[i]);
+		}
+		printf("\nUsing %d of %d netcdf grid cells", j, world[0].num_base_stations);
+		world[0].num_base_stations = j;
+		construct_netcdf_grids(world[0].base_stations,
+			world[0].num_base_stations,
+			world[0].base_station_ncheader,
+			&world[0].start_date,
+			&world[0].duration,
+			command_line);
+	}
+#endif
 
 	/*--------------------------------------------------------------*/
 	/*	If spinup flag is set construct the spinup thresholds object*/
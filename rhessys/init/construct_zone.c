@@ -181,6 +181,8 @@ struct zone_object *construct_zone(
 	zone[0].acc_month.tmin = 0.0;
 	zone[0].acc_month.precip = 0.0;
 	zone[0].acc_month.length = 0;
+	zone[0].hourly_summary.day = -1;
+	zone[0].hourly_summary.num_hours = 0;
 	/*--------------------------------------------------------------*/
 	/*	Define hourly array zone				*/
 	/*--------------------------------------------------------------*/
@@ -271,6 +273,12 @@ struct zone_object *construct_zone(
 
 #ifndef FIND_STATION_BASED_ON_ID
 			/* Identify centerpoint coords for closest netcdf cell to zone x, y */
+			if (base_station_ncheader[0].grid_index != NULL)
+				k = (find_netcdf_grid_cell(base_station_ncheader[0].grid_index,
+						(float)zone[0].y, (float)zone[0].x,
+						base_station_ncheader[0].resolution_meter,
+						&(base_y), &(base_x)) == -1) ? -1 : 0;
+			else
 			k = get_netcdf_xy(base_station_ncheader[0].netcdf_tmax_filename, 
 							  base_station_ncheader[0].netcdf_y_varname,
 							  base_station_ncheader[0].netcdf_x_varname,
@@ -30,6 +30,8 @@ void destroy_hillslope(
 	void	destroy_zone(
 		struct	command_line_object	*,
 		struct	zone_object	**);
+	void	destroy_neighbour_table(
+		struct	neighbour_table_object	*);
 	/*--------------------------------------------------------------*/
 	/*	local variable declarations 								*/
 	/*--------------------------------------------------------------*/
@@ -55,6 +57,7 @@ void destroy_hillslope(
 	/*--------------------------------------------------------------*/
 	if ( hillslope[0].num_base_stations > 0 )
 		free( hillslope[0].base_stations);
+	free(hillslope[0].riparian_list.list);
 
 
   if (command_line[0].routing_flag==1){
@@ -62,6 +65,57 @@ void destroy_hillslope(
 	    free(hillslope[0].route_list);
 	    free(hillslope[0].surface_route_list[0].list);
 	    free(hillslope[0].surface_route_list);
+	    destroy_neighbour_table(hillslope[0].neighbour_table);
+	}
+  else if (hillslope[0].route_list != NULL) {
+	    free(hillslope[0].route_list[0].list);
+	    free(hillslope[0].route_list);
+	    free(hillslope[0].topmodel_sums);
+	}
+	if (hillslope[0].soil_thermal != NULL) {
+		free(hillslope[0].soil_thermal[0].patches);
+		free(hillslope[0].soil_thermal[0].depth);
+		free(hillslope[0].soil_thermal[0].moisture);
+		free(hillslope[0].soil_thermal[0].T);
+		free(hillslope[0].soil_thermal);
+	}
+	if (hillslope[0].snowpack_batch != NULL) {
+		free(hillslope[0].snowpack_batch[0].patch);
+		free(hillslope[0].snowpack_batch[0].update_flag);
+		free(hillslope[0].snowpack_batch[0].albedo_flag);
+		free(hillslope[0].snowpack_batch[0].gasnow);
+		free(hillslope[0].snowpack_batch[0].rain);
+		free(hillslope[0].snowpack_batch[0].snow);
+		free(hillslope[0].snowpack_batch[0].Kdown_direct);
+		free(hillslope[0].snowpack_batch[0].Kup_direct);
+		free(hillslope[0].snowpack_batch[0].Kdown_diffuse);
+		free(hillslope[0].snowpack_batch[0].Kup_diffuse);
+		free(hillslope[0].snowpack_batch[0].PAR_direct);
+		free(hillslope[0].snowpack_batch[0].PAR_diffuse);
+		free(hillslope[0].snowpack_batch[0].Lstar);
+		free(hillslope[0].snowpack_batch[0].overstory_fraction);
+		free(hillslope[0].snowpack_batch[0].area_fraction);
+		free(hillslope[0].snowpack_batch[0].bats_b);
+		free(hillslope[0].snowpack_batch[0].bats_r3);
+		free(hillslope[0].snowpack_batch[0].maximum_energy_deficit);
+		free(hillslope[0].snowpack_batch[0].light_ext_coef);
+		free(hillslope[0].snowpack_batch[0].melt_Tcoef);
+		free(hillslope[0].snowpack_batch[0].water_equivalent_depth);
+		free(hillslope[0].snowpack_batch[0].surface_age);
+		free(hillslope[0].snowpack_batch[0].energy_deficit);
+		free(hillslope[0].snowpack_batch[0].K_reflectance);
+		free(hillslope[0].snowpack_batch[0].Kstar_direct);
+		free(hillslope[0].snowpack_batch[0].Kstar_diffuse);
+		free(hillslope[0].snowpack_batch[0].APAR_direct);
+		free(hillslope[0].snowpack_batch[0].APAR_diffuse);
+		free(hillslope[0].snowpack_batch[0].Rnet);
+		free(hillslope[0].snowpack_batch[0].sublimation);
+		free(hillslope[0].snowpack_batch[0].melt);
+		free(hillslope[0].snowpack_batch);
+	}
+	if (hillslope[0].balance_log != NULL) {
+		free(hillslope[0].balance_log[0].entries);
+		free(hillslope[0].balance_log);
 	}
 	/*--------------------------------------------------------------*/
 	/*	Destroy the main hillslope object.							*/
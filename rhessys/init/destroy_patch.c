@@ -64,8 +64,14 @@ void destroy_patch(
   free(patch[0].surface_innundation_list[0].neighbours);
   free(patch[0].surface_innundation_list);
 	free(patch[0].transmissivity_profile);
+	if ( patch[0].varflow_table != NULL ) {
+		free(patch[0].varflow_table[0].flow);
+		free(patch[0].varflow_table);
+	}
 	
 	free(patch[0].hourly);
+	for ( i=0 ; i<patch[0].num_canopy_strata ; i++ )
+		free(patch[0].layers[i].strata);
 	free(patch[0].layers);
 	/*--------------------------------------------------------------*/
 	/*	destroy the main patch object.								*/
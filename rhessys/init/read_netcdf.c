@@ -122,6 +122,105 @@ int wrap_repeat_date( int month, int day, int start_date_index, int data_length
   return index;
 }
 
+/* Check for Climate repeat flag. If flag is set, cycle through clim data
+ *
+ * Variables:
+ *    nday : the total number of days in the actual netcdf file
+ *    startday: the start of the metdata, the starting index to read from allActualData... the first date requested when this function is called
+ *    start_date_index : index that says where in the netcdf data array we begin to read from
+ *    allActualData: the entire dataset from the netcdf file, irrespective of how much data is requested by the user
+ *    duration: the number of days of requested data
+ *    data: an array passed as an argument to this function to be populated with the requested netcdf data
+ */
+static void repeat_clim_data(float *allActualData, int *days, int nday,
+    int startday, int day_offset, int duration, float *data){
+  float * real_netcdf_data = allActualData;
+  float * output_data = data;
+  int total_days_in_netcdf_data = nday;
+  struct date target_date;
+  struct date curr_date;
+
+  int requested_output_data_length = duration;
+
+  // index that says where in the netcdf data array we begin to read from
+  int read_start_index = startday - days[0] + day_offset;
+  int start_date_index = read_start_index;
+
+  // how many days of existing, sequential, real netcdf data to copy
+  // directly into the beginning of our output_data array.
+  int amount_to_memcpy = total_days_in_netcdf_data - read_start_index;
+  if (amount_to_memcpy > requested_output_data_length)
+    amount_to_memcpy = requested_output_data_length;
+
+  //fprintf( stderr, "start with copying %d days of %d total netcdf.\n", amount_to_memcpy, nday);
+  memcpy( &output_data[ 0 ], &real_netcdf_data[ read_start_index ], amount_to_memcpy * sizeof(float) );
+
+  // now we should have all the data from the start date to the end of the actual data copied over.
+  // next comes looping through and creating repeated data as needed...
+
+  int next_write_index = amount_to_memcpy;
+
+  // index inside of netcdf data where we are getting records to repeat
+  int read_data_index = 0;
+
+  // get date object for next day after the last day held in days[]
+  int last_date_in_netcdf_data = days[ total_days_in_netcdf_data - 1];
+  struct date first_date_for_new_data = caldat( last_date_in_netcdf_data + 1 );
+
+  // determine initial index to start drawing repeated data from
+  read_data_index = wrap_repeat_date( first_date_for_new_data.month,
+                                      first_date_for_new_data.day,
+                                      days[0],
+                                      total_days_in_netcdf_data );
+
+  struct date next_date_to_fill;
+  struct date candidate_repeat_date;
+
+  for( int i = next_write_index; i < requested_output_data_length; i++ ) {
+    next_date_to_fill  = caldat( last_date_in_netcdf_data + i - next_write_index );
+    candidate_repeat_date = caldat( days[0] + read_data_index ); //day[0] is the point we start reading netcdfdata (it doesn't change)
+
+    // Test to see if next day is feb. 29th in a leap year
+    if( next_date_to_fill.month == 2 && next_date_to_fill.day == 29 ) {
+      // if the current year of netcdf data is also a leap year...
+      if( LEAPYR( candidate_repeat_date.year ) ) {
+        if( read_data_index >= total_days_in_netcdf_data ) {
+          read_data_index = wrap_repeat_date( next_date_to_fill.month,
+                            next_date_to_fill.day,
+                            days[0],
+                            total_days_in_netcdf_data );
+        }
+        output_data[ i ] = real_netcdf_data[ read_data_index++ ];
+      }else{
+        // use previous day of data for feb. 29th
+        output_data[ i ] = output_data[ i - 1 ];
+      }
+    }else{
+      // if the repeat day is feb. 29th, just skip it.
+      if( candidate_repeat_date.month == 2 && candidate_repeat_date.day == 29 ) {
+        read_data_index++;
+        candidate_repeat_date = caldat( days[0] + read_data_index );
+      }
+      if( read_data_index >= total_days_in_netcdf_data ) {
+        read_data_index = wrap_repeat_date( next_date_to_fill.month,
+                                            next_date_to_fill.day,
+                                            days[0],
+                                            total_days_in_netcdf_data );
+
+        candidate_repeat_date = caldat( days[0] + read_data_index );
+      }
+
+      output_data[ i ] = real_netcdf_data[ read_data_index++ ];
+   
+      /*if( candidate_repeat_date.month != next_date_to_fill.month) {
+          fprintf( stderr, "candidate month: %d, target month %d, target year %d\n", candidate_repeat_date.month, next_date_to_fill.month, next_date_to_fill.year );
+      }*/
+    } // end last else
+  } // end for loop
+
+  //fprintf( stderr, "read_start_index %d, startday %d, durationRequest %d, days in dataset %d\n", read_start_index, startday, duration, nday );
+}
+//_____________________________________________________________________________/
 int get_netcdf_var_timeserias(char *netcdf_filename, char *varname,
     char *nlat_name, char *nlon_name,
     float rlat, float rlon, float sd,
@@ -271,103 +370,8 @@ clim_repeat_flag: command line object that tells RHESSys to recycle through netc
   }
   //fprintf( stderr, "WE HAVE READ NETCDF\n" );
 
-/* Check for Climate repeat flag. If flag is set, cycle through clim data
- *
- * Variables:
- *    nday : the total number of days in the actual netcdf file
- *    startday: the start of the metdata, the starting index to read from allActualData... the first date requested when this function is called
- *    start_date_index : index that says where in the netcdf data array we begin to read from
- *    allActualData: the entire dataset from the netcdf file, irrespective of how much data is requested by the user
- *    duration: the number of days of requested data
- *    data: an array passed as an argument to this function to be populated with the requested netcdf data
- */
-
-  if( clim_repeat_flag ) {
-    float * real_netcdf_data = allActualData;
-    float * output_data = data;
-    int total_days_in_netcdf_data = nday;
-    struct date target_date;
-    struct date curr_date;
-
-    int requested_output_data_length = duration;
-
-    // index that says where in the netcdf data array we begin to read from
-    int read_start_index = startday - days[0] + day_offset;
-    int start_date_index = read_start_index;
-
-    // how many days of existing, sequential, real netcdf data to copy
-    // directly into the beginning of our output_data array.
-    int amount_to_memcpy = total_days_in_netcdf_data - read_start_index;
-
-    //fprintf( stderr, "start with copying %d days of %d total netcdf.\n", amount_to_memcpy, nday);
-    memcpy( &output_data[ 0 ], &real_netcdf_data[ read_start_index ], amount_to_memcpy * sizeof(float) );
-
-    // now we should have all the data from the start date to the end of the actual data copied over.
-    // next comes looping through and creating repeated data as needed...
-
-    int next_write_index = amount_to_memcpy;
-
-    // index inside of netcdf data where we are getting records to repeat
-    int read_data_index = 0;
-
-    // get date object for next day after the last day held in days[]
-    int last_date_in_netcdf_data = days[ total_days_in_netcdf_data - 1];
-    struct date first_date_for_new_data = caldat( last_date_in_netcdf_data + 1 );
-
-    // determine initial index to start drawing repeated data from
-    read_data_index = wrap_repeat_date( first_date_for_new_data.month,
-                                        first_date_for_new_data.day,
-                                        days[0],
-                                        total_days_in_netcdf_data );
-
-    struct date next_date_to_fill;
-    struct date candidate_repeat_date;
-
-    for( int i = next_write_index; i < requested_output_data_length; i++ ) {
-      next_date_to_fill  = caldat( last_date_in_netcdf_data + i - next_write_index );
-      candidate_repeat_date = caldat( days[0] + read_data_index ); //day[0] is the point we start reading netcdfdata (it doesn't change)
-
-      // Test to see if next day is feb. 29th in a leap year
-      if( next_date_to_fill.month == 2 && next_date_to_fill.day == 29 ) {
-        // if the current year of netcdf data is also a leap year...
-        if( LEAPYR( candidate_repeat_date.year ) ) {
-          if( read_data_index >= total_days_in_netcdf_data ) {
-            read_data_index = wrap_repeat_date( next_date_to_fill.month,
-                              next_date_to_fill.day,
-                              days[0],
-                              total_days_in_netcdf_data );
-          }
-          output_data[ i ] = real_netcdf_data[ read_data_index++ ];
-        }else{
-          // use previous day of data for feb. 29th
-          output_data[ i ] = output_data[ i - 1 ];
-        }
-      }else{
-        // if the repeat day is feb. 29th, just skip it.
-        if( candidate_repeat_date.month == 2 && candidate_repeat_date.day == 29 ) {
-          read_data_index++;
-          candidate_repeat_date = caldat( days[0] + read_data_index );
-        }
-        if( read_data_index >= total_days_in_netcdf_data ) {
-          read_data_index = wrap_repeat_date( next_date_to_fill.month,
-                                              next_date_to_fill.day,
-                                              days[0],
-                                              total_days_in_netcdf_data );
-
-          candidate_repeat_date = caldat( days[0] + read_data_index );
-        }
-
-        output_data[ i ] = real_netcdf_data[ read_data_index++ ];
-     
-        /*if( candidate_repeat_date.month != next_date_to_fill.month) {
-            fprintf( stderr, "candidate month: %d, target month %d, target year %d\n", candidate_repeat_date.month, next_date_to_fill.month, next_date_to_fill.year );
-        }*/
-      } // end last else
-    } // end for loop
-
-    //fprintf( stderr, "read_start_index %d, startday %d, durationRequest %d, days in dataset %d\n", read_start_index, startday, duration, nday );
-  
- } // end if clim_repeat_flag
+  if( clim_repeat_flag )
+    repeat_clim_data(allActualData, days, nday, startday, day_offset, duration, data);
 
   if ((retval = nc_close(ncid))){
     free(days);
@@ -385,6 +389,234 @@ clim_repeat_flag: command line object that tells RHESSys to recycle through netc
   return 0;
 }
 //_____________________________________________________________________________/
+int get_netcdf_var_timeseries_cells(char *netcdf_filename, char *varname,
+    char *nlat_name, char *nlon_name, int ncells,
+    float *rlat, float *rlon, float sd,
+    int startday, int day_offset, int duration, int clim_repeat_flag, float *data ){
+
+/****************************************************************
+Same as get_netcdf_var_timeserias for ncells sites at once
+rlat,rlon: latitue and longitude of each site
+data: ncells * duration values, site after site
+
+The file and its coordinates are read once. When the sites are
+compact (as the cells of one watershed are) their bounding box is
+read in a single hyperslab; otherwise each site is read from the
+open file in turn.
+   ************************************************************/
+
+  int ncid, temp_varid,ndaysid,nlatid,nlontid;
+  int dayid,latid,lontid;
+  size_t nday,nlat,nlont;
+  int *days;
+  float *lat,*lont;
+  int *idlat,*idlont;
+  size_t start[3],count[3];
+  size_t lat0,lat1,lont0,lont1,nbox,ncount,t;
+  float *box,*series;
+  int retval;
+  int c;
+
+  if (ncells < 1)
+    return 0;
+  if((retval = nc_open(netcdf_filename, NC_NOWRITE, &ncid)))
+    ERR(retval);
+  if((retval = nc_inq_dimid(ncid,NDAYS_NAME, &ndaysid)))
+    ERR(retval);
+  if((retval = nc_inq_dimid(ncid, nlat_name, &nlatid)))
+    ERR(retval);
+  if((retval = nc_inq_dimid(ncid, nlon_name, &nlontid)))
+    ERR(retval);
+  if((retval = nc_inq_dimlen(ncid, ndaysid, &nday)))
+    ERR(retval);
+  if((retval = nc_inq_dimlen(ncid, nlatid, &nlat)))
+    ERR(retval);
+  if((retval = nc_inq_dimlen(ncid, nlontid, &nlont)))
+    ERR(retval);
+  if ((retval = nc_inq_varid(ncid, NDAYS_NAME, &dayid)))
+    ERR(retval);
+  if ((retval = nc_inq_varid(ncid, nlat_name, &latid)))
+    ERR(retval);
+  if ((retval = nc_inq_varid(ncid, nlon_name, &lontid)))
+    ERR(retval);
+  if ((retval = nc_inq_varid(ncid, varname, &temp_varid)))
+    ERR(retval);
+
+  days = (int *) alloc(nday * sizeof(int),"days","get_netcdf_var_timeseries_cells");
+  lat = (float *) alloc(nlat * sizeof(float),"lat","get_netcdf_var_timeseries_cells");
+  lont = (float *) alloc(nlont * sizeof(float),"lont","get_netcdf_var_timeseries_cells");
+  idlat = (int *) alloc(ncells * sizeof(int),"idlat","get_netcdf_var_timeseries_cells");
+  idlont = (int *) alloc(ncells * sizeof(int),"idlont","get_netcdf_var_timeseries_cells");
+  box = NULL;
+  series = NULL;
+  retval = 0;
+  if ((retval = nc_get_var_int(ncid, dayid, &days[0])))
+    goto fail;
+  if ((retval = nc_get_var_float(ncid, latid, &lat[0])))
+    goto fail;
+  if ((retval = nc_get_var_float(ncid, lontid, &lont[0])))
+    goto fail;
+
+  /*locate the records and their bounding box */
+  lat0 = nlat; lat1 = 0;
+  lont0 = nlont; lont1 = 0;
+  for (c = 0; c < ncells; c++) {
+    idlat[c] = locate(lat,nlat,rlat[c],sd);
+    idlont[c] = locate(lont,nlont,rlon[c],sd);
+    if(idlat[c] == -1 || idlont[c] == -1){
+      fprintf(stderr,"rlat:%lf\trlon:%lf\tsd:%lf\tlat[0]:%lf\tlont[0]:%lf can't locate the station get_netcdf_var_timeseries_cells\n",rlat[c],rlon[c],sd,lat[0],lont[0]);
+      goto fail;
+    }
+    if ((size_t)idlat[c] < lat0) lat0 = idlat[c];
+    if ((size_t)idlat[c] > lat1) lat1 = idlat[c];
+    if ((size_t)idlont[c] < lont0) lont0 = idlont[c];
+    if ((size_t)idlont[c] > lont1) lont1 = idlont[c];
+  }
+
+  if((startday<days[0] || (duration+startday) > days[nday-1])){
+    if( clim_repeat_flag == 0) {
+      fprintf(stderr,"time period is out of the range of metdata\n");
+      goto fail;
+    }
+  }
+
+  /* as in get_netcdf_var_timeserias, clim_repeat_flag reads the whole record */
+  start[0] = clim_repeat_flag ? 0 : startday-days[0]+day_offset;
+  ncount = clim_repeat_flag ? nday : duration;
+  series = (float *) alloc(ncount * sizeof(float),"series","get_netcdf_var_timeseries_cells");
+
+  nbox = (lat1 - lat0 + 1) * (lont1 - lont0 + 1);
+  if (nbox <= 4 * (size_t)ncells) {
+    start[1] = lat0;
+    start[2] = lont0;
+    count[0] = ncount;
+    count[1] = lat1 - lat0 + 1;
+    count[2] = lont1 - lont0 + 1;
+    box = (float *) alloc(ncount * nbox * sizeof(float),"box","get_netcdf_var_timeseries_cells");
+    if ((retval = nc_get_vara_float(ncid,temp_varid,start,count,&box[0])))
+      goto fail;
+  }
+
+  for (c = 0; c < ncells; c++) {
+    if (box != NULL) {
+      for (t = 0; t < ncount; t++)
+        series[t] = box[t * nbox + (idlat[c] - lat0) * count[2] + (idlont[c] - lont0)];
+    }
+    else {
+      start[1] = idlat[c];
+      start[2] = idlont[c];
+      count[0] = ncount;
+      count[1] = 1;
+      count[2] = 1;
+      if ((retval = nc_get_vara_float(ncid,temp_varid,start,count,&series[0])))
+        goto fail;
+    }
+    if (clim_repeat_flag)
+      repeat_clim_data(series, days, nday, startday, day_offset, duration, &data[c * duration]);
+    else
+      memcpy(&data[c * duration], &series[0], duration * sizeof(float));
+  }
+
+  free(days);
+  free(lat);
+  free(lont);
+  free(idlat);
+  free(idlont);
+  free(series);
+  if (box != NULL)
+    free(box);
+  if ((retval = nc_close(ncid)))
+    ERR(retval);
+  return 0;
+
+fail:
+  free(days);
+  free(lat);
+  free(lont);
+  free(idlat);
+  free(idlont);
+  if (series != NULL)
+    free(series);
+  if (box != NULL)
+    free(box);
+  nc_close(ncid);
+  if (retval)
+    ERR(retval);
+  return -1;
+}
+//_____________________________________________________________________________/
+int get_netcdf_var_cells(char *netcdf_filename, char *varname,
+    char *nlat_name, char *nlon_name, int ncells,
+    float *rlat, float *rlon, float sd, float *data){
+  /***Same as get_netcdf_var for ncells sites, from one open of the file
+    NO TIME DIMENSION
+   ************************************************************/
+
+  int ncid, temp_varid,nlatid,nlontid;
+  int latid,lontid;
+  size_t nlat,nlont;
+  float *lat,*lont;
+  size_t start[2],count[2];
+  int retval;
+  int c,idlat,idlont;
+
+  if (ncells < 1)
+    return 0;
+  if((retval = nc_open(netcdf_filename, NC_NOWRITE, &ncid)))
+    ERR(retval);
+  if((retval = nc_inq_dimid(ncid, nlat_name, &nlatid)))
+    ERR(retval);
+  if((retval = nc_inq_dimid(ncid, nlon_name, &nlontid)))
+    ERR(retval);
+  if((retval = nc_inq_dimlen(ncid, nlatid, &nlat)))
+    ERR(retval);
+  if((retval = nc_inq_dimlen(ncid, nlontid, &nlont)))
+    ERR(retval);
+  if ((retval = nc_inq_varid(ncid, nlat_name, &latid)))
+    ERR(retval);
+  if ((retval = nc_inq_varid(ncid, nlon_name, &lontid)))
+    ERR(retval);
+  if ((retval = nc_inq_varid(ncid, varname, &temp_varid)))
+    ERR(retval);
+
+  lat = (float *) alloc(nlat * sizeof(float),"lat","get_netcdf_var_cells");
+  lont = (float *) alloc(nlont * sizeof(float),"lont","get_netcdf_var_cells");
+  retval = 0;
+  if ((retval = nc_get_var_float(ncid, latid, &lat[0])))
+    goto fail;
+  if ((retval = nc_get_var_float(ncid, lontid, &lont[0])))
+    goto fail;
+
+  count[0] = 1;
+  count[1] = 1;
+  for (c = 0; c < ncells; c++) {
+    idlat = locate(lat,nlat,rlat[c],sd);
+    idlont = locate(lont,nlont,rlon[c],sd);
+    if(idlat == -1 || idlont == -1){
+      fprintf(stderr,"rlat:%lf\trlon:%lf can't locate the station get_netcdf_var_cells\n",rlat[c],rlon[c]);
+      goto fail;
+    }
+    start[0] = idlat;
+    start[1] = idlont;
+    if ((retval = nc_get_vara_float(ncid,temp_varid,start,count,&data[c])))
+      goto fail;
+  }
+
+  free(lat);
+  free(lont);
+  if ((retval = nc_close(ncid)))
+    ERR(retval);
+  return 0;
+
+fail:
+  free(lat);
+  free(lont);
+  nc_close(ncid);
+  if (retval)
+    ERR(retval);
+  return -1;
+}
+//_____________________________________________________________________________/
 int get_netcdf_var(char *netcdf_filename, char *varname,
     char *nlat_name, char *nlon_name,
     float rlat, float rlon, float sd, float *data){
@@ -553,3 +785,56 @@ sd: the minimum distance for searching nearby grid in netcdf
   free(lont);
   return 0;
 }
+//_____________________________________________________________________________/
+int get_netcdf_axes(char *netcdf_filename, char *nlat_name, char *nlon_name,
+    int *nlat_out, float **lat_out, int *nlon_out, float **lon_out){
+  /***Read the y and x coordinate axes of a netcdf file, for an in
+    memory lookup of cells (construct_netcdf_grid_index)
+    the axes are allocated here and belong to the caller
+   ************************************************************/
+
+  int ncid, nlatid,nlontid;
+  int latid,lontid;
+  size_t nlat,nlont;
+  float *lat,*lont;
+  int retval;
+
+  if((retval = nc_open(netcdf_filename, NC_NOWRITE, &ncid)))
+    ERR(retval);
+  if((retval = nc_inq_dimid(ncid, nlat_name, &nlatid)))
+    ERR(retval);
+  if((retval = nc_inq_dimid(ncid, nlon_name, &nlontid)))
+    ERR(retval);
+  if((retval = nc_inq_dimlen(ncid,nlatid, &nlat)))
+    ERR(retval);
+  if((retval = nc_inq_dimlen(ncid,nlontid, &nlont)))
+    ERR(retval);
+  if ((retval = nc_inq_varid(ncid, nlat_name, &latid)))
+    ERR(retval);
+  if ((retval = nc_inq_varid(ncid, nlon_name, &lontid)))
+    ERR(retval);
+
+  lat = (float *) alloc(nlat * sizeof(float),"lat","get_netcdf_axes");
+  lont = (float *) alloc(nlont * sizeof(float),"lont","get_netcdf_axes");
+  if ((retval = nc_get_var_float(ncid, latid, &lat[0]))){
+    free(lat);
+    free(lont);
+    ERR(retval);
+  }
+  if ((retval = nc_get_var_float(ncid, lontid, &lont[0]))){
+    free(lat);
+    free(lont);
+    ERR(retval);
+  }
+  if ((retval = nc_close(ncid))){
+    free(lat);
+    free(lont);
+    ERR(retval);
+  }
+
+  *nlat_out = (int)nlat;
+  *lat_out = lat;
+  *nlon_out = (int)nlont;
+  *lon_out = lont;
+  return 0;
+}
@@ -57,6 +57,13 @@
         -str    Streamflow routing option. Gives name of stream_table to define explicit streamflow routing connectivit.     
         -stro   Streamflow routing output option. Print out streamflow for specified stream reaches.
 		-version Prints the RHESSys version number, then exits immediately
+		-workers Split the basins over the given number of local processes
+		-checkpoint Write a checkpoint every given number of years (default 1)
+		-restart Resume from the checkpoint of the world file
+		-zstate	Write state files gzip compressed (.state.gz)
+		-digits Decimals written for real valued output (default 6)
+		-hsum [b][z] Write daily mean, min, max and peak hour in place of hourly basin and/or zone rows
+		-pull	Route land patches in two passes: all outflows, then each patch gathers its inflows
 
 	DESCRIPTION
 
@@ -361,6 +368,11 @@ int	main( int main_argc, char **main_argv)
 		struct world_output_file_object *,
 		struct command_line_object * );
 
+	int	launch_workers(
+		struct command_line_object * );
+
+	void	set_output_digits( int );
+
 
 	srand((unsigned)(time(0)));
 
@@ -382,6 +394,16 @@ int	main( int main_argc, char **main_argv)
 
 	if (command_line[0].verbose_flag > 0 )
 		fprintf(stderr,"FINISHED CON COMMAND LINE ***\n");
+	set_output_digits(command_line[0].output_digits);
+
+	/*--------------------------------------------------------------*/
+	/*	With -workers the basins are run by child processes; 	*/
+	/*	the launcher only waits for them and joins the output.	*/
+	/*--------------------------------------------------------------*/
+	if ((command_line[0].num_workers > 1) && (launch_workers(command_line) == 1)) {
+		destroy_command_line( command_line );
+		return(EXIT_SUCCESS);
+	}
 	
 	/*--------------------------------------------------------------*/
 	/*	Construct the world object.									*/
@@ -395,13 +417,26 @@ int	main( int main_argc, char **main_argv)
 	/*--------------------------------------------------------------*/
 	/*      Make up the prefix for the output files.                */
 	/*--------------------------------------------------------------*/
-	prefix = (char *)calloc(256, sizeof(char));
+	prefix = (char *)calloc(FILEPATH_LEN + 32, sizeof(char));
 	if ( command_line[0].output_prefix != NULL ){
+		if (strlen(command_line[0].output_prefix) >= FILEPATH_LEN) {
+			fprintf(stderr, "FATAL ERROR: output prefix %s is too long\n",
+				command_line[0].output_prefix);
+			exit(EXIT_FAILURE);
+		}
 		strcpy(prefix,command_line[0].output_prefix);
 	}
 	else{
 		strcpy(prefix,PRE);
 	}
+	if ( command_line[0].worker_rank >= 0 ) {
+		if (snprintf(prefix + strlen(prefix), 32 - strlen("_grow"), "_w%d",
+			command_line[0].worker_rank) >= 32 - (int) strlen("_grow")) {
+			fprintf(stderr, "FATAL ERROR: worker rank %d does not fit the output prefix\n",
+				command_line[0].worker_rank);
+			exit(EXIT_FAILURE);
+		}
+	}
 	output = construct_output_files( prefix, command_line );
 	if (command_line[0].grow_flag > 0) {
 		strcat(prefix,"_grow");
@@ -409,9 +444,14 @@ int	main( int main_argc, char **main_argv)
 	}
 	else growth_output = NULL;
 
-	add_headers(output, command_line);
+	/*--------------------------------------------------------------*/
+	/*	A resumed run already has its headers.				*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].restart_flag == 0) {
+		add_headers(output, command_line);
 		if (command_line[0].grow_flag > 0)
 			add_growth_headers(growth_output, command_line);
+	}
 
 
 
@@ -34,17 +34,30 @@ void add_headers(struct world_output_file_object *world_output_files,
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.									*/
 	/*--------------------------------------------------------------*/
+	void	add_hourly_summary_header(FILE *, char **, int, char **, int);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
 	FILE *outfile;
 	int check;
+	char *basin_key[] = {"basinID"};
+	char *basin_hourly[] = {"pot_surface_infil", "sat_def_z", "sat_def",
+		"rz_stor", "unsat_stor", "rz_drainage", "unsat_drainage",
+		"subsur2stream_flow", "sur2stream_flow", "streamflow",
+		"gw.Qout", "gw.storage", "detention_store", "%sat_area",
+		"litter_store", "canopy_store", "precip", "routedstreamflow"};
+	char *zone_key[] = {"basinID", "hillID", "ID"};
+	char *zone_hourly[] = {"rain", "snow", "tday", "tavg", "vpd",
+		"Kdown_direct", "Kdown_diffuse", "PAR_direct", "PAR_diffuse"};
 	/*--------------------------------------------------------------*/
 	/*	Basin file headers					*/
 	/*--------------------------------------------------------------*/
 
 	if (command_line[0].b != NULL) {
 	outfile = world_output_files[0].basin[0].hourly;
+	if (command_line[0].hourly_summary_basin_flag == 1)
+		add_hourly_summary_header(outfile, basin_key, 1, basin_hourly, 18);
+	else
 	fprintf(outfile,"%s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s \n",
 	// the unit is based on mm and day
 		"hour",		
@@ -328,6 +341,9 @@ void add_headers(struct world_output_file_object *world_output_files,
 	/*	Hourly 							*/
 	/*--------------------------------------------------------------*/
 	outfile = world_output_files[0].zone[0].hourly;
+	if (command_line[0].hourly_summary_zone_flag == 1)
+		add_hourly_summary_header(outfile, zone_key, 3, zone_hourly, 9);
+	else
 	fprintf(outfile,"%s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s\n " ,
 		"day",
 		"month",
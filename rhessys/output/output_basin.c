@@ -25,6 +25,8 @@
 /*	We only permit one fileset per spatial modelling level.     */
 /*	Each fileset has one file for each timestep.  				*/
 /*																*/
+/*	Means are taken from the sums of update_daily_aggregates.	*/
+/*																*/
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
@@ -41,8 +43,7 @@ void	output_basin(			int routing_flag,
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
-	int h,z,p,c;
-	int var_flag, layer;
+	int h;
 	double arain_throughfall;
 	double asnow_throughfall;
 	double alitter_store;
@@ -60,7 +61,7 @@ void	output_basin(			int routing_flag,
 	double asublimation, acanopysubl;
 	double asat_area, adetention_store;
 	double apsn, anppcum, alai, acrain, acsnow;
-	double abase_flow, hbase_flow,  hstreamflow_NO3, hstreamflow_NH4;
+	double abase_flow, hbase_flow;
 	double	aacctrans, var_acctrans, var_trans;
 	double aPET, adC13, amortality_fract, apcp, apcpassim;
 	double	hgw;
@@ -78,240 +79,97 @@ void	output_basin(			int routing_flag,
 	double acLstar;
 	double acdrip;
 	double acga;	
-	struct	patch_object  *patch;
-	struct	zone_object	*zone;
 	struct hillslope_object *hillslope;
+	struct daily_aggregate_object *agg;
 	/*--------------------------------------------------------------*/
 	/*	Initialize Accumlating variables.								*/
 	/*--------------------------------------------------------------*/
-	arain_throughfall =  0.0;
-	asnow_throughfall = 0.0 ;
-	acrain = 0.0;
-	asat_deficit_z = 0.0 ;
-	asat_deficit = 0.0 ;
-	arz_storage = 0.0;	
-	aunsat_storage = 0.0 ;
-	arz_drainage = 0.0;		
-	aunsat_drainage = 0.0 ;
-	acap_rise = 0.0 ;
-	areturn_flow = 0.0 ;
-	aevaporation = 0.0 ;
-	asat_area = 0.0;
-	asnowpack = 0.0  ;
-	asublimation = 0.0  ;
-	aperc_snow = 0.0  ;
-	alitter_store = 0.0  ;
-	atranspiration = 0.0  ;
 	astreamflow = 0.0;
-	arecharge = 0.0;
-	apsn = 0.0 ;
-	anppcum = 0.0;
-	aPET = 0.0;
-	aarea =  0.0 ;
 	abase_flow = 0.0;
 	hbase_flow = 0.0;
-	hstreamflow_NO3 = 0.0;
-	hstreamflow_NH4 = 0.0;
 	hgwQout = 0.0;
 	hgw = 0.0;
-	alai = 0.0;
-	adetention_store = 0.0;
-	aacctrans = 0.0; 
 	basin_area = 0.0;
-	zone_area = 0.0;
-	adC13 = 0.0;
-	amortality_fract = 0.0;
-	apcp = 0.0;
-	apcpassim = 0.0;
-    atmin = 0.0;
-    atmax = 0.0;
-    atavg = 0.0;
-    avpd = 0.0;
-    asnow = 0.0;
-	
-	agpsn=0.0;
-	aresp=0.0;
-	ags=0.0;
-	arootdepth = 0.0;
-	aleafc = 0.0;
-	afrootc = 0.0;
-	awoodc = 0.0;
-	asnowmelt = 0.0;
-	acanopysubl = 0.0;
-	acsnow = 0.0;
-	aheight = 0.0;
-	
-	aevap_can = 0.0;
-	aevap_lit = 0.0;
-	aevap_soil = 0.0;
-	
-	aKdown = 0.0;
-	aLdown = 0.0;
-	aKup = 0.0;
-	aLup = 0.0;
-	aKstar_can = 0.0;
-	aKstar_soil = 0.0;
-	aKstar_snow = 0.0;
-	aLstar_can = 0.0;
-	aLstar_soil = 0.0;
-	aLstar_snow = 0.0;
-	aLE_can = 0.0;
-	aLE_soil = 0.0;
-	aLE_snow = 0.0;
-	acLstar = 0.0;
-	
-	alitrc = 0.0;
-	acdrip = 0.0;
-	acga = 0.0;
-	
+
+	/*--------------------------------------------------------------*/
+	/*	patch, zone and strata sums from update_daily_aggregates	*/
+	/*--------------------------------------------------------------*/
+	agg = &(basin[0].daily_aggregate);
+	apcp = agg->pcp;
+	atmin = agg->tmin;
+	atmax = agg->tmax;
+	atavg = agg->tavg;
+	avpd = agg->vpd;
+	aKdown = agg->Kdown;
+	aLdown = agg->Ldown;
+	asnow = agg->snow;
+	zone_area = agg->zone_area;
+	arain_throughfall = agg->rain_throughfall_24hours + agg->rain_throughfall;
+	asnow_throughfall = agg->snow_throughfall;
+	apcpassim = agg->precip_with_assim;
+	asat_deficit_z = agg->sat_deficit_z;
+	asat_deficit = agg->sat_deficit;
+	arecharge = agg->recharge;
+	arz_storage = agg->rz_storage;
+	aunsat_storage = agg->unsat_storage;
+	arz_drainage = agg->rz_drainage;
+	aunsat_drainage = agg->unsat_drainage;
+	acap_rise = agg->cap_rise;
+	aevaporation = agg->evaporation + agg->evaporation_surf + agg->exfiltration;
+	aevap_can = agg->evaporation;
+	aevap_lit = agg->evaporation_surf;
+	aevap_soil = agg->exfiltration;
+	asublimation = agg->sublimation;
+	asnowpack = agg->snowpack;
+	aperc_snow = agg->snow_area;
+	asnowmelt = agg->snow_melt;
+	aPET = agg->PET;
+	alitter_store = agg->litter_store;
+	adetention_store = agg->detention_store;
+	aacctrans = agg->acc_year_trans;
+	atranspiration = agg->transpiration;
+	alitrc = agg->litrc;
+	aKup = agg->Kup;
+	aLup = agg->Lup;
+	aKstar_can = agg->Kstar_canopy;
+	aKstar_soil = agg->Kstar_soil;
+	aKstar_snow = agg->Kstar_snow;
+	aLstar_can = agg->Lstar_canopy;
+	aLstar_soil = agg->Lstar_soil;
+	aLstar_snow = agg->Lstar_snow;
+	aLE_can = agg->LE_canopy;
+	aLE_soil = agg->LE_soil;
+	aLE_snow = agg->LE_snow;
+	asat_area = agg->sat_area;
+	areturn_flow = agg->return_flow;
+	if (routing_flag == 1) {
+		astreamflow = agg->streamflow;
+		abase_flow = agg->base_flow;
+	}
+	acrain = agg->canopy_store;
+	apsn = agg->net_psn;
+	anppcum = agg->nppcum;
+	alai = agg->lai;
+	acanopysubl = agg->canopy_sublimation;
+	adC13 = agg->dC13;
+	amortality_fract = agg->mortality_fract;
+	agpsn = agg->gpsn;
+	aresp = agg->resp;
+	ags = agg->gs;
+	arootdepth = agg->rootdepth;
+	aleafc = agg->leafc;
+	afrootc = agg->frootc;
+	awoodc = agg->woodc;
+	acsnow = agg->canopy_snow;
+	aheight = agg->height;
+	acLstar = agg->canopy_Lstar;
+	acdrip = agg->canopy_drip;
+	acga = agg->ga;
+	aarea = agg->area;
 
 	for (h=0; h < basin[0].num_hillslopes; h++){
 		hillslope = basin[0].hillslopes[h];
-		hill_area = 0.0;
-		for (z=0; z< hillslope[0].num_zones; z++){
-			zone = hillslope[0].zones[z];
-			apcp += (zone[0].rain_hourly_total+zone[0].rain+zone[0].snow)*zone[0].area;
-			atmin += zone[0].metv.tmin * zone[0].area;
-			atmax += zone[0].metv.tmax * zone[0].area;
-			atavg += zone[0].metv.tavg * zone[0].area;
-			avpd += zone[0].metv.vpd * zone[0].area;
-			aKdown += (zone[0].Kdown_diffuse + zone[0].Kdown_direct) * zone[0].area;
-			aLdown += zone[0].Ldown * zone[0].area;
-			asnow += zone[0].snow * zone[0].area;
-			zone_area += zone[0].area;
-			for (p=0; p< zone[0].num_patches; p++){
-				patch = zone[0].patches[p];
-				arain_throughfall += (patch[0].rain_throughfall_24hours + patch[0].rain_throughfall) * patch[0].area;
-				asnow_throughfall += patch[0].snow_throughfall * patch[0].area;
-				apcpassim += patch[0].precip_with_assim * patch[0].area;
-				asat_deficit_z += patch[0].sat_deficit_z * patch[0].area;
-				asat_deficit += patch[0].sat_deficit * patch[0].area;
-				arecharge += patch[0].recharge * patch[0].area;
-				arz_storage += patch[0].rz_storage * patch[0].area;		
-				aunsat_storage += patch[0].unsat_storage * patch[0].area;
-				arz_drainage += patch[0].rz_drainage * patch[0].area;	
-				aunsat_drainage += patch[0].unsat_drainage * patch[0].area;
-				acap_rise += patch[0].cap_rise * patch[0].area;
-				aevaporation += (patch[0].evaporation + patch[0].evaporation_surf
-					+ patch[0].exfiltration_sat_zone
-					+ patch[0].exfiltration_unsat_zone) * patch[0].area;
-				aevap_can += (patch[0].evaporation) * patch[0].area;
-				aevap_lit += (patch[0].evaporation_surf) * patch[0].area;
-				aevap_soil += (patch[0].exfiltration_sat_zone
-							   + patch[0].exfiltration_unsat_zone) * patch[0].area;
-				asublimation += patch[0].snowpack.sublimation * patch[0].area;
-				asnowpack += patch[0].snowpack.water_equivalent_depth*patch[0].area;
-				if (patch[0].snowpack.water_equivalent_depth > 0.001)
-					aperc_snow += patch[0].area;
-				asnowmelt += patch[0].snow_melt*patch[0].area;
-				aPET += (patch[0].PET) * patch[0].area;
-				alitter_store += patch[0].litter.rain_stored * patch[0].area;
-				adetention_store += patch[0].detention_store*patch[0].area;
-				aacctrans += patch[0].acc_year_trans * patch[0].area; 
-				atranspiration += (patch[0].transpiration_sat_zone
-					+ patch[0].transpiration_unsat_zone)  *  patch[0].area;
-				alitrc += (patch[0].litter_cs.litr1c + patch[0].litter_cs.litr2c
-						   + patch[0].litter_cs.litr3c + patch[0].litter_cs.litr4c)
-				* patch[0].area;
-				aKup += (patch[0].Kup_direct + patch[0].Kup_diffuse) * patch[0].area;
-				aLup += (patch[0].Lup) * patch[0].area;
-				aKstar_can += patch[0].Kstar_canopy * patch[0].area;
-				aKstar_soil += patch[0].Kstar_soil * patch[0].area;
-				aKstar_snow += (patch[0].snowpack.Kstar_direct + patch[0].snowpack.Kstar_diffuse) * patch[0].area;
-				aLstar_can += patch[0].Lstar_canopy * patch[0].area;
-				aLstar_soil += patch[0].Lstar_soil * patch[0].area;
-				aLstar_snow += patch[0].Lstar_snow * patch[0].area;
-				aLE_can += patch[0].LE_canopy * patch[0].area;
-				aLE_soil += patch[0].LE_soil * patch[0].area;
-				aLE_snow += (-1 * patch[0].snowpack.Q_LE + patch[0].snowpack.Q_melt) * patch[0].area;
-				if (patch[0].sat_deficit <= ZERO)
-					asat_area += patch[0].area;
-				if (routing_flag == 1) {
-					if (patch[0].drainage_type == STREAM  )  
-						astreamflow += patch[0].streamflow*patch[0].area;
-						areturn_flow += patch[0].return_flow * patch[0].area;
-						abase_flow += patch[0].base_flow * patch[0].area;
-				}
-				else {
-						/* for Topmodel version compute only return flow and later added to streamflow */
-						areturn_flow += patch[0].return_flow * patch[0].area;
-				}
-				for ( layer=0 ; layer<patch[0].num_layers; layer++ ){
-					for ( c=0 ; c<patch[0].layers[layer].count; c++ ){
-						acrain += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* (patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].rain_stored +
-							 patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].snow_stored )
-							* patch[0].area;
-						apsn += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.net_psn
-							* patch[0].area;
-						anppcum += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.nppcum
-							* patch[0].area;
-						alai += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].epv.proj_lai
-							* patch[0].area;
-						acanopysubl += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].sublimation
-							* patch[0].area;
-						adC13 += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].dC13
-							* patch[0].area;
-						amortality_fract += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.mortality_fract
-							* patch[0].area;
-						agpsn += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction * patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.psn_to_cpool
-							* patch[0].area;
-						aresp += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* (patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.leaf_day_mr + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.cpool_leaf_gr
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.leaf_night_mr +	patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.livestem_mr
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.cpool_livestem_gr + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.livecroot_mr
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.cpool_livecroot_gr
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.cpool_deadcroot_gr
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.froot_mr + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.cpool_froot_gr
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.cpool_to_gresp_store)	* patch[0].area;
-						ags += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction 
-							* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].gs * patch[0].area;
-						arootdepth += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction 
-							* (patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].rootzone.depth)
-							* patch[0].area;
-						aleafc += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction	* (patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.leafc
-							+ patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.leafc_store + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.leafc_transfer ) 
-							* patch[0].area;
-						afrootc += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction * (patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.frootc
-							+ patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.frootc_store + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.frootc_transfer)
-							* patch[0].area;
-						awoodc += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction	* (patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.live_crootc
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.live_stemc + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.dead_crootc
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.dead_stemc + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.livecrootc_store
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.livestemc_store + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.deadcrootc_store
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.deadstemc_store
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.livecrootc_transfer
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.livestemc_transfer
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.deadcrootc_transfer
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.deadstemc_transfer
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.cwdc + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.cpool) 
-							* patch[0].area;
-						acsnow += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* (	patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].snow_stored )
-							* patch[0].area;
-						aheight += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction 
-							* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].epv.height 
-							* patch[0].area;
-						acLstar += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* (	patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].Lstar )
-							* patch[0].area;
-						acdrip += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* (	patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].canopy_drip )
-							* patch[0].area;
-						acga += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].ga * patch[0].area;
-					}
-				}
-				aarea +=  patch[0].area;
-				hill_area += patch[0].area;
-			}
-		}
+		hill_area = hillslope[0].daily_aggregate.area;
 		hbase_flow += hillslope[0].base_flow * hill_area;
 		hgw += hillslope[0].gw.storage * hill_area;
 		hgwQout += hillslope[0].gw.Qout * hill_area;
@@ -398,27 +256,14 @@ void	output_basin(			int routing_flag,
 	if (routing_flag == 0)
 		astreamflow += areturn_flow;
 
-	var_flag = 1;
-	var_trans = 0; 
-	var_acctrans = 0;
-	if (var_flag == 1) {
-       #pragma omp parallel for reduction(+ : var_acctrans,var_trans)      
-        for (int h=0; h < basin[0].num_hillslopes; h++){
-        struct hillslope_object *hillslope = basin[0].hillslopes[h];
-        for (int z=0; z< hillslope[0].num_zones; z++){
-            struct zone_object *zone = hillslope[0].zones[z];
-            for (int p=0; p< zone[0].num_patches; p++){
-                struct patch_object *patch = zone[0].patches[p];
-				var_acctrans += pow( 1000*(patch[0].acc_year_trans - aacctrans), 2.0)  *  patch[0].area;
-				var_trans += pow( 1000*(patch[0].transpiration_sat_zone
-					+ patch[0].transpiration_unsat_zone - atranspiration), 2.0)  *  patch[0].area;
-			}
-		}
-		}
-	}
-
-	var_trans /= aarea;
-	var_acctrans /= aarea;
+	/*--------------------------------------------------------------*/
+	/*	spatial variance of transpiration, (mm/day)^2, from the	*/
+	/*	area weighted sums of squares				*/
+	/*--------------------------------------------------------------*/
+	var_trans = max(0.0, 1.0e6 * (agg->transpiration_sq / aarea
+		- atranspiration * atranspiration));
+	var_acctrans = max(0.0, 1.0e6 * (agg->acc_year_trans_sq / aarea
+		- aacctrans * aacctrans));
 				
 
 	fprintf(outfile,"%d %d %d %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf\n",
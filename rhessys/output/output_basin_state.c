@@ -26,8 +26,15 @@
 /*	May 20, 1997	C.Tague					*/
 /*	- typo in counter for hillslope loop (changed from i to h ) */
 /*																*/
+/*	Hillslopes are formatted in parallel, each into its own	*/
+/*	memory stream, and then written to outfile in order, so	*/
+/*	the text is the same as a serial write and a compressed	*/
+/*	outfile only has to compress.								*/
+/*																*/
 /*--------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
+#include <stdlib.h>
 #include "rhessys.h"
 
 void	output_basin_state(
@@ -48,6 +55,9 @@ void	output_basin_state(
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
 	int h,i;
+	char	**text;
+	size_t	*length;
+	FILE	*buffer;
 	/*--------------------------------------------------------------*/
 	/*	output basin information									*/
 	/*--------------------------------------------------------------*/
@@ -77,9 +87,27 @@ void	output_basin_state(
 	/*--------------------------------------------------------------*/
 	/*	output hillslopes 											*/
 	/*--------------------------------------------------------------*/
+	text = (char **) calloc(basin[0].num_hillslopes + 1, sizeof(char *));
+	length = (size_t *) calloc(basin[0].num_hillslopes + 1, sizeof(size_t));
+	if ((text == NULL) || (length == NULL)) {
+		fprintf(stderr,"FATAL ERROR: out of memory in output_basin_state\n");
+		exit(EXIT_FAILURE);
+	}
+	#pragma omp parallel for private(buffer) schedule(dynamic)
+	for (h=0; h < basin[0].num_hillslopes; ++ h ) {
+		if ((buffer = open_memstream(&(text[h]), &(length[h]))) == NULL) {
+			fprintf(stderr,"FATAL ERROR: out of memory in output_basin_state\n");
+			exit(EXIT_FAILURE);
+		}
+		output_hillslope_state(basin[0].hillslopes[h], current_date, command_line, buffer);
+		fclose(buffer);
+	}
 	for (h=0; h < basin[0].num_hillslopes; ++ h ) {
-		output_hillslope_state(basin[0].hillslopes[h], current_date, command_line, outfile);
+		fwrite(text[h], 1, length[h], outfile);
+		free(text[h]);
 	}
+	free(text);
+	free(length);
     printf("\n Finishing basin output state\n");
 	return;
 } /*end output_basin_state*/
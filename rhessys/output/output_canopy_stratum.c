@@ -37,50 +37,54 @@ void	output_canopy_stratum( int basinID, int hillID, int zoneID, int patchID,
 	/*------------------------------------------------------*/
 	/*	Local Function Declarations.						*/
 	/*------------------------------------------------------*/
+	void	output_line_start(struct output_line_object *, FILE *);
+	void	output_line_int(struct output_line_object *, long, char *);
+	void	output_line_double(struct output_line_object *, double, char *);
+	int	output_line_end(struct output_line_object *);
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
+	struct	output_line_object	line;
 	
-	fprintf(outfile,
-		"%d %d %d %d %d %d %d %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %d \n",
-		current_date.day,
-		current_date.month,
-		current_date.year,
-		basinID,
-		hillID,
-		zoneID,
-		patchID,
-		stratum[0].ID,
-		stratum[0].epv.proj_lai,
-		stratum[0].evaporation*1000,
-		stratum[0].Kstar_direct,
-		stratum[0].Kstar_diffuse,
-		stratum[0].sublimation*1000,
-		stratum[0].transpiration_unsat_zone *1000.0
-			+ stratum[0].transpiration_sat_zone *1000.0,
-		stratum[0].ga*1000.0,
-		stratum[0].gsurf*1000.0,
-		stratum[0].gs*1000.0,
-		stratum[0].epv.psi,
-		stratum[0].cdf.leaf_day_mr*1000.0,
-		stratum[0].cdf.psn_to_cpool*1000.0,
-		stratum[0].rain_stored*1000.0,
-		stratum[0].snow_stored*1000.0,
-		stratum[0].rootzone.S,
-		stratum[0].mult_conductance.APAR,
-		stratum[0].mult_conductance.tavg,
-		stratum[0].mult_conductance.LWP,
-		stratum[0].mult_conductance.CO2,
-		stratum[0].mult_conductance.tmin,
-		stratum[0].mult_conductance.vpd,
-		stratum[0].dC13,
-			stratum[0].Kstar_direct,
-			stratum[0].Kstar_diffuse,
-			stratum[0].Lstar,
-			stratum[0].surface_heat_flux,
-			stratum[0].epv.height,
-			stratum[0].cover_fraction,
-			stratum[0].defaults[0][0].ID);
+	output_line_start(&line, outfile);
+	output_line_int(&line, current_date.day, " ");
+	output_line_int(&line, current_date.month, " ");
+	output_line_int(&line, current_date.year, " ");
+	output_line_int(&line, basinID, " ");
+	output_line_int(&line, hillID, " ");
+	output_line_int(&line, zoneID, " ");
+	output_line_int(&line, patchID, " ");
+	output_line_int(&line, stratum[0].ID, " ");
+	output_line_double(&line, stratum[0].epv.proj_lai, " ");
+	output_line_double(&line, stratum[0].evaporation*1000, " ");
+	output_line_double(&line, stratum[0].Kstar_direct, " ");
+	output_line_double(&line, stratum[0].Kstar_diffuse, " ");
+	output_line_double(&line, stratum[0].sublimation*1000, " ");
+	output_line_double(&line, stratum[0].transpiration_unsat_zone *1000.0 + stratum[0].transpiration_sat_zone *1000.0, " ");
+	output_line_double(&line, stratum[0].ga*1000.0, " ");
+	output_line_double(&line, stratum[0].gsurf*1000.0, " ");
+	output_line_double(&line, stratum[0].gs*1000.0, " ");
+	output_line_double(&line, stratum[0].epv.psi, " ");
+	output_line_double(&line, stratum[0].cdf.leaf_day_mr*1000.0, " ");
+	output_line_double(&line, stratum[0].cdf.psn_to_cpool*1000.0, " ");
+	output_line_double(&line, stratum[0].rain_stored*1000.0, " ");
+	output_line_double(&line, stratum[0].snow_stored*1000.0, " ");
+	output_line_double(&line, stratum[0].rootzone.S, " ");
+	output_line_double(&line, stratum[0].mult_conductance.APAR, " ");
+	output_line_double(&line, stratum[0].mult_conductance.tavg, " ");
+	output_line_double(&line, stratum[0].mult_conductance.LWP, " ");
+	output_line_double(&line, stratum[0].mult_conductance.CO2, " ");
+	output_line_double(&line, stratum[0].mult_conductance.tmin, " ");
+	output_line_double(&line, stratum[0].mult_conductance.vpd, " ");
+	output_line_double(&line, stratum[0].dC13, " ");
+	output_line_double(&line, stratum[0].Kstar_direct, " ");
+	output_line_double(&line, stratum[0].Kstar_diffuse, " ");
+	output_line_double(&line, stratum[0].Lstar, " ");
+	output_line_double(&line, stratum[0].surface_heat_flux, " ");
+	output_line_double(&line, stratum[0].epv.height, " ");
+	output_line_double(&line, stratum[0].cover_fraction, " ");
+	output_line_int(&line, stratum[0].defaults[0][0].ID, " \n");
+	output_line_end(&line);
 	return;
 } /*end output_canopy_stratum*/
@@ -38,10 +38,15 @@ void	output_csv_patch(
 	/*------------------------------------------------------*/
 	/*	Local Function Declarations.						*/
 	/*------------------------------------------------------*/
+	void	output_line_start(struct output_line_object *, FILE *);
+	void	output_line_int(struct output_line_object *, long, char *);
+	void	output_line_double(struct output_line_object *, double, char *);
+	int	output_line_end(struct output_line_object *);
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
+	struct	output_line_object	line;
 	int check, c, layer;
 	double apsn, litterS;
 
@@ -57,32 +62,33 @@ void	output_csv_patch(
 				* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.net_psn ;
 		}
 	}
-	check = fprintf(outfile,"%d,%d,%d,%d,%d,%d,%d,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf\n",
-		current_date.day,
-		current_date.month,
-		current_date.year,
-		basinID,
-		hillID,
-		zoneID,
-		patch[0].ID,
-		patch[0].rain_throughfall*1000.0,
-		patch[0].detention_store*1000.0,
-		patch[0].sat_deficit_z*1000,
-		patch[0].sat_deficit*1000,
-		patch[0].unsat_storage*1000,
-		patch[0].unsat_drainage*1000,
-		patch[0].cap_rise*1000,
-		patch[0].return_flow*1000.0,
-		patch[0].evaporation*1000.0,
-		patch[0].snowpack.water_equivalent_depth*1000.0,
-		(patch[0].transpiration_sat_zone+patch[0].transpiration_unsat_zone)*1000.0,
-		(patch[0].Qin_total) * 1000.0,
-		(patch[0].Qout_total) * 1000.0,
-		apsn * 1000.0,
-		patch[0].rootzone.S,
-		patch[0].litter.rain_stored*1000.0,
-		litterS,
-		patch[0].area);
+	output_line_start(&line, outfile);
+	output_line_int(&line, current_date.day, ",");
+	output_line_int(&line, current_date.month, ",");
+	output_line_int(&line, current_date.year, ",");
+	output_line_int(&line, basinID, ",");
+	output_line_int(&line, hillID, ",");
+	output_line_int(&line, zoneID, ",");
+	output_line_int(&line, patch[0].ID, ",");
+	output_line_double(&line, patch[0].rain_throughfall*1000.0, ",");
+	output_line_double(&line, patch[0].detention_store*1000.0, ",");
+	output_line_double(&line, patch[0].sat_deficit_z*1000, ",");
+	output_line_double(&line, patch[0].sat_deficit*1000, ",");
+	output_line_double(&line, patch[0].unsat_storage*1000, ",");
+	output_line_double(&line, patch[0].unsat_drainage*1000, ",");
+	output_line_double(&line, patch[0].cap_rise*1000, ",");
+	output_line_double(&line, patch[0].return_flow*1000.0, ",");
+	output_line_double(&line, patch[0].evaporation*1000.0, ",");
+	output_line_double(&line, patch[0].snowpack.water_equivalent_depth*1000.0, ",");
+	output_line_double(&line, (patch[0].transpiration_sat_zone+patch[0].transpiration_unsat_zone)*1000.0, ",");
+	output_line_double(&line, (patch[0].Qin_total) * 1000.0, ",");
+	output_line_double(&line, (patch[0].Qout_total) * 1000.0, ",");
+	output_line_double(&line, apsn * 1000.0, ",");
+	output_line_double(&line, patch[0].rootzone.S, ",");
+	output_line_double(&line, patch[0].litter.rain_stored*1000.0, ",");
+	output_line_double(&line, litterS, ",");
+	output_line_double(&line, patch[0].area, "\n");
+	check = output_line_end(&line);
 	if (check <= 0) {
 		fprintf(stdout, "\nWARNING: output error has occured in output_csv_patch");
 	}
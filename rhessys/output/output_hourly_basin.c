@@ -41,11 +41,14 @@
 void	output_hourly_basin(	int routing_flag,
 					struct	basin_object	*basin,
 					struct	date	date,
-					FILE *outfile)
+					FILE *outfile,
+					int summary_flag)
 {
 	/*------------------------------------------------------*/
 	/*	Local Function Declarations.						*/
 	/*------------------------------------------------------*/
+	void	hourly_summary(struct hourly_summary_object *,
+		struct date, long *, int, double *, int, FILE *);
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
@@ -84,6 +87,8 @@ void	output_hourly_basin(	int routing_flag,
 	struct	patch_object  *patch;
 	struct	zone_object	*zone;
 	struct hillslope_object *hillslope;
+	long	key[1];
+	double	value[18];
 	/*--------------------------------------------------------------*/
 	/*	Initialize Accumlating variables.								*/
 	/*--------------------------------------------------------------*/
@@ -272,6 +277,33 @@ void	output_hourly_basin(	int routing_flag,
 	var_acctrans /= aarea;
 				
 	*/
+	/*--------------------------------------------------------------*/
+	/*	-hsum keeps daily statistics in place of the hourly row	*/
+	/*--------------------------------------------------------------*/
+	if (summary_flag == 1) {
+		value[0] = arain_throughfall * 1000.0;
+		value[1] = asat_deficit_z * 1000.0;
+		value[2] = asat_deficit * 1000.0;
+		value[3] = arz_storage * 1000.0;
+		value[4] = aunsat_storage * 1000.0;
+		value[5] = ahourly_rz_drainage * 1000.0;
+		value[6] = ahourly_unsat_drainage * 1000.0;
+		value[7] = abase_flow * 1000.0;
+		value[8] = areturn_flow * 1000.0;
+		value[9] = astreamflow * 1000.0;
+		value[10] = hgwQout *1000.0;
+		value[11] = hgw *1000.0;
+		value[12] = adetention_store * 1000;
+		value[13] = asat_area * 100;
+		value[14] = alitter_store * 1000;
+		value[15] = acrain * 1000.0;
+		value[16] = apcp*1000.0;
+		value[17] = basin[0].stream_list.streamflow *1000.0*24*3600/aarea;
+		key[0] = basin[0].ID;
+		hourly_summary(&(basin[0].hourly_summary), date, key, 1,
+			value, 18, outfile);
+		return;
+	}
 	fprintf(outfile,"%ld %ld %ld %ld %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf \n",
 		date.hour,		
 		date.day,
@@ -32,15 +32,38 @@
 void	output_hourly_zone(	int basinID, int hillID,
 					struct	zone_object	*zone,
 					struct	date	current_date,
-					FILE *outfile)
+					FILE *outfile,
+					int summary_flag)
 {
 	/*------------------------------------------------------*/
 	/*	Local Function Declarations.						*/
 	/*------------------------------------------------------*/
+	void	hourly_summary(struct hourly_summary_object *,
+		struct date, long *, int, double *, int, FILE *);
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
+	long	key[3];
+	double	value[9];
+
+	if (summary_flag == 1) {
+		key[0] = basinID;
+		key[1] = hillID;
+		key[2] = zone[0].ID;
+		value[0] = zone[0].hourly[0].rain * 1000.0;
+		value[1] = zone[0].snow * 1000.0;
+		value[2] = zone[0].metv.tday;
+		value[3] = zone[0].metv.tavg;
+		value[4] = zone[0].metv.vpd;
+		value[5] = zone[0].hourly[0].Kdown_direct;
+		value[6] = zone[0].hourly[0].Kdown_diffuse;
+		value[7] = zone[0].PAR_direct;
+		value[8] = zone[0].PAR_diffuse;
+		hourly_summary(&(zone[0].hourly_summary), current_date, key, 3,
+			value, 9, outfile);
+		return;
+	}
 	fprintf(outfile,
 		"%d %d %d %d %d %d %d %f %f %f %f %f %f %f %f %f \n ",
 		current_date.day,
@@ -39,10 +39,15 @@ void	output_patch(
 	/*------------------------------------------------------*/
 	/*	Local Function Declarations.						*/
 	/*------------------------------------------------------*/
+	void	output_line_start(struct output_line_object *, FILE *);
+	void	output_line_int(struct output_line_object *, long, char *);
+	void	output_line_double(struct output_line_object *, double, char *);
+	int	output_line_end(struct output_line_object *);
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
+	struct	output_line_object	line;
 	int check, c, layer;
 	double alai, asub, apsn, litterS, aheight;
 
@@ -70,68 +75,86 @@ void	output_patch(
 		}
 	}
 
-	check = fprintf(outfile,"%d %d %d %d %d %d %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf\n",
-					current_date.day,
-					current_date.month,
-					current_date.year,
-					basinID,
-					hillID,
-					zoneID,
-					patch[0].ID,
-					patch[0].rain_throughfall*1000.0,
-					patch[0].detention_store*1000.0,
-					patch[0].sat_deficit_z*1000,
-					patch[0].sat_deficit*1000,
-					patch[0].rz_storage*1000,
-					patch[0].rootzone.potential_sat*1000,
-					patch[0].rootzone.field_capacity*1000,
-					patch[0].wilting_point*1000,
-					patch[0].unsat_storage*1000,
-					patch[0].rz_drainage*1000,
-					patch[0].unsat_drainage*1000,
-					(patch[0].snowpack.sublimation + asub)*1000,
-					patch[0].return_flow*1000.0,
-					patch[0].evaporation*1000.0,
-					patch[0].evaporation_surf*1000.0,
-					(patch[0].exfiltration_sat_zone + patch[0].exfiltration_unsat_zone) * 1000.0, 
-					patch[0].snowpack.water_equivalent_depth*1000.0,
-					patch[0].snow_melt*1000.0,
-					(patch[0].transpiration_sat_zone*1000.0), (patch[0].transpiration_unsat_zone)*1000.0,
-					patch[0].Qin_total * 1000.0,
-					patch[0].Qout_total * 1000.0,
-					apsn * 1000.0,
-					patch[0].rootzone.S,
-					patch[0].rootzone.depth*1000.0,
-					patch[0].litter.rain_stored*1000.0,
-					litterS,
-					patch[0].area, (patch[0].PET)*1000.0, alai, 
-					patch[0].base_flow*1000.0, 
-					patch[0].streamflow*1000.0, 1000.0*(zone[0].rain+zone[0].snow), patch[0].recharge, 
-					patch[0].Kdown_direct, patch[0].Kdown_diffuse, 
-					patch[0].Kup_direct, patch[0].Kup_diffuse, patch[0].Lup,
-					patch[0].Kdown_direct_subcanopy, patch[0].Kdown_diffuse_subcanopy, patch[0].Ldown_subcanopy, 
-					patch[0].Kstar_canopy,
-					patch[0].snowpack.Kstar_direct, patch[0].snowpack.Kstar_diffuse,
-					patch[0].Lstar_canopy, patch[0].Lstar_snow, patch[0].Lstar_soil, 
-					patch[0].wind, patch[0].windsnow, zone[0].wind, 
-					patch[0].ga*1000.0, patch[0].gasnow*1000.0,
-					patch[0].trans_reduc_perc,
-					patch[0].field_capacity,
-					patch[0].overland_flow*1000.0,
-					aheight,
-					patch[0].ustar,
-					patch[0].snowpack.K_reflectance,
-					patch[0].Kstar_soil,
-					patch[0].Kdown_direct_bare, patch[0].Kdown_diffuse_bare,
-					patch[0].exfiltration_unsat_zone,
-					patch[0].snowpack.Rnet/86.4,
-					patch[0].snowpack.Q_LE/86.4,
-					patch[0].snowpack.Q_H/86.4,
-					patch[0].snowpack.Q_rain/86.4,
-					patch[0].snowpack.Q_melt/86.4,
-					patch[0].LE_canopy,
-					patch[0].snowpack.energy_deficit,
-					patch[0].snowpack.surface_age);
+	output_line_start(&line, outfile);
+	output_line_int(&line, current_date.day, " ");
+	output_line_int(&line, current_date.month, " ");
+	output_line_int(&line, current_date.year, " ");
+	output_line_int(&line, basinID, " ");
+	output_line_int(&line, hillID, " ");
+	output_line_int(&line, zoneID, " ");
+	output_line_int(&line, patch[0].ID, " ");
+	output_line_double(&line, patch[0].rain_throughfall*1000.0, " ");
+	output_line_double(&line, patch[0].detention_store*1000.0, " ");
+	output_line_double(&line, patch[0].sat_deficit_z*1000, " ");
+	output_line_double(&line, patch[0].sat_deficit*1000, " ");
+	output_line_double(&line, patch[0].rz_storage*1000, " ");
+	output_line_double(&line, patch[0].rootzone.potential_sat*1000, " ");
+	output_line_double(&line, patch[0].rootzone.field_capacity*1000, " ");
+	output_line_double(&line, patch[0].wilting_point*1000, " ");
+	output_line_double(&line, patch[0].unsat_storage*1000, " ");
+	output_line_double(&line, patch[0].rz_drainage*1000, " ");
+	output_line_double(&line, patch[0].unsat_drainage*1000, " ");
+	output_line_double(&line, (patch[0].snowpack.sublimation + asub)*1000, " ");
+	output_line_double(&line, patch[0].return_flow*1000.0, " ");
+	output_line_double(&line, patch[0].evaporation*1000.0, " ");
+	output_line_double(&line, patch[0].evaporation_surf*1000.0, " ");
+	output_line_double(&line, (patch[0].exfiltration_sat_zone + patch[0].exfiltration_unsat_zone) * 1000.0, " ");
+	output_line_double(&line, patch[0].snowpack.water_equivalent_depth*1000.0, " ");
+	output_line_double(&line, patch[0].snow_melt*1000.0, " ");
+	output_line_double(&line, (patch[0].transpiration_sat_zone*1000.0), " ");
+	output_line_double(&line, (patch[0].transpiration_unsat_zone)*1000.0, " ");
+	output_line_double(&line, patch[0].Qin_total * 1000.0, " ");
+	output_line_double(&line, patch[0].Qout_total * 1000.0, " ");
+	output_line_double(&line, apsn * 1000.0, " ");
+	output_line_double(&line, patch[0].rootzone.S, " ");
+	output_line_double(&line, patch[0].rootzone.depth*1000.0, " ");
+	output_line_double(&line, patch[0].litter.rain_stored*1000.0, " ");
+	output_line_double(&line, litterS, " ");
+	output_line_double(&line, patch[0].area, " ");
+	output_line_double(&line, (patch[0].PET)*1000.0, " ");
+	output_line_double(&line, alai, " ");
+	output_line_double(&line, patch[0].base_flow*1000.0, " ");
+	output_line_double(&line, patch[0].streamflow*1000.0, " ");
+	output_line_double(&line, 1000.0*(zone[0].rain+zone[0].snow), " ");
+	output_line_double(&line, patch[0].recharge, " ");
+	output_line_double(&line, patch[0].Kdown_direct, " ");
+	output_line_double(&line, patch[0].Kdown_diffuse, " ");
+	output_line_double(&line, patch[0].Kup_direct, " ");
+	output_line_double(&line, patch[0].Kup_diffuse, " ");
+	output_line_double(&line, patch[0].Lup, " ");
+	output_line_double(&line, patch[0].Kdown_direct_subcanopy, " ");
+	output_line_double(&line, patch[0].Kdown_diffuse_subcanopy, " ");
+	output_line_double(&line, patch[0].Ldown_subcanopy, " ");
+	output_line_double(&line, patch[0].Kstar_canopy, " ");
+	output_line_double(&line, patch[0].snowpack.Kstar_direct, " ");
+	output_line_double(&line, patch[0].snowpack.Kstar_diffuse, " ");
+	output_line_double(&line, patch[0].Lstar_canopy, " ");
+	output_line_double(&line, patch[0].Lstar_snow, " ");
+	output_line_double(&line, patch[0].Lstar_soil, " ");
+	output_line_double(&line, patch[0].wind, " ");
+	output_line_double(&line, patch[0].windsnow, " ");
+	output_line_double(&line, zone[0].wind, " ");
+	output_line_double(&line, patch[0].ga*1000.0, " ");
+	output_line_double(&line, patch[0].gasnow*1000.0, " ");
+	output_line_double(&line, patch[0].trans_reduc_perc, " ");
+	output_line_double(&line, patch[0].field_capacity, " ");
+	output_line_double(&line, patch[0].overland_flow*1000.0, " ");
+	output_line_double(&line, aheight, " ");
+	output_line_double(&line, patch[0].ustar, " ");
+	output_line_double(&line, patch[0].snowpack.K_reflectance, " ");
+	output_line_double(&line, patch[0].Kstar_soil, " ");
+	output_line_double(&line, patch[0].Kdown_direct_bare, " ");
+	output_line_double(&line, patch[0].Kdown_diffuse_bare, " ");
+	output_line_double(&line, patch[0].exfiltration_unsat_zone, " ");
+	output_line_double(&line, patch[0].snowpack.Rnet/86.4, " ");
+	output_line_double(&line, patch[0].snowpack.Q_LE/86.4, " ");
+	output_line_double(&line, patch[0].snowpack.Q_H/86.4, " ");
+	output_line_double(&line, patch[0].snowpack.Q_rain/86.4, " ");
+	output_line_double(&line, patch[0].snowpack.Q_melt/86.4, " ");
+	output_line_double(&line, patch[0].LE_canopy, " ");
+	output_line_double(&line, patch[0].snowpack.energy_deficit, " ");
+	output_line_double(&line, patch[0].snowpack.surface_age, "\n");
+	check = output_line_end(&line);
 	
 
 	if (check <= 0) {
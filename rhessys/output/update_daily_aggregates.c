@@ -0,0 +1,276 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		update_daily_aggregates				*/
+/*								*/
+/*	NAME							*/
+/*	update_daily_aggregates - area weighted daily sums of	*/
+/*		each hillslope and of the basin			*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	void	update_daily_aggregates(			*/
+/*			struct	basin_object	*basin)		*/
+/*								*/
+/*	OPTIONS							*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	The daily basin and hillslope outputs (plain and	*/
+/*	growth) all report area weighted means of the same	*/
+/*	zone, patch and canopy strata variables.  They are	*/
+/*	summed here in one pass over the hillslopes, into	*/
+/*	hillslope[h].daily_aggregate and then, in hillslope	*/
+/*	order, into basin.daily_aggregate.  The sums are kept	*/
+/*	until basin_daily_F or basin_hourly moves the state	*/
+/*	on, so whichever output event of the step runs first	*/
+/*	does the work and the others only read them.		*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*	Sums of squares of transpiration and acc_year_trans	*/
+/*	are kept so output_basin gets their spatial variance	*/
+/*	without a second pass.					*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "rhessys.h"
+
+static void aggregate_hillslope(struct hillslope_object *hillslope)
+{
+	int	z, p, c, layer;
+	double	area, u20, trans, p_over, p_under;
+	double	leafc, frootc, woodc;
+	struct	daily_aggregate_object *agg;
+	struct	zone_object	*zone;
+	struct	patch_object	*patch;
+	struct	canopy_strata_object	*strata;
+
+	agg = &(hillslope[0].daily_aggregate);
+	memset(agg, 0, sizeof(struct daily_aggregate_object));
+
+	for (z=0; z < hillslope[0].num_zones; z++){
+		zone = hillslope[0].zones[z];
+		agg->zone_area += zone[0].area;
+		agg->pcp += (zone[0].rain_hourly_total + zone[0].rain + zone[0].snow) * zone[0].area;
+		agg->tmin += zone[0].metv.tmin * zone[0].area;
+		agg->tmax += zone[0].metv.tmax * zone[0].area;
+		agg->tavg += zone[0].metv.tavg * zone[0].area;
+		agg->vpd += zone[0].metv.vpd * zone[0].area;
+		agg->Kdown += (zone[0].Kdown_diffuse + zone[0].Kdown_direct) * zone[0].area;
+		agg->Ldown += zone[0].Ldown * zone[0].area;
+		agg->snow += zone[0].snow * zone[0].area;
+		agg->ndep += (zone[0].ndep_NO3 + zone[0].ndep_NH4) * zone[0].area;
+
+		for (p=0; p < zone[0].num_patches; p++){
+			patch = zone[0].patches[p];
+			area = patch[0].area;
+			agg->area += area;
+			agg->rain_throughfall += patch[0].rain_throughfall * area;
+			agg->rain_throughfall_24hours += patch[0].rain_throughfall_24hours * area;
+			agg->snow_throughfall += patch[0].snow_throughfall * area;
+			agg->precip_with_assim += patch[0].precip_with_assim * area;
+			agg->sat_deficit_z += patch[0].sat_deficit_z * area;
+			agg->sat_deficit += patch[0].sat_deficit * area;
+
+			/* determine actual amount in upper 20cm */
+			if (patch[0].sat_deficit_z > 0.020)
+				u20 = patch[0].unsat_storage * 0.020/patch[0].sat_deficit_z;
+			else
+				u20 = patch[0].unsat_storage + (0.020 - patch[0].sat_deficit_z)*
+						patch[0].soil_defaults[0][0].porosity_0;
+			agg->u20 += u20 * area;
+
+			agg->rz_storage += patch[0].rz_storage * area;
+			agg->unsat_storage += patch[0].unsat_storage * area;
+			agg->rz_drainage += patch[0].rz_drainage * area;
+			agg->unsat_drainage += patch[0].unsat_drainage * area;
+			agg->cap_rise += patch[0].cap_rise * area;
+			agg->recharge += patch[0].recharge * area;
+			agg->evaporation += patch[0].evaporation * area;
+			agg->evaporation_surf += patch[0].evaporation_surf * area;
+			agg->exfiltration += (patch[0].exfiltration_sat_zone
+				+ patch[0].exfiltration_unsat_zone) * area;
+			trans = patch[0].transpiration_sat_zone + patch[0].transpiration_unsat_zone;
+			agg->transpiration += trans * area;
+			agg->transpiration_sq += trans * trans * area;
+			agg->acc_year_trans += patch[0].acc_year_trans * area;
+			agg->acc_year_trans_sq += patch[0].acc_year_trans * patch[0].acc_year_trans * area;
+			agg->PET += patch[0].PET * area;
+			agg->sublimation += patch[0].snowpack.sublimation * area;
+			agg->snowpack += patch[0].snowpack.water_equivalent_depth * area;
+			if (patch[0].snowpack.water_equivalent_depth > 0.001)
+				agg->snow_area += area;
+			agg->snow_melt += patch[0].snow_melt * area;
+			agg->litter_store += patch[0].litter.rain_stored * area;
+			agg->detention_store += patch[0].detention_store * area;
+			if (patch[0].sat_deficit <= ZERO)
+				agg->sat_area += area;
+			agg->return_flow += patch[0].return_flow * area;
+			agg->base_flow += patch[0].base_flow * area;
+			if (patch[0].drainage_type == STREAM)
+				agg->streamflow += patch[0].streamflow * area;
+			agg->streamflow_NO3 += patch[0].streamflow_NO3 * area;
+			agg->streamflow_NH4 += patch[0].streamflow_NH4 * area;
+			agg->streamflow_DON += patch[0].streamflow_DON * area;
+			agg->streamflow_DOC += patch[0].streamflow_DOC * area;
+			agg->streamNO3_from_surface += patch[0].streamNO3_from_surface * area;
+			agg->streamNO3_from_sub += patch[0].streamNO3_from_sub * area;
+
+			agg->Kup += (patch[0].Kup_direct + patch[0].Kup_diffuse) * area;
+			agg->Lup += patch[0].Lup * area;
+			agg->Kstar_canopy += patch[0].Kstar_canopy * area;
+			agg->Kstar_soil += patch[0].Kstar_soil * area;
+			agg->Kstar_snow += (patch[0].snowpack.Kstar_direct + patch[0].snowpack.Kstar_diffuse) * area;
+			agg->Lstar_canopy += patch[0].Lstar_canopy * area;
+			agg->Lstar_soil += patch[0].Lstar_soil * area;
+			agg->Lstar_snow += patch[0].Lstar_snow * area;
+			agg->LE_canopy += patch[0].LE_canopy * area;
+			agg->LE_soil += patch[0].LE_soil * area;
+			agg->LE_snow += (-1 * patch[0].snowpack.Q_LE + patch[0].snowpack.Q_melt) * area;
+
+			agg->litrc += (patch[0].litter_cs.litr1c + patch[0].litter_cs.litr2c
+				+ patch[0].litter_cs.litr3c + patch[0].litter_cs.litr4c) * area;
+			agg->litrn += (patch[0].litter_ns.litr1n + patch[0].litter_ns.litr2n
+				+ patch[0].litter_ns.litr3n + patch[0].litter_ns.litr4n) * area;
+			agg->soilc += (patch[0].soil_cs.soil1c + patch[0].soil_cs.soil2c
+				+ patch[0].soil_cs.soil3c + patch[0].soil_cs.soil4c) * area;
+			agg->soiln += (patch[0].soil_ns.soil1n + patch[0].soil_ns.soil2n
+				+ patch[0].soil_ns.soil3n + patch[0].soil_ns.soil4n) * area;
+			agg->soiln_noslow += (patch[0].soil_ns.soil1n + patch[0].soil_ns.soil2n
+				+ patch[0].soil_ns.soil3n) * area;
+			agg->sminn += patch[0].soil_ns.sminn * area;
+			agg->nitrate += patch[0].soil_ns.nitrate * area;
+			agg->surfaceN += (patch[0].surface_DON + patch[0].surface_NO3
+				+ patch[0].surface_NH4) * area;
+			agg->totaln += patch[0].totaln * area;
+			agg->carbon_balance += patch[0].carbon_balance * area;
+			agg->nitrogen_balance += patch[0].nitrogen_balance * area;
+			agg->denitrif += patch[0].ndf.denitrif * area;
+			agg->nitrif += patch[0].ndf.sminn_to_nitrate * area;
+			agg->fertilizer_NO3 += patch[0].fertilizer_NO3 * area;
+			agg->fertilizer_NH4 += patch[0].fertilizer_NH4 * area;
+			agg->DON += patch[0].soil_ns.DON * area;
+			agg->DOC += patch[0].soil_cs.DOC * area;
+			agg->nfix += patch[0].ndf.nfix_to_sminn * area;
+			agg->grazing_Closs += patch[0].grazing_Closs * area;
+			agg->nuptake += patch[0].ndf.sminn_to_npool * area;
+			agg->soilhr += (patch[0].cdf.litr1c_hr
+				+ patch[0].cdf.litr2c_hr
+				+ patch[0].cdf.litr4c_hr
+				+ patch[0].cdf.soil1c_hr
+				+ patch[0].cdf.soil2c_hr
+				+ patch[0].cdf.soil3c_hr
+				+ patch[0].cdf.soil4c_hr) * area;
+
+			for ( layer=0 ; layer<patch[0].num_layers; layer++ ){
+				for ( c=0 ; c<patch[0].layers[layer].count; c++ ){
+					strata = patch[0].canopy_strata[(patch[0].layers[layer].strata[c])];
+					agg->canopy_store += strata->cover_fraction
+						* (strata->rain_stored + strata->snow_stored) * area;
+					agg->canopy_snow += strata->cover_fraction * strata->snow_stored * area;
+					agg->net_psn += strata->cover_fraction * strata->cs.net_psn * area;
+					agg->gpsn += strata->cover_fraction * strata->cdf.psn_to_cpool * area;
+					agg->nppcum += strata->cover_fraction * strata->cs.nppcum * area;
+					agg->lai += strata->cover_fraction * strata->epv.proj_lai * area;
+					agg->canopy_sublimation += strata->cover_fraction * strata->sublimation * area;
+					agg->dC13 += strata->cover_fraction * strata->dC13 * area;
+					agg->mortality_fract += strata->cover_fraction * strata->cs.mortality_fract * area;
+					agg->resp += strata->cover_fraction
+						* (strata->cdf.leaf_day_mr + strata->cdf.cpool_leaf_gr
+						+ strata->cdf.leaf_night_mr + strata->cdf.livestem_mr
+						+ strata->cdf.cpool_livestem_gr + strata->cdf.livecroot_mr
+						+ strata->cdf.cpool_livecroot_gr
+						+ strata->cdf.cpool_deadcroot_gr
+						+ strata->cdf.froot_mr + strata->cdf.cpool_froot_gr
+						+ strata->cdf.cpool_to_gresp_store) * area;
+					agg->resp_leaf += strata->cover_fraction
+						* (strata->cdf.leaf_day_mr + strata->cdf.leaf_night_mr) * area;
+					agg->gs += strata->cover_fraction * strata->gs * area;
+					agg->ga += strata->cover_fraction * strata->ga * area;
+					agg->rootdepth += strata->cover_fraction * strata->rootzone.depth * area;
+					leafc = strata->cover_fraction * (strata->cs.leafc
+						+ strata->cs.leafc_store + strata->cs.leafc_transfer) * area;
+					frootc = strata->cover_fraction * (strata->cs.frootc
+						+ strata->cs.frootc_store + strata->cs.frootc_transfer) * area;
+					woodc = strata->cover_fraction * (strata->cs.live_crootc
+						+ strata->cs.live_stemc + strata->cs.dead_crootc
+						+ strata->cs.dead_stemc + strata->cs.livecrootc_store
+						+ strata->cs.livestemc_store + strata->cs.deadcrootc_store
+						+ strata->cs.deadstemc_store
+						+ strata->cs.livecrootc_transfer
+						+ strata->cs.livestemc_transfer
+						+ strata->cs.deadcrootc_transfer
+						+ strata->cs.deadstemc_transfer
+						+ strata->cs.cwdc + strata->cs.cpool) * area;
+					agg->leafc += leafc;
+					agg->frootc += frootc;
+					agg->woodc += woodc;
+					agg->leafn += strata->cover_fraction * (strata->ns.leafn
+						+ strata->ns.leafn_store + strata->ns.leafn_transfer) * area;
+					agg->frootn += strata->cover_fraction * (strata->ns.frootn
+						+ strata->ns.frootn_store + strata->ns.frootn_transfer) * area;
+					agg->woodn += strata->cover_fraction * (strata->ns.live_crootn
+						+ strata->ns.live_stemn + strata->ns.dead_crootn
+						+ strata->ns.dead_stemn + strata->ns.livecrootn_store
+						+ strata->ns.livestemn_store + strata->ns.deadcrootn_store
+						+ strata->ns.deadstemn_store
+						+ strata->ns.livecrootn_transfer
+						+ strata->ns.livestemn_transfer
+						+ strata->ns.deadcrootn_transfer
+						+ strata->ns.deadstemn_transfer
+						+ strata->ns.cwdn + strata->ns.retransn + strata->ns.npool) * area;
+					agg->cpool += strata->cover_fraction * strata->cs.cpool * area;
+					agg->npool += strata->cover_fraction * strata->ns.npool * area;
+					agg->height += strata->cover_fraction * strata->epv.height * area;
+					agg->canopy_Lstar += strata->cover_fraction * strata->Lstar * area;
+					agg->canopy_drip += strata->cover_fraction * strata->canopy_drip * area;
+
+					p_under = max(0.0, (patch[0].soil_defaults[0][0].overstory_height_thresh - strata->epv.height)) /
+						(patch[0].soil_defaults[0][0].overstory_height_thresh
+						- patch[0].soil_defaults[0][0].understory_height_thresh);
+					p_under = min(1.0, p_under);
+					p_over = 1.0 - p_under;
+					agg->overstory_height += strata->cover_fraction * strata->epv.height * area * p_over;
+					agg->overstory_leafc += strata->cover_fraction * strata->cs.leafc * area * p_over;
+					agg->overstory_stemc += strata->cover_fraction * (strata->cs.live_stemc
+						+ strata->cs.dead_stemc) * area * p_over;
+					agg->overstory_biomassc += (woodc + frootc + leafc) * p_over;
+					agg->understory_height += strata->cover_fraction * strata->epv.height * area * p_under;
+					agg->understory_leafc += strata->cover_fraction * strata->cs.leafc * area * p_under;
+					agg->understory_stemc += strata->cover_fraction * (strata->cs.live_stemc
+						+ strata->cs.dead_stemc) * area * p_under;
+					agg->understory_biomassc += (woodc + frootc + leafc) * p_under;
+				}
+			}
+		}
+	}
+	return;
+} /*end aggregate_hillslope*/
+
+void	update_daily_aggregates(
+				struct	basin_object	*basin)
+{
+	/*------------------------------------------------------*/
+	/*	Local Variable Definition.			*/
+	/*------------------------------------------------------*/
+	int	h, i, n;
+	double	*sum, *hill;
+
+	if (basin[0].daily_aggregate_valid)
+		return;
+
+	#pragma omp parallel for
+	for (h=0; h < basin[0].num_hillslopes; h++)
+		aggregate_hillslope(basin[0].hillslopes[h]);
+
+	n = sizeof(struct daily_aggregate_object) / sizeof(double);
+	sum = (double *) &(basin[0].daily_aggregate);
+	for (i=0; i < n; i++)
+		sum[i] = 0.0;
+	for (h=0; h < basin[0].num_hillslopes; h++) {
+		hill = (double *) &(basin[0].hillslopes[h][0].daily_aggregate);
+		for (i=0; i < n; i++)
+			sum[i] += hill[i];
+	}
+	basin[0].daily_aggregate_valid = 1;
+	return;
+} /*end update_daily_aggregates*/
@@ -2,14 +2,15 @@
 /* 								*/
 /*			compute_subsurface_temperature_profile				*/
 /*								*/
-/*	compute_subsurface_temperature_profile - computes heat flux	*/
-/*		between surface of patch and a stratum.		*/
+/*	compute_subsurface_temperature_profile - computes soil	*/
+/*		temperature profiles of all patches of a hillslope	*/
 /*								*/
 /*	NAME							*/
 /*	compute_subsurface_temperature_profile						*/
 /*								*/
 /*	SYNOPSIS						*/
-/*	double	compute_subsurface_temperature_profile(				*/
+/*	void	compute_subsurface_temperature_profile(		*/
+/*			struct soil_thermal_object *)		*/
 /*													*/
 /*	OPTIONS											*/
 /*	DESCRIPTION										*/
@@ -20,29 +21,80 @@
 /*								*/
 /*	Sep 2, 1997 RAF									*/
 /*								*/
+/*	All patches of a hillslope are done in one call, with	*/
+/*	the layer depths and moistures staged into the layer	*/
+/*	major arrays of the hillslope soil_thermal object so	*/
+/*	that each step is a unit stride loop over patches.	*/
+/*	There is still no solve: as before, the layer		*/
+/*	temperatures carry over from the previous day.		*/
+/*								*/
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
 #include "phys_constants.h"
 
-void compute_subsurface_temperature_profile( 
-					  struct surface_energy_profile	*se_profile,
-					  struct surface_energy_default	*sedef,
-					  double tsurface,
-					  double rnet,
-					  double *percent_soil_water_unfrozen)
+void compute_subsurface_temperature_profile(struct soil_thermal_object *thermal)
 {
-	/*--------------------------------------------------------------*/
-	/*	Local function declaration				*/
-	/*--------------------------------------------------------------*/
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.				*/
 	/*--------------------------------------------------------------*/
-	double tmp;
+	int	j, l, np;
+	double	*depth, *moisture, *T;
+	struct	patch_object *patch;
 
-	tmp = 	HVAP;
+	np = thermal->num_patches;
+	depth = thermal->depth;
+	moisture = thermal->moisture;
+	T = thermal->T;
 
+	/*--------------------------------------------------------------*/
+	/* determine moistures and depths to send to solver		*/
+	/* note that depth for layer 3 is always the soil depth so 	*/
+	/* this is set only once in construct_soil_thermal		*/
+	/*--------------------------------------------------------------*/
+	for (j = 0; j < np; j++) {
+		patch = thermal->patches[j];
+		depth[j] = patch[0].litter.depth;
+		moisture[j] = patch[0].litter.rain_stored;
+		if (patch[0].sat_deficit > patch[0].rootzone.potential_sat) {
+			depth[np + j] = depth[j] + patch[0].rootzone.depth;
+			moisture[np + j] = patch[0].rz_storage;
+			depth[2 * np + j] = depth[j] + patch[0].sat_deficit_z;
+			moisture[2 * np + j] = patch[0].unsat_storage;
+			moisture[3 * np + j] = patch[0].soil_defaults[0][0].soil_water_cap - patch[0].sat_deficit;
+		}
+		else {
+			depth[np + j] = depth[j] + patch[0].sat_deficit_z;
+			moisture[np + j] = patch[0].rz_storage;
+			depth[2 * np + j] = depth[j] + patch[0].rootzone.depth;
+			moisture[2 * np + j] = patch[0].rootzone.potential_sat - patch[0].sat_deficit;
+			moisture[3 * np + j] = patch[0].soil_defaults[0][0].soil_water_cap - patch[0].rootzone.potential_sat;
+		}
+	}
 
+	/*--------------------------------------------------------------*/
+	/* map iterative temperatures back to soil and litter, for now  */
+	/* we don't differentiate between unsat, rootzone and sat for temperature */
+	/*--------------------------------------------------------------*/
+	for (j = 0; j < np; j++) {
+		patch = thermal->patches[j];
+		for (l = 0; l < 4; l++) {
+			patch[0].surface_energy_profile[l].depth = depth[l * np + j];
+			patch[0].surface_energy_profile[l].moisture = moisture[l * np + j];
+			patch[0].surface_energy_profile[l].T = T[l * np + j];
+		}
+		patch[0].litter.T = T[j];
+		if (patch[0].sat_deficit > patch[0].rootzone.potential_sat)
+			patch[0].rootzone.T = T[np + j];
+		else
+			patch[0].rootzone.T = (T[np + j] * (patch[0].sat_deficit) +
+					T[2 * np + j] * (patch[0].rootzone.potential_sat - patch[0].sat_deficit))
+					/ (patch[0].rootzone.potential_sat);
+		patch[0].Tsoil = (T[np + j] * (depth[np + j] - depth[j]) +
+				T[2 * np + j] * (depth[2 * np + j] - depth[np + j]) +
+				T[3 * np + j] * (depth[3 * np + j] - depth[2 * np + j])) /
+				depth[3 * np + j];
+	}
 
 	return;
 } /*end compute_subsurface_temperature_profile*/
@@ -0,0 +1,281 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		execute_checkpoint_event			*/
+/*								*/
+/*	NAME							*/
+/*	execute_checkpoint_event - write the dynamic state of	*/
+/*		the run so that -restart can resume it		*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	void	execute_checkpoint_event(			*/
+/*			struct world_object *,			*/
+/*			struct command_line_object *,		*/
+/*			struct world_output_file_object *,	*/
+/*			struct world_output_file_object *,	*/
+/*			struct date,				*/
+/*			long, long, long, long)			*/
+/*	FILE	*checkpoint_output_file(			*/
+/*			struct world_output_file_object *,	*/
+/*			int, int)				*/
+/*								*/
+/*	OPTIONS							*/
+/*	-checkpoint [years]					*/
+/*		checkpoint every years simulated years		*/
+/*		(default 1)					*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	Called by execute_tec at the start of a year.  The	*/
+/*	checkpoint is a binary image of every basin, reach,	*/
+/*	hillslope, zone, patch and stratum object in world	*/
+/*	order, the patch layers, the climate sequence cursors	*/
+/*	of the base stations, the execute_tec counters, the	*/
+/*	tec file entry still to be handled, the output flags	*/
+/*	set by tec events and the length of every output file.	*/
+/*								*/
+/*	The output files are flushed, then a child process	*/
+/*	is forked to write <world file>.checkpoint (with .w<k>	*/
+/*	appended for -workers) while the simulation goes on.	*/
+/*	The child writes to a .tmp file and renames it, so a	*/
+/*	run that dies while writing keeps the last complete	*/
+/*	checkpoint.  A new checkpoint first waits for the last	*/
+/*	child.							*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*	Pointers are written as they are and are ignored by	*/
+/*	restore_checkpoint, which keeps those of the world it	*/
+/*	has just constructed.  The parameter defaults and	*/
+/*	routing tables are among them, so the header records	*/
+/*	whether a redefine or roads_on event has run, and such	*/
+/*	a checkpoint is not restored.				*/
+/*								*/
+/*--------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "rhessys.h"
+
+static	pid_t	checkpoint_pid = 0;
+
+FILE	*checkpoint_output_file(struct world_output_file_object *output,
+				int level,
+				int step)
+{
+	/*--------------------------------------------------------------*/
+	/*	levels in world_output_file_object order, steps		*/
+	/*	yearly, monthly, daily, hourly				*/
+	/*--------------------------------------------------------------*/
+	struct	output_files_object	*fileset;
+
+	if (output == NULL)
+		return(NULL);
+	switch (level) {
+	case 0: fileset = output[0].basin; break;
+	case 1: fileset = output[0].hillslope; break;
+	case 2: fileset = output[0].zone; break;
+	case 3: fileset = output[0].patch; break;
+	case 4: fileset = output[0].canopy_stratum; break;
+	case 5: fileset = output[0].fire; break;
+	case 6: fileset = output[0].shadow_strata; break;
+	default: fileset = output[0].stream_routing; break;
+	}
+	if (fileset == NULL)
+		return(NULL);
+	switch (step) {
+	case 0: return(fileset[0].yearly);
+	case 1: return(fileset[0].monthly);
+	case 2: return(fileset[0].daily);
+	default: return(fileset[0].hourly);
+	}
+}
+
+static	void	write_object(void *object, size_t size, FILE *outfile)
+{
+	if (fwrite(object, size, 1, outfile) != 1) {
+		fprintf(stderr, "FATAL ERROR: cannot write checkpoint\n");
+		_exit(EXIT_FAILURE);
+	}
+}
+
+static	void	write_patch(struct patch_object *patch, FILE *outfile)
+{
+	int	c, i;
+
+	write_object(patch, sizeof(struct patch_object), outfile);
+	if (patch[0].grow != NULL)
+		write_object(patch[0].grow, sizeof(struct grow_patch_object), outfile);
+	for (i = 0; i < patch[0].num_layers; i++) {
+		write_object(&(patch[0].layers[i]), sizeof(struct layer_object), outfile);
+		if (patch[0].layers[i].count > 0)
+			write_object(patch[0].layers[i].strata,
+				patch[0].layers[i].count * sizeof(long), outfile);
+	}
+	for (c = 0; c < patch[0].num_canopy_strata; c++)
+		write_object(patch[0].canopy_strata[c],
+			sizeof(struct canopy_strata_object), outfile);
+}
+
+static	void	write_basin(struct basin_object *basin, FILE *outfile)
+{
+	struct	hillslope_object	*hillslope;
+	struct	zone_object	*zone;
+	int	h, z, p;
+
+	write_object(basin, sizeof(struct basin_object), outfile);
+	if (basin[0].grow != NULL)
+		write_object(basin[0].grow, sizeof(struct grow_basin_object), outfile);
+	if (basin[0].stream_list.num_reaches > 0)
+		write_object(basin[0].stream_list.stream_network,
+			basin[0].stream_list.num_reaches
+			* sizeof(struct stream_network_object), outfile);
+	for (h = 0; h < basin[0].num_hillslopes; h++) {
+		hillslope = basin[0].hillslopes[h];
+		write_object(hillslope, sizeof(struct hillslope_object), outfile);
+		if (hillslope[0].grow != NULL)
+			write_object(hillslope[0].grow,
+				sizeof(struct grow_hillslope_object), outfile);
+		for (z = 0; z < hillslope[0].num_zones; z++) {
+			zone = hillslope[0].zones[z];
+			write_object(zone, sizeof(struct zone_object), outfile);
+			if (zone[0].grow != NULL)
+				write_object(zone[0].grow,
+					sizeof(struct grow_zone_object), outfile);
+			for (p = 0; p < zone[0].num_patches; p++)
+				write_patch(zone[0].patches[p], outfile);
+		}
+	}
+}
+
+static	void	write_cursors(struct base_station_object *station, FILE *outfile)
+{
+	/*--------------------------------------------------------------*/
+	/*	hourly rain, hourly rain duration, then dated inputs	*/
+	/*--------------------------------------------------------------*/
+	int	inx[10];
+	int	i;
+
+	for (i = 0; i < 10; i++)
+		inx[i] = -999;
+	if (station[0].hourly_clim != NULL) {
+		inx[0] = station[0].hourly_clim[0].rain.inx;
+		inx[1] = station[0].hourly_clim[0].rain_duration.inx;
+	}
+	if (station[0].dated_input != NULL) {
+		inx[2] = station[0].dated_input[0].fertilizer_NO3.inx;
+		inx[3] = station[0].dated_input[0].fertilizer_NH4.inx;
+		inx[4] = station[0].dated_input[0].irrigation.inx;
+		inx[5] = station[0].dated_input[0].snow_melt_input.inx;
+		inx[6] = station[0].dated_input[0].biomass_removal_percent.inx;
+		inx[7] = station[0].dated_input[0].pspread.inx;
+		inx[8] = station[0].dated_input[0].PH.inx;
+		inx[9] = station[0].dated_input[0].grazing_Closs.inx;
+	}
+	write_object(inx, sizeof(inx), outfile);
+}
+
+void	execute_checkpoint_event(struct world_object *world,
+				 struct command_line_object *command_line,
+				 struct world_output_file_object *outfile,
+				 struct world_output_file_object *growth_outfile,
+				 struct date current_date,
+				 long day,
+				 long month,
+				 long year,
+				 long tec_offset)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	struct	checkpoint_header_object	header;
+	FILE	*file;
+	FILE	*checkpoint_file;
+	char	filename[FILEPATH_LEN+20];
+	char	tmp_filename[FILEPATH_LEN+24];
+	int	b, i, l, s;
+
+	/*--------------------------------------------------------------*/
+	/*	one checkpoint is written at a time			*/
+	/*--------------------------------------------------------------*/
+	if (checkpoint_pid > 0)
+		waitpid(checkpoint_pid, NULL, 0);
+	checkpoint_pid = 0;
+
+	memset(&header, 0, sizeof(header));
+	strcpy(header.magic, CHECKPOINT_MAGIC);
+	header.version = CHECKPOINT_VERSION;
+	header.object_size[0] = sizeof(struct basin_object);
+	header.object_size[1] = sizeof(struct stream_network_object);
+	header.object_size[2] = sizeof(struct hillslope_object);
+	header.object_size[3] = sizeof(struct zone_object);
+	header.object_size[4] = sizeof(struct patch_object);
+	header.object_size[5] = sizeof(struct canopy_strata_object);
+	header.object_size[6] = sizeof(struct layer_object);
+	header.object_size[7] = sizeof(struct base_station_object);
+	header.grow_flag = command_line[0].grow_flag;
+	header.num_basins = world[0].num_basin_files;
+	header.num_base_stations = world[0].num_base_stations;
+	header.current_date = current_date;
+	header.day = day;
+	header.month = month;
+	header.year = year;
+	header.tec_offset = tec_offset;
+	header.output_flags = command_line[0].output_flags;
+	header.output_yearly_date = command_line[0].output_yearly_date;
+	header.road_flag = command_line[0].road_flag;
+	header.world_redefined = command_line[0].world_redefined;
+
+	/*--------------------------------------------------------------*/
+	/*	flush the output so the child records its full length	*/
+	/*--------------------------------------------------------------*/
+	for (l = 0; l < 8; l++)
+		for (s = 0; s < 4; s++) {
+			header.output_offset[0][l][s] = -1;
+			header.output_offset[1][l][s] = -1;
+			if ((file = checkpoint_output_file(outfile, l, s)) != NULL) {
+				fflush(file);
+				header.output_offset[0][l][s] = ftell(file);
+			}
+			if ((file = checkpoint_output_file(growth_outfile, l, s)) != NULL) {
+				fflush(file);
+				header.output_offset[1][l][s] = ftell(file);
+			}
+		}
+	fflush(stdout);
+	fflush(stderr);
+
+	if ((checkpoint_pid = fork()) < 0) {
+		fprintf(stderr, "WARNING: cannot fork to write a checkpoint, skipped\n");
+		checkpoint_pid = 0;
+		return;
+	}
+	if (checkpoint_pid > 0)
+		return;
+
+	/*--------------------------------------------------------------*/
+	/*	child: write the checkpoint and leave without flushing	*/
+	/*	any stdio buffers of the simulation			*/
+	/*--------------------------------------------------------------*/
+	strcpy(filename, command_line[0].world_filename);
+	strcat(filename, ".checkpoint");
+	if (command_line[0].worker_rank >= 0)
+		sprintf(filename + strlen(filename), ".w%d", command_line[0].worker_rank);
+	sprintf(tmp_filename, "%s.tmp", filename);
+	if ((checkpoint_file = fopen(tmp_filename, "wb")) == NULL) {
+		fprintf(stderr, "FATAL ERROR: cannot open checkpoint %s\n", tmp_filename);
+		_exit(EXIT_FAILURE);
+	}
+	write_object(&header, sizeof(header), checkpoint_file);
+	for (b = 0; b < world[0].num_basin_files; b++)
+		write_basin(world[0].basins[b], checkpoint_file);
+	for (i = 0; i < world[0].num_base_stations; i++)
+		write_cursors(world[0].base_stations[i], checkpoint_file);
+	if ((fclose(checkpoint_file) != 0) || (rename(tmp_filename, filename) != 0)) {
+		fprintf(stderr, "FATAL ERROR: cannot write checkpoint %s\n", filename);
+		_exit(EXIT_FAILURE);
+	}
+	_exit(EXIT_SUCCESS);
+} /*end execute_checkpoint_event*/
@@ -35,6 +35,7 @@
 /*		moss is present.				*/
 /*--------------------------------------------------------------*/
 #include <stdio.h>
+#include <stdlib.h>
 #include "rhessys.h"
 
 void	execute_daily_output_event(
@@ -46,6 +47,9 @@ void	execute_daily_output_event(
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.									*/
 	/*--------------------------------------------------------------*/
+	void update_daily_aggregates(
+		struct	basin_object *);
+
 	void output_basin(
 		int,
 		struct	basin_object *,
@@ -91,11 +95,20 @@ void	execute_daily_output_event(
 		struct	stream_network_object *,
 		struct	date,
 		FILE	*);
+	FILE	*open_output_buffer(
+		struct	output_buffer_object *,
+		int);
+
+	void	write_output_buffer(
+		struct	output_buffer_object *,
+		FILE	*);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
 	int	basinID, hillID, patchID, zoneID, stratumID, reachID;
 	int b,h,p,z,c,s;
+	struct	hillslope_output_buffer_object	*buffer;
+	FILE	*hillslope_file, *zone_file, *patch_file, *stratum_file, *fire_file;
 	/*--------------------------------------------------------------*/
 	/*	check to see if there are any print options					*/
 	/*--------------------------------------------------------------*/
@@ -128,6 +141,8 @@ void	execute_daily_output_event(
 		/*	output basins												*/
 		/*--------------------------------------------------------------*/
 		for (b=0; b < world[0].num_basin_files; ++ b ) {
+			if ((command_line[0].b != NULL) || (command_line[0].h != NULL))
+				update_daily_aggregates(world[0].basins[b]);
 			/*--------------------------------------------------------------*/
 			/*	Construct the basin output files.							*/
 			/*--------------------------------------------------------------*/
@@ -148,7 +163,28 @@ void	execute_daily_output_event(
 				/*--------------------------------------------------------------*/
 				/*	output hillslopes 											*/
 				/*--------------------------------------------------------------*/
+				buffer = (struct hillslope_output_buffer_object *)
+					calloc(world[0].basins[b][0].num_hillslopes + 1,
+					sizeof(struct hillslope_output_buffer_object));
+				if (buffer == NULL) {
+					fprintf(stderr,"FATAL ERROR: out of memory in execute_daily_output_event\n");
+					exit(EXIT_FAILURE);
+				}
+				/*--------------------------------------------------------------*/
+				/*	format each hillslope into its own buffers in parallel	*/
+				/*--------------------------------------------------------------*/
+				#pragma omp parallel for private(basinID, hillID, zoneID, patchID, stratumID, z, p, c, hillslope_file, zone_file, patch_file, stratum_file, fire_file) schedule(dynamic)
 				for (h=0; h < world[0].basins[b][0].num_hillslopes; ++h) {
+					hillslope_file = open_output_buffer(&(buffer[h].hillslope),
+						(command_line[0].h != NULL));
+					zone_file = open_output_buffer(&(buffer[h].zone),
+						(command_line[0].z != NULL));
+					patch_file = open_output_buffer(&(buffer[h].patch),
+						(command_line[0].p != NULL));
+					stratum_file = open_output_buffer(&(buffer[h].canopy_stratum),
+						(command_line[0].c != NULL));
+					fire_file = open_output_buffer(&(buffer[h].fire),
+						(command_line[0].f != NULL));
 					/*-----------------------------------------------------------*/
 					/*	Construct the hillslope output files.						*/
 					/*-----------------------------------------------------------*/
@@ -163,7 +199,7 @@ void	execute_daily_output_event(
 								world[0].basins[b][0].ID,
 								world[0].basins[b]->hillslopes[h],
 								date,
-								outfile->hillslope->daily);
+								hillslope_file);
 					}
 					/*-------------------------------------------------------------*/
 					/*	check to see if there are any lower print options			*/
@@ -193,7 +229,7 @@ void	execute_daily_output_event(
 											world[0].basins[b][0].ID,
 											world[0].basins[b][0].hillslopes[h][0].ID,
 											world[0].basins[b]->hillslopes[h]->zones[z],
-											date, outfile->zone->daily);
+											date, zone_file);
 							}
 							/*-------------------------------------------------------*/
 							/*	check to see if there are any lower print options		*/
@@ -229,7 +265,7 @@ void	execute_daily_output_event(
 															world[0].basins[b]->hillslopes[h]->zones[z]->patches[p],
 															world[0].basins[b]->hillslopes[h]->zones[z],
 															date,
-															outfile->patch->daily);
+															patch_file);
 													}
 									}
 									/*------------------------------------------------*/
@@ -263,7 +299,7 @@ void	execute_daily_output_event(
 																world[0].basins[b][0].hillslopes[h][0].zones[z][0].ID,
 																world[0].basins[b][0].hillslopes[h][0].zones[z][0].patches[p][0].ID,
 																world[0].basins[b]->hillslopes[h]->zones[z]->patches[p]->canopy_strata[c],
-																date, outfile->canopy_stratum->daily);
+																date, stratum_file);
 															}
 										} /* end stratum (c) for loop */
 									} /* end if options */
@@ -299,7 +335,7 @@ void	execute_daily_output_event(
 																world[0].basins[b][0].hillslopes[h][0].zones[z][0].ID,
 																world[0].basins[b][0].hillslopes[h][0].zones[z][0].patches[p][0].ID,
 																world[0].basins[b]->hillslopes[h]->zones[z]->patches[p]->canopy_strata[c],
-																date, outfile->fire->daily);
+																date, fire_file);
 															}
 										} /* end fire (f) for loop */
 									} /* end if options */
@@ -308,7 +344,23 @@ void	execute_daily_output_event(
 							} /* end if options */
 						} /* end zone (z) for  loop*/
 					} /* end if options */
-					} /* end hillslope (h) for loop */
+				} /* end hillslope (h) for loop */
+				/*--------------------------------------------------------------*/
+				/*	write the buffers in hillslope order			*/
+				/*--------------------------------------------------------------*/
+				for (h=0; h < world[0].basins[b][0].num_hillslopes; ++h) {
+					if (command_line[0].h != NULL)
+						write_output_buffer(&(buffer[h].hillslope), outfile->hillslope->daily);
+					if (command_line[0].z != NULL)
+						write_output_buffer(&(buffer[h].zone), outfile->zone->daily);
+					if (command_line[0].p != NULL)
+						write_output_buffer(&(buffer[h].patch), outfile->patch->daily);
+					if (command_line[0].c != NULL)
+						write_output_buffer(&(buffer[h].canopy_stratum), outfile->canopy_stratum->daily);
+					if (command_line[0].f != NULL)
+						write_output_buffer(&(buffer[h].fire), outfile->fire->daily);
+				}
+				free(buffer);
 				} /* end if options */
 			} /* end basin (b) for loop */
 		} /* end if options */
@@ -50,6 +50,9 @@ void	execute_hourly_growth_output_event(
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.									*/
 	/*--------------------------------------------------------------*/
+	void update_daily_aggregates(
+		struct	basin_object *);
+
 	void output_hourly_growth_basin(
 		struct	basin_object *,
 		struct	date,
@@ -91,6 +94,8 @@ void	execute_hourly_growth_output_event(
 		/*	output_growth basins												*/
 		/*--------------------------------------------------------------*/
 		for (b=0; b < world[0].num_basin_files; ++ b ) {
+			if (command_line[0].h != NULL)
+				update_daily_aggregates(world[0].basins[b]);
 			/*--------------------------------------------------------------*/
 			/*	Construct the basin output_growth files.							*/
 			/*--------------------------------------------------------------*/
@@ -32,6 +32,7 @@
 /*																*/
 /*--------------------------------------------------------------*/
 #include <stdio.h>
+#include <stdlib.h>
 #include "rhessys.h"
 
 void	execute_hourly_output_event(
@@ -43,11 +44,15 @@ void	execute_hourly_output_event(
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.									*/
 	/*--------------------------------------------------------------*/
+	void update_daily_aggregates(
+		struct	basin_object *);
+
 	void output_hourly_basin(
 		int,
 		struct	basin_object *,
 		struct	date,
-		FILE	*);
+		FILE	*,
+		int);
 	
 	void output_hillslope( int,
 		struct	hillslope_object *,
@@ -58,6 +63,12 @@ void	execute_hourly_output_event(
 		struct	zone_object *,
 		struct	date,
 		FILE	*);
+
+	void output_hourly_zone(	int, int,
+		struct	zone_object *,
+		struct	date,
+		FILE	*,
+		int);
 	
 	void output_patch(	int, int,int,
 		struct	patch_object *,
@@ -69,11 +80,20 @@ void	execute_hourly_output_event(
 		struct	canopy_strata_object *,
 		struct	date,
 		FILE	*);
+	FILE	*open_output_buffer(
+		struct	output_buffer_object *,
+		int);
+
+	void	write_output_buffer(
+		struct	output_buffer_object *,
+		FILE	*);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
 	int	basinID, hillID, patchID, zoneID, stratumID;
 	int b,h,p,z,c;
+	struct	hillslope_output_buffer_object	*buffer;
+	FILE	*hillslope_file, *zone_file, *patch_file, *stratum_file;
 	/*--------------------------------------------------------------*/
 	/*	check to see if there are any print options					*/
 	/*--------------------------------------------------------------*/
@@ -84,6 +104,8 @@ void	execute_hourly_output_event(
 		/*	output basins												*/
 		/*--------------------------------------------------------------*/
 		for (b=0; b < world[0].num_basin_files; ++ b ) {
+			if (command_line[0].h != NULL)
+				update_daily_aggregates(world[0].basins[b]);
 			/*--------------------------------------------------------------*/
 			/*	Construct the basin output files.							*/
 			/*--------------------------------------------------------------*/
@@ -94,7 +116,8 @@ void	execute_hourly_output_event(
 					command_line[0].routing_flag,
 					world[0].basins[b],
 					date,
-					outfile->basin->hourly);
+					outfile->basin->hourly,
+					command_line[0].hourly_summary_basin_flag);
 			}
 			/*--------------------------------------------------------------*/
 			/*	check to see if there are any lower print options			*/
@@ -104,7 +127,26 @@ void	execute_hourly_output_event(
 				/*--------------------------------------------------------------*/
 				/*	output hillslopes 											*/
 				/*--------------------------------------------------------------*/
-				for(h=0; h < world[0].basins[b][0].num_hillslopes; ++h) {
+				buffer = (struct hillslope_output_buffer_object *)
+					calloc(world[0].basins[b][0].num_hillslopes + 1,
+					sizeof(struct hillslope_output_buffer_object));
+				if (buffer == NULL) {
+					fprintf(stderr,"FATAL ERROR: out of memory in execute_hourly_output_event\n");
+					exit(EXIT_FAILURE);
+				}
+				/*--------------------------------------------------------------*/
+				/*	format each hillslope into its own buffers in parallel	*/
+				/*--------------------------------------------------------------*/
+				#pragma omp parallel for private(basinID, hillID, zoneID, patchID, stratumID, z, p, c, hillslope_file, zone_file, patch_file, stratum_file) schedule(dynamic)
+				for (h=0; h < world[0].basins[b][0].num_hillslopes; ++h) {
+					hillslope_file = open_output_buffer(&(buffer[h].hillslope),
+						(command_line[0].h != NULL));
+					zone_file = open_output_buffer(&(buffer[h].zone),
+						(command_line[0].z != NULL));
+					patch_file = open_output_buffer(&(buffer[h].patch),
+						(command_line[0].p != NULL));
+					stratum_file = open_output_buffer(&(buffer[h].canopy_stratum),
+						(command_line[0].c != NULL));
 					/*----------------------------------------------------------*/
 					/*	Construct the hillslope output files.						*/
 					/*----------------------------------------------------------*/
@@ -119,7 +161,7 @@ void	execute_hourly_output_event(
 								world[0].basins[b][0].ID,
 								world[0].basins[b]->hillslopes[h],
 								date,
-								outfile->hillslope->hourly);
+								hillslope_file);
 					}
 					/*------------------------------------------------------------*/
 					/*	check to see if there are any lower print options			*/
@@ -150,7 +192,8 @@ void	execute_hourly_output_event(
 											world[0].basins[b][0].hillslopes[h][0].ID,
 											world[0].basins[b]->hillslopes[h]->zones[z],
 											date,
-											outfile->zone->hourly);
+											zone_file,
+											command_line[0].hourly_summary_zone_flag);
 							}
 							/*------------------------------------------------------*/
 							/*	check to see if there are any lower print options	  */
@@ -186,7 +229,7 @@ void	execute_hourly_output_event(
 														world[0].basins[b]->hillslopes[h]->zones[z]->patches[p],
 														world[0].basins[b]->hillslopes[h]->zones[z],
 														date,
-														outfile->patch->hourly);
+														patch_file);
 									}
 									/*-----------------------------------------------*/
 									/*	Construct the canopy_stratum output files		 */
@@ -220,14 +263,28 @@ void	execute_hourly_output_event(
 																world[0].basins[b][0].hillslopes[h][0].zones[z][0].patches[p][0].ID,
 																world[0].basins[b]->hillslopes[h]->zones[z]->patches[p]->canopy_strata[c],
 																date,
-																outfile->canopy_stratum->hourly);
+																stratum_file);
 										} /* end stratum (c) for loop */
 									} /* end if options */
 								} /* end patch (p) for loop */
 							} /* end if options */
 						} /* end zone (z) for  loop*/
 						} /* end if options */
-					} /* end hillslope (h) for loop */
+				} /* end hillslope (h) for loop */
+				/*--------------------------------------------------------------*/
+				/*	write the buffers in hillslope order			*/
+				/*--------------------------------------------------------------*/
+				for (h=0; h < world[0].basins[b][0].num_hillslopes; ++h) {
+					if (command_line[0].h != NULL)
+						write_output_buffer(&(buffer[h].hillslope), outfile->hillslope->hourly);
+					if (command_line[0].z != NULL)
+						write_output_buffer(&(buffer[h].zone), outfile->zone->hourly);
+					if (command_line[0].p != NULL)
+						write_output_buffer(&(buffer[h].patch), outfile->patch->hourly);
+					if (command_line[0].c != NULL)
+						write_output_buffer(&(buffer[h].canopy_stratum), outfile->canopy_stratum->hourly);
+				}
+				free(buffer);
 				} /* end if options */
 			} /* end basin (b) for loop */
 		} /* end if options */
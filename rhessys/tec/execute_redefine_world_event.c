@@ -113,6 +113,7 @@ void	execute_redefine_world_event(struct world_object *world,
 		struct basin_object *);
 	struct basin_object	*find_basin( int, 
 		struct world_object *);
+	FILE	*open_state_file(char *, char *, int);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
@@ -138,7 +139,7 @@ void	execute_redefine_world_event(struct world_object *world,
 		current_date.hour);
 	strcpy(world_input_filename, command_line[0].world_filename);
 	strcat(world_input_filename, ext);
-	if ( (world_input_file = fopen(world_input_filename,"r")) == NULL ){
+	if ( (world_input_file = open_state_file(world_input_filename, "r", 0)) == NULL ){
 		fprintf(stderr,
 			"FATAL ERROR:  Cannot open world  execute_redefine input file %s\n",
 			world_input_filename);
@@ -125,6 +125,7 @@ void execute_road_construction_event(
       free(hillslope->route_list);
       free(hillslope->surface_route_list->list);
       free(hillslope->surface_route_list);
+      destroy_neighbour_table(hillslope->neighbour_table);
 
       if ( command_line[0].ddn_routing_flag == 1 ) {
         hillslope->route_list = construct_ddn_routing_topology( redefine_routing_file, hillslope );
@@ -155,6 +156,7 @@ void execute_road_construction_event(
         );
 			  exit(EXIT_FAILURE);
 		  }
+      hillslope->neighbour_table = construct_neighbour_table(hillslope);
           //construct_routing_topology(hillslope, command_line, false);
     }	
 	} 
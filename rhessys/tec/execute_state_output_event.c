@@ -21,6 +21,10 @@
 /*																*/
 /*	outputs current world state - in worldfile format			*/
 /*																*/
+/*	With -zstate the file is gzip compressed and named			*/
+/*	.state.gz; construct_world and the redefine events read		*/
+/*	it back through open_state_file.							*/
+/*																*/
 /*	PROGRAMMER NOTES											*/
 /*																*/
 /*																*/
@@ -43,6 +47,10 @@ void	execute_state_output_event(
 		struct	date,
 		struct	command_line_object *,
 		FILE	*);
+	FILE	*open_state_file(
+		char	*,
+		char	*,
+		int);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
@@ -61,11 +69,22 @@ void	execute_state_output_event(
 	strcpy(filename, command_line[0].world_filename);
 	strcat(filename, ext);
 	strcat(filename, ".state");
+	if (command_line[0].zstate_flag == 1)
+		strcat(filename, ".gz");
+	/*--------------------------------------------------------------*/
+	/*	-workers processes each write their own basins; the	*/
+	/*	launcher joins the pieces once all workers are done.	*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].worker_rank >= 0) {
+		sprintf(ext, ".w%d", command_line[0].worker_rank);
+		strcat(filename, ext);
+	}
 
 	/*--------------------------------------------------------------*/
 	/*	open output file											*/
 	/*--------------------------------------------------------------*/
-	if ( ( outfile = fopen(filename, "w")) == NULL ){
+	if ( ( outfile = open_state_file(filename, "w",
+			command_line[0].zstate_flag)) == NULL ){
 		fprintf(stderr,"FATAL ERROR: in execute_state_output_event.\n");
 		exit(EXIT_FAILURE);
 	}
@@ -184,6 +184,28 @@ void	execute_tec(
 		struct date,
 		struct command_line_object *);
 
+	void	execute_checkpoint_event(
+		struct world_object *,
+		struct command_line_object *,
+		struct world_output_file_object *,
+		struct world_output_file_object *,
+		struct date,
+		long,
+		long,
+		long,
+		long);
+
+	void	restore_checkpoint(
+		struct world_object *,
+		struct command_line_object *,
+		struct tec_object *,
+		struct world_output_file_object *,
+		struct world_output_file_object *,
+		struct date *,
+		long *,
+		long *,
+		long *);
+
 	/*--------------------------------------------------------------*/
 	/*	Local Variable Definition. 									*/
 	/*--------------------------------------------------------------*/
@@ -193,6 +215,7 @@ void	execute_tec(
 	long	hour;
 	long	month;
 	long	year;
+	long	tec_offset;
 	struct	date	current_date;
 	struct	date	next_date;
 	struct	tec_entry	*event;
@@ -217,6 +240,18 @@ void	execute_tec(
 	/*--------------------------------------------------------------*/
 	current_date = world[0].start_date;
 	next_date = current_date;
+	tec_offset = ftell(tecfile[0].tfile);
+	/*--------------------------------------------------------------*/
+	/*	A resumed run starts at its checkpoint with a null event	*/
+	/*	so that the tec entry still to be handled is read again.	*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].restart_flag == 1) {
+		restore_checkpoint(world, command_line, tecfile, outfile,
+			growth_outfile, &current_date, &day, &month, &year);
+		next_date = current_date;
+		tec_offset = ftell(tecfile[0].tfile);
+		event = construct_tec_entry(current_date, "none");
+	}
 	while ( cal_date_lt(current_date,world[0].end_date)){
 		/*--------------------------------------------------------------*/
 		/*		Perform the tec event.									*/
@@ -230,6 +265,7 @@ void	execute_tec(
 			/*--------------------------------------------------------------*/
 			/*			read in the next tec line.							*/
 			/*--------------------------------------------------------------*/
+			tec_offset = ftell(tecfile[0].tfile);
 			check = fscanf(tecfile[0].tfile,"%d %d %d %d %s\n",
 				&(event[0].cal_date.year),
 				&(event[0].cal_date.month),
@@ -249,6 +285,7 @@ void	execute_tec(
 		/* 	if end of tec file next event is the end of the world		*/
 		/*--------------------------------------------------------------*/
 		else{
+			tec_offset = ftell(tecfile[0].tfile);
 			event =  construct_tec_entry(world[0].end_date, "none");
 		} /*end if-else*/
 		/*--------------------------------------------------------------*/
@@ -438,6 +475,21 @@ void	execute_tec(
                 printf("\nYear %d\n", current_date.year);
 				year = year + 1;
 				current_date.year= next_date.year;
+				/*--------------------------------------------------------------*/
+				/*				checkpoint every checkpoint_interval years		*/
+				/*--------------------------------------------------------------*/
+				if ((command_line[0].checkpoint_flag == 1) &&
+					((year % command_line[0].checkpoint_interval) == 0))
+					execute_checkpoint_event(
+						world,
+						command_line,
+						outfile,
+						growth_outfile,
+						current_date,
+						day,
+						month,
+						year,
+						tec_offset);
 			}  /*end if*/
 			} /*end while*/
 		} /*end while*/
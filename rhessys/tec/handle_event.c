@@ -169,25 +169,32 @@ void	handle_event(
 	}
 	else if ( !strcmp(event[0].command,"redefine_strata") ){
 		execute_redefine_strata_event(world, command_line, current_date);
+		command_line[0].world_redefined = 1;
 	}
 	else if ( !strcmp(event[0].command,"redefine_world") ){
 		execute_redefine_world_event(world, command_line, current_date);
+		command_line[0].world_redefined = 1;
 	}
 	else if ( !strcmp(event[0].command,"redefine_world_multiplier") ){
 		execute_redefine_world_mult_event(world, command_line, current_date);
+		command_line[0].world_redefined = 1;
 	}	
 	else if ( !strcmp(event[0].command,"redefine_world_thin_remain") ){
 		execute_redefine_world_thin_event(world, command_line, current_date, 1);
+		command_line[0].world_redefined = 1;
 	}		
 	else if ( !strcmp(event[0].command,"redefine_world_thin_harvest") ){
 		execute_redefine_world_thin_event(world, command_line, current_date, 2);
+		command_line[0].world_redefined = 1;
 	}
 	else if ( !strcmp(event[0].command,"redefine_world_thin_snags") ){
 		execute_redefine_world_thin_event(world, command_line, current_date, 3);
+		command_line[0].world_redefined = 1;
 	}			
 	else if ( !strcmp(event[0].command,"roads_on") ){
 		command_line[0].road_flag = 1;
 		execute_road_construction_event(world, command_line, current_date);
+		command_line[0].world_redefined = 1;
 	}
 	else if ( !strcmp(event[0].command,"roads_off") ){
 		command_line[0].road_flag = 0;
@@ -0,0 +1,377 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		restore_checkpoint				*/
+/*								*/
+/*	NAME							*/
+/*	restore_checkpoint - resume a run from its checkpoint	*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	void	restore_checkpoint(				*/
+/*			struct world_object *,			*/
+/*			struct command_line_object *,		*/
+/*			struct tec_object *,			*/
+/*			struct world_output_file_object *,	*/
+/*			struct world_output_file_object *,	*/
+/*			struct date *,				*/
+/*			long *, long *, long *)			*/
+/*								*/
+/*	OPTIONS							*/
+/*	-restart						*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	Reads the file written by execute_checkpoint_event	*/
+/*	into a world constructed from the same world file and	*/
+/*	command line.  Every object is read over the one just	*/
+/*	constructed, keeping the pointers of the new world.	*/
+/*	The execute_tec date and counters are set to those of	*/
+/*	the checkpoint, the tec file is moved back to the entry	*/
+/*	that was still to be handled, and the output files	*/
+/*	(opened without truncation) are cut back to their	*/
+/*	length at the checkpoint so that the resumed run	*/
+/*	writes the same files a run without a break would.	*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*	A world that does not match the checkpoint, in		*/
+/*	object IDs or counts, is a fatal error.  So is a	*/
+/*	checkpoint written after a redefine or roads_on event:	*/
+/*	the world is rebuilt from the world file, with the	*/
+/*	original defaults, transmissivity profiles, flow	*/
+/*	tables and neighbour tables, so the run could not go	*/
+/*	on as it would have without the break.			*/
+/*								*/
+/*--------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "rhessys.h"
+
+#define	KEEP(field)	(saved.field = live[0].field)
+
+static	char	*checkpoint_filename;
+
+static	void	read_object(void *object, size_t size, FILE *infile)
+{
+	if (fread(object, size, 1, infile) != 1) {
+		fprintf(stderr, "FATAL ERROR: checkpoint %s is incomplete\n",
+			checkpoint_filename);
+		exit(EXIT_FAILURE);
+	}
+}
+
+static	void	check_object(char *object, int saved_ID, int ID,
+			     int saved_count, int count)
+{
+	if ((saved_ID != ID) || (saved_count != count)) {
+		fprintf(stderr,
+			"FATAL ERROR: %s %d of checkpoint %s does not match world (%s %d)\n",
+			object, saved_ID, checkpoint_filename, object, ID);
+		exit(EXIT_FAILURE);
+	}
+}
+
+static	void	restore_stratum(struct canopy_strata_object *live, FILE *infile)
+{
+	struct	canopy_strata_object	saved;
+
+	read_object(&saved, sizeof(saved), infile);
+	check_object("stratum", saved.ID, live[0].ID, 0, 0);
+	KEEP(base_stations);
+	KEEP(defaults);
+	KEEP(spinup_defaults);
+	KEEP(hourly);
+	*live = saved;
+}
+
+static	void	restore_patch(struct patch_object *live, FILE *infile)
+{
+	struct	patch_object	saved;
+	int	c, i;
+	long	*strata;
+
+	read_object(&saved, sizeof(saved), infile);
+	check_object("patch", saved.ID, live[0].ID,
+		saved.num_canopy_strata, live[0].num_canopy_strata);
+	KEEP(base_stations);
+	KEEP(soil_defaults);
+	KEEP(landuse_defaults);
+	KEEP(fire_defaults);
+	KEEP(surface_energy_defaults);
+	KEEP(grow);
+	KEEP(canopy_strata);
+	KEEP(shadow_strata);
+	KEEP(shadow_litter);
+	KEEP(hourly);
+	KEEP(layers);
+	KEEP(innundation_list);
+	KEEP(surface_innundation_list);
+	KEEP(neighbours);
+	KEEP(next_stream);
+	KEEP(surface_energy_profile);
+	KEEP(zone);
+	KEEP(transmissivity_profile);
+	KEEP(varflow_table);
+	KEEP(shadow_soil_cs);
+	KEEP(shadow_soil_ns);
+	KEEP(shadow_litter_cs);
+	KEEP(shadow_litter_ns);
+
+	/*--------------------------------------------------------------*/
+	/*	read the layers into the strata lists of the patch,	*/
+	/*	which hold num_canopy_strata entries each		*/
+	/*--------------------------------------------------------------*/
+	*live = saved;
+	if (live[0].grow != NULL)
+		read_object(live[0].grow, sizeof(struct grow_patch_object), infile);
+	for (i = 0; i < live[0].num_layers; i++) {
+		strata = live[0].layers[i].strata;
+		read_object(&(live[0].layers[i]), sizeof(struct layer_object), infile);
+		live[0].layers[i].strata = strata;
+		if ((live[0].layers[i].count < 0)
+			|| (live[0].layers[i].count > live[0].num_canopy_strata)) {
+			fprintf(stderr, "FATAL ERROR: bad layer in checkpoint %s\n",
+				checkpoint_filename);
+			exit(EXIT_FAILURE);
+		}
+		if (live[0].layers[i].count > 0)
+			read_object(live[0].layers[i].strata,
+				live[0].layers[i].count * sizeof(long), infile);
+	}
+	for (c = 0; c < live[0].num_canopy_strata; c++)
+		restore_stratum(live[0].canopy_strata[c], infile);
+}
+
+static	void	restore_zone(struct zone_object *live, FILE *infile)
+{
+	struct	zone_object	saved;
+	int	p;
+
+	read_object(&saved, sizeof(saved), infile);
+	check_object("zone", saved.ID, live[0].ID,
+		saved.num_patches, live[0].num_patches);
+	KEEP(base_stations);
+	KEEP(grow);
+	KEEP(patches);
+	KEEP(defaults);
+	KEEP(hourly);
+	*live = saved;
+	if (live[0].grow != NULL)
+		read_object(live[0].grow, sizeof(struct grow_zone_object), infile);
+	for (p = 0; p < live[0].num_patches; p++)
+		restore_patch(live[0].patches[p], infile);
+}
+
+static	void	restore_hillslope(struct hillslope_object *live, FILE *infile)
+{
+	struct	hillslope_object	saved;
+	int	z;
+
+	read_object(&saved, sizeof(saved), infile);
+	check_object("hillslope", saved.ID, live[0].ID,
+		saved.num_zones, live[0].num_zones);
+	KEEP(base_stations);
+	KEEP(grow);
+	KEEP(defaults);
+	KEEP(hourly);
+	KEEP(routing_order.list);
+	KEEP(zones);
+	KEEP(route_list);
+	KEEP(surface_route_list);
+	KEEP(neighbour_table);
+	KEEP(riparian_list.num_patches);
+	KEEP(riparian_list.list);
+	KEEP(topmodel_sums);
+	KEEP(soil_thermal);
+	KEEP(snowpack_batch);
+	KEEP(balance_log);
+	*live = saved;
+	if (live[0].grow != NULL)
+		read_object(live[0].grow, sizeof(struct grow_hillslope_object), infile);
+	for (z = 0; z < live[0].num_zones; z++)
+		restore_zone(live[0].zones[z], infile);
+}
+
+static	void	restore_reach(struct stream_network_object *live, FILE *infile)
+{
+	struct	stream_network_object	saved;
+
+	read_object(&saved, sizeof(saved), infile);
+	check_object("reach", saved.reach_ID, live[0].reach_ID, 0, 0);
+	KEEP(downstream_neighbours);
+	KEEP(upstream_neighbours);
+	KEEP(lateral_inputs);
+	KEEP(neighbour_hill);
+	*live = saved;
+}
+
+static	void	restore_basin(struct basin_object *live, FILE *infile)
+{
+	struct	basin_object	saved;
+	int	h, r;
+
+	read_object(&saved, sizeof(saved), infile);
+	check_object("basin", saved.ID, live[0].ID,
+		saved.num_hillslopes, live[0].num_hillslopes);
+	check_object("basin", saved.ID, live[0].ID,
+		saved.stream_list.num_reaches, live[0].stream_list.num_reaches);
+	KEEP(base_stations);
+	KEEP(defaults);
+	KEEP(hourly);
+	KEEP(grow);
+	KEEP(hillslopes);
+	KEEP(outside_region);
+	KEEP(stream_list.stream_network);
+	*live = saved;
+	if (live[0].grow != NULL)
+		read_object(live[0].grow, sizeof(struct grow_basin_object), infile);
+	for (r = 0; r < live[0].stream_list.num_reaches; r++)
+		restore_reach(&(live[0].stream_list.stream_network[r]), infile);
+	for (h = 0; h < live[0].num_hillslopes; h++)
+		restore_hillslope(live[0].hillslopes[h], infile);
+}
+
+static	void	restore_cursors(struct base_station_object *station, FILE *infile)
+{
+	int	inx[10];
+
+	read_object(inx, sizeof(inx), infile);
+	if (station[0].hourly_clim != NULL) {
+		station[0].hourly_clim[0].rain.inx = inx[0];
+		station[0].hourly_clim[0].rain_duration.inx = inx[1];
+	}
+	if (station[0].dated_input != NULL) {
+		station[0].dated_input[0].fertilizer_NO3.inx = inx[2];
+		station[0].dated_input[0].fertilizer_NH4.inx = inx[3];
+		station[0].dated_input[0].irrigation.inx = inx[4];
+		station[0].dated_input[0].snow_melt_input.inx = inx[5];
+		station[0].dated_input[0].biomass_removal_percent.inx = inx[6];
+		station[0].dated_input[0].pspread.inx = inx[7];
+		station[0].dated_input[0].PH.inx = inx[8];
+		station[0].dated_input[0].grazing_Closs.inx = inx[9];
+	}
+}
+
+static	void	restore_output_file(FILE *file, long offset)
+{
+	if ((file == NULL) != (offset < 0)) {
+		fprintf(stderr,
+			"FATAL ERROR: output options differ from the run of checkpoint %s\n",
+			checkpoint_filename);
+		exit(EXIT_FAILURE);
+	}
+	if (file == NULL)
+		return;
+	fflush(file);
+	if ((ftruncate(fileno(file), (off_t) offset) != 0)
+		|| (fseek(file, offset, SEEK_SET) != 0)) {
+		fprintf(stderr,
+			"FATAL ERROR: cannot return output to checkpoint %s\n",
+			checkpoint_filename);
+		exit(EXIT_FAILURE);
+	}
+}
+
+void	restore_checkpoint(struct world_object *world,
+			   struct command_line_object *command_line,
+			   struct tec_object *tecfile,
+			   struct world_output_file_object *outfile,
+			   struct world_output_file_object *growth_outfile,
+			   struct date *current_date,
+			   long *day,
+			   long *month,
+			   long *year)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	FILE	*checkpoint_output_file(
+		struct world_output_file_object *,
+		int,
+		int);
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	struct	checkpoint_header_object	header;
+	FILE	*infile;
+	char	filename[FILEPATH_LEN+20];
+	int	b, i, l, s;
+
+	strcpy(filename, command_line[0].world_filename);
+	strcat(filename, ".checkpoint");
+	if (command_line[0].worker_rank >= 0)
+		sprintf(filename + strlen(filename), ".w%d", command_line[0].worker_rank);
+	checkpoint_filename = filename;
+	if ((infile = fopen(filename, "rb")) == NULL) {
+		fprintf(stderr, "FATAL ERROR: cannot open checkpoint %s\n", filename);
+		exit(EXIT_FAILURE);
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	the checkpoint must come from this build and world	*/
+	/*--------------------------------------------------------------*/
+	read_object(&header, sizeof(header), infile);
+	if ((strncmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) != 0)
+		|| (header.version != CHECKPOINT_VERSION)
+		|| (header.object_size[0] != sizeof(struct basin_object))
+		|| (header.object_size[1] != sizeof(struct stream_network_object))
+		|| (header.object_size[2] != sizeof(struct hillslope_object))
+		|| (header.object_size[3] != sizeof(struct zone_object))
+		|| (header.object_size[4] != sizeof(struct patch_object))
+		|| (header.object_size[5] != sizeof(struct canopy_strata_object))
+		|| (header.object_size[6] != sizeof(struct layer_object))
+		|| (header.object_size[7] != sizeof(struct base_station_object))) {
+		fprintf(stderr,
+			"FATAL ERROR: %s is not a checkpoint of this rhessys build\n",
+			filename);
+		exit(EXIT_FAILURE);
+	}
+	if ((header.grow_flag != command_line[0].grow_flag)
+		|| (header.num_basins != world[0].num_basin_files)
+		|| (header.num_base_stations != world[0].num_base_stations)) {
+		fprintf(stderr,
+			"FATAL ERROR: checkpoint %s does not match this world and command line\n",
+			filename);
+		exit(EXIT_FAILURE);
+	}
+	if (header.world_redefined == 1) {
+		fprintf(stderr,
+			"FATAL ERROR: checkpoint %s was written after a redefine or roads_on event and cannot be restarted\n",
+			filename);
+		exit(EXIT_FAILURE);
+	}
+
+	for (b = 0; b < world[0].num_basin_files; b++)
+		restore_basin(world[0].basins[b], infile);
+	for (i = 0; i < world[0].num_base_stations; i++)
+		restore_cursors(world[0].base_stations[i], infile);
+	fclose(infile);
+
+	/*--------------------------------------------------------------*/
+	/*	event loop position, tec state and output files		*/
+	/*--------------------------------------------------------------*/
+	*current_date = header.current_date;
+	*day = header.day;
+	*month = header.month;
+	*year = header.year;
+	command_line[0].output_flags = header.output_flags;
+	command_line[0].output_yearly_date = header.output_yearly_date;
+	command_line[0].road_flag = header.road_flag;
+	clearerr(tecfile[0].tfile);
+	if (fseek(tecfile[0].tfile, header.tec_offset, SEEK_SET) != 0) {
+		fprintf(stderr, "FATAL ERROR: cannot return tec file to checkpoint %s\n",
+			filename);
+		exit(EXIT_FAILURE);
+	}
+	for (l = 0; l < 8; l++)
+		for (s = 0; s < 4; s++) {
+			restore_output_file(checkpoint_output_file(outfile, l, s),
+				header.output_offset[0][l][s]);
+			restore_output_file(checkpoint_output_file(growth_outfile, l, s),
+				header.output_offset[1][l][s]);
+		}
+	printf("\nRestarted from checkpoint %s at %ld %ld %ld\n", filename,
+		current_date[0].year, current_date[0].month, current_date[0].day);
+	return;
+} /*end restore_checkpoint*/
@@ -65,6 +65,15 @@ int	 valid_option( char *command_line){
 		(strcmp(command_line,"-pre") == 0) ||
 		(strcmp(command_line,"-rddn")  == 0) ||
 		(strcmp(command_line,"-stdev") == 0) ||
+		(strcmp(command_line,"-stdevtable") == 0) ||
+		(strcmp(command_line,"-balance") == 0) ||
+		(strcmp(command_line,"-workers") == 0) ||
+		(strcmp(command_line,"-checkpoint") == 0) ||
+		(strcmp(command_line,"-restart") == 0) ||
+		(strcmp(command_line,"-zstate") == 0) ||
+		(strcmp(command_line,"-digits") == 0) ||
+		(strcmp(command_line,"-hsum") == 0) ||
+		(strcmp(command_line,"-pull") == 0) ||
 		(strcmp(command_line,"-dor") == 0) ||
 		(strcmp(command_line,"-csv") == 0) ||
 		(strcmp(command_line,"-vgsen") == 0) ||
@@ -0,0 +1,143 @@
+/** @file test_output_line.c
+ *
+ * 	@brief Reals written by output_line_double must be the same text
+ * 	that snprintf gives for %.<digits>f (%lf with the default 6 digits)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <float.h>
+
+#include <glib.h>
+
+#include "rhessys.h"
+
+void	set_output_digits(int);
+void	output_line_start(struct output_line_object *, FILE *);
+void	output_line_double(struct output_line_object *, double, char *);
+
+
+static void check_value(double value, int digits) {
+	struct output_line_object line;
+	char expected[OUTPUT_LINE_LEN];
+
+	set_output_digits(digits);
+	output_line_start(&line, NULL);
+	output_line_double(&line, value, "");
+	line.text[line.length] = '\0';
+	snprintf(expected, sizeof(expected), "%.*f", digits, value);
+	if (strcmp(line.text, expected) != 0)
+		g_test_message("%.17g with %d digits", value, digits);
+	g_assert_cmpstr(line.text, ==, expected);
+}
+
+static double from_bits(uint64_t bits) {
+	double value;
+
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+void test_output_line_default_digits() {
+	struct output_line_object line;
+	char expected[64];
+
+	set_output_digits(6);
+	output_line_start(&line, NULL);
+	output_line_double(&line, 1234.5678, " ");
+	line.text[line.length] = '\0';
+	snprintf(expected, sizeof(expected), "%lf ", 1234.5678);
+	g_assert_cmpstr(line.text, ==, expected);
+}
+
+void test_output_line_edge_cases() {
+	double values[] = {
+		0.0, -0.0, 1.0, -1.0,
+		/* ties at 0 to 3 digits, exact in binary */
+		0.5, 1.5, 2.5, -2.5, 9.5, 0.25, 0.125, 0.375, 0.0625,
+		/* not ties in binary */
+		0.0000005, 0.0000015, 1.0000005, 0.9999995, 2.675, 1.005,
+		/* carries into the whole part */
+		0.99999999, 9.9999999, 99999.9999999, -0.99999999,
+		/* subnormals and the smallest normal */
+		5e-324, -5e-324, 2.2250738585072014e-308,
+		/* around 2^53, 2^63 and 2^64 */
+		9007199254740991.0, 9007199254740992.0, 9007199254740993.0,
+		9223372036854774784.0, 9223372036854775808.0,
+		18446744073709551616.0, -9223372036854775808.0,
+		1e20, -1e20, 1e300, DBL_MAX, -DBL_MAX,
+		/* typical output values */
+		0.1, 0.2, 0.3, 1.0 / 3.0, 2.0 / 3.0, 1000.0 / 7.0, 1e-7, 123456.789};
+	int i, digits;
+
+	for (digits = 0; digits <= 15; digits++)
+		for (i = 0; i < (int) (sizeof(values) / sizeof(values[0])); i++)
+			check_value(values[i], digits);
+}
+
+void test_output_line_nan_inf() {
+	int digits;
+
+	for (digits = 0; digits <= 15; digits++) {
+		check_value(NAN, digits);
+		check_value(-NAN, digits);
+		check_value(INFINITY, digits);
+		check_value(-INFINITY, digits);
+	}
+}
+
+void test_output_line_random() {
+	uint64_t bits;
+	double value;
+	int i, digits;
+
+	/* random bit patterns and random values of the size model output has */
+	srand(1);
+	for (i = 0; i < 200000; i++) {
+		bits = ((uint64_t) rand() << 62) ^ ((uint64_t) rand() << 31) ^ (uint64_t) rand();
+		digits = i % 16;
+		check_value(from_bits(bits), digits);
+		value = ((double) rand() / RAND_MAX - 0.5) * pow(10.0, (i % 17) - 8);
+		check_value(value, digits);
+		/* values just off a tie at this number of digits */
+		value = (floor(value * pow(10.0, digits)) + 0.5) / pow(10.0, digits);
+		check_value(value, digits);
+		check_value(nextafter(value, 0.0), digits);
+		check_value(nextafter(value, 1e308), digits);
+	}
+}
+
+void test_output_line_digits_clamped() {
+	struct output_line_object line;
+	char expected[64];
+
+	/* -digits outside 0 .. 15 is clamped */
+	set_output_digits(-3);
+	output_line_start(&line, NULL);
+	output_line_double(&line, 2.5, "");
+	line.text[line.length] = '\0';
+	snprintf(expected, sizeof(expected), "%.0f", 2.5);
+	g_assert_cmpstr(line.text, ==, expected);
+
+	set_output_digits(40);
+	output_line_start(&line, NULL);
+	output_line_double(&line, 0.1, "");
+	line.text[line.length] = '\0';
+	snprintf(expected, sizeof(expected), "%.15f", 0.1);
+	g_assert_cmpstr(line.text, ==, expected);
+	set_output_digits(6);
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL);
+
+	g_test_add_func("/output_line/default digits", test_output_line_default_digits);
+	g_test_add_func("/output_line/edge cases", test_output_line_edge_cases);
+	g_test_add_func("/output_line/nan and inf", test_output_line_nan_inf);
+	g_test_add_func("/output_line/random", test_output_line_random);
+	g_test_add_func("/output_line/digits clamped", test_output_line_digits_clamped);
+
+	return g_test_run();
+}
@@ -0,0 +1,220 @@
+/** @file test_sort_patch_layers.c
+ *
+ * 	@brief sort_patch_layers must give the layers of the old routine,
+ * 	which rebuilt and qsorted them on every call, whether it regroups
+ * 	the strata or only refreshes base and null_cover
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <glib.h>
+
+#include "rhessys.h"
+
+#define MAX_STRATA 8
+
+void	sort_patch_layers(struct patch_object *);
+
+struct test_patch {
+	struct patch_object patch;
+	struct canopy_strata_object *strata[MAX_STRATA];
+	struct layer_object layers[MAX_STRATA];
+	long lists[MAX_STRATA][MAX_STRATA];
+};
+
+
+static int old_key_compare(const void *e1, const void *e2) {
+	double v1 = ((const struct layer_object *) e1)->height;
+	double v2 = ((const struct layer_object *) e2)->height;
+
+	return (v1 > v2) ? -1 : (v1 < v2) ? 1 : 0;
+}
+
+/* the routine before layers were kept in place, into separate lists */
+static void old_sort_patch_layers(struct test_patch *t) {
+	struct patch_object *patch = &(t->patch);
+	int i, j, k;
+	double cover_fraction;
+
+	patch->num_layers = 0;
+	for (i = 0; i < patch->num_canopy_strata; i++) {
+		j = 0;
+		while ((j < patch->num_layers)
+			&& (patch->canopy_strata[i][0].epv.height != patch->layers[j].height))
+			j++;
+		if (j >= patch->num_layers) {
+			patch->layers[j].height = patch->canopy_strata[i][0].epv.height;
+			patch->layers[j].count = 1;
+			patch->num_layers++;
+		}
+		else
+			patch->layers[j].count++;
+	}
+	qsort(patch->layers, patch->num_layers, sizeof(struct layer_object),
+		old_key_compare);
+	for (i = 0; i < patch->num_layers; i++) {
+		patch->layers[i].strata = t->lists[i];
+		if (i != patch->num_layers - 1)
+			patch->layers[i].base = patch->layers[i+1].height;
+		else
+			patch->layers[i].base = 0.0;
+		cover_fraction = 0.0;
+		k = 0;
+		for (j = 0; j < patch->num_canopy_strata; j++) {
+			if (patch->canopy_strata[j][0].epv.height == patch->layers[i].height) {
+				patch->layers[i].strata[k++] = j;
+				cover_fraction += patch->canopy_strata[j][0].cover_fraction;
+			}
+		}
+		if (cover_fraction <= 1.0)
+			patch->layers[i].null_cover = 1.0 - cover_fraction;
+	}
+}
+
+/* set up a patch the way construct_patch does */
+static void init_patch(struct test_patch *t, int num_strata) {
+	int i;
+
+	memset(t, 0, sizeof(*t));
+	t->patch.num_canopy_strata = num_strata;
+	t->patch.canopy_strata = t->strata;
+	t->patch.layers = t->layers;
+	for (i = 0; i < num_strata; i++) {
+		t->strata[i] = (struct canopy_strata_object *)
+			calloc(1, sizeof(struct canopy_strata_object));
+		t->layers[i].strata = t->lists[i];
+	}
+	t->patch.num_layers = 0;
+}
+
+static void free_patch(struct test_patch *t) {
+	int i;
+
+	for (i = 0; i < t->patch.num_canopy_strata; i++)
+		free(t->strata[i]);
+}
+
+static void check_layers(struct test_patch *t, struct test_patch *ref) {
+	int i, k;
+
+	g_assert_cmpint(t->patch.num_layers, ==, ref->patch.num_layers);
+	for (i = 0; i < ref->patch.num_layers; i++) {
+		g_assert(t->patch.layers[i].height == ref->patch.layers[i].height);
+		g_assert(t->patch.layers[i].base == ref->patch.layers[i].base);
+		g_assert(t->patch.layers[i].null_cover == ref->patch.layers[i].null_cover);
+		g_assert_cmpint(t->patch.layers[i].count, ==, ref->patch.layers[i].count);
+		for (k = 0; k < ref->patch.layers[i].count; k++)
+			g_assert_cmpint(t->patch.layers[i].strata[k], ==,
+				ref->patch.layers[i].strata[k]);
+	}
+}
+
+static void set_stratum(struct test_patch *t, struct test_patch *ref,
+						int j, double height, double cover) {
+	t->strata[j][0].epv.height = ref->strata[j][0].epv.height = height;
+	t->strata[j][0].cover_fraction = ref->strata[j][0].cover_fraction = cover;
+}
+
+/* few distinct heights so that strata share layers */
+static double random_height() {
+	return (double) (rand() % 6) * 2.5;
+}
+
+/* covers of a layer stay below 1.0, where null_cover is left as it was */
+static double random_cover() {
+	return (double) (rand() % 100) / (100.0 * MAX_STRATA);
+}
+
+void test_sort_patch_layers_random() {
+	struct test_patch t, ref;
+	int n, day, j, num_strata;
+
+	srand(1);
+	for (n = 0; n < 2000; n++) {
+		num_strata = 1 + rand() % MAX_STRATA;
+		init_patch(&t, num_strata);
+		init_patch(&ref, num_strata);
+		for (j = 0; j < num_strata; j++)
+			set_stratum(&t, &ref, j, random_height(), random_cover());
+		sort_patch_layers(&(t.patch));
+		old_sort_patch_layers(&ref);
+		check_layers(&t, &ref);
+		/* on most days only covers change; on some a height does */
+		for (day = 0; day < 30; day++) {
+			for (j = 0; j < num_strata; j++) {
+				if (rand() % 10 == 0)
+					set_stratum(&t, &ref, j, random_height(), random_cover());
+				else
+					set_stratum(&t, &ref, j, t.strata[j][0].epv.height, random_cover());
+			}
+			sort_patch_layers(&(t.patch));
+			old_sort_patch_layers(&ref);
+			check_layers(&t, &ref);
+		}
+		free_patch(&t);
+		free_patch(&ref);
+	}
+}
+
+void test_sort_patch_layers_dirty() {
+	struct test_patch t, ref;
+	long *top;
+
+	init_patch(&t, 3);
+	init_patch(&ref, 3);
+	set_stratum(&t, &ref, 0, 10.0, 0.5);
+	set_stratum(&t, &ref, 1, 2.0, 0.4);
+	set_stratum(&t, &ref, 2, 10.0, 0.3);
+	sort_patch_layers(&(t.patch));
+	old_sort_patch_layers(&ref);
+	check_layers(&t, &ref);
+
+	/* heights unchanged: the strata are not regrouped (the swapped
+	 * list is kept) and null_cover follows the covers */
+	top = t.patch.layers[0].strata;
+	top[0] = 2;
+	top[1] = 0;
+	set_stratum(&t, &ref, 1, 2.0, 0.9);
+	sort_patch_layers(&(t.patch));
+	old_sort_patch_layers(&ref);
+	g_assert_cmpint(t.patch.layers[0].strata[0], ==, 2);
+	g_assert(t.patch.layers[1].null_cover == ref.patch.layers[1].null_cover);
+	top[0] = 0;
+	top[1] = 2;
+	check_layers(&t, &ref);
+
+	/* a stratum grows past the others: its layer moves to the top */
+	set_stratum(&t, &ref, 1, 12.0, 0.9);
+	sort_patch_layers(&(t.patch));
+	old_sort_patch_layers(&ref);
+	check_layers(&t, &ref);
+	g_assert_cmpint(t.patch.layers[0].strata[0], ==, 1);
+
+	/* back to a clean state, then two layers merge into one */
+	sort_patch_layers(&(t.patch));
+	check_layers(&t, &ref);
+	set_stratum(&t, &ref, 0, 12.0, 0.05);
+	set_stratum(&t, &ref, 2, 12.0, 0.05);
+	sort_patch_layers(&(t.patch));
+	old_sort_patch_layers(&ref);
+	check_layers(&t, &ref);
+	g_assert_cmpint(t.patch.num_layers, ==, 1);
+
+	/* a stratum count the layers do not account for is regrouped */
+	t.patch.layers[0].count = 2;
+	sort_patch_layers(&(t.patch));
+	check_layers(&t, &ref);
+
+	free_patch(&t);
+	free_patch(&ref);
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL);
+
+	g_test_add_func("/sort_patch_layers/random", test_sort_patch_layers_random);
+	g_test_add_func("/sort_patch_layers/dirty", test_sort_patch_layers_dirty);
+
+	return g_test_run();
+}
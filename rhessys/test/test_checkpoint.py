@@ -0,0 +1,92 @@
+from unittest import TestCase
+import os, sys
+from zipfile import ZipFile
+from shutil import rmtree, copyfile
+import subprocess, shlex
+
+
+# W8 run used for the -checkpoint / -restart tests; checkpoints are
+# written at the start of 2004 and 2005
+CMDLINE = '-t ../tecfiles/{tec} -w ../worldfiles/world.w8.testcase  -r ../flowtables/flow.w8  -st 2003 10 1 1 -ed 2005 10 1 1 -pre ../out/testcase -s 0.812 58.038 -sv 0.812 58.038 -gw 0.042 0.716 -g -b -checkpoint 1'
+WORLD = 'world.w8.testcase'
+OUTFILE = 'testcase_basin.daily'
+
+
+class TestCheckpoint(TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        rhessysBin = os.path.join( './', os.environ['RHESSYS_BIN'] )
+        cls.rhessys = os.path.abspath(rhessysBin)
+        cls.dataRoot = os.path.abspath('./test/data')
+        cls.testRoot = os.path.join(cls.dataRoot, 'testtmp_checkpoint')
+        if os.path.exists(cls.testRoot):
+            rmtree(cls.testRoot)
+        os.mkdir(cls.testRoot)
+
+        zipPath = os.path.join(cls.dataRoot, 'W8.zip')
+        if not os.access(zipPath, os.R_OK):
+            raise IOError("Unable to read test data zip %s" % zipPath)
+        zip = ZipFile(zipPath, 'r')
+        zip.extractall(path=cls.testRoot)
+        cls.testPath = os.path.join(cls.testRoot, 'W8')
+        cls.runDir = os.path.join(cls.testPath, 'scripts')
+        cls.worldDir = os.path.join(cls.testPath, 'worldfiles')
+
+        # tec files with and without a redefine before the 2005 checkpoint;
+        # the redefine reads the world file back unchanged
+        tecDir = os.path.join(cls.testPath, 'tecfiles')
+        with open(os.path.join(tecDir, 'tec.checkpoint'), 'w') as f:
+            f.write("2003 10 1 1 print_daily_on\n")
+        with open(os.path.join(tecDir, 'tec.redefine'), 'w') as f:
+            f.write("2003 10 1 1 print_daily_on\n")
+            f.write("2004 6 1 1 redefine_world\n")
+        copyfile(os.path.join(cls.worldDir, WORLD),
+                 os.path.join(cls.worldDir, WORLD + '.Y2004M6D1H1'))
+
+    @classmethod
+    def tearDownClass(cls):
+        rmtree(cls.testRoot)
+
+    def runRhessys(self, tec, extra=''):
+        cmdline = self.rhessys + ' ' + CMDLINE.format(tec=tec) + ' ' + extra
+        args = shlex.split(cmdline)
+        p = subprocess.Popen(args, cwd=self.runDir,
+                             stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+        (stdout, stderr) = p.communicate()
+        return (p.returncode, stdout, stderr)
+
+    def removeCheckpoint(self):
+        checkpoint = os.path.join(self.worldDir, WORLD + '.checkpoint')
+        if os.path.exists(checkpoint):
+            os.remove(checkpoint)
+        return checkpoint
+
+    def testRestartMatchesUninterruptedRun(self):
+        checkpoint = self.removeCheckpoint()
+        (result, stdout, stderr) = self.runRhessys('tec.checkpoint')
+        self.assertEqual(result, 0, stderr)
+        self.assertTrue(os.path.exists(checkpoint))
+        outputPath = os.path.join(self.testPath, 'out', OUTFILE)
+        with open(outputPath, 'rb') as f:
+            uninterrupted = f.read()
+
+        # resume from the 2005 checkpoint; the output is cut back to
+        # its length at the checkpoint and written again from there
+        (result, stdout, stderr) = self.runRhessys('tec.checkpoint', '-restart')
+        self.assertEqual(result, 0, stderr)
+        with open(outputPath, 'rb') as f:
+            restarted = f.read()
+        self.assertEqual(uninterrupted, restarted)
+
+    def testRestartAfterRedefineIsRefused(self):
+        checkpoint = self.removeCheckpoint()
+        (result, stdout, stderr) = self.runRhessys('tec.redefine')
+        self.assertEqual(result, 0, stderr)
+        self.assertTrue(os.path.exists(checkpoint))
+
+        # the 2005 checkpoint follows the redefine, so the restored
+        # world would not have the redefined parameters
+        (result, stdout, stderr) = self.runRhessys('tec.redefine', '-restart')
+        self.assertNotEqual(result, 0)
+        self.assertTrue(b'redefine' in stderr)
@@ -0,0 +1,106 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		balance_log					*/
+/*								*/
+/*	NAME							*/
+/*	balance_log - mass balance diagnostics (-balance)	*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	int	balance_check_due(				*/
+/*			struct command_line_object *,		*/
+/*			struct date)				*/
+/*	void	add_balance_entry(				*/
+/*			struct balance_log_object *,		*/
+/*			int, int, int, double)			*/
+/*	void	flush_balance_log(				*/
+/*			struct balance_log_object *,		*/
+/*			struct date)				*/
+/*								*/
+/*	OPTIONS							*/
+/*	-balance [interval [sample]]				*/
+/*		check water balances every interval days	*/
+/*		(default 1) for patches whose ID is a multiple	*/
+/*		of sample (default 1, all patches)		*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	Without -balance no balance is checked and hillslopes	*/
+/*	have no log.  On a check day each hillslope collects	*/
+/*	its violations in its own log, so that hillslopes run	*/
+/*	in parallel do not share any output; basin_daily_F	*/
+/*	prints the logs in hillslope order once the day is	*/
+/*	done.							*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+#include "functions.h"
+
+#define	BALANCE_LOG_INCREMENT	64
+
+int	balance_check_due(struct command_line_object *command_line,
+			  struct date current_date)
+{
+	long	julday(struct date);
+
+	if (command_line[0].balance_flag == 0)
+		return(0);
+	if (command_line[0].balance_interval <= 1)
+		return(1);
+	return((julday(current_date) % command_line[0].balance_interval) == 0);
+}
+
+void	add_balance_entry(struct balance_log_object *log,
+			  int kind,
+			  int ID,
+			  int drainage_type,
+			  double balance)
+{
+	if (log[0].num_entries == log[0].max_entries) {
+		log[0].max_entries += BALANCE_LOG_INCREMENT;
+		log[0].entries = (struct balance_entry *)realloc(log[0].entries,
+			log[0].max_entries * sizeof(struct balance_entry));
+		if (log[0].entries == NULL) {
+			fprintf(stderr, "FATAL ERROR: out of memory in add_balance_entry\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	log[0].entries[log[0].num_entries].kind = kind;
+	log[0].entries[log[0].num_entries].ID = ID;
+	log[0].entries[log[0].num_entries].drainage_type = drainage_type;
+	log[0].entries[log[0].num_entries].balance = balance;
+	log[0].num_entries++;
+	return;
+}
+
+void	flush_balance_log(struct balance_log_object *log,
+			  struct date current_date)
+{
+	int	i;
+	struct	balance_entry *entry;
+
+	for (i = 0; i < log[0].num_entries; i++) {
+		entry = &(log[0].entries[i]);
+		switch (entry[0].kind) {
+		case BALANCE_PATCH_WATER:
+			printf("\n Water Balance is %12.8f on %ld %ld %ld for patch %d of type %d",
+				entry[0].balance, current_date.day, current_date.month,
+				current_date.year, entry[0].ID, entry[0].drainage_type);
+			break;
+		case BALANCE_TOPMODEL_WATER:
+			printf("\n Hill Water Balance is %12.8f on %ld %ld %ld for Hill %d",
+				entry[0].balance, current_date.day, current_date.month,
+				current_date.year, entry[0].ID);
+			break;
+		case BALANCE_ROUTING_WATER:
+			printf("\n Routing Water Balance is %12.8f on %ld %ld %ld for Hill %d",
+				entry[0].balance, current_date.day, current_date.month,
+				current_date.year, entry[0].ID);
+			break;
+		}
+	}
+	log[0].num_entries = 0;
+	return;
+}
@@ -0,0 +1,131 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		hourly_summary					*/
+/*								*/
+/*	NAME							*/
+/*	hourly_summary - keep per day statistics of hourly	*/
+/*			 output in place of the hourly rows	*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	void	hourly_summary(					*/
+/*			struct hourly_summary_object *summary,	*/
+/*			struct	date	current_date,		*/
+/*			long	*key,				*/
+/*			int	num_keys,			*/
+/*			double	*value,				*/
+/*			int	num_values,			*/
+/*			FILE	*outfile)			*/
+/*	void	add_hourly_summary_header(			*/
+/*			FILE	*outfile,			*/
+/*			char	**key_name,			*/
+/*			int	num_keys,			*/
+/*			char	**value_name,			*/
+/*			int	num_values)			*/
+/*								*/
+/*	OPTIONS							*/
+/*	-hsum [b][z]						*/
+/*		summarize hourly basin and/or zone output	*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	hourly_summary is called with the values of one basin	*/
+/*	or zone every hour, in place of writing them.  The	*/
+/*	mean, minimum, maximum and hour of the maximum of each	*/
+/*	value are updated in summary, which lives in the	*/
+/*	object.  After hour 24 one row is written:		*/
+/*								*/
+/*	day month year keys value_mean value_min value_max	*/
+/*	value_peakhr ...					*/
+/*								*/
+/*	so the hourly files grow by one row per object per day.	*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*	The statistics restart at hour 1 or on a new day, so	*/
+/*	a day where hourly output is switched on late by a tec	*/
+/*	event covers only the hours that were seen, and one	*/
+/*	switched off early writes no row.			*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include "rhessys.h"
+
+void	hourly_summary(struct hourly_summary_object *summary,
+		       struct date current_date,
+		       long *key,
+		       int num_keys,
+		       double *value,
+		       int num_values,
+		       FILE *outfile)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	output_line_start(struct output_line_object *, FILE *);
+	void	output_line_int(struct output_line_object *, long, char *);
+	void	output_line_double(struct output_line_object *, double, char *);
+	int	output_line_end(struct output_line_object *);
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	struct	output_line_object	line;
+	int	i;
+
+	num_values = min(num_values, HOURLY_SUMMARY_LEN);
+	if ((current_date.hour == 1) || (summary[0].day != current_date.day)) {
+		summary[0].day = current_date.day;
+		summary[0].num_hours = 0;
+	}
+	for (i = 0; i < num_values; i++) {
+		if ((summary[0].num_hours == 0) || (value[i] > summary[0].max[i])) {
+			summary[0].max[i] = value[i];
+			summary[0].peak_hour[i] = (int) current_date.hour;
+		}
+		if ((summary[0].num_hours == 0) || (value[i] < summary[0].min[i]))
+			summary[0].min[i] = value[i];
+		if (summary[0].num_hours == 0)
+			summary[0].sum[i] = value[i];
+		else
+			summary[0].sum[i] += value[i];
+	}
+	summary[0].num_hours += 1;
+	if (current_date.hour < 24)
+		return;
+
+	/*--------------------------------------------------------------*/
+	/*	end of the day: write the row and start again		*/
+	/*--------------------------------------------------------------*/
+	output_line_start(&line, outfile);
+	output_line_int(&line, current_date.day, " ");
+	output_line_int(&line, current_date.month, " ");
+	output_line_int(&line, current_date.year, " ");
+	for (i = 0; i < num_keys; i++)
+		output_line_int(&line, key[i], " ");
+	for (i = 0; i < num_values; i++) {
+		output_line_double(&line, summary[0].sum[i] / summary[0].num_hours, " ");
+		output_line_double(&line, summary[0].min[i], " ");
+		output_line_double(&line, summary[0].max[i], " ");
+		output_line_int(&line, summary[0].peak_hour[i],
+			(i == num_values - 1) ? "\n" : " ");
+	}
+	if (output_line_end(&line) <= 0)
+		fprintf(stdout, "\nWARNING: output error has occured in hourly_summary");
+	summary[0].num_hours = 0;
+	summary[0].day = -1;
+} /*end hourly_summary*/
+
+void	add_hourly_summary_header(FILE *outfile,
+				  char **key_name,
+				  int num_keys,
+				  char **value_name,
+				  int num_values)
+{
+	int	i;
+
+	fprintf(outfile, "day month year");
+	for (i = 0; i < num_keys; i++)
+		fprintf(outfile, " %s", key_name[i]);
+	for (i = 0; i < min(num_values, HOURLY_SUMMARY_LEN); i++)
+		fprintf(outfile, " %s_mean %s_min %s_max %s_peakhr",
+			value_name[i], value_name[i], value_name[i], value_name[i]);
+	fprintf(outfile, "\n");
+} /*end add_hourly_summary_header*/
@@ -0,0 +1,375 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		launch_workers					*/
+/*								*/
+/*	NAME							*/
+/*	launch_workers - run basins in worker processes		*/
+/*			 (-workers)				*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	int	launch_workers(					*/
+/*			struct command_line_object *)		*/
+/*								*/
+/*	OPTIONS							*/
+/*	-workers N						*/
+/*		split the basins of the world file over N	*/
+/*		local processes					*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	Forks num_workers copies of rhessys.  Worker k returns	*/
+/*	0 with worker_rank set to k; construct_world then keeps	*/
+/*	only basins [k*n/N, (k+1)*n/N) and the worker writes	*/
+/*	its output with the prefix <prefix>_w<k>.		*/
+/*								*/
+/*	The launcher waits for all workers, joins their output	*/
+/*	into the files a single process run would write and	*/
+/*	returns 1.  Every output line starts with its date, so	*/
+/*	the files are merged by date and, within a date, in	*/
+/*	worker order.  As the shares are contiguous this is	*/
+/*	the basin order of a single process run and the merged	*/
+/*	files are identical to it.  State files are joined by	*/
+/*	summing num_basins and appending the basin states.	*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*	Basins do not exchange water or nutrients (each basin	*/
+/*	routes its own stream network), so workers do not talk	*/
+/*	to each other while they run.  Fire spread works on a	*/
+/*	world grid and spinup thresholds may name any patch,	*/
+/*	so both are refused with -workers.			*/
+/*								*/
+/*--------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <glob.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "rhessys.h"
+
+#define	MAX_DATE_KEY	4
+
+static	int	date_key_width(char *header)
+{
+	/*--------------------------------------------------------------*/
+	/*	count the leading hour/day/month/year header fields	*/
+	/*--------------------------------------------------------------*/
+	char	field[16];
+	int	width, offset, n;
+
+	width = 0;
+	offset = 0;
+	while ((width < MAX_DATE_KEY)
+		&& (sscanf(header + offset, "%15s%n", field, &n) == 1)
+		&& ((strcmp(field, "hour") == 0) || (strcmp(field, "day") == 0)
+		|| (strcmp(field, "month") == 0) || (strcmp(field, "year") == 0))) {
+		offset += n;
+		width++;
+	}
+	return(width);
+}
+
+static	int	is_header(char *line)
+{
+	while (*line == ' ')
+		line++;
+	return(isalpha((unsigned char) *line) != 0);
+}
+
+static	int	compare_date_key(long *a, long *b, int width)
+{
+	/*--------------------------------------------------------------*/
+	/*	fields run from hour up to year, so compare backwards	*/
+	/*--------------------------------------------------------------*/
+	int	i;
+
+	for (i = width - 1; i >= 0; i--) {
+		if (a[i] < b[i]) return(-1);
+		if (a[i] > b[i]) return(1);
+	}
+	return(0);
+}
+
+static	void	read_date_key(char *line, long *key, int width)
+{
+	int	i, offset, n;
+
+	offset = 0;
+	for (i = 0; i < width; i++) {
+		if (sscanf(line + offset, "%ld%n", &(key[i]), &n) != 1)
+			key[i] = 0;
+		else
+			offset += n;
+	}
+}
+
+/*--------------------------------------------------------------*/
+/*	format a file name; a name that does not fit is fatal	*/
+/*--------------------------------------------------------------*/
+static	void	format_filename(char *filename,
+				size_t size,
+				const char *format, ...)
+{
+	va_list	ap;
+	int	n;
+
+	va_start(ap, format);
+	n = vsnprintf(filename, size, format, ap);
+	va_end(ap);
+	if ((n < 0) || ((size_t) n >= size)) {
+		fprintf(stderr, "FATAL ERROR: file name too long in launch_workers: %s\n",
+			filename);
+		exit(EXIT_FAILURE);
+	}
+}
+
+static	void	merge_output_file(char *prefix,
+				  char *suffix,
+				  int num_workers)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	FILE	*outfile;
+	FILE	**infile;
+	char	**line;
+	size_t	*line_size;
+	int	*has_line;
+	long	(*key)[MAX_DATE_KEY];
+	long	min_key[MAX_DATE_KEY];
+	char	filename[FILEPATH_LEN+100];
+	int	k, c, width, found;
+
+	/*--------------------------------------------------------------*/
+	/*	only files that worker 0 opened exist			*/
+	/*--------------------------------------------------------------*/
+	format_filename(filename, sizeof(filename), "%s_w0%s", prefix, suffix);
+	if (access(filename, F_OK) != 0)
+		return;
+
+	infile = (FILE **) calloc(num_workers, sizeof(FILE *));
+	line = (char **) calloc(num_workers, sizeof(char *));
+	line_size = (size_t *) calloc(num_workers, sizeof(size_t));
+	has_line = (int *) calloc(num_workers, sizeof(int));
+	key = calloc(num_workers, sizeof(*key));
+	if ((infile == NULL) || (line == NULL) || (line_size == NULL)
+		|| (has_line == NULL) || (key == NULL)) {
+		fprintf(stderr, "FATAL ERROR: out of memory in launch_workers\n");
+		exit(EXIT_FAILURE);
+	}
+	for (k = 0; k < num_workers; k++) {
+		format_filename(filename, sizeof(filename), "%s_w%d%s", prefix, k, suffix);
+		if ((infile[k] = fopen(filename, "r")) == NULL) {
+			fprintf(stderr, "FATAL ERROR: cannot open worker output %s\n",
+				filename);
+			exit(EXIT_FAILURE);
+		}
+	}
+	format_filename(filename, sizeof(filename), "%s%s", prefix, suffix);
+	if ((outfile = fopen(filename, "w")) == NULL) {
+		fprintf(stderr, "FATAL ERROR: cannot open output %s\n", filename);
+		exit(EXIT_FAILURE);
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	every worker wrote the same header; keep worker 0's	*/
+	/*	together with any blanks add_headers left after it.	*/
+	/*	A file without a header starts with its data.		*/
+	/*--------------------------------------------------------------*/
+	width = 0;
+	for (k = 0; k < num_workers; k++) {
+		has_line[k] = (getline(&(line[k]), &(line_size[k]), infile[k]) >= 0);
+		if (!has_line[k] || !is_header(line[k]))
+			continue;
+		if (k == 0) {
+			fputs(line[0], outfile);
+			width = date_key_width(line[0]);
+		}
+		while ((c = getc(infile[k])) == ' ')
+			if (k == 0) putc(c, outfile);
+		if (c != EOF) ungetc(c, infile[k]);
+		has_line[k] = (getline(&(line[k]), &(line_size[k]), infile[k]) >= 0);
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	merge the data lines by date, ties in worker order	*/
+	/*--------------------------------------------------------------*/
+	for (k = 0; k < num_workers; k++)
+		if (has_line[k])
+			read_date_key(line[k], key[k], width);
+	do {
+		found = 0;
+		for (k = 0; k < num_workers; k++) {
+			if (has_line[k] && ((found == 0)
+				|| (compare_date_key(key[k], min_key, width) < 0))) {
+				memcpy(min_key, key[k], sizeof(min_key));
+				found = 1;
+			}
+		}
+		for (k = 0; (k < num_workers) && found; k++) {
+			while (has_line[k]
+				&& (compare_date_key(key[k], min_key, width) == 0)) {
+				fputs(line[k], outfile);
+				has_line[k] = (getline(&(line[k]), &(line_size[k]),
+					infile[k]) >= 0);
+				if (has_line[k])
+					read_date_key(line[k], key[k], width);
+			}
+		}
+	} while (found);
+
+	fclose(outfile);
+	for (k = 0; k < num_workers; k++) {
+		fclose(infile[k]);
+		free(line[k]);
+		format_filename(filename, sizeof(filename), "%s_w%d%s", prefix, k, suffix);
+		remove(filename);
+	}
+	free(infile);
+	free(line);
+	free(line_size);
+	free(has_line);
+	free(key);
+	return;
+}
+
+static	void	merge_state_file(char *worker0_filename,
+				 int num_workers)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	FILE	*outfile;
+	FILE	*infile;
+	char	filename[FILEPATH_LEN+100];
+	char	buffer[BUFSIZ];
+	size_t	n, length;
+	long	world_ID, num_basins, worker_basins;
+	int	k, compress;
+	FILE	*open_state_file(char *, char *, int);
+
+	/*--------------------------------------------------------------*/
+	/*	strip the trailing .w0					*/
+	/*--------------------------------------------------------------*/
+	length = strlen(worker0_filename) - strlen(".w0");
+	compress = ((length > 3)
+		&& (strncmp(worker0_filename + length - 3, ".gz", 3) == 0));
+
+	num_basins = 0;
+	world_ID = 0;
+	for (k = 0; k < num_workers; k++) {
+		format_filename(filename, sizeof(filename), "%.*s.w%d",
+			(int) length, worker0_filename, k);
+		if (((infile = open_state_file(filename, "r", 0)) == NULL)
+			|| (fscanf(infile, "%ld %*s %ld %*s",
+				&world_ID, &worker_basins) != 2)) {
+			fprintf(stderr, "FATAL ERROR: cannot read worker state %s\n",
+				filename);
+			exit(EXIT_FAILURE);
+		}
+		num_basins += worker_basins;
+		fclose(infile);
+	}
+
+	format_filename(filename, sizeof(filename), "%.*s", (int) length, worker0_filename);
+	if ((outfile = open_state_file(filename, "w", compress)) == NULL) {
+		fprintf(stderr, "FATAL ERROR: cannot open state file %s\n", filename);
+		exit(EXIT_FAILURE);
+	}
+	fprintf(outfile, "\n%-30ld %s", world_ID, "world_id");
+	fprintf(outfile, "\n%-30ld %s", num_basins, "num_basins");
+	for (k = 0; k < num_workers; k++) {
+		format_filename(filename, sizeof(filename), "%.*s.w%d",
+			(int) length, worker0_filename, k);
+		infile = open_state_file(filename, "r", 0);
+		fscanf(infile, "%*s %*s %*s %*s");
+		while ((n = fread(buffer, 1, BUFSIZ, infile)) > 0)
+			fwrite(buffer, 1, n, outfile);
+		fclose(infile);
+		remove(filename);
+	}
+	fclose(outfile);
+	return;
+}
+
+int	launch_workers(struct command_line_object *command_line)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	static char	*level[] = {"_streamrouting", "_basin", "_hillslope",
+				"_zone", "_patch", "_stratum", "_fire",
+				"_shadow_stratum"};
+	static char	*step[] = {".yearly", ".monthly", ".daily", ".hourly"};
+	char	prefix[FILEPATH_LEN];
+	char	suffix[64];
+	char	pattern[FILEPATH_LEN+32];
+	glob_t	state_files;
+	pid_t	pid;
+	int	k, l, s, grow, status, failed;
+	size_t	i;
+
+	if ((command_line[0].firespread_flag == 1)
+		|| (command_line[0].vegspinup_flag > 0)) {
+		fprintf(stderr,
+			"FATAL ERROR: -workers cannot be used with fire spread or vegetation spinup\n");
+		exit(EXIT_FAILURE);
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	start the workers; flush first so buffered output is	*/
+	/*	not written once per process				*/
+	/*--------------------------------------------------------------*/
+	fflush(stdout);
+	fflush(stderr);
+	for (k = 0; k < command_line[0].num_workers; k++) {
+		if ((pid = fork()) < 0) {
+			fprintf(stderr, "FATAL ERROR: cannot start worker %d\n", k);
+			exit(EXIT_FAILURE);
+		}
+		if (pid == 0) {
+			command_line[0].worker_rank = k;
+			return(0);
+		}
+	}
+
+	failed = 0;
+	while (wait(&status) > 0)
+		if (!WIFEXITED(status) || (WEXITSTATUS(status) != EXIT_SUCCESS))
+			failed = 1;
+	if (failed) {
+		fprintf(stderr, "FATAL ERROR: a worker did not finish, outputs left unmerged\n");
+		exit(EXIT_FAILURE);
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	join the output files					*/
+	/*--------------------------------------------------------------*/
+	format_filename(prefix, sizeof(prefix), "%s",
+		(command_line[0].output_prefix != NULL) ? command_line[0].output_prefix : PRE);
+	for (grow = 0; grow < 2; grow++)
+		for (l = 0; l < (int)(sizeof(level) / sizeof(level[0])); l++)
+			for (s = 0; s < (int)(sizeof(step) / sizeof(step[0])); s++) {
+				format_filename(suffix, sizeof(suffix), "%s%s%s",
+					grow ? "_grow" : "", level[l], step[s]);
+				merge_output_file(prefix, suffix,
+					command_line[0].num_workers);
+			}
+
+	/*--------------------------------------------------------------*/
+	/*	join the state files					*/
+	/*--------------------------------------------------------------*/
+	format_filename(pattern, sizeof(pattern), "%s.Y*.state*.w0",
+		command_line[0].world_filename);
+	if (glob(pattern, 0, NULL, &state_files) == 0) {
+		for (i = 0; i < state_files.gl_pathc; i++)
+			merge_state_file(state_files.gl_pathv[i],
+				command_line[0].num_workers);
+		globfree(&state_files);
+	}
+	return(1);
+}
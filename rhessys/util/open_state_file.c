@@ -0,0 +1,109 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		open_state_file					*/
+/*								*/
+/*	NAME							*/
+/*	open_state_file - open a world or state file that may	*/
+/*			  be gzip compressed			*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	FILE	*open_state_file(				*/
+/*			char	*filename,			*/
+/*			char	*mode,				*/
+/*			int	compress)			*/
+/*								*/
+/*	OPTIONS							*/
+/*	-zstate							*/
+/*		write state files gzip compressed		*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	Returns a stdio stream, or NULL if the file cannot be	*/
+/*	opened, so that the world file readers and the state	*/
+/*	writers keep using fscanf and fprintf.			*/
+/*								*/
+/*	In read mode a file that starts with the gzip magic	*/
+/*	bytes is decompressed as it is read; any other file is	*/
+/*	opened as before.  In write mode the stream is gzip	*/
+/*	compressed when compress is set.  fclose finishes the	*/
+/*	gzip stream.						*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*	Compression needs zlib: build with make zlib=1.  Other	*/
+/*	builds treat a compressed file as a fatal error.	*/
+/*								*/
+/*--------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+#ifdef ZLIB_STATE
+#include <zlib.h>
+
+#define	STATE_GZ_BUFFER	(256*1024)
+
+static	ssize_t	gz_state_read(void *cookie, char *buffer, size_t size)
+{
+	return((ssize_t) gzread((gzFile) cookie, buffer, (unsigned) size));
+}
+
+static	ssize_t	gz_state_write(void *cookie, const char *buffer, size_t size)
+{
+	if (size == 0)
+		return(0);
+	return((ssize_t) gzwrite((gzFile) cookie, buffer, (unsigned) size));
+}
+
+static	int	gz_state_close(void *cookie)
+{
+	return((gzclose((gzFile) cookie) == Z_OK) ? 0 : EOF);
+}
+#endif
+
+FILE	*open_state_file(char *filename,
+			 char *mode,
+			 int compress)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	FILE	*file;
+	int	c1, c2;
+#ifdef ZLIB_STATE
+	gzFile	gz;
+	cookie_io_functions_t	gz_functions = {gz_state_read,
+		gz_state_write, NULL, gz_state_close};
+#endif
+
+	/*--------------------------------------------------------------*/
+	/*	look for the gzip magic bytes 1f 8b			*/
+	/*--------------------------------------------------------------*/
+	if (mode[0] == 'r') {
+		if ((file = fopen(filename, "r")) == NULL)
+			return(NULL);
+		c1 = getc(file);
+		c2 = getc(file);
+		if ((c1 != 0x1f) || (c2 != 0x8b)) {
+			rewind(file);
+			return(file);
+		}
+		fclose(file);
+		compress = 1;
+	}
+	if (compress == 0)
+		return(fopen(filename, mode));
+
+#ifdef ZLIB_STATE
+	if ((gz = gzopen(filename, (mode[0] == 'r') ? "rb" : "wb6")) == NULL)
+		return(NULL);
+	gzbuffer(gz, STATE_GZ_BUFFER);
+	if ((file = fopencookie(gz, (mode[0] == 'r') ? "r" : "w", gz_functions)) == NULL)
+		gzclose(gz);
+	return(file);
+#else
+	fprintf(stderr,
+		"FATAL ERROR: %s is gzip compressed; rebuild rhessys with make zlib=1\n",
+		filename);
+	exit(EXIT_FAILURE);
+#endif
+} /*end open_state_file*/
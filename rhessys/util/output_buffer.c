@@ -0,0 +1,67 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		output_buffer					*/
+/*								*/
+/*	NAME							*/
+/*	output_buffer - format output of one hillslope into	*/
+/*			memory					*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	FILE	*open_output_buffer(				*/
+/*			struct output_buffer_object *buffer,	*/
+/*			int	used)				*/
+/*	void	write_output_buffer(				*/
+/*			struct output_buffer_object *buffer,	*/
+/*			FILE	*outfile)			*/
+/*								*/
+/*	OPTIONS							*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	The output events format the hillslopes of a basin in	*/
+/*	parallel.  open_output_buffer returns a memory stream	*/
+/*	to pass to the output_* routines in place of the	*/
+/*	shared file, or NULL if used is 0.  Once the parallel	*/
+/*	loop is done write_output_buffer is called for each	*/
+/*	hillslope in order; it closes the stream and appends	*/
+/*	its text to outfile, so the file is the same as when	*/
+/*	the hillslopes are written one after the other.		*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*--------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+
+FILE	*open_output_buffer(struct output_buffer_object *buffer,
+			    int used)
+{
+	buffer[0].file = NULL;
+	buffer[0].text = NULL;
+	buffer[0].length = 0;
+	if (used == 0)
+		return(NULL);
+	if ((buffer[0].file = open_memstream(&(buffer[0].text),
+		&(buffer[0].length))) == NULL) {
+		fprintf(stderr,"FATAL ERROR: out of memory in open_output_buffer\n");
+		exit(EXIT_FAILURE);
+	}
+	return(buffer[0].file);
+} /*end open_output_buffer*/
+
+void	write_output_buffer(struct output_buffer_object *buffer,
+			    FILE *outfile)
+{
+	if (buffer[0].file == NULL)
+		return;
+	fclose(buffer[0].file);
+	if ((buffer[0].length > 0)
+		&& (fwrite(buffer[0].text, 1, buffer[0].length, outfile)
+			!= buffer[0].length))
+		fprintf(stdout, "\nWARNING: output error has occured in write_output_buffer");
+	free(buffer[0].text);
+	buffer[0].file = NULL;
+	buffer[0].text = NULL;
+	buffer[0].length = 0;
+} /*end write_output_buffer*/
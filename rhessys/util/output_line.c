@@ -0,0 +1,220 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		output_line					*/
+/*								*/
+/*	NAME							*/
+/*	output_line - build a line of text output without	*/
+/*		      going through fprintf			*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	void	set_output_digits(int digits)			*/
+/*	void	output_line_start(				*/
+/*			struct output_line_object *line,	*/
+/*			FILE	*outfile)			*/
+/*	void	output_line_int(				*/
+/*			struct output_line_object *line,	*/
+/*			long	value,				*/
+/*			char	*separator)			*/
+/*	void	output_line_double(				*/
+/*			struct output_line_object *line,	*/
+/*			double	value,				*/
+/*			char	*separator)			*/
+/*	int	output_line_end(				*/
+/*			struct output_line_object *line)	*/
+/*								*/
+/*	OPTIONS							*/
+/*	-digits n						*/
+/*		decimals written for real values (default 6)	*/
+/*								*/
+/*	DESCRIPTION						*/
+/*	Each value is converted into line.text followed by its	*/
+/*	separator; output_line_end writes the text with one	*/
+/*	fwrite and returns the number of bytes written, or a	*/
+/*	value <= 0 on error, like the fprintf it replaces.	*/
+/*								*/
+/*	Integers are written as %ld.  Reals are written as	*/
+/*	%.<digits>f, so the default gives the same text as the	*/
+/*	%lf used before.					*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*	A double is mantissa * 2^-shift.  The whole part and	*/
+/*	the fraction bits are split exactly, the fraction is	*/
+/*	scaled by 10^digits in 128 bit integers and rounded	*/
+/*	half to even on the exact remainder, which is what	*/
+/*	glibc printf does.  Values of 2^63 and more, nan and	*/
+/*	inf, and compilers without 128 bit integers go to	*/
+/*	snprintf.						*/
+/*								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "rhessys.h"
+
+#define	OUTPUT_VALUE_LEN	400
+
+static	int	output_digits = 6;
+
+void	set_output_digits(int digits)
+{
+	output_digits = max(0, min(15, digits));
+}
+
+static	int	format_fixed(char *text, double value, int digits)
+{
+#ifdef __SIZEOF_INT128__
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	static	const	uint64_t	power[16] = {1ULL, 10ULL, 100ULL,
+		1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+		100000000ULL, 1000000000ULL, 10000000000ULL,
+		100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+		100000000000000ULL, 1000000000000000ULL};
+	unsigned __int128	scaled, half, remainder;
+	uint64_t	bits, mantissa, whole, fraction, odd;
+	int	exponent, shift, n, i;
+	char	reverse[24];
+
+	memcpy(&bits, &value, sizeof(bits));
+	exponent = (int) ((bits >> 52) & 0x7ff);
+	mantissa = bits & ((1ULL << 52) - 1);
+	if (exponent == 0x7ff)
+		return(snprintf(text, OUTPUT_VALUE_LEN, "%.*f", digits, value));
+	if (exponent == 0)
+		exponent = 1;
+	else
+		mantissa |= (1ULL << 52);
+
+	/*--------------------------------------------------------------*/
+	/*	value = mantissa * 2^-shift				*/
+	/*--------------------------------------------------------------*/
+	shift = 1075 - exponent;
+	if (shift <= 0) {
+		if (shift < -10)
+			return(snprintf(text, OUTPUT_VALUE_LEN, "%.*f", digits, value));
+		whole = mantissa << (-shift);
+		fraction = 0;
+	}
+	else if (shift >= 128) {
+		whole = 0;
+		fraction = 0;
+	}
+	else {
+		if (shift < 64) {
+			whole = mantissa >> shift;
+			scaled = (unsigned __int128) (mantissa & ((1ULL << shift) - 1))
+				* power[digits];
+		}
+		else {
+			whole = 0;
+			scaled = (unsigned __int128) mantissa * power[digits];
+		}
+		fraction = (uint64_t) (scaled >> shift);
+		remainder = scaled - ((unsigned __int128) fraction << shift);
+		half = (unsigned __int128) 1 << (shift - 1);
+		odd = (digits == 0) ? (whole & 1) : (fraction & 1);
+		if ((remainder > half) || ((remainder == half) && odd))
+			fraction++;
+		if (fraction == power[digits]) {
+			fraction = 0;
+			whole++;
+		}
+	}
+
+	n = 0;
+	if (bits >> 63)
+		text[n++] = '-';
+	i = 0;
+	do {
+		reverse[i++] = (char) ('0' + whole % 10);
+		whole /= 10;
+	} while (whole > 0);
+	while (i > 0)
+		text[n++] = reverse[--i];
+	if (digits > 0) {
+		text[n++] = '.';
+		for (i = digits - 1; i >= 0; i--) {
+			text[n + i] = (char) ('0' + fraction % 10);
+			fraction /= 10;
+		}
+		n += digits;
+	}
+	text[n] = '\0';
+	return(n);
+#else
+	return(snprintf(text, OUTPUT_VALUE_LEN, "%.*f", digits, value));
+#endif
+}
+
+static	void	append_separator(struct output_line_object *line, char *separator)
+{
+	while (*separator != '\0')
+		line[0].text[line[0].length++] = *separator++;
+	/*--------------------------------------------------------------*/
+	/*	keep room for the next value				*/
+	/*--------------------------------------------------------------*/
+	if (line[0].length > OUTPUT_LINE_LEN - OUTPUT_VALUE_LEN - 16) {
+		if (fwrite(line[0].text, 1, line[0].length, line[0].outfile)
+			!= (size_t) line[0].length)
+			line[0].check = -1;
+		else if (line[0].check >= 0)
+			line[0].check += line[0].length;
+		line[0].length = 0;
+	}
+}
+
+void	output_line_start(struct output_line_object *line, FILE *outfile)
+{
+	line[0].outfile = outfile;
+	line[0].length = 0;
+	line[0].check = 0;
+}
+
+void	output_line_int(struct output_line_object *line,
+			long value,
+			char *separator)
+{
+	char	reverse[24];
+	unsigned long	magnitude;
+	int	i;
+
+	if (value < 0) {
+		line[0].text[line[0].length++] = '-';
+		magnitude = 0UL - (unsigned long) value;
+	}
+	else
+		magnitude = (unsigned long) value;
+	i = 0;
+	do {
+		reverse[i++] = (char) ('0' + magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude > 0);
+	while (i > 0)
+		line[0].text[line[0].length++] = reverse[--i];
+	append_separator(line, separator);
+}
+
+void	output_line_double(struct output_line_object *line,
+			   double value,
+			   char *separator)
+{
+	line[0].length += format_fixed(&(line[0].text[line[0].length]),
+		value, output_digits);
+	append_separator(line, separator);
+}
+
+int	output_line_end(struct output_line_object *line)
+{
+	if ((line[0].length > 0)
+		&& (fwrite(line[0].text, 1, line[0].length, line[0].outfile)
+			!= (size_t) line[0].length))
+		line[0].check = -1;
+	else if (line[0].check >= 0)
+		line[0].check += line[0].length;
+	line[0].length = 0;
+	return(line[0].check);
+}
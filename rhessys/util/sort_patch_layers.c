@@ -18,6 +18,14 @@
 /*								*/
 /*  PROGRAMMER NOTES                                            */
 /*                                                              */
+/*	Called every day from patch_daily_I.  The layers are	*/
+/*	only regrouped when a stratum no longer has the height	*/
+/*	of its layer (or the strata were not yet layered);	*/
+/*	otherwise only base and null_cover are refreshed.	*/
+/*	Regrouping fills the strata lists allocated by		*/
+/*	construct_patch, which hold num_canopy_strata entries	*/
+/*	each, and orders the layers by insertion sort, which	*/
+/*	is linear when the order has not changed.		*/
 /*                                                              */
 /*                                                              */
 /*--------------------------------------------------------------*/
@@ -27,86 +35,58 @@
 
 void sort_patch_layers( struct patch_object *patch)
 {
-	/*--------------------------------------------------------------*/
-	/*  Local function declaration                                  */
-	/*--------------------------------------------------------------*/
-	int key_compare(void *,  void *);
-	void	*alloc( 	size_t, char *, char *);
 	/*--------------------------------------------------------------*/
 	/*  Local variable definition.                                  */
 	/*--------------------------------------------------------------*/
-	int i, j,k;
-	int list_bottom;
+	int i, j, k;
+	int num_strata, dirty;
 	double cover_fraction;
-	/*--------------------------------------------------------------*/
-	/*	free current layer structure				*/
-	/*--------------------------------------------------------------*/
-	for ( i=0 ; i<patch[0].num_layers ; i++ ) {
-		free(patch[0].layers[i].strata);
-		patch[0].layers[i].count = 0;
+	struct layer_object layer;
+	/*--------------------------------------------------------------*/
+	/*	check that every stratum still has its layer height	*/
+	/*--------------------------------------------------------------*/
+	dirty = 0;
+	num_strata = 0;
+	for ( i=0 ; (i<patch[0].num_layers) && (dirty == 0) ; i++ ) {
+		for ( k=0 ; k<patch[0].layers[i].count ; k++ )
+			if ( patch[0].canopy_strata[(patch[0].layers[i].strata[k])][0].epv.height
+				!= patch[0].layers[i].height )
+				dirty = 1;
+		num_strata += patch[0].layers[i].count;
 	}
-	/*--------------------------------------------------------------*/
-	/*		Establish index of next free list entry.	*/
-	/*--------------------------------------------------------------*/
-
-	patch[0].num_layers = 0;
-	list_bottom = 0;
-	/*--------------------------------------------------------------*/
-	/*	Determine the	unique height layers in the patch	*/
-	/*--------------------------------------------------------------*/
-	for( i=0; i<patch[0].num_canopy_strata ; i++ ){
+	if ( num_strata != patch[0].num_canopy_strata )
+		dirty = 1;
+	if ( dirty == 1 ) {
 		/*--------------------------------------------------------------*/
-		/*		Check if this height alread exists.		*/
+		/*	Determine the	unique height layers in the patch	*/
+		/*	and the strata in each, in stratum order		*/
 		/*--------------------------------------------------------------*/
-		j = 0;
-		while( (j<list_bottom) && (patch[0].canopy_strata[i][0].epv.height!=
-			(patch[0].layers[j]).height) ){
-			j++;
+		patch[0].num_layers = 0;
+		for( j=0; j<patch[0].num_canopy_strata ; j++ ){
+			i = 0;
+			while( (i<patch[0].num_layers) && (patch[0].canopy_strata[j][0].epv.height!=
+				(patch[0].layers[i]).height) ){
+				i++;
+			}
+			if ( i >= patch[0].num_layers ){
+				(patch[0].layers[i]).height =
+					patch[0].canopy_strata[j][0].epv.height;
+				(patch[0].layers[i]).count = 0;
+				patch[0].num_layers++;
+			}
+			patch[0].layers[i].strata[(patch[0].layers[i].count)++] = j;
 		}
 		/*--------------------------------------------------------------*/
-		/*		If we did not find this height in the list	*/
-		/*		add it to the bottom of the list.		*/
-		/*		otherwise just increment the count of layers	*/
-		/*		at height "height".				*/
+		/*	Now sort the layer list into descending order.		*/
 		/*--------------------------------------------------------------*/
-		if ( j >= list_bottom ){
-			(patch[0].layers[list_bottom]).height =
-				patch[0].canopy_strata[i][0].epv.height;
-			(patch[0].layers[list_bottom]).count = 1;
-			list_bottom++;
-		}
-		else {
-			(patch[0].layers[j]).count++;
+		for ( i=1 ; i<patch[0].num_layers ; i++ ){
+			layer = patch[0].layers[i];
+			for ( j=i ; (j>0) && (patch[0].layers[j-1].height < layer.height) ; j-- )
+				patch[0].layers[j] = patch[0].layers[j-1];
+			patch[0].layers[j] = layer;
 		}
 	}
-	/*--------------------------------------------------------------*/
-	/*	Define number of unique layers in this patch.		*/
-	/*--------------------------------------------------------------*/
-	patch[0].num_layers = list_bottom;
-	/*--------------------------------------------------------------*/
-	/*	Now sort the layer list into descending order.		*/
-	/*--------------------------------------------------------------*/
-	qsort(
-		(void *) patch[0].layers,
-		(size_t) patch[0].num_layers,
-		sizeof(struct layer_object),
-		key_compare);
-	/*--------------------------------------------------------------*/
-	/*	Now construct a list of pointers to strata at each	*/
-	/*	height layer						*/
-	/*--------------------------------------------------------------*/
 	for ( i=0 ; i<patch[0].num_layers ; i++ ){
-		/*--------------------------------------------------------------*/
-		/*		Allocate the list for layer i			*/
-		/*--------------------------------------------------------------*/
-		patch[0].layers[i].strata = (long *)
-			alloc(patch[0].layers[i].count*sizeof(long),
-			"patch[0].layers[i].strata",
-			"construct_patch");
-		/*--------------------------------------------------------------*/
-		/*		Reset the cover_fraction accumulator		*/
-		/*--------------------------------------------------------------*/
-		cover_fraction = 0.0;
 		/*--------------------------------------------------------------*/
 		/*	assign a bottom of layer				*/
 		/*--------------------------------------------------------------*/
@@ -115,27 +95,12 @@ void sort_patch_layers( struct patch_object *patch)
 		else
 			patch[0].layers[i].base = 0.0;
 		/*--------------------------------------------------------------*/
-		/*		Find all strata with height matching layer i	*/
+		/*		Keep a running total of the cover fraction in	*/
+		/*		this layer to check that it adds to 1.0		*/
 		/*--------------------------------------------------------------*/
-		k = 0;
-		for ( j=0 ; j<patch[0].num_canopy_strata; j++ ){
-			/*--------------------------------------------------------------*/
-			/*			check if this stratum has layer i height*/
-			/*--------------------------------------------------------------*/
-			if ( patch[0].canopy_strata[j][0].epv.height
-				==(patch[0].layers[i]).height){
-			/*--------------------------------------------------------------*/
-			/*		Add the stratum index to the layer if it matches*/
-			/*--------------------------------------------------------------*/
-				patch[0].layers[i].strata[k] = j;
-				k++;
-				/*--------------------------------------------------------------*/
-				/*		Keep a running total of the cover fraction in	*/
-				/*		this layer to check that it adds to 1.0		*/
-				/*--------------------------------------------------------------*/
-				cover_fraction += patch[0].canopy_strata[j][0].cover_fraction;
-			}
-		}
+		cover_fraction = 0.0;
+		for ( k=0 ; k<patch[0].layers[i].count; k++ )
+			cover_fraction += patch[0].canopy_strata[(patch[0].layers[i].strata[k])][0].cover_fraction;
 		/*--------------------------------------------------------------*/
 		/*		Report a fatal error if the cover fraction for	*/
 		/*		this layer does not add to 1.0			*/
@@ -12,6 +12,8 @@
 /*                                                              */
 /*		-d print debug information 			*/
 /*		-v print verbose information 			*/
+/*		-s build the table in a single raster pass	*/
+/*		   (see stream_table.c)				*/
 /*                                                              */
 /*  DESCRIPTION                                                 */
 /*                                                              */
@@ -31,6 +33,7 @@
 #include "glb.h"
 #include "sub.h"
 #include "stream.h"
+#include "stream_table.h"
 #include "limits.h"
 
 /* Function prototypes */
@@ -213,6 +216,10 @@ int main(int argc, char *argv[])
     debug_flag ->key = 'd';
     debug_flag ->description = "print debug info";
 
+    struct Flag* single_pass_flag  = G_define_flag();
+    single_pass_flag ->key = 's';
+    single_pass_flag ->description = "build stream table in a single raster pass (maxPasses is ignored)";
+
     // Parse GRASS arguments
     if (G_parser(argc, argv))
         exit(1);
@@ -332,6 +339,43 @@ int main(int argc, char *argv[])
         printf("Cataloging streams...\n");
     }
 
+    if (single_pass_flag->answer) {
+        streamRasters rasters;
+
+        rasters.maxr = maxr;
+        rasters.maxc = maxc;
+        rasters.stream = stream;
+        rasters.dem = dem;
+        rasters.patch = patch;
+        rasters.zone = zone;
+        rasters.hill = hill;
+        rasters.basin = (rnbasin != NULL) ? basin : NULL;
+        rasters.ManningsN_map = ManningsN_map;
+        rasters.streamTopWidth_map = streamTopWidth_map;
+        rasters.streamBottomWidth_map = streamBottomWidth_map;
+        rasters.streamDepth_map = streamDepth_map;
+        rasters.ManningsN = ManningsN;
+        rasters.streamTopWidth = streamTopWidth;
+        rasters.streamBottomWidth = streamBottomWidth;
+        rasters.streamDepth = streamDepth;
+        rasters.cellResolution = cellResolution;
+
+        streamCnt = buildStreamTable(&rasters, &streamEntryPtr);
+
+        FILE *streamOutFile = fopen(output_name_opt->answer, "w");
+        if (streamOutFile == NULL)
+            G_fatal_error("Unable to open output file <%s>", output_name_opt->answer);
+        if (verbose)
+            printf("Writing out file %s\n", output_name_opt->answer);
+        writeStreamTable(streamOutFile, streamEntryPtr, streamCnt, cellResolution);
+        fclose(streamOutFile);
+        freeStreamTable(streamEntryPtr, streamCnt);
+
+        if (verbose)
+            printf("Program %s Done\n", argv[0]);
+        return EXIT_SUCCESS;
+    }
+
     streamEntry *newStreamPtr = NULL;
 
     /* Loop though the stream raster map and collect info on each stream reach that is found.
@@ -0,0 +1,188 @@
+/*--------------------------------------------------------------*/
+/*                                                              */
+/*                                                              */
+/*  NAME                                                        */
+/*		 create_stream_table_grid			*/
+/*                                                              */
+/*                                                              */
+/*  SYNOPSIS                                                    */
+/* 		 cst_grid -output file -stream file -dem file	*/
+/*			-patch file -zone file -hill file	*/
+/*			[-basin file] [-ManningsN value|file]	*/
+/*			[-streamTopWidth value|file]		*/
+/*			[-streamBottomWidth value|file]		*/
+/*			[-streamDepth value|file]		*/
+/*			[-bin rows cols cellsize]		*/
+/*			[-nodata value] [-v] [-d]		*/
+/*                                                              */
+/*  OPTIONS                                                     */
+/*                                                              */
+/*		-bin read headerless 4 byte binary grids	*/
+/*		     (int for id maps, float otherwise)		*/
+/*		-nodata no data value of binary grids		*/
+/*		     (default -9999)				*/
+/*		-d print debug information 			*/
+/*		-v print verbose information 			*/
+/*                                                              */
+/*  DESCRIPTION                                                 */
+/*                                                              */
+/*  Same stream table as cst, built with the single pass        */
+/*  algorithm in stream_table.c from ESRI ASCII (default) or    */
+/*  binary grids, so that no GRASS session is needed.           */
+/*                                                              */
+/*--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gridio.h"
+#include "stream_table.h"
+
+/* Global variables */
+int    debug;
+int    verbose;
+
+static void usage(const char *pgm) {
+    fprintf(stderr, "Usage: %s -output file -stream file -dem file -patch file -zone file -hill file\n", pgm);
+    fprintf(stderr, "          [-basin file] [-ManningsN value|file] [-streamTopWidth value|file]\n");
+    fprintf(stderr, "          [-streamBottomWidth value|file] [-streamDepth value|file]\n");
+    fprintf(stderr, "          [-bin rows cols cellsize] [-nodata value] [-v] [-d]\n");
+    exit(EXIT_FAILURE);
+}
+
+/* Channel parameters may be given either as a constant or as a grid file name */
+static const float *readParameter(const char *arg, float *constant, gridInfo *info, const char *name) {
+    char *pEnd;
+    float inVal;
+
+    if (arg == NULL)
+        return NULL;
+
+    inVal = strtof(arg, &pEnd);
+    if (pEnd != arg && *pEnd == '\0') {
+        *constant = inVal;
+        if (verbose)
+            printf("Using constant value for %s: %7.3f\n", name, *constant);
+        return NULL;
+    }
+    if (verbose)
+        printf("Using grid for %s: %s\n", name, arg);
+    return readFloatGrid(arg, info);
+}
+
+int main(int argc, char *argv[])
+{
+    char *fnOutput = NULL;
+    char *fnStream = NULL;
+    char *fnDem = NULL;
+    char *fnPatch = NULL;
+    char *fnZone = NULL;
+    char *fnHill = NULL;
+    char *fnBasin = NULL;
+    char *argManningsN = NULL;
+    char *argStreamTopWidth = NULL;
+    char *argStreamBottomWidth = NULL;
+    char *argStreamDepth = NULL;
+    int i;
+    int streamCnt;
+    FILE *streamOutFile;
+    gridInfo info;
+    streamRasters rasters;
+    streamEntry *streamEntryPtr = NULL;
+
+    memset(&info, 0, sizeof(info));
+    info.nodata = GRID_NODATA_DEFAULT;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0)
+            verbose = 1;
+        else if (strcmp(argv[i], "-d") == 0)
+            debug = 1;
+        else if (strcmp(argv[i], "-bin") == 0) {
+            if (i + 3 >= argc)
+                usage(argv[0]);
+            info.binary = true;
+            info.maxr = atoi(argv[++i]);
+            info.maxc = atoi(argv[++i]);
+            info.cellsize = atof(argv[++i]);
+        }
+        else if (i + 1 >= argc)
+            usage(argv[0]);
+        else if (strcmp(argv[i], "-output") == 0)
+            fnOutput = argv[++i];
+        else if (strcmp(argv[i], "-stream") == 0)
+            fnStream = argv[++i];
+        else if (strcmp(argv[i], "-dem") == 0)
+            fnDem = argv[++i];
+        else if (strcmp(argv[i], "-patch") == 0)
+            fnPatch = argv[++i];
+        else if (strcmp(argv[i], "-zone") == 0)
+            fnZone = argv[++i];
+        else if (strcmp(argv[i], "-hill") == 0)
+            fnHill = argv[++i];
+        else if (strcmp(argv[i], "-nodata") == 0)
+            info.nodata = atof(argv[++i]);
+        else if (strcmp(argv[i], "-basin") == 0)
+            fnBasin = argv[++i];
+        else if (strcmp(argv[i], "-ManningsN") == 0)
+            argManningsN = argv[++i];
+        else if (strcmp(argv[i], "-streamTopWidth") == 0)
+            argStreamTopWidth = argv[++i];
+        else if (strcmp(argv[i], "-streamBottomWidth") == 0)
+            argStreamBottomWidth = argv[++i];
+        else if (strcmp(argv[i], "-streamDepth") == 0)
+            argStreamDepth = argv[++i];
+        else
+            usage(argv[0]);
+    }
+
+    if (fnOutput == NULL || fnStream == NULL || fnDem == NULL || fnPatch == NULL || fnZone == NULL || fnHill == NULL)
+        usage(argv[0]);
+
+    memset(&rasters, 0, sizeof(rasters));
+    rasters.ManningsN = 0.05;
+    rasters.streamTopWidth = 1.0;
+    rasters.streamBottomWidth = 1.0;
+    rasters.streamDepth = 1.0;
+
+    rasters.stream = readIntGrid(fnStream, &info);
+    rasters.dem = readDoubleGrid(fnDem, &info);
+    rasters.patch = readIntGrid(fnPatch, &info);
+    rasters.zone = readIntGrid(fnZone, &info);
+    rasters.hill = readIntGrid(fnHill, &info);
+    if (fnBasin != NULL)
+        rasters.basin = readIntGrid(fnBasin, &info);
+
+    rasters.ManningsN_map = readParameter(argManningsN, &rasters.ManningsN, &info, "ManningsN");
+    rasters.streamTopWidth_map = readParameter(argStreamTopWidth, &rasters.streamTopWidth, &info, "stream top width");
+    rasters.streamBottomWidth_map = readParameter(argStreamBottomWidth, &rasters.streamBottomWidth, &info, "stream bottom width");
+    rasters.streamDepth_map = readParameter(argStreamDepth, &rasters.streamDepth, &info, "stream depth");
+
+    rasters.maxr = info.maxr;
+    rasters.maxc = info.maxc;
+    rasters.cellResolution = info.cellsize;
+
+    if (verbose) {
+        printf("maxr: %d\n", rasters.maxr);
+        printf("maxc: %d\n", rasters.maxc);
+        printf("Grid cell resolution: %7.2f\n", rasters.cellResolution);
+    }
+
+    streamCnt = buildStreamTable(&rasters, &streamEntryPtr);
+
+    if ((streamOutFile = fopen(fnOutput, "w")) == NULL) {
+        fprintf(stderr, "Fatal error: cannot open output file %s\n", fnOutput);
+        exit(EXIT_FAILURE);
+    }
+    if (verbose)
+        printf("Writing out file %s\n", fnOutput);
+    writeStreamTable(streamOutFile, streamEntryPtr, streamCnt, rasters.cellResolution);
+    fclose(streamOutFile);
+
+    freeStreamTable(streamEntryPtr, streamCnt);
+
+    if (verbose)
+        printf("Program %s Done\n", argv[0]);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,179 @@
+/*--------------------------------------------------------------*/
+/*                                                              */
+/*  NAME                                                        */
+/*		 gridio						*/
+/*                                                              */
+/*  DESCRIPTION                                                 */
+/*                                                              */
+/*  Read ESRI ASCII or headerless binary grids so that cst can  */
+/*  be run without a GRASS session.                             */
+/*                                                              */
+/*--------------------------------------------------------------*/
+
+#include <ctype.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "gridio.h"
+
+static FILE *openGrid(const char *filename, const char *mode) {
+    FILE *in;
+
+    if ((in = fopen(filename, mode)) == NULL) {
+        fprintf(stderr, "Fatal error: cannot open grid file %s\n", filename);
+        exit(EXIT_FAILURE);
+    }
+    return in;
+}
+
+static void *allocGrid(const gridInfo *info, size_t size) {
+    void *array = malloc(size * info->maxr * info->maxc);
+
+    if (array == NULL) {
+        fprintf(stderr, "Fatal error: unable to allocate a %d x %d grid\n", info->maxr, info->maxc);
+        exit(EXIT_FAILURE);
+    }
+    return array;
+}
+
+/* Read the ESRI ASCII header and check it against the dimensions of grids already read.
+   cellsize and nodata are those of this grid only; keys it leaves out get the defaults. */
+static void readAsciiHeader(FILE *in, const char *filename, gridInfo *info) {
+    char key[64];
+    double value;
+    long pos;
+    int nrows = 0;
+    int ncols = 0;
+
+    info->cellsize = 0.0;
+    info->nodata = GRID_NODATA_DEFAULT;
+    for (;;) {
+        pos = ftell(in);
+        if (fscanf(in, "%63s", key) != 1)
+            break;
+        if (!isalpha((unsigned char)key[0])) {
+            fseek(in, pos, SEEK_SET);
+            break;
+        }
+        if (fscanf(in, "%lf", &value) != 1)
+            break;
+        if (strcasecmp(key, "ncols") == 0)
+            ncols = (int)value;
+        else if (strcasecmp(key, "nrows") == 0)
+            nrows = (int)value;
+        else if (strcasecmp(key, "cellsize") == 0)
+            info->cellsize = value;
+        else if (strcasecmp(key, "nodata_value") == 0)
+            info->nodata = value;
+    }
+
+    if (nrows <= 0 || ncols <= 0) {
+        fprintf(stderr, "Fatal error: %s is not an ESRI ASCII grid\n", filename);
+        exit(EXIT_FAILURE);
+    }
+    if (info->cellsize <= 0.0) {
+        fprintf(stderr, "Fatal error: %s has no cellsize in its header\n", filename);
+        exit(EXIT_FAILURE);
+    }
+    if (info->maxr != 0 && (info->maxr != nrows || info->maxc != ncols)) {
+        fprintf(stderr, "Fatal error: %s is %d x %d, expected %d x %d\n", filename, nrows, ncols, info->maxr, info->maxc);
+        exit(EXIT_FAILURE);
+    }
+    info->maxr = nrows;
+    info->maxc = ncols;
+}
+
+static void checkBinaryInfo(const char *filename, const gridInfo *info) {
+    if (info->maxr <= 0 || info->maxc <= 0) {
+        fprintf(stderr, "Fatal error: rows and columns must be given to read binary grid %s\n", filename);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int *readIntGrid(const char *filename, gridInfo *info) {
+    FILE *in;
+    int *array;
+    double value;
+    size_t i, n;
+
+    if (info->binary) {
+        checkBinaryInfo(filename, info);
+        in = openGrid(filename, "rb");
+        array = (int *) allocGrid(info, sizeof(int));
+        n = (size_t)info->maxr * info->maxc;
+        if (fread(array, sizeof(int), n, in) != n) {
+            fprintf(stderr, "Fatal error: %s is shorter than %d x %d\n", filename, info->maxr, info->maxc);
+            exit(EXIT_FAILURE);
+        }
+        for (i = 0; i < n; i++)
+            if (array[i] == (int)info->nodata)
+                array[i] = INT_MIN;
+    } else {
+        in = openGrid(filename, "r");
+        readAsciiHeader(in, filename, info);
+        array = (int *) allocGrid(info, sizeof(int));
+        n = (size_t)info->maxr * info->maxc;
+        for (i = 0; i < n; i++) {
+            if (fscanf(in, "%lf", &value) != 1) {
+                fprintf(stderr, "Fatal error: %s is shorter than %d x %d\n", filename, info->maxr, info->maxc);
+                exit(EXIT_FAILURE);
+            }
+            array[i] = (value == info->nodata) ? INT_MIN : (int)value;
+        }
+    }
+
+    fclose(in);
+    return array;
+}
+
+double *readDoubleGrid(const char *filename, gridInfo *info) {
+    FILE *in;
+    double *array;
+    float value;
+    size_t i, n;
+
+    if (info->binary) {
+        checkBinaryInfo(filename, info);
+        in = openGrid(filename, "rb");
+        array = (double *) allocGrid(info, sizeof(double));
+        n = (size_t)info->maxr * info->maxc;
+        for (i = 0; i < n; i++) {
+            if (fread(&value, sizeof(float), 1, in) != 1) {
+                fprintf(stderr, "Fatal error: %s is shorter than %d x %d\n", filename, info->maxr, info->maxc);
+                exit(EXIT_FAILURE);
+            }
+            array[i] = (value == (float)info->nodata) ? NAN : value;
+        }
+    } else {
+        in = openGrid(filename, "r");
+        readAsciiHeader(in, filename, info);
+        array = (double *) allocGrid(info, sizeof(double));
+        n = (size_t)info->maxr * info->maxc;
+        for (i = 0; i < n; i++) {
+            if (fscanf(in, "%lf", &array[i]) != 1) {
+                fprintf(stderr, "Fatal error: %s is shorter than %d x %d\n", filename, info->maxr, info->maxc);
+                exit(EXIT_FAILURE);
+            }
+            if (array[i] == info->nodata)
+                array[i] = NAN;
+        }
+    }
+
+    fclose(in);
+    return array;
+}
+
+float *readFloatGrid(const char *filename, gridInfo *info) {
+    double *values = readDoubleGrid(filename, info);
+    float *array = (float *) allocGrid(info, sizeof(float));
+    size_t i, n;
+
+    n = (size_t)info->maxr * info->maxc;
+    for (i = 0; i < n; i++)
+        array[i] = (float)values[i];
+    free(values);
+    return array;
+}
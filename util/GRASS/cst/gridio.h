@@ -0,0 +1,33 @@
+#ifndef GRIDIO_H
+#define GRIDIO_H
+
+#include <stdbool.h>
+
+/* Description of a grid read outside of GRASS.
+
+   ESRI ASCII grids carry their own header (ncols, nrows, cellsize,
+   NODATA_value ...). Binary grids are headerless row major arrays of 4 byte
+   values (int for integer maps, float for real maps) whose dimensions,
+   resolution and no data value must be given by the caller.
+ */
+typedef struct {
+    bool binary;
+    int maxr;		/* rows, 0 if not yet known */
+    int maxc;		/* columns, 0 if not yet known */
+    double cellsize;
+    double nodata;
+} gridInfo;
+
+/* NODATA_value of an ESRI ASCII grid whose header does not give one */
+#define GRID_NODATA_DEFAULT -9999.0
+
+/* Read an integer grid; no data cells are set to INT_MIN, as for GRASS CELL maps */
+int *readIntGrid(const char *filename, gridInfo *info);
+
+/* Read a real valued grid into doubles; no data cells are set to NaN */
+double *readDoubleGrid(const char *filename, gridInfo *info);
+
+/* Read a real valued grid into floats; no data cells are set to NaN */
+float *readFloatGrid(const char *filename, gridInfo *info);
+
+#endif // GRIDIO_H
@@ -1,3 +1,6 @@
+#ifndef STREAM_H
+#define STREAM_H
+
     /* Struct that holds info for streams that intersect with the current stream. */
     typedef struct {
         int streamId; //
@@ -35,3 +38,5 @@
         int basinDivisionCnt;
         bool printed;
     } streamEntry ;
+
+#endif // STREAM_H
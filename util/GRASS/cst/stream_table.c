@@ -0,0 +1,574 @@
+/*--------------------------------------------------------------*/
+/*                                                              */
+/*  NAME                                                        */
+/*		 stream_table					*/
+/*                                                              */
+/*  DESCRIPTION                                                 */
+/*                                                              */
+/*  Single pass construction of the RHESSys stream table.       */
+/*                                                              */
+/*  The original cst algorithm sweeps the full raster once to   */
+/*  catalog reaches, once more to find intersections and then   */
+/*  up to maxPasses more times to connect reaches that were     */
+/*  missed because of scan order, with a linear search over the */
+/*  reach list for every stream cell. Here the raster is swept  */
+/*  once: reach IDs, basin divisions and reach adjacencies are  */
+/*  found through hash tables, and the connection and ordering  */
+/*  steps are done on the (small) reach adjacency graph.        */
+/*                                                              */
+/*  PROGRAMMER NOTES                                            */
+/*                                                              */
+/*  Neighbour cells are inspected in the same order as cst.c    */
+/*  and downstream reaches are chosen with the same elevation   */
+/*  rules as checkStreamIntxns. Connection is repeated on the   */
+/*  graph until no more reaches can be connected, so maxPasses  */
+/*  has no meaning here. Neighbour cells outside the basin mask */
+/*  are not considered.                                         */
+/*                                                              */
+/*--------------------------------------------------------------*/
+
+#include <float.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "stream_table.h"
+
+extern int debug;
+extern int verbose;
+
+#define MAX_DOWNSTREAM_REACH_COUNT 10
+#define HASH_EMPTY -1
+
+/* Open addressing hash table keyed by up to four ints */
+typedef struct {
+    int key[4];
+    int value;
+} hashSlot;
+
+typedef struct {
+    size_t size;	/* always a power of two */
+    size_t count;
+    hashSlot *slots;
+} keyHash;
+
+/* Adjacent reach candidates for one reach, in the order they were encountered */
+typedef struct {
+    int *reach;
+    int *row;
+    int *col;
+    int cnt;
+    int cap;
+} reachLinks;
+
+static void *xrealloc(void *ptr, size_t size) {
+    void *newPtr = realloc(ptr, size);
+    if (newPtr == NULL && size != 0) {
+        fprintf(stderr, "Fatal error: unable to allocate %lu bytes in cst\n", (unsigned long)size);
+        exit(EXIT_FAILURE);
+    }
+    return newPtr;
+}
+
+static size_t hashKey(const int key[4]) {
+    uint64_t h = 1469598103934665603ULL;
+    int i;
+    for (i = 0; i < 4; i++) {
+        h ^= (uint32_t)key[i];
+        h *= 1099511628211ULL;
+        h ^= h >> 29;
+    }
+    return (size_t)h;
+}
+
+static void keyHashInit(keyHash *h, size_t size) {
+    size_t i;
+    h->size = 64;
+    while (h->size < size)
+        h->size <<= 1;
+    h->count = 0;
+    h->slots = (hashSlot *) xrealloc(NULL, h->size * sizeof(hashSlot));
+    for (i = 0; i < h->size; i++)
+        h->slots[i].value = HASH_EMPTY;
+}
+
+static void keyHashInsertSlot(keyHash *h, const int key[4], int value) {
+    size_t mask = h->size - 1;
+    size_t i = hashKey(key) & mask;
+    while (h->slots[i].value != HASH_EMPTY)
+        i = (i + 1) & mask;
+    memcpy(h->slots[i].key, key, sizeof(h->slots[i].key));
+    h->slots[i].value = value;
+    h->count++;
+}
+
+static void keyHashGrow(keyHash *h) {
+    hashSlot *oldSlots = h->slots;
+    size_t oldSize = h->size;
+    size_t i;
+
+    keyHashInit(h, oldSize * 2);
+    for (i = 0; i < oldSize; i++) {
+        if (oldSlots[i].value != HASH_EMPTY)
+            keyHashInsertSlot(h, oldSlots[i].key, oldSlots[i].value);
+    }
+    free(oldSlots);
+}
+
+/* Return the value stored for key, or store and return value if key is new. */
+static int keyHashGetOrInsert(keyHash *h, const int key[4], int value, bool *inserted) {
+    size_t mask;
+    size_t i;
+
+    if (2 * (h->count + 1) > h->size)
+        keyHashGrow(h);
+
+    mask = h->size - 1;
+    i = hashKey(key) & mask;
+    while (h->slots[i].value != HASH_EMPTY) {
+        if (memcmp(h->slots[i].key, key, sizeof(h->slots[i].key)) == 0) {
+            *inserted = false;
+            return h->slots[i].value;
+        }
+        i = (i + 1) & mask;
+    }
+    memcpy(h->slots[i].key, key, sizeof(h->slots[i].key));
+    h->slots[i].value = value;
+    h->count++;
+    *inserted = true;
+    return value;
+}
+
+static void keyHashFree(keyHash *h) {
+    free(h->slots);
+    h->slots = NULL;
+    h->size = h->count = 0;
+}
+
+static void initStreamEntry(streamEntry *entry, int streamId) {
+    memset(entry, 0, sizeof(streamEntry));
+    entry->streamId = streamId;
+    entry->minElevation = DBL_MAX;
+    entry->maxElevation = -DBL_MAX;
+    entry->downstreamReach.streamId = -1;
+    entry->upstreamReaches = NULL;
+    entry->basinDivisions = NULL;
+    entry->printed = false;
+}
+
+/* Find the index of a reach, adding a new reach entry if it has not been seen before */
+static int findReachIndex(int streamId, keyHash *reachIndex, streamEntry **entries, reachLinks **links,
+                          int *streamCnt, int *streamCap) {
+    bool inserted;
+    int key[4] = { streamId, 0, 0, 0 };
+    int i = keyHashGetOrInsert(reachIndex, key, *streamCnt, &inserted);
+
+    if (inserted) {
+        if (*streamCnt == *streamCap) {
+            *streamCap = (*streamCap == 0) ? 256 : 2 * (*streamCap);
+            *entries = (streamEntry *) xrealloc(*entries, sizeof(streamEntry) * (*streamCap));
+            *links = (reachLinks *) xrealloc(*links, sizeof(reachLinks) * (*streamCap));
+        }
+        initStreamEntry((*entries) + i, streamId);
+        memset((*links) + i, 0, sizeof(reachLinks));
+        (*streamCnt)++;
+    }
+    return i;
+}
+
+static void addReachLink(reachLinks *link, int reach, int row, int col) {
+    if (link->cnt == link->cap) {
+        link->cap = (link->cap == 0) ? 4 : 2 * link->cap;
+        link->reach = (int *) xrealloc(link->reach, sizeof(int) * link->cap);
+        link->row = (int *) xrealloc(link->row, sizeof(int) * link->cap);
+        link->col = (int *) xrealloc(link->col, sizeof(int) * link->cap);
+    }
+    link->reach[link->cnt] = reach;
+    link->row[link->cnt] = row;
+    link->col[link->cnt] = col;
+    link->cnt++;
+}
+
+static void addDivision(streamEntry *entry, int patchId, int zoneId, int hillId) {
+    basinDivision *division;
+
+    /* basinDivisionCnt is also used as the capacity, grown in powers of two */
+    if ((entry->basinDivisionCnt & (entry->basinDivisionCnt - 1)) == 0) {
+        int cap = (entry->basinDivisionCnt == 0) ? 1 : 2 * entry->basinDivisionCnt;
+        entry->basinDivisions = (basinDivision *) xrealloc(entry->basinDivisions, sizeof(basinDivision) * cap);
+    }
+    division = entry->basinDivisions + entry->basinDivisionCnt;
+    division->patchId = patchId;
+    division->zoneId = zoneId;
+    division->hillId = hillId;
+    entry->basinDivisionCnt++;
+}
+
+static void addUpstreamReach(streamEntry *downstreamPtr, const streamEntry *upstreamPtr, int row, int col) {
+    streamIntxn *upstream;
+
+    if ((downstreamPtr->upstreamCnt & (downstreamPtr->upstreamCnt - 1)) == 0) {
+        int cap = (downstreamPtr->upstreamCnt == 0) ? 1 : 2 * downstreamPtr->upstreamCnt;
+        downstreamPtr->upstreamReaches = (streamIntxn *) xrealloc(downstreamPtr->upstreamReaches, sizeof(streamIntxn) * cap);
+    }
+    upstream = downstreamPtr->upstreamReaches + downstreamPtr->upstreamCnt;
+    upstream->streamId = upstreamPtr->streamId;
+    upstream->row = row;
+    upstream->col = col;
+    upstream->minElevation = upstreamPtr->minElevation;
+    upstream->maxElevation = upstreamPtr->maxElevation;
+    downstreamPtr->upstreamCnt++;
+}
+
+/* Decide whether the adjacent reach can be the downstream reach of the current reach.
+   These are the rules of checkStreamIntxns in cst.c, walking the already connected
+   downstream reaches of the adjacent reach.
+ */
+static bool isDownstreamReach(const streamEntry *entries, const int *downstream, int current, int adjacent) {
+    const double elevationDiffThreshold = 0.0;
+    const streamEntry *currentStreamPtr = entries + current;
+    int candidate = adjacent;
+    int downstreamReachCount;
+    double streamMidPoint;
+
+    for (downstreamReachCount = 1; downstreamReachCount <= MAX_DOWNSTREAM_REACH_COUNT; downstreamReachCount++) {
+        const streamEntry *candidatePtr = entries + candidate;
+
+        /* Looped back to ourselves */
+        if (candidate == current)
+            return false;
+
+        streamMidPoint = candidatePtr->maxElevation - ((candidatePtr->maxElevation - candidatePtr->minElevation) / 2.0);
+
+        /* Candidate is actually upstream */
+        if ((streamMidPoint - currentStreamPtr->maxElevation) > elevationDiffThreshold)
+            return false;
+
+        if ((currentStreamPtr->minElevation - streamMidPoint) >= elevationDiffThreshold)
+            return true;
+
+        if (downstream[candidate] == -1)
+            return false;
+        candidate = downstream[candidate];
+    }
+    return false;
+}
+
+static const streamEntry *sortEntries;
+
+static int compareElevation(const void *a, const void *b) {
+    int i = *(const int *)a;
+    int j = *(const int *)b;
+    double ei = sortEntries[i].maxElevation;
+    double ej = sortEntries[j].maxElevation;
+
+    if (ei > ej)
+        return -1;
+    if (ei < ej)
+        return 1;
+    return (i < j) ? -1 : (i > j);
+}
+
+int buildStreamTable(const streamRasters *rasters, streamEntry **streamEntryPtr) {
+
+    /* Adjacent cells, in the same order that cst.c checks them */
+    static const int dRow[8] = { 1, 1, 1, 0, -1, -1, -1, 0 };
+    static const int dCol[8] = { -1, 0, 1, 1, 1, 0, -1, -1 };
+
+    const int maxr = rasters->maxr;
+    const int maxc = rasters->maxc;
+    const int *stream = rasters->stream;
+    const int *basin = rasters->basin;
+
+    keyHash reachIndex;
+    keyHash divisionIndex;
+    keyHash linkIndex;
+    streamEntry *entries = NULL;
+    streamEntry *ordered = NULL;
+    reachLinks *links = NULL;
+    int *downstream;
+    int *downstreamLink;
+    int *order;
+    int *stack;
+    int *nextUpstream;
+    int **upstreamIdx;
+    bool *visited;
+    bool inserted;
+    bool changed;
+    int streamCnt = 0;
+    int streamCap = 0;
+    int row, col, index, nRow, nCol, nIndex;
+    int streamId, adjacentId;
+    int current, adjacent;
+    int i, k, n, top, pass;
+    int key[4];
+    double demValue;
+    double distance;
+
+    keyHashInit(&reachIndex, 1024);
+    keyHashInit(&divisionIndex, 4096);
+    keyHashInit(&linkIndex, 4096);
+
+    if (verbose)
+        printf("Cataloging streams and stream intersections in a single pass...\n");
+
+    for (row = 0; row < maxr; ++row) {
+        for (col = 0; col < maxc; ++col) {
+            index = col + row*maxc;
+
+            /* If a basin map was provided, only process cells within the basin. */
+            if (basin != NULL && (basin[index] == STREAM_NULL_CELL || basin[index] == 0))
+                continue;
+
+            streamId = stream[index];
+            if (streamId == STREAM_NULL_CELL)
+                continue;
+
+            current = findReachIndex(streamId, &reachIndex, &entries, &links, &streamCnt, &streamCap);
+            streamEntry *currentStreamPtr = entries + current;
+
+            currentStreamPtr->pixelCount++;
+
+            demValue = rasters->dem[index];
+            if (demValue > currentStreamPtr->maxElevation)
+                currentStreamPtr->maxElevation = demValue;
+            if (demValue < currentStreamPtr->minElevation)
+                currentStreamPtr->minElevation = demValue;
+
+            if (rasters->ManningsN_map != NULL)
+                currentStreamPtr->ManningsN += rasters->ManningsN_map[index];
+            if (rasters->streamTopWidth_map != NULL)
+                currentStreamPtr->streamTopWidth += rasters->streamTopWidth_map[index];
+            if (rasters->streamBottomWidth_map != NULL)
+                currentStreamPtr->streamBottomWidth += rasters->streamBottomWidth_map[index];
+            if (rasters->streamDepth_map != NULL)
+                currentStreamPtr->streamDepth += rasters->streamDepth_map[index];
+
+            key[0] = current;
+            key[1] = rasters->patch[index];
+            key[2] = rasters->zone[index];
+            key[3] = rasters->hill[index];
+            keyHashGetOrInsert(&divisionIndex, key, 0, &inserted);
+            if (inserted)
+                addDivision(currentStreamPtr, key[1], key[2], key[3]);
+
+            /* Record every other reach that touches this cell */
+            for (k = 0; k < 8; k++) {
+                nRow = row + dRow[k];
+                nCol = col + dCol[k];
+                if (nRow < 0 || nCol < 0 || nRow >= maxr || nCol >= maxc)
+                    continue;
+                nIndex = nCol + nRow*maxc;
+
+                adjacentId = stream[nIndex];
+                if (adjacentId == STREAM_NULL_CELL || adjacentId == streamId)
+                    continue;
+                if (basin != NULL && (basin[nIndex] == STREAM_NULL_CELL || basin[nIndex] == 0))
+                    continue;
+
+                /* entries may move when a reach is added */
+                adjacent = findReachIndex(adjacentId, &reachIndex, &entries, &links, &streamCnt, &streamCap);
+                key[0] = current;
+                key[1] = adjacent;
+                key[2] = key[3] = 0;
+                keyHashGetOrInsert(&linkIndex, key, 0, &inserted);
+                if (inserted)
+                    addReachLink(links + current, adjacent, nRow, nCol);
+            }
+        }
+    }
+
+    keyHashFree(&divisionIndex);
+    keyHashFree(&linkIndex);
+
+    if (verbose)
+        printf("Found %d stream reaches\n", streamCnt);
+
+    /* Assign reach wide values */
+    for (i = 0; i < streamCnt; i++) {
+        streamEntry *currentStreamPtr = entries + i;
+
+        distance = currentStreamPtr->pixelCount * rasters->cellResolution;
+        if (currentStreamPtr->maxElevation == currentStreamPtr->minElevation)
+            currentStreamPtr->slope = 0;
+        else
+            currentStreamPtr->slope = (currentStreamPtr->maxElevation - currentStreamPtr->minElevation) / distance;
+
+        if (rasters->ManningsN_map != NULL)
+            currentStreamPtr->ManningsN /= currentStreamPtr->pixelCount;
+        else
+            currentStreamPtr->ManningsN = rasters->ManningsN;
+
+        if (rasters->streamTopWidth_map != NULL)
+            currentStreamPtr->streamTopWidth /= currentStreamPtr->pixelCount;
+        else
+            currentStreamPtr->streamTopWidth = rasters->streamTopWidth;
+
+        if (rasters->streamBottomWidth_map != NULL)
+            currentStreamPtr->streamBottomWidth /= currentStreamPtr->pixelCount;
+        else
+            currentStreamPtr->streamBottomWidth = rasters->streamBottomWidth;
+
+        if (rasters->streamDepth_map != NULL)
+            currentStreamPtr->streamDepth /= currentStreamPtr->pixelCount;
+        else
+            currentStreamPtr->streamDepth = rasters->streamDepth;
+    }
+
+    /* Connect each reach to its downstream reach. A connection may only become possible
+       once the adjacent reach has itself been connected, so repeat until nothing changes.
+     */
+    downstream = (int *) xrealloc(NULL, sizeof(int) * (streamCnt + 1));
+    downstreamLink = (int *) xrealloc(NULL, sizeof(int) * (streamCnt + 1));
+    for (i = 0; i < streamCnt; i++)
+        downstream[i] = downstreamLink[i] = -1;
+
+    pass = 0;
+    do {
+        changed = false;
+        pass++;
+        for (i = 0; i < streamCnt; i++) {
+            if (downstream[i] != -1)
+                continue;
+            for (k = 0; k < links[i].cnt; k++) {
+                if (isDownstreamReach(entries, downstream, i, links[i].reach[k])) {
+                    downstream[i] = links[i].reach[k];
+                    downstreamLink[i] = k;
+                    entries[i].downstreamReach.streamId = entries[downstream[i]].streamId;
+                    entries[i].downstreamReach.row = links[i].row[k];
+                    entries[i].downstreamReach.col = links[i].col[k];
+                    entries[i].downstreamReachMinElevation = entries[downstream[i]].minElevation;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    } while (changed);
+
+    if (verbose) {
+        n = 0;
+        for (i = 0; i < streamCnt; i++)
+            if (downstream[i] == -1)
+                n++;
+        printf("Connected stream reaches in %d graph passes\n", pass);
+        printf("Final count of stream reaches without an outlet: %d\n", n);
+    }
+
+    /* Reverse the downstream links to get the upstream reaches */
+    upstreamIdx = (int **) xrealloc(NULL, sizeof(int *) * (streamCnt + 1));
+    for (i = 0; i < streamCnt; i++)
+        upstreamIdx[i] = NULL;
+    for (i = 0; i < streamCnt; i++) {
+        if (downstream[i] == -1)
+            continue;
+        n = entries[downstream[i]].upstreamCnt;
+        addUpstreamReach(entries + downstream[i], entries + i, links[i].row[downstreamLink[i]], links[i].col[downstreamLink[i]]);
+        upstreamIdx[downstream[i]] = (int *) xrealloc(upstreamIdx[downstream[i]], sizeof(int) * (n + 1));
+        upstreamIdx[downstream[i]][n] = i;
+    }
+
+    /* Order reaches from highest to lowest, as cst.c does, but never write a reach before
+       any of its upstream reaches: depth first post order over the upstream links.
+     */
+    order = (int *) xrealloc(NULL, sizeof(int) * (streamCnt + 1));
+    for (i = 0; i < streamCnt; i++)
+        order[i] = i;
+    sortEntries = entries;
+    qsort(order, streamCnt, sizeof(int), compareElevation);
+
+    ordered = (streamEntry *) xrealloc(NULL, sizeof(streamEntry) * (streamCnt + 1));
+    stack = (int *) xrealloc(NULL, sizeof(int) * (streamCnt + 1));
+    nextUpstream = (int *) xrealloc(NULL, sizeof(int) * (streamCnt + 1));
+    visited = (bool *) xrealloc(NULL, sizeof(bool) * (streamCnt + 1));
+    for (i = 0; i < streamCnt; i++) {
+        nextUpstream[i] = 0;
+        visited[i] = false;
+    }
+
+    n = 0;
+    for (k = 0; k < streamCnt; k++) {
+        if (visited[order[k]])
+            continue;
+        top = 0;
+        stack[top++] = order[k];
+        visited[order[k]] = true;
+        while (top > 0) {
+            current = stack[top - 1];
+            if (nextUpstream[current] < entries[current].upstreamCnt) {
+                adjacent = upstreamIdx[current][nextUpstream[current]++];
+                if (!visited[adjacent]) {
+                    visited[adjacent] = true;
+                    stack[top++] = adjacent;
+                }
+            } else {
+                ordered[n++] = entries[current];
+                top--;
+            }
+        }
+    }
+
+    for (i = 0; i < streamCnt; i++) {
+        free(links[i].reach);
+        free(links[i].row);
+        free(links[i].col);
+        free(upstreamIdx[i]);
+    }
+    free(links);
+    free(upstreamIdx);
+    free(downstream);
+    free(downstreamLink);
+    free(order);
+    free(stack);
+    free(nextUpstream);
+    free(visited);
+    free(entries);
+    keyHashFree(&reachIndex);
+
+    *streamEntryPtr = ordered;
+    return streamCnt;
+}
+
+void writeStreamTable(FILE *streamOutFile, streamEntry *streamEntryPtr, int streamCnt, float cellResolution) {
+
+    streamEntry *currentStreamPtr;
+    basinDivision *currentBasinDivisionPtr;
+    int i, j;
+
+    fprintf(streamOutFile, "%i\n", streamCnt);
+
+    for (i = 0; i < streamCnt; i++) {
+        currentStreamPtr = streamEntryPtr + i;
+
+        fprintf(streamOutFile, "\n%d %7.2f %7.2f %7.2f %7.4f %7.4f %7.2f\n", currentStreamPtr->streamId, currentStreamPtr->streamTopWidth,
+                currentStreamPtr->streamBottomWidth, currentStreamPtr->streamDepth, currentStreamPtr->slope, currentStreamPtr->ManningsN,
+                currentStreamPtr->pixelCount*cellResolution);
+        fprintf(streamOutFile, "%d\n", currentStreamPtr->basinDivisionCnt);
+
+        for (j = 0; j < currentStreamPtr->basinDivisionCnt; ++j) {
+            currentBasinDivisionPtr = (currentStreamPtr->basinDivisions) + j;
+            fprintf(streamOutFile, "    %d %d %d\n", currentBasinDivisionPtr->patchId, currentBasinDivisionPtr->zoneId, currentBasinDivisionPtr->hillId);
+        }
+
+        fprintf(streamOutFile, "%d\n", currentStreamPtr->upstreamCnt);
+        for (j = 0; j < currentStreamPtr->upstreamCnt; ++j)
+            fprintf(streamOutFile, "    %d\n", currentStreamPtr->upstreamReaches[j].streamId);
+
+        if (currentStreamPtr->downstreamReach.streamId == -1) {
+            fprintf(streamOutFile, "0\n");
+        } else {
+            fprintf(streamOutFile, "1\n");
+            fprintf(streamOutFile, "    %d\n", currentStreamPtr->downstreamReach.streamId);
+        }
+        currentStreamPtr->printed = true;
+    }
+}
+
+void freeStreamTable(streamEntry *streamEntryPtr, int streamCnt) {
+    int i;
+
+    for (i = 0; i < streamCnt; i++) {
+        free(streamEntryPtr[i].basinDivisions);
+        free(streamEntryPtr[i].upstreamReaches);
+    }
+    free(streamEntryPtr);
+}
@@ -0,0 +1,55 @@
+#ifndef STREAM_TABLE_H
+#define STREAM_TABLE_H
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "stream.h"
+
+/* Value used for "no data" in CELL (integer) rasters */
+#define STREAM_NULL_CELL INT_MIN
+
+/* Input rasters and constants for the single pass stream table builder.
+   All rasters are maxr x maxc in row major order. The basin mask and the
+   four channel parameter maps are optional and may be NULL, in which case
+   the constant value is used for every reach.
+ */
+typedef struct {
+    int maxr;
+    int maxc;
+    const int *stream;
+    const double *dem;
+    const int *patch;
+    const int *zone;
+    const int *hill;
+    const int *basin;
+    const float *ManningsN_map;
+    const float *streamTopWidth_map;
+    const float *streamBottomWidth_map;
+    const float *streamDepth_map;
+    float ManningsN;
+    float streamTopWidth;
+    float streamBottomWidth;
+    float streamDepth;
+    float cellResolution;
+} streamRasters;
+
+/* Build the stream table with a single sweep over the rasters.
+
+   Reach statistics, basin divisions and reach adjacency are collected in one
+   raster pass, using hash tables keyed by reach ID. Downstream reaches are
+   then resolved on the reach adjacency graph (with the same elevation rules
+   as checkStreamIntxns) and reaches are ordered so that every reach is
+   written after all of its upstream reaches.
+
+   On return *streamEntryPtr holds the reaches in output order and
+   the number of reaches is returned.
+ */
+int buildStreamTable(const streamRasters *rasters, streamEntry **streamEntryPtr);
+
+/* Write a stream table, in the format read by construct_stream_routing_topology */
+void writeStreamTable(FILE *streamOutFile, streamEntry *streamEntryPtr, int streamCnt, float cellResolution);
+
+void freeStreamTable(streamEntry *streamEntryPtr, int streamCnt);
+
+#endif // STREAM_TABLE_H
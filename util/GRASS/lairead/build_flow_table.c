@@ -24,10 +24,116 @@
 #include <stdlib.h> 
 #include <string.h>
 #include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "blender.h"
 #include "fileio.h"
 
+/* patch totals gathered by one thread over its band of rows */
+struct patch_sum
+	{
+	int	patchID;
+	int	zoneID;
+	int	hillID;
+	int	vegid;
+	int	area;
+	double	lai;
+	int	pch;		/* flow table index, set when merged */
+	};
+
+/* open addressing table of patch_sum keyed on (patch, zone, hill) */
+struct patch_hash
+	{
+	int	n;
+	int	cap;
+	int	nslots;
+	int	*slots;		/* entry index + 1, 0 if empty */
+	struct patch_sum *sums;
+	};
+
+static unsigned int patch_key(int patchID, int zoneID, int hillID)
+{
+	unsigned int h;
+
+	h = (unsigned int)patchID * 2654435761u;
+	h ^= (unsigned int)zoneID * 2246822519u;
+	h ^= (unsigned int)hillID * 3266489917u;
+	return(h ^ (h >> 15));
+}
+
+static void patch_hash_init(struct patch_hash *t, int cap)
+{
+	t->n = 0;
+	t->cap = cap;
+	t->nslots = 2*cap;
+	t->slots = (int *)calloc(t->nslots, sizeof(int));
+	t->sums = (struct patch_sum *)malloc(cap*sizeof(struct patch_sum));
+	if ((t->slots == NULL) || (t->sums == NULL)) {
+		fprintf(stderr, "ERROR: Could not allocate patch hash table\n");
+		exit(1);
+		}
+}
+
+static void patch_hash_grow(struct patch_hash *t)
+{
+	int i, s;
+
+	t->cap *= 2;
+	t->nslots = 2*t->cap;
+	t->sums = (struct patch_sum *)realloc(t->sums, t->cap*sizeof(struct patch_sum));
+	free(t->slots);
+	t->slots = (int *)calloc(t->nslots, sizeof(int));
+	if ((t->slots == NULL) || (t->sums == NULL)) {
+		fprintf(stderr, "ERROR: Could not allocate patch hash table\n");
+		exit(1);
+		}
+	for (i=0; i < t->n; i++) {
+		s = patch_key(t->sums[i].patchID, t->sums[i].zoneID, t->sums[i].hillID) % t->nslots;
+		while (t->slots[s] != 0)
+			s = (s + 1) % t->nslots;
+		t->slots[s] = i + 1;
+		}
+}
+
+/* return the entry for a patch, adding an empty one if it is new */
+static struct patch_sum *patch_hash_find(struct patch_hash *t, int patchID, int zoneID, int hillID)
+{
+	int s, i;
+	struct patch_sum *p;
+
+	s = patch_key(patchID, zoneID, hillID) % t->nslots;
+	while ((i = t->slots[s]) != 0) {
+		p = &(t->sums[i-1]);
+		if ((p->patchID == patchID) && (p->zoneID == zoneID) && (p->hillID == hillID))
+			return(p);
+		s = (s + 1) % t->nslots;
+		}
+
+	if (t->n == t->cap) {
+		patch_hash_grow(t);
+		return(patch_hash_find(t, patchID, zoneID, hillID));
+		}
+	t->slots[s] = t->n + 1;
+	p = &(t->sums[t->n]);
+	t->n += 1;
+	p->patchID = patchID;
+	p->zoneID = zoneID;
+	p->hillID = hillID;
+	p->vegid = 0;
+	p->area = 0;
+	p->lai = 0.0;
+	p->pch = 0;
+	return(p);
+}
+
+static void patch_hash_free(struct patch_hash *t)
+{
+	free(t->slots);
+	free(t->sums);
+}
+
 int build_flow_table(f1, flow_table, vegid, lai, hill, zone, patch, maxr, maxc )
 	struct flow_struct *flow_table;
 	int *patch;
@@ -42,12 +148,14 @@ int build_flow_table(f1, flow_table, vegid, lai, hill, zone, patch, maxr, maxc )
 
  	/* local variable declarations */
 	int num_patches;
-	int inx;
-	int r,c,pch;
+	int nthreads;
+	int badlabel;
+	int i, t, pch;
+	struct patch_hash *band, all;
+	struct patch_sum *p, *q;
 
  	/* local function definitions */
 	void	zero_flow_table();
-	int		find_patch();
 
 
 	num_patches = 0;
@@ -55,61 +163,102 @@ int build_flow_table(f1, flow_table, vegid, lai, hill, zone, patch, maxr, maxc )
 	printf("\n Initializing flowtable");
 	zero_flow_table(flow_table, maxr, maxc);
 
+#ifdef _OPENMP
+	nthreads = omp_get_max_threads();
+#else
+	nthreads = 1;
+#endif
+	band = (struct patch_hash *)calloc(nthreads, sizeof(struct patch_hash));
+	badlabel = 0;
 
+	/* each thread sums the cells of a contiguous band of rows, so that
+	   merging the bands in thread order keeps patches in the raster
+	   order of their first cell and gives each the vegid of its last cell */
 	printf("\n searching %d rows and %d cols", maxr, maxc);
-	for (r=0; r< maxr; r++) 
+#pragma omp parallel private(t, i, p) reduction(max: badlabel)
+	{
+	int r, c, inx, r0, r1, nt;
+
+#ifdef _OPENMP
+	t = omp_get_thread_num();
+	nt = omp_get_num_threads();
+#else
+	t = 0;
+	nt = 1;
+#endif
+	r0 = (int)(((long)maxr * t) / nt);
+	r1 = (int)(((long)maxr * (t+1)) / nt);
+	patch_hash_init(&(band[t]), 1024);
+
+	for (r=r0; r< r1; r++) 
 		{
 		for (c=0; c< maxc; c++)
 			{
 			inx = r*maxc+c;
 			if (patch[inx] == -99999) {
-				printf("error in patch file use of -99999 as a patch label not allowed \n");
-				exit(1);
+				badlabel = 1;
+				continue;
 				}
 
-
 			/* ignore areas outside the basin */
 			if (( patch[inx] > 0) && (zone[inx] > 0) && (hill[inx] > 0)) {
-				pch = find_patch(num_patches, flow_table, patch[inx], zone[inx], hill[inx]);
-				if (pch == 0) {
-					num_patches += 1;
-					pch = num_patches;
-					}
-				flow_table[pch].patchID = patch[inx];
-				flow_table[pch].hillID = hill[inx];
-				flow_table[pch].zoneID = zone[inx];
-				flow_table[pch].area += 1;
-				flow_table[pch].vegid = vegid[inx];
-				if (flow_table[pch].lai < ZERO)
-						flow_table[pch].lai = 0.0;
-				if (lai[inx] > 0.0) {
-					flow_table[pch].lai += ( float ) (1.0 * lai[inx]);
-				}
-
+				p = patch_hash_find(&(band[t]), patch[inx], zone[inx], hill[inx]);
+				p->area += 1;
+				p->vegid = vegid[inx];
+				if (lai[inx] > 0.0)
+					p->lai += lai[inx];
 				} /* end if */
 			}		
 			
 		}
+	}
+
+	if (badlabel) {
+		printf("error in patch file use of -99999 as a patch label not allowed \n");
+		exit(1);
+		}
+
+	/* merge the bands; the table maps each patch to its flow table index */
+	patch_hash_init(&all, 1024);
+	for (t=0; t < nthreads; t++) {
+		for (i=0; i < band[t].n; i++) {
+			p = &(band[t].sums[i]);
+			q = patch_hash_find(&all, p->patchID, p->zoneID, p->hillID);
+			if (q->pch == 0) {
+				num_patches += 1;
+				q->pch = num_patches;
+				flow_table[num_patches].patchID = p->patchID;
+				flow_table[num_patches].hillID = p->hillID;
+				flow_table[num_patches].zoneID = p->zoneID;
+				flow_table[num_patches].lai = 0.0;
+				}
+			pch = q->pch;
+			flow_table[pch].area += p->area;
+			flow_table[pch].vegid = p->vegid;
+			q->lai += p->lai;
+			}
+		patch_hash_free(&(band[t]));
+		}
+	free(band);
 
 	printf("\n Total number of patches is %d", num_patches);
 
 
 	/* compute mean pch values */
-	for (pch = 1; pch <= num_patches; pch++) 
+	for (i=0; i < all.n; i++) 
 		{
+		pch = all.sums[i].pch;
 		if (flow_table[pch].area > 0.0)
-			flow_table[pch].lai = flow_table[pch].lai / flow_table[pch].area;
+			flow_table[pch].lai = (float)(all.sums[i].lai / flow_table[pch].area);
 		else {
 			printf("\n patch %d has zero area and %f lai", flow_table[pch].patchID, flow_table[pch].lai);
 			flow_table[pch].lai = flow_table[pch].lai;
 			}
 		}
+	patch_hash_free(&all);
 
 
 	return(num_patches);
 
 
     }
-
-
-
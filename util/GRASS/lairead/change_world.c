@@ -34,8 +34,17 @@
 
 #include "blender.h"
 
+/* index of the strata of a basin keyed on (hill, zone, patch, stratum) ID */
+struct world_index {
+	int nslots;
+	int *keys;
+	struct tlevelstruct **links;
+	};
+
 /* function declarations */
 	struct tlevelstruct *find_tlevel(struct tlevelstruct *, int *, int);
+	void build_world_index(struct world_index *, struct tlevelstruct *);
+	struct tlevelstruct *find_world_index(struct world_index *, int *);
 	struct tlevelstruct *readnextlevel(int, FILE *);
 	void writenextlevel(struct tlevelstruct *, int, FILE *);
 
@@ -46,12 +55,13 @@ change_world(char* oldworld_name, FILE *oldworld, FILE *redefine,
 */
   struct tlevelstruct *tlevel;
   struct headerstruct *header;
-  int level, ID[5], i, j, n, itmp;
+  int level, ID[6], i, j, n, itmp;
   char ch;
   char name[MAXNAME], line[MAXTEMPLATELINE];
   char header_filename[MAXS];
   FILE *header_file;
   int legacy_worldfile = 0;
+  struct world_index index;
 
   /* Determine where to read worldfile header information from.
   	 * The two options, in order of precedence are:
@@ -128,6 +138,11 @@ change_world(char* oldworld_name, FILE *oldworld, FILE *redefine,
 
 	printf("\n finished reading worldfile");
 
+	/* patches are looked up in the first basin, which must have ID 1 */
+	index.nslots = 0;
+	if ((tlevel[0].nchildren > 0) && (tlevel[0].children[0][0].ID == 1))
+		build_world_index(&index, tlevel[0].children[0]);
+
 	/* ******************************************************* */
 	/* ******************************************************* */
 
@@ -140,7 +155,7 @@ change_world(char* oldworld_name, FILE *oldworld, FILE *redefine,
 		ID[5] = flow_table[i].patchID;
 
 		printf("\n processing patchID %d", flow_table[i].patchID);
-		flow_table[i].worldlink = find_tlevel(tlevel[0].children[0], ID, 1);
+		flow_table[i].worldlink = find_world_index(&index, ID);
 
 		if ((flow_table[i].worldlink != NULL)  && (flow_table[i].veglink != NULL) ) {
 			if ((flow_table[i].veglink[0].sla > 0.0001) && (flow_table[i].lai > -0.000)) {
@@ -157,6 +172,7 @@ change_world(char* oldworld_name, FILE *oldworld, FILE *redefine,
 				flow_table[i].worldlink[0].valuelist[7] = flow_table[i].lai/0.01;
 			} else {
 				flow_table[i].worldlink[0].valuelist[7] = flow_table[i].lai/flow_table[i].veglink[0].sla;
+			}
 					
 			flow_table[i].worldlink[0].valuelist[4] = 0.0;
 			flow_table[i].worldlink[0].valuelist[5] = 0.0;
@@ -290,6 +306,96 @@ change_world(char* oldworld_name, FILE *oldworld, FILE *redefine,
 	fclose(redefine);
 	fclose(oldworld);
 
+	if (index.nslots > 0) {
+		free(index.keys);
+		free(index.links);
+		}
+
+}
+
+/* **************************** ******************************************************* */
+/* 	index the strata of a basin, so that each patch is found with one probe	*/
+/*	rather than a walk of the tree; as with find_tlevel the first stratum	*/
+/*	met in worldfile order wins when IDs repeat				*/
+/* **************************** ******************************************************* */
+
+static unsigned int world_key(int *key)
+{
+	unsigned int h;
+
+	h = (unsigned int)key[0] * 2654435761u;
+	h ^= (unsigned int)key[1] * 2246822519u;
+	h ^= (unsigned int)key[2] * 3266489917u;
+	h ^= (unsigned int)key[3] * 668265263u;
+	return(h ^ (h >> 15));
+}
+
+void build_world_index(struct world_index *index, struct tlevelstruct *basin)
+{
+	int h, z, p, s, n, slot, key[4];
+	struct tlevelstruct *hill, *zone, *patch;
+
+	n = 0;
+	for (h=0; h < basin[0].nchildren; h++) {
+		hill = basin[0].children[h];
+		for (z=0; z < hill[0].nchildren; z++) {
+			zone = hill[0].children[z];
+			for (p=0; p < zone[0].nchildren; p++)
+				n += zone[0].children[p][0].nchildren;
+			}
+		}
+
+	index->nslots = 2*n + 1;
+	index->keys = (int *)calloc(4*index->nslots, sizeof(int));
+	index->links = (struct tlevelstruct **)calloc(index->nslots, sizeof(struct tlevelstruct *));
+	if ((index->keys == NULL) || (index->links == NULL)) {
+		fprintf(stderr,"ERROR: Could not allocate worldfile index for %d strata\n", n);
+		exit(1);
+		}
+
+	for (h=0; h < basin[0].nchildren; h++) {
+		hill = basin[0].children[h];
+		for (z=0; z < hill[0].nchildren; z++) {
+			zone = hill[0].children[z];
+			for (p=0; p < zone[0].nchildren; p++) {
+				patch = zone[0].children[p];
+				for (s=0; s < patch[0].nchildren; s++) {
+					key[0] = hill[0].ID;
+					key[1] = zone[0].ID;
+					key[2] = patch[0].ID;
+					key[3] = patch[0].children[s][0].ID;
+					slot = world_key(key) % index->nslots;
+					while ((index->links[slot] != NULL)
+						&& (memcmp(&(index->keys[4*slot]), key, sizeof(key)) != 0))
+						slot = (slot + 1) % index->nslots;
+					if (index->links[slot] == NULL) {
+						memcpy(&(index->keys[4*slot]), key, sizeof(key));
+						index->links[slot] = patch[0].children[s];
+						}
+					}
+				}
+			}
+		}
+
+	return;
+}
+
+struct tlevelstruct *find_world_index(struct world_index *index, int *ID)
+{
+	int slot;
+
+	if (index->nslots == 0)
+		return(NULL);
+
+	/* ID is indexed by level, as for find_tlevel */
+	slot = world_key(&(ID[2])) % index->nslots;
+	while (index->links[slot] != NULL) {
+		if (memcmp(&(index->keys[4*slot]), &(ID[2]), 4*sizeof(int)) == 0)
+			return(index->links[slot]);
+		slot = (slot + 1) % index->nslots;
+		}
+
+	return(NULL);
 }
 
 /* **************************** ******************************************************* */
@@ -409,9 +409,6 @@ void input_int2(array, filename, mc, mr)
 	
   int  r;
    int max; 
-	int *array2;
-
-	array2 = (int *)malloc(sizeof(int)*(mr*mc));
 
 	printf(" Maxr %d Maxc %d \n", mr, mc);
     max = 0;
@@ -428,9 +425,9 @@ void input_int2(array, filename, mc, mr)
        /* fread(array, sizeof(int), mc*mr, in1); */
 
 	for (r=0; r < mr*mc; r++) {
-		  fread(&(array2[r]),sizeof(int), 1, in1);
-		  if (array2[r] > max) 
-					max = array2[r];
+		  fread(&(array[r]),sizeof(int), 1, in1);
+		  if (array[r] > max) 
+					max = array[r];
 		   }
 		
 		 printf("\n Final Max is %d",max);
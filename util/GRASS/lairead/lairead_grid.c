@@ -0,0 +1,220 @@
+/*--------------------------------------------------------------*/
+/*                                                              */
+/*		lairead_grid					*/
+/*                                                              */
+/*  NAME                                                        */
+/*		 lairead_grid					*/
+/*                                                              */
+/*                                                              */
+/*  SYNOPSIS                                                    */
+/* 		 lairead_grid -old file -redef file -allom file	*/
+/*			-lai file -vegid file -zone file	*/
+/*			-hill file -patch file [-mask file]	*/
+/*			[-bin rows cols]			*/
+/*                                                              */
+/*  OPTIONS                                                     */
+/*                                                              */
+/*	-allom  name of allometric ratios file			*/
+/*	-old    old worldfile name				*/
+/*	-redef  new redefine worldfile name			*/
+/*	-lai, -vegid, -zone, -hill, -patch, -mask		*/
+/*		map files; cells outside the mask, or with a	*/
+/*		patch, zone or hill <= 0 (e.g. no data) are	*/
+/*		ignored						*/
+/*	-bin    maps are headerless binary rows x cols grids	*/
+/*		(4 byte int, float for lai); otherwise they	*/
+/*		are ESRI ASCII grids with the 6 line header	*/
+/*		(ncols ... NODATA_value)			*/
+/*                                                              */
+/*  DESCRIPTION                                                 */
+/*                                                              */
+/*  Same redefine worldfile as lairead, from map files rather   */
+/*  than GRASS rasters, so that it can be rerun outside of a    */
+/*  GRASS session whenever a new LAI image arrives.             */
+/*                                                              */
+/*  PROGRAMMER NOTES                                            */
+/*                                                              */
+/*--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "blender.h"
+#include "sub.h"
+
+void	input_int2(int *, char *, int, int);
+void	input_float2(float *, char *, int, int);
+void	input_header(int *, int *, char *, int);
+
+static void usage(char *pgm)
+{
+	fprintf(stderr, "usage: %s -old file -redef file -allom file -lai file -vegid file\n", pgm);
+	fprintf(stderr, "          -zone file -hill file -patch file [-mask file] [-bin rows cols]\n");
+	exit(EXIT_FAILURE);
+}
+
+static int *read_int_map(char *filename, int maxr, int maxc, int bin_flag)
+{
+	int *array;
+
+	if ( (array = (int *)malloc(maxr*maxc*sizeof(int))) == NULL) {
+		fprintf(stderr, "cannot allocate %d x %d map for %s\n", maxr, maxc, filename);
+		exit(EXIT_FAILURE);
+	}
+	if (bin_flag)
+		input_int2(array, filename, maxc, maxr);
+	else
+		input_ascii_int(array, filename, maxc, maxr, 1);
+	return(array);
+}
+
+int main(int argc, char *argv[])
+{
+    /* local variable declarations */
+    int	 	i, nvegtype, num_patches;
+    FILE 	*out1, *fac;
+    FILE 	*fdWorld, *fdRedefWorld;
+    int		maxr, maxc, bin_flag;
+
+    /* filenames for each image and file */
+    char *fnAllom, *fnRedefWorld, *fnWorld;
+    char *fnLAI, *fnVegid, *fnPatch, *fnHill, *fnZone, *fnMask;
+    char name[MAXS];
+
+    /* set pointers for images */
+    int	     *vegid;
+    int      *mask;
+    int      *patch;
+    int      *hill;
+    int      *zone;
+    float *lai;
+
+    struct    allom_struct	*allometric_table;
+    struct    flow_struct	*flow_table;
+
+    fnAllom = fnRedefWorld = fnWorld = NULL;
+    fnLAI = fnVegid = fnPatch = fnHill = fnZone = fnMask = NULL;
+    maxr = maxc = 0;
+    bin_flag = 0;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-bin") == 0) {
+            if (i + 2 >= argc)
+                usage(argv[0]);
+            bin_flag = 1;
+            maxr = atoi(argv[++i]);
+            maxc = atoi(argv[++i]);
+        }
+        else if (i + 1 >= argc)
+            usage(argv[0]);
+        else if (strcmp(argv[i], "-old") == 0)
+            fnWorld = argv[++i];
+        else if (strcmp(argv[i], "-redef") == 0)
+            fnRedefWorld = argv[++i];
+        else if (strcmp(argv[i], "-allom") == 0)
+            fnAllom = argv[++i];
+        else if (strcmp(argv[i], "-lai") == 0)
+            fnLAI = argv[++i];
+        else if (strcmp(argv[i], "-vegid") == 0)
+            fnVegid = argv[++i];
+        else if (strcmp(argv[i], "-zone") == 0)
+            fnZone = argv[++i];
+        else if (strcmp(argv[i], "-hill") == 0)
+            fnHill = argv[++i];
+        else if (strcmp(argv[i], "-patch") == 0)
+            fnPatch = argv[++i];
+        else if (strcmp(argv[i], "-mask") == 0)
+            fnMask = argv[++i];
+        else
+            usage(argv[0]);
+    }
+
+    if ((fnWorld == NULL) || (fnRedefWorld == NULL) || (fnAllom == NULL) || (fnLAI == NULL)
+        || (fnVegid == NULL) || (fnZone == NULL) || (fnHill == NULL) || (fnPatch == NULL))
+        usage(argv[0]);
+    if (bin_flag && ((maxr <= 0) || (maxc <= 0)))
+        usage(argv[0]);
+
+    /* allometric file */
+    if ( (fac = fopen(fnAllom, "r")) == NULL) {
+        printf("cannot open allometric ratio file \'%s\'\n", fnAllom);
+        exit(EXIT_FAILURE);
+    }
+
+    if ( (fdWorld = fopen(fnWorld, "r")) == NULL) {
+        printf("cannot open world file \'%s\' for reading.\n", fnWorld);
+        exit(EXIT_FAILURE);
+    }
+
+    /* redefine world */
+    if ( (fdRedefWorld = fopen(fnRedefWorld, "w")) == NULL) {
+        printf("cannot open new world \'%s\' file for output.\n", fnRedefWorld);
+        exit(EXIT_FAILURE);
+    }
+
+    /* open some diagnostic output files */
+    strcpy(name, fnRedefWorld);
+    strcat(name, ".log");
+    if ( (out1 = fopen(name, "w")) == NULL) {
+        printf("cannot open diagnostic file %s for writing\n", name);
+        exit(EXIT_FAILURE);
+    }
+
+    /* map dimensions come from the patch map header */
+    if (!bin_flag)
+        input_header(&maxr, &maxc, fnPatch, 1);
+    printf("Maps are %d rows by %d cols\n", maxr, maxc);
+
+    /* allocate and input map images */
+    vegid = read_int_map(fnVegid, maxr, maxc, bin_flag);
+    patch = read_int_map(fnPatch, maxr, maxc, bin_flag);
+    zone = read_int_map(fnZone, maxr, maxc, bin_flag);
+    hill = read_int_map(fnHill, maxr, maxc, bin_flag);
+
+    if ( (lai = (float *)malloc(maxr*maxc*sizeof(float))) == NULL) {
+        fprintf(stderr, "cannot allocate %d x %d map for %s\n", maxr, maxc, fnLAI);
+        exit(EXIT_FAILURE);
+    }
+    if (bin_flag)
+        input_float2(lai, fnLAI, maxr, maxc);
+    else
+        input_ascii_float(lai, fnLAI, maxc, maxr, 1, 1.0);
+
+    /* cells outside the mask are dropped as in lairead */
+    if (fnMask != NULL) {
+        mask = read_int_map(fnMask, maxr, maxc, bin_flag);
+        for (i = 0; i < maxr*maxc; i++) {
+            if (mask[i] != 1) {
+                lai[i] = 0.0;
+                hill[i] = 0;
+                zone[i] = 0;
+                patch[i] = 0;
+                vegid[i] = 0;
+            }
+        }
+        free(mask);
+    }
+
+    /* allocate flow table */
+    flow_table = (struct flow_struct *)calloc((maxr*maxc),sizeof(struct flow_struct));
+
+    printf("\nBuilding patch table...\n");
+    /* build representation of patches */
+    num_patches = build_flow_table(out1, flow_table, vegid, lai, hill, zone, patch, maxr, maxc);
+
+    /* read in allometric ratios table */
+    fscanf(fac,"%d", &nvegtype);
+    allometric_table = (struct allom_struct *)calloc(nvegtype, sizeof(struct allom_struct));
+    read_allom_table(fac, nvegtype, allometric_table);
+    printf("number of vegetation types from allometric table: %d\n\n", nvegtype);
+
+    /* link patches with allometry */
+    printf("\n Linking vegetation and allometry...\n");
+    link_patch_veg(flow_table, allometric_table, num_patches, nvegtype);
+
+    /* now read in and change the worldfile */
+    change_world(fnWorld, fdWorld, fdRedefWorld, flow_table, num_patches);
+
+    printf("\n Finished LAIread \n\n");
+    exit(EXIT_SUCCESS);
+} /* end lairead_grid.c */